@@ -42,6 +42,7 @@
 #include "omnetpp/ccontextswitcher.h"
 #include "omnetpp/ccoroutine.h"
 #include "omnetpp/cdataratechannel.h"
+#include "omnetpp/cddsketch.h"
 #include "omnetpp/csoftowner.h"
 #include "omnetpp/cdelaychannel.h"
 #include "omnetpp/cdisplaystring.h"
@@ -87,6 +88,7 @@
 #include "omnetpp/cparimpl.h"
 #include "omnetpp/cparsimcomm.h"
 #include "omnetpp/cpatternmatcher.h"
+#include "omnetpp/cphilox.h"
 #include "omnetpp/cprecolldensityest.h"
 #include "omnetpp/cproperties.h"
 #include "omnetpp/cproperty.h"
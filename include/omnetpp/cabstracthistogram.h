@@ -80,6 +80,24 @@ class SIM_API cAbstractHistogram : public cStdDev
     virtual cAbstractHistogram *dup() const override {throw cRuntimeError(this, E_CANTDUP);}
     //@}
 
+    /** @name Redefined cStatistic functions. */
+    //@{
+    /**
+     * Calls collect(double) for each value, because density estimation
+     * classes do extra work for every observation. Subclasses that can
+     * process an array at once (e.g. cHistogram) redefine this method.
+     */
+    virtual void collect(const double *values, size_t n) override {cStatistic::collect(values, n);}
+    using cStdDev::collect;
+
+    /**
+     * Calls collectWeighted(double, double) for each value; see
+     * collect(const double *, size_t).
+     */
+    virtual void collectWeighted(const double *values, const double *weights, size_t n) override {cStatistic::collectWeighted(values, weights, n);}
+    using cStdDev::collectWeighted;
+    //@}
+
     /** @name Accessing histogram bins. */
     //@{
     /**
@@ -20,6 +20,7 @@
 #include "cownedobject.h"
 #include "simtime.h"
 #include "opp_string.h"
+#include "opp_pooledstring.h"
 #include "any_ptr.h"
 
 namespace omnetpp {
@@ -57,6 +58,11 @@ class SIM_API cClassDescriptor : public cNoncopyableOwnedObject
     cClassDescriptor *baseClassDesc = nullptr;
     int inheritanceChainLength = 1;
     int extendscObject = -1;  // 0:false, 1:true, -1:unset
+    mutable int baseClassFieldCount = -1;  // -1: unset
+
+  private:
+    int computeBaseClassFieldCount() const;
+    static cClassDescriptor *lookupDescriptorFor(const cObject *object);
 
   protected:
     // utility functions for converting from/to strings
@@ -78,6 +84,7 @@ class SIM_API cClassDescriptor : public cNoncopyableOwnedObject
     int string2enum(const char *s, const char *enumName) const;
     static std::string oppstring2string(const char *s) {return s?s:"";}
     static std::string oppstring2string(const opp_string& s) {return s.c_str();}
+    static std::string oppstring2string(const opp_pooledstring& s) {return s.c_str();}
     static std::string oppstring2string(const std::string& s)  {return s;}
     static void string2oppstring(const char *s, opp_string& str) {str = s?s:"";}
     static void string2oppstring(const char *s, std::string& str) {str = s?s:"";}
@@ -111,6 +118,9 @@ class SIM_API cClassDescriptor : public cNoncopyableOwnedObject
      * Returns the descriptor object for the given object. This can return
      * descriptor for a base class, if there is no exact match.
      * The returned descriptor object must not be deleted.
+     *
+     * The result is cached per C++ class (typeid), so this method is cheap
+     * to call repeatedly, e.g. for every message in every event.
      */
     static cClassDescriptor *getDescriptorFor(const cObject *object);
     //@}
@@ -130,6 +140,15 @@ class SIM_API cClassDescriptor : public cNoncopyableOwnedObject
      */
     virtual cClassDescriptor *getBaseClassDescriptor() const;
 
+    /**
+     * Returns the number of fields in the base class, i.e. the field index
+     * of the first field declared on this class. The value is cached, which
+     * assumes that the field count of the base class descriptor is constant.
+     * Generated descriptors use it for delegating calls with base class
+     * field indices to the base class descriptor.
+     */
+    int getBaseClassFieldCount() const {return baseClassFieldCount != -1 ? baseClassFieldCount : computeBaseClassFieldCount();}
+
     /**
      * Returns true if cObject's class descriptor is present on the inheritance chain.
      */
@@ -37,6 +37,7 @@ class cRNG;
 class cStatistic;
 class cResultRecorder;
 class cRngManager;
+class cCommBuffer;
 
 /**
  * @brief Common base for module and channel classes.
@@ -349,6 +350,30 @@ class SIM_API cComponent : public cSoftOwner //implies noncopyable
      * the job of the destructors.
      */
     virtual void preDelete(cComponent *root);
+
+    /**
+     * Checkpointing hook: it should write the state of the module or channel
+     * into the buffer when a simulation checkpoint is written (see the
+     * `checkpoint-at` configuration option). Simulation time, the contents
+     * of the future event set, the RNGs and the state of result recorders
+     * are saved by the simulation kernel; everything else that initialize()
+     * and event handling have put into data members needs to be saved here,
+     * e.g. counters, queue contents (see cCommBuffer::packObject()), and the
+     * IDs of scheduled self-messages (see cMessage::getId()). This default
+     * implementation does nothing, which is only right for components that
+     * have no state of their own.
+     */
+    virtual void checkpoint(cCommBuffer *buffer);
+
+    /**
+     * Restore hook: when a simulation is resumed from a checkpoint, it is
+     * called instead of initialize(), and it should read back exactly what
+     * checkpoint() wrote. Messages in the future event set are already
+     * restored when this method is called, and pointers to them can be
+     * obtained from the saved IDs with cSimulation::getRestoredMessage().
+     * This default implementation does nothing.
+     */
+    virtual void restore(cCommBuffer *buffer);
     //@}
 
   public:
@@ -500,6 +525,10 @@ class SIM_API cComponent : public cSoftOwner //implies noncopyable
      * This method never returns nullptr. If the module was not found,
      * an exception is thrown.
      *
+     * The results of absolute path lookups are cached by the simulation
+     * (the cache is invalidated whenever modules are created, deleted,
+     * renamed or moved), so repeated lookups of the same path are cheap.
+     *
      * Examples:
      *   "." means this module;
      *   "<root>" means the toplevel module;
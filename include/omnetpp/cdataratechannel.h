@@ -142,6 +142,10 @@ class SIM_API cDatarateChannel : public cChannel //implies noncopyable
     // internal: emits last busy signal
     virtual void finish() override;
 
+    // internal: simulation checkpoints
+    virtual void checkpoint(cCommBuffer *buffer) override;
+    virtual void restore(cCommBuffer *buffer) override;
+
   public:
     /** @name Constructors, destructor */
     //@{
@@ -0,0 +1,256 @@
+//==========================================================================
+//  CDDSKETCH.H - part of
+//                     OMNeT++/OMNEST
+//             Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_CDDSKETCH_H
+#define __OMNETPP_CDDSKETCH_H
+
+#include <vector>
+#include "cabstracthistogram.h"
+
+namespace omnetpp {
+
+namespace common { class DDSketch; };
+
+/**
+ * @brief Quantile estimation with a mergeable sketch (DDSketch).
+ *
+ * Observations are counted in logarithmically sized bins, so that any
+ * quantile (median, 99th percentile, etc.) can be obtained with a
+ * guaranteed relative error, e.g. 1% with the default relativeAccuracy=0.01.
+ * Collecting a value takes constant time, and memory use is bounded by
+ * maxBins (per sign of the values). When the observations span a range so
+ * large that maxBins is exceeded, the bins closest to zero are merged;
+ * quantiles in the upper range remain accurate.
+ *
+ * Unlike cPSquare, sketches with the same relative accuracy can be merged
+ * without loss: the result is the same as if all observations had been
+ * collected into one object. This also holds for sketches recorded into
+ * scalar files (as histograms) in separate runs, which can be merged with
+ * opp_scavetool.
+ *
+ * Weighted statistics are supported. Infinities are counted as underflows
+ * and overflows.
+ *
+ * Source: Charles Masson, Jee E. Rim, Homin K. Lee: DDSketch: A Fast and
+ * Fully-Mergeable Quantile Sketch with Relative-Error Guarantees. VLDB 2019.
+ *
+ * @ingroup Statistics
+ */
+class SIM_API cDDSketch : public cAbstractHistogram
+{
+  protected:
+    common::DDSketch *sketch;
+    double negInfSumWeights = 0, posInfSumWeights = 0;
+    int64_t numNegInfs = 0, numPosInfs = 0;
+
+    // histogram view of the sketch, computed on demand
+    mutable std::vector<double> binEdges, binValues;
+    mutable bool binsValid = false;
+
+  protected:
+    void copy(const cDDSketch& other);
+    void ensureBins() const;
+    virtual void getAttributesToRecord(opp_string_map& attributes) override;
+
+  public:
+    /** @name Constructors, destructor, assignment. */
+    //@{
+
+    /**
+     * Copy constructor.
+     */
+    cDDSketch(const cDDSketch& r);
+
+    /**
+     * Constructor. relativeAccuracy must be in the (0,1) interval;
+     * maxBins limits the number of bins per sign of the values.
+     */
+    explicit cDDSketch(const char *name=nullptr, double relativeAccuracy=0.01, int maxBins=2048, bool weighted=false);
+
+    /**
+     * Destructor.
+     */
+    virtual ~cDDSketch();
+
+    /**
+     * Assignment operator. The name member is not copied; see cNamedObject::operator=() for details.
+     */
+    cDDSketch& operator=(const cDDSketch& res);
+    //@}
+
+    /** @name Redefined cObject member functions. */
+    //@{
+
+    /**
+     * Creates and returns an exact copy of this object.
+     * See cObject for more details.
+     */
+    virtual cDDSketch *dup() const override  {return new cDDSketch(*this);}
+
+    /**
+     * Serializes the object into an MPI send buffer.
+     * Used by the simulation kernel for parallel execution.
+     * See cObject for more details.
+     */
+    virtual void parsimPack(cCommBuffer *buffer) const override;
+
+    /**
+     * Deserializes the object from an MPI receive buffer
+     * Used by the simulation kernel for parallel execution.
+     * See cObject for more details.
+     */
+    virtual void parsimUnpack(cCommBuffer *buffer) override;
+    //@}
+
+    /** @name Redefined member functions from cStatistic and cAbstractHistogram */
+    //@{
+    /**
+     * Returns true, as the bins are determined by the sketch from the start.
+     */
+    virtual bool binsAlreadySetUp() const override {return true;}
+
+    /**
+     * This cDDSketch implementation does nothing.
+     */
+    virtual void setUpBins() override {}
+
+    /**
+     * Collects one observation.
+     */
+    virtual void collect(double value) override;
+    using cStatistic::collect;
+
+    /**
+     * Collects one observation with a given weight.
+     */
+    virtual void collectWeighted(double value, double weight) override;
+    using cStatistic::collectWeighted;
+
+    /**
+     * Returns the number of bins. Bins are contiguous; they span from the
+     * bin of the smallest finite observation to that of the largest one.
+     */
+    virtual int getNumBins() const override;
+
+    /**
+     * Returns the kth bin edge.
+     */
+    virtual double getBinEdge(int k) const override;
+
+    /**
+     * Returns the total weight of the observations in the kth bin.
+     */
+    virtual double getBinValue(int k) const override;
+
+    /**
+     * Returns the number of negative infinities.
+     */
+    virtual int64_t getNumUnderflows() const override {return numNegInfs;}
+
+    /**
+     * Returns the number of positive infinities.
+     */
+    virtual int64_t getNumOverflows() const override {return numPosInfs;}
+
+    /**
+     * Returns the total weight of negative infinities.
+     */
+    virtual double getUnderflowSumWeights() const override {return negInfSumWeights;}
+
+    /**
+     * Returns the total weight of positive infinities.
+     */
+    virtual double getOverflowSumWeights() const override {return posInfSumWeights;}
+
+    /**
+     * Returns number of observations that were negative infinity, independent of their weights.
+     */
+    virtual int64_t getNumNegInfs() const override {return numNegInfs;}
+
+    /**
+     * Returns number of observations that were positive infinity, independent of their weights.
+     */
+    virtual int64_t getNumPosInfs() const override {return numPosInfs;}
+
+    /**
+     * Returns the total weight of the observations that were negative infinity.
+     */
+    virtual double getNegInfSumWeights() const override {return negInfSumWeights;}
+
+    /**
+     * Returns the total weight of the observations that were positive infinity.
+     */
+    virtual double getPosInfSumWeights() const override {return posInfSumWeights;}
+
+    /**
+     * Generates a random number from the distribution of the collected data,
+     * by taking the quantile at a uniformly distributed random position.
+     */
+    virtual double draw() const override;
+
+    /**
+     * Merges another cDDSketch with the same relative accuracy into this one.
+     * Other statistics objects are rejected with an error.
+     */
+    virtual void merge(const cStatistic *other) override;
+
+    /**
+     * Clears the results collected so far.
+     */
+    virtual void clear() override;
+
+    /**
+     * Writes the contents of the object into a text file.
+     */
+    virtual void saveToFile(FILE *) const override;
+
+    /**
+     * Reads the object data from a file, in the format written out by saveToFile().
+     */
+    virtual void loadFromFile(FILE *) override;
+    //@}
+
+    /** @name Sketch-specific methods. */
+    //@{
+    /**
+     * Returns the estimated q-quantile of the observations, 0 <= q <= 1.
+     * For finite results, the relative error is at most getRelativeAccuracy().
+     * Returns NaN if there are no observations.
+     */
+    virtual double getQuantile(double q) const;
+
+    /**
+     * Returns the relative accuracy of the sketch.
+     */
+    double getRelativeAccuracy() const;
+
+    /**
+     * Returns the maximum number of bins per sign of the values.
+     */
+    int getMaxBins() const;
+
+    /**
+     * Adds the result attributes that identify the recorded histogram as a
+     * sketch ("sketch", "relativeAccuracy"), and the estimates of the given
+     * quantiles ("p50", "p99.9", etc). Tools rely on the former to merge
+     * recorded sketches.
+     */
+    void addResultAttributes(opp_string_map& attributes, const std::vector<double>& quantiles) const;
+    //@}
+};
+
+}  // namespace omnetpp
+
+
+#endif
@@ -53,6 +53,10 @@ class SIM_API cDelayChannel : public cChannel //implies noncopyable
      */
     virtual void handleParameterChange(const char *parname) override;
 
+    // internal: simulation checkpoints
+    virtual void checkpoint(cCommBuffer *buffer) override;
+    virtual void restore(cCommBuffer *buffer) override;
+
   public:
     /** @name Constructors, destructor */
     //@{
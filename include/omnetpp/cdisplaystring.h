@@ -68,13 +68,15 @@ class SIM_API cDisplayString
 {
   private:
     enum { MAXARGS = 16 };  // maximum number of arguments per tag
+    enum { NUMERICARG_SIZE = 32 }; // buffer size for args set via the numeric setters
 
     // holds one tag
     struct Tag {
        char *name;
        int numArgs;
+       unsigned short numericArgs; // bit i set: args[i] is a NUMERICARG_SIZE-long buffer that can be overwritten in place
        char *args[MAXARGS];
-       Tag() {name=nullptr; numArgs=0;}
+       Tag() {name=nullptr; numArgs=0; numericArgs=0;}
     };
 
     char *buffer = nullptr;     // holds pieces of display string (sliced with zeroes)
@@ -87,6 +89,7 @@ class SIM_API cDisplayString
 
     // needed for notifications
     cComponent *ownerComponent = nullptr;
+    bool notificationPending = false; // whether displayStringChanged() was deferred to the end of the event
 
   private:
     void copy(const cDisplayString& other) {parse(other.str());}
@@ -96,6 +99,7 @@ class SIM_API cDisplayString
     void doUpdateWith(const cDisplayString& ds);
     bool doSetTagArg(int tagindex, int index, const char *value);
     bool doSetTagArg(const char *tagname, int index, const char *value);
+    bool setNumericTagArg(const char *tagname, int index, const char *value);
     int doInsertTag(const char *tagname, int atindex=0);
     bool doRemoveTag(int tagindex);
 
@@ -113,6 +117,7 @@ class SIM_API cDisplayString
   public:
     // internal:
     void setHostObject(cComponent *o) {ownerComponent=o;}
+    void notifyPendingChange();
     void dump(std::ostream& out) const;
 
   public:
@@ -235,11 +240,47 @@ class SIM_API cDisplayString
     bool setTagArg(const char *tagname, int index, const char *value);
 
     /**
-     * Convenience function to set a tag argument to a numeric value. Converts
-     * 'value' to string, then calls setTagArg(const char *, int, const char *).
+     * Sets a tag argument to a numeric value. Otherwise it works like
+     * setTagArg(const char *, int, const char *), but it is cheaper:
+     * the number is formatted without going through printf, and the
+     * argument's storage is reused when it is set again, so that updating
+     * e.g. the position ("p" tag) of a module in every event does not
+     * allocate memory.
      */
     bool setTagArg(const char *tagname, int index, long value);
 
+    /**
+     * Sets a tag argument to a numeric value. See setTagArg(const char *, int, long).
+     */
+    bool setTagArg(const char *tagname, int index, int value) {return setTagArg(tagname, index, (long long)value);}
+
+    /**
+     * Sets a tag argument to a numeric value. See setTagArg(const char *, int, long).
+     */
+    bool setTagArg(const char *tagname, int index, unsigned int value) {return setTagArg(tagname, index, (unsigned long long)value);}
+
+    /**
+     * Sets a tag argument to a numeric value. See setTagArg(const char *, int, long).
+     */
+    bool setTagArg(const char *tagname, int index, unsigned long value) {return setTagArg(tagname, index, (unsigned long long)value);}
+
+    /**
+     * Sets a tag argument to a numeric value. See setTagArg(const char *, int, long).
+     */
+    bool setTagArg(const char *tagname, int index, long long value);
+
+    /**
+     * Sets a tag argument to a numeric value. See setTagArg(const char *, int, long).
+     */
+    bool setTagArg(const char *tagname, int index, unsigned long long value);
+
+    /**
+     * Sets a tag argument to a numeric value. See setTagArg(const char *, int, long).
+     * Values that are integers are printed without a decimal point, other
+     * values with at most 12 significant digits.
+     */
+    bool setTagArg(const char *tagname, int index, double value);
+
     /**
      * Removes the given tag with all its arguments from the display
      * string. The result is true if the tag was actually deleted
@@ -84,6 +84,18 @@ class SIM_API cEnvir
     // connectionDeleted(), displayStringChanged().
     bool suppressNotifications = false; //FIXME set to true when not needed!
 
+    // Internal flag. When set to true, the simulation kernel MAY omit calling
+    // messageSendHop() for connections that have no channel object or have
+    // a cIdealChannel, i.e. it may deliver messages across such connections
+    // in one step.
+    bool suppressSendHopNotifications = false;
+
+    // Internal flag. When set to true, the simulation kernel MAY defer calling
+    // displayStringChanged() to the end of the current event (or network setup,
+    // initialization or finish stage), and call it only once per component
+    // even if its display string was changed several times.
+    bool coalesceDisplayStringNotifications = false;
+
   public:
     /** @name Constructor, destructor. */
     //@{
@@ -131,6 +131,7 @@ class SIM_API cGate : public cObject, noncopyable
     cChannel *channel = nullptr; // channel object (if exists)
     cGate *prevGate = nullptr;   // previous and next gate in the path
     cGate *nextGate = nullptr;
+    cGate *shortcutGate = nullptr; // next gate in the path that has a non-ideal channel or is the end gate, see getShortcutGate(); nullptr if not yet computed
 
     static OPP_THREAD_LOCAL int lastConnectionId;
 
@@ -150,6 +151,13 @@ class SIM_API cGate : public cObject, noncopyable
     // internal
     void checkChannels() const;
 
+    // internal: returns the gate messages can be fast-forwarded to, skipping
+    // the connections without a channel or with a cIdealChannel; may be this gate
+    cGate *getShortcutGate();
+
+    // internal: invalidates getShortcutGate() results affected by a change at this gate
+    void invalidateShortcutGates();
+
 #ifdef SIMFRONTEND_SUPPORT
     // internal
     virtual bool hasChangedSince(int64_t lastRefreshSerial);
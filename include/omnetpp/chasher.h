@@ -105,6 +105,99 @@ class SIM_API cHasher : noncopyable
     //@}
 };
 
+/**
+ * @brief Utility class to calculate a 64-bit hash of some data.
+ *
+ * This class has the same interface as cHasher, but computes a much stronger
+ * hash: the result is identical to the XXH64 hash (seed 0) of the bytes
+ * added. Data are collected into a 32-byte stripe buffer and hashed in four
+ * independent 64-bit lanes when the buffer fills up, so adding a large
+ * number of small values (as fingerprint calculation does) is cheap.
+ *
+ * Values are converted to bytes the same way as in cHasher: integers shorter
+ * than 32 bits are widened to 32 bits, and longs to 64 bits. Endianness is
+ * not converted.
+ *
+ * @see cFastFingerprintCalculator
+ * @ingroup Misc
+ */
+class SIM_API cHasher64 : noncopyable
+{
+  private:
+    uint64_t v[4];
+    uint64_t totalLength;
+    uint8_t stripe[32];
+    size_t stripeLength;
+
+    void merge(uint32_t x) {append(&x, 4);}
+    void merge2(uint64_t x) {append(&x, 8);}
+    void append(const void *p, size_t length) {
+        if (stripeLength + length < sizeof(stripe)) {
+            memcpy(stripe + stripeLength, p, length);
+            stripeLength += length;
+            totalLength += length;
+        }
+        else
+            update(p, length);
+    }
+    void update(const void *p, size_t length);
+
+  public:
+    /**
+     * Constructor.
+     */
+    cHasher64() {reset();}
+
+    /** @name Updating the hash */
+    //@{
+    void reset();
+    void add(char d)           {merge((uint32_t)d);}
+    void add(short d)          {merge((uint32_t)d);}
+    void add(int d)            {merge((uint32_t)d);}
+    void add(long d)           {int64_t tmp=d; merge2((uint64_t)tmp);}
+    void add(long long d)      {merge2((uint64_t)d);}
+    void add(unsigned char d)  {merge((uint32_t)d);}
+    void add(unsigned short d) {merge((uint32_t)d);}
+    void add(unsigned int d)   {merge((uint32_t)d);}
+    void add(unsigned long d)  {uint64_t tmp=d; merge2(tmp);}
+    void add(unsigned long long d)  {merge2(d);}
+    void add(double d)         {append(&d, 8);}
+    void add(simtime_t t)      {merge2(t.raw());}
+    void add(const char *s)    {if (s) append(s, strlen(s)+1); else add(0);}
+    void add(const std::string& s) {append(s.c_str(), s.size()+1);}
+    void add(const void *p, size_t length) {append(p, length);}
+    template<typename T>
+    cHasher64& operator<<(const T& x) {add(x); return *this;} // allows chaining
+    //@}
+
+    /** @name Obtaining the result */
+    //@{
+    /**
+     * Returns the hash value. The object is not changed, i.e. more data
+     * can be added afterwards.
+     */
+    uint64_t getHash() const;
+
+    /**
+     * Converts the given string to a numeric hash value. The object is
+     * not changed. Throws an error if the string does not contain a valid
+     * hash.
+     */
+    uint64_t parse(const char *hash) const;
+
+    /**
+     * Parses the given hash string, and compares it to the stored hash.
+     */
+    bool equals(const char *hash) const;
+
+    /**
+     * Returns the textual representation (hex string, four groups of four
+     * digits separated by hyphens) of the stored hash.
+     */
+    std::string str() const;
+    //@}
+};
+
 }  // namespace omnetpp
 
 #endif
@@ -106,11 +106,14 @@ class SIM_API cHistogram : public cAbstractHistogram
     // INTERNAL, only for cIHistogramSetupStrategy implementations.
     // Directly collects the value into the existing bins, without delegating to the strategy object
     virtual void collectIntoHistogram(double value, double weight=1);
+    // Array version of the above; weights may be nullptr (all weights are 1)
+    virtual void collectIntoHistogram(const double *values, const double *weights, size_t n);
     void dump() const; // for debugging
     void assertSanity();
 
   private:
     void copy(const cHistogram& other);
+    void collectFiniteRuns(const double *values, const double *weights, size_t n);
     cAutoRangeHistogramStrategy *getOrCreateAutoRangeStrategy() const;
 
   public:
@@ -196,6 +199,22 @@ class SIM_API cHistogram : public cAbstractHistogram
     virtual void collectWeighted(double value, double weight) override;
     using cAbstractHistogram::collectWeighted;
 
+    /**
+     * Collects n observations at once. The moments are accumulated as in
+     * cStdDev::collect(const double *, size_t). The values are passed to the
+     * strategy object in one call, and once the bins are set up, bin indices
+     * are computed for whole blocks of values: with a multiplication for
+     * uniform bins, and with a branchless binary search otherwise. Bin values
+     * are exactly the same as with collecting the values one by one.
+     */
+    virtual void collect(const double *values, size_t n) override;
+
+    /**
+     * Collects n observations with the corresponding weights at once.
+     * See collect(const double *, size_t).
+     */
+    virtual void collectWeighted(const double *values, const double *weights, size_t n) override;
+
     /**
      * Clears the results collected so far.
      */
@@ -73,6 +73,21 @@ class SIM_API cIHistogramStrategy : public cObject
      */
     virtual void collectWeighted(double value, double weight) = 0;
 
+    /**
+     * Called from cHistogram's collect(const double *, size_t) method with
+     * a run of finite values. The default implementation calls collect(double)
+     * for each value; strategies redefine it to pass the values to
+     * cHistogram's array version of collectIntoHistogram() when possible.
+     */
+    virtual void collect(const double *values, size_t n);
+
+    /**
+     * Called from cHistogram's collectWeighted(const double *, const double *, size_t)
+     * method. The default implementation calls collectWeighted(double, double)
+     * for each value.
+     */
+    virtual void collectWeighted(const double *values, const double *weights, size_t n);
+
     /**
      * cHistogram's setUpBins() method delegates here. Implementations are expected
      * to create bins in the associated histogram by calling its setBinEdges()
@@ -124,6 +139,12 @@ class SIM_API cFixedRangeHistogramStrategy : public cIHistogramStrategy
     virtual cFixedRangeHistogramStrategy *dup() const override {return new cFixedRangeHistogramStrategy(*this);}
     //@}
 
+    /** @name Redefined cObject methods. */
+    //@{
+    virtual void parsimPack(cCommBuffer *buffer) const override;
+    virtual void parsimUnpack(cCommBuffer *buffer) override;
+    //@}
+
     /** @name Configuring. */
     //@{
     void setRange(double lo, double hi) {this->lo = lo; this->hi = hi;}
@@ -141,6 +162,8 @@ class SIM_API cFixedRangeHistogramStrategy : public cIHistogramStrategy
     //@{
     virtual void collect(double value) override;
     virtual void collectWeighted(double value, double weight) override;
+    virtual void collect(const double *values, size_t n) override;
+    virtual void collectWeighted(const double *values, const double *weights, size_t n) override;
     virtual void setUpBins() override;
     virtual void clear() override {}
     //@}
@@ -169,6 +192,7 @@ class SIM_API cPrecollectionBasedHistogramStrategy : public cIHistogramStrategy
 
   protected:
     virtual void moveValuesIntoHistogram();
+    virtual void collectRun(const double *values, const double *weights, size_t n);
     virtual bool precollect(double value, double weight=1.0); // true: precollection over
     virtual void createBins() = 0;
 
@@ -183,6 +207,12 @@ class SIM_API cPrecollectionBasedHistogramStrategy : public cIHistogramStrategy
     cPrecollectionBasedHistogramStrategy& operator=(const cPrecollectionBasedHistogramStrategy& other);
     //@}
 
+    /** @name Redefined cObject methods. */
+    //@{
+    virtual void parsimPack(cCommBuffer *buffer) const override;
+    virtual void parsimUnpack(cCommBuffer *buffer) override;
+    //@}
+
     /** @name Configuring. */
     //@{
     int getNumToPrecollect() const {return numToPrecollect;}
@@ -195,6 +225,10 @@ class SIM_API cPrecollectionBasedHistogramStrategy : public cIHistogramStrategy
 
     /** @name Redefined cIHistogramStrategy methods */
     //@{
+    using cIHistogramStrategy::collect;
+    using cIHistogramStrategy::collectWeighted;
+    virtual void collect(const double *values, size_t n) override {collectRun(values, nullptr, n);}
+    virtual void collectWeighted(const double *values, const double *weights, size_t n) override {collectRun(values, weights, n);}
     virtual void setUpBins() override;
     virtual void clear() override;
     //@}
@@ -250,6 +284,12 @@ class SIM_API cDefaultHistogramStrategy : public cPrecollectionBasedHistogramStr
     virtual cDefaultHistogramStrategy *dup() const override {return new cDefaultHistogramStrategy(*this);}
     //@}
 
+    /** @name Redefined cObject methods. */
+    //@{
+    virtual void parsimPack(cCommBuffer *buffer) const override;
+    virtual void parsimUnpack(cCommBuffer *buffer) override;
+    //@}
+
     /** @name Configuring. */
     //@{
     int getNumBinsHint() const {return numBinsHint;}
@@ -260,6 +300,8 @@ class SIM_API cDefaultHistogramStrategy : public cPrecollectionBasedHistogramStr
     //@{
     virtual void collect(double value) override;
     virtual void collectWeighted(double value, double weight) override;
+    using cPrecollectionBasedHistogramStrategy::collect;
+    using cPrecollectionBasedHistogramStrategy::collectWeighted;
     virtual void clear() override {cPrecollectionBasedHistogramStrategy::clear();}
     //@}
 };
@@ -337,6 +379,12 @@ class SIM_API cAutoRangeHistogramStrategy : public cPrecollectionBasedHistogramS
     virtual cAutoRangeHistogramStrategy *dup() const override {return new cAutoRangeHistogramStrategy(*this);}
     //@}
 
+    /** @name Redefined cObject methods. */
+    //@{
+    virtual void parsimPack(cCommBuffer *buffer) const override;
+    virtual void parsimUnpack(cCommBuffer *buffer) override;
+    //@}
+
     /** @name Configuring. */
     //@{
     void setRangeHint(double lo, double hi) {this->lo = lo; this->hi = hi;}  ///< Use NAN to leave either value unspecified.
@@ -366,6 +414,8 @@ class SIM_API cAutoRangeHistogramStrategy : public cPrecollectionBasedHistogramS
     //@{
     virtual void collect(double value) override;
     virtual void collectWeighted(double value, double weight) override;
+    using cPrecollectionBasedHistogramStrategy::collect;
+    using cPrecollectionBasedHistogramStrategy::collectWeighted;
     virtual void clear() override;
     //@}
 };
@@ -79,6 +79,12 @@ class SIM_API cLCG32 : public cRNG
 
     /** Random double on the [0,1] interval */
     virtual double doubleRandIncl1() override;
+
+    /** Writes the RNG state into the buffer */
+    virtual void checkpoint(cCommBuffer *buffer) const override;
+
+    /** Restores the RNG state from the buffer */
+    virtual void restore(cCommBuffer *buffer) override;
 };
 
 }  // namespace omnetpp
@@ -184,6 +184,14 @@ class SIM_API cLog
      */
     static OPP_THREAD_LOCAL ComponentLogPredicate componentLogPredicate;
 
+    /**
+     * Determines whether the user (CPU) time is captured into cLogEntry::userTime
+     * for each log statement. Capturing it involves a clock() call which is
+     * relatively expensive, so user interfaces may turn it off when their log
+     * prefix format does not need it.
+     */
+    static OPP_THREAD_LOCAL bool captureUserTime;
+
   public:
     /**
      * Returns true if logging is enabled. (Logging is normally disabled while
@@ -404,7 +412,7 @@ class SIM_API cLogEntry
     int sourceLine;
     const char *sourceFunction;
 
-    // operating system related
+    // operating system related (only filled in if cLog::captureUserTime is set)
     clock_t userTime;
 
     // the actual text of the log statement
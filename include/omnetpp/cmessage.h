@@ -134,6 +134,11 @@ class SIM_API cMessage : public cEvent
     // internal: create an exact clone (including msgid) that doesn't show up in the statistics
     cMessage *privateDup() const;
 
+    // internal: used when restoring a simulation checkpoint
+    void setIds(msgid_t id, msgid_t treeId) {messageId = id; messageTreeId = treeId;}
+    static msgid_t getNextMessageId() {return nextMessageId;}
+    static void setNextMessageId(msgid_t id) {nextMessageId = id;}
+
     // internal: called by the simulation kernel as part of the send(),
     // scheduleAt() calls to set the values returned by the
     // getSenderModuleId(), getSenderGate(), getSendingTime() methods.
@@ -17,6 +17,8 @@
 #define __OMNETPP_CMODULE_H
 
 #include <vector>
+#include <cstring>
+#include <unordered_map>
 #include "ccomponent.h"
 #include "globals.h"
 #include "cgate.h"
@@ -287,11 +289,20 @@ class SIM_API cModule : public cComponent //implies noncopyable
         std::string name;
         std::vector<cModule*> array;
     };
+    struct NameHash {
+        size_t operator()(const char *s) const;
+    };
+    struct NameEq {
+        bool operator()(const char *a, const char *b) const {return strcmp(a, b) == 0;}
+    };
     struct SubcomponentData {
         std::vector<cModule*> scalarSubmodules; // scalar submodules in creation order
         std::vector<SubmoduleVector> submoduleVectors; // submodule vectors in creation order
         std::vector<cChannel*> channels;  // channels among submodules
         int submoduleChangeCount = 0;
+        // lookup by name; keys are statically pooled strings
+        std::unordered_map<const char *, cModule*, NameHash, NameEq> scalarSubmoduleByName;
+        std::unordered_map<const char *, int, NameHash, NameEq> submoduleVectorByName; // index into submoduleVectors
     };
     SubcomponentData *subcomponentData = nullptr;
 
@@ -350,6 +361,9 @@ class SIM_API cModule : public cComponent //implies noncopyable
     // internal: removes a channel
     void removeChannel(cChannel *channel);
 
+    // internal: returns the submodule vector with the given name, or nullptr
+    SubmoduleVector *findSubmoduleVector(const char *name) const;
+
     // internal: returns the ptr array for a submodule vector, exception if not found
     std::vector<cModule*>& getSubmoduleArray(const char *name) const;
 
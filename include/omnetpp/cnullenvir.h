@@ -62,7 +62,7 @@ class SIM_API cNullEnvir : public cEnvir
 
   public:
     // constructor, destructor
-    cNullEnvir() {}
+    cNullEnvir() {suppressSendHopNotifications = true; coalesceDisplayStringNotifications = true;}
     virtual ~cNullEnvir();
     virtual void configure(cConfiguration *cfg) override {this->cfg = cfg;}
 
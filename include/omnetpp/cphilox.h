@@ -0,0 +1,151 @@
+//==========================================================================
+//  CPHILOX.H - part of
+//                 OMNeT++/OMNEST
+//              Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_CPHILOX_H
+#define __OMNETPP_CPHILOX_H
+
+#include "simkerneldefs.h"
+#include "globals.h"
+#include "crng.h"
+#include "cconfiguration.h"
+
+namespace omnetpp {
+
+
+/**
+ * @brief Implements the Philox4x32-10 counter-based random number generator.
+ *
+ * A counter-based RNG computes the nth output directly from n and a key,
+ * by applying a bijective mixing function (10 rounds of multiply-and-xor)
+ * to a 128-bit counter. The state of the generator is just the key and
+ * the stream position, so:
+ *
+ *    - skip() moves forward in the stream in O(1) time;
+ *    - independent streams are obtained by using different keys, without
+ *      large per-stream state or seed spacing tables. The key is made up
+ *      of the seed set and the RNG index, and the parsim partition index
+ *      goes into the upper counter word, so all (seed set, RNG, partition)
+ *      combinations get their own non-overlapping streams of 2^64 numbers;
+ *    - blocks are independent of each other, so fillDoubles() computes many
+ *      of them at once in a loop that the compiler can vectorize.
+ *
+ * doubleRand() and its variants consume two 32-bit outputs and return
+ * doubles with 53-bit resolution.
+ *
+ * Source: John K. Salmon, Mark A. Moraes, Ron O. Dror, David E. Shaw:
+ * Parallel Random Numbers: As Easy as 1, 2, 3. SC'11, 2011.
+ */
+class SIM_API cPhilox : public cRNG
+{
+  public:
+    typedef uint32_t Block[4];
+
+  protected:
+    uint32_t key[2] = {0, 0};
+    uint32_t streamId = 0;    // upper counter word
+    uint64_t position = 0;    // number of 32-bit outputs consumed so far
+    uint64_t bufferedBlockIndex = UINT64_MAX;
+    Block buffer;             // output of block bufferedBlockIndex
+
+  protected:
+    uint32_t nextWord() {
+        uint64_t blockIndex = position >> 2;
+        if (blockIndex != bufferedBlockIndex) {
+            generateBlock(blockIndex, buffer);
+            bufferedBlockIndex = blockIndex;
+        }
+        return buffer[position++ & 3];
+    }
+    uint64_t nextRes53() {
+        uint32_t a = nextWord() >> 5, b = nextWord() >> 6;
+        return ((uint64_t)a << 26) | b;
+    }
+    void generateBlock(uint64_t blockIndex, Block& out) const;
+
+  public:
+    cPhilox() {}
+    virtual ~cPhilox() {}
+
+    /** Sets up the RNG. */
+    virtual void configure(int seedSet, int rngId, int numRngs,
+                            int parsimProcId, int parsimNumPartitions,
+                            cConfiguration *cfg) override;
+
+    /** Tests correctness of the RNG */
+    virtual void selfTest() override;
+
+    /** Random integer in the range [0,intRandMax()] */
+    virtual uint32_t intRand() override;
+
+    /** Maximum value that can be returned by intRand() */
+    virtual uint32_t intRandMax() override;
+
+    /** Random integer in [0,n), n < intRandMax() */
+    virtual uint32_t intRand(uint32_t n) override;
+
+    /** Random double on the [0,1) interval */
+    virtual double doubleRand() override;
+
+    /** Random double on the (0,1) interval */
+    virtual double doubleRandNonz() override;
+
+    /** Random double on the [0,1] interval */
+    virtual double doubleRandIncl1() override;
+
+    /** Fills the array with n random doubles on the [0,1) interval, in bulk */
+    virtual void fillDoubles(double *dest, size_t n) override;
+
+    /** Writes the RNG state into the buffer */
+    virtual void checkpoint(cCommBuffer *buffer) const override;
+
+    /** Restores the RNG state from the buffer */
+    virtual void restore(cCommBuffer *buffer) override;
+
+    /** @name Philox-specific methods. */
+    //@{
+    /**
+     * Sets the key and the stream identifier (the upper counter word),
+     * and rewinds the generator to the beginning of the stream.
+     */
+    void setKey(uint32_t key0, uint32_t key1, uint32_t streamId=0);
+
+    /**
+     * Skips n 32-bit outputs in O(1) time. A doubleRand() call consumes
+     * two outputs, an intRand() call one (or more, for intRand(n)).
+     */
+    void skip(uint64_t n) {position += n;}
+
+    /**
+     * Returns the position in the stream, i.e. the number of 32-bit outputs
+     * consumed since the last setKey() or configure() call.
+     */
+    uint64_t getPosition() const {return position;}
+
+    /**
+     * Moves to the given position in the stream, in O(1) time.
+     */
+    void setPosition(uint64_t pos) {position = pos;}
+
+    /**
+     * Computes the Philox4x32-10 function for the given counter and key.
+     */
+    static void philox4x32_10(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]);
+    //@}
+};
+
+}  // namespace omnetpp
+
+
+#endif
+
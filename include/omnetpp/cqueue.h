@@ -30,6 +30,14 @@ namespace omnetpp {
  * cQueue may be set up to act as a priority queue. This requires the user to
  * supply a comparison function.
  *
+ * The elements are stored in an array with free space kept at both ends,
+ * so insertion at the back and removal at the front take amortized constant
+ * time, and there is no per-element memory allocation. In priority queue mode,
+ * the insertion position is found with binary search, i.e. an insertion costs
+ * O(log n) comparisons plus moving the elements between the insertion point
+ * and the nearer end of the queue (a memmove of pointers). Elements that
+ * compare equal are kept in insertion order.
+ *
  * Ownership of cOwnedObjects may be controlled by invoking setTakeOwnership()
  * prior to inserting objects. Objects that cannot track their ownership
  * (cObject but not cOwnedObject) are always treated as owned. Whether an
@@ -41,14 +49,6 @@ namespace omnetpp {
  */
 class SIM_API cQueue : public cOwnedObject
 {
-  private:
-    struct QElem
-    {
-        cObject *obj; // the contained object
-        QElem *prev;  // element towards the front of the queue
-        QElem *next;  // element towards the back of the queue
-    };
-
   public:
     /**
      * @brief Base class for object comparators, used by cQueue for
@@ -81,7 +81,11 @@ class SIM_API cQueue : public cOwnedObject
     class SIM_API Iterator
     {
       private:
-        QElem *p;
+        const cQueue *q;
+        cObject *obj; // the current object; nullptr if the iterator reached either end
+        int pos;      // position of obj at the last step; the queue may have changed since
+
+        void advance(int delta);
 
       public:
         /**
@@ -94,64 +98,71 @@ class SIM_API cQueue : public cOwnedObject
         /**
          * Reinitializes the iterator object.
          */
-        void init(const cQueue& q, bool reverse=false) {p = reverse ? q.backp : q.frontp;}
+        void init(const cQueue& q, bool reverse=false) {this->q = &q; pos = reverse ? q.len-1 : 0; obj = q.len == 0 ? nullptr : q.elemAt(pos);}
 
         /**
          * Returns the current object.
          */
-        cObject *operator*() const {return p ? p->obj : nullptr;}
+        cObject *operator*() const {return obj;}
 
         /**
          * Returns true if the iterator has reached either end of the queue.
          */
-        bool end() const {return p == nullptr;}
+        bool end() const {return obj == nullptr;}
 
         /**
          * Prefix increment operator (++it). Moves the iterator to the next object
          * in the queue. It has no effect if the iterator has reached either
          * end of the queue.
          */
-        Iterator& operator++() {if (!end()) p = p->next; return *this;}
+        Iterator& operator++() {if (!end()) advance(1); return *this;}
 
         /**
          * Postfix increment operator (it++). Moves the iterator to the next object
          * in the queue, and returns the iterator's previous state. It has
          * no effect if the iterator has reached either end of the queue.
          */
-        Iterator operator++(int) {Iterator tmp(*this); if (!end()) p = p->next; return tmp;}
+        Iterator operator++(int) {Iterator tmp(*this); if (!end()) advance(1); return tmp;}
 
         /**
          * Prefix decrement operator (--it). Moves the iterator to the previous object
          * in the queue. It has no effect if the iterator has reached either
          * end of the queue.
          */
-        Iterator& operator--() {if (!end()) p = p->prev; return *this;}
+        Iterator& operator--() {if (!end()) advance(-1); return *this;}
 
         /**
          * Postfix decrement operator (it--). Moves the iterator to the previous object
          * in the queue, and returns the iterator's previous state. It has
          * no effect if the iterator has reached either end of the queue.
          */
-        Iterator operator--(int) {Iterator tmp(*this); if (!end()) p = p->prev; return tmp;}
+        Iterator operator--(int) {Iterator tmp(*this); if (!end()) advance(-1); return tmp;}
     };
 
     friend class Iterator;
 
   private:
     bool takeOwnership = true;
-    QElem *frontp = nullptr, *backp = nullptr;  // front and back pointers
+    cObject **elems = nullptr; // the contents from front to back are elems[head]..elems[head+len-1]
+    int capacity = 0; // allocated size of elems[]
+    int head = 0;  // index of the front element in elems[]
     int len = 0;  // number of items in the queue
     Comparator *comparator = nullptr; // comparison functor; nullptr for FIFO
+    bool sorted = true; // whether the contents are in comparator order, allowing binary search
 
   private:
     void copy(const cQueue& other);
+    cObject *elemAt(int pos) const {return elems[head + pos];}
+    void reallocate(int newCapacity);
+    bool isSorted() const;
+    int findInsertionPosition(cObject *obj) const;
+    void checkOrderAt(int pos);
 
   protected:
     // internal functions
-    QElem *find_qelem(cObject *obj) const;
-    void insbefore_qelem(QElem *p, cObject *obj);
-    void insafter_qelem(QElem *p, cObject *obj);
-    cObject *remove_qelem(QElem *p);
+    int findIndex(cObject *obj, int hint=0) const;
+    void insertAt(int pos, cObject *obj);
+    cObject *removeAt(int pos);
 
   public:
     /** @name Constructors, destructor, assignment. */
@@ -316,8 +327,7 @@ class SIM_API cQueue : public cOwnedObject
 
     /**
      * Returns the ith element in the queue, or nullptr if i is out of range.
-     * get(0) returns the front element. This method performs linear
-     * search.
+     * get(0) returns the front element. This method takes constant time.
      */
     virtual cObject *get(int i) const;
 
@@ -24,6 +24,7 @@ namespace omnetpp {
 
 class cResultFilter;
 class cComponent;
+class cCommBuffer;
 
 
 /**
@@ -53,6 +54,10 @@ class SIM_API cResultListener : public cObject, public cIListener
         virtual void callEmitInitialValue() {emitInitialValue();}
         virtual void emitInitialValue() {}
 
+        // simulation checkpoints: save and restore the result collection state (see cComponent::checkpoint())
+        virtual void checkpoint(cCommBuffer *buffer) {}
+        virtual void restore(cCommBuffer *buffer) {}
+
         // original listener API delegates to simplified API:
         virtual void receiveSignal(cComponent *source, simsignal_t signalID, bool b, cObject *details) override;
         virtual void receiveSignal(cComponent *source, simsignal_t signalID, intval_t l, cObject *details) override;
@@ -22,12 +22,13 @@
 namespace omnetpp {
 
 class cConfiguration;
+class cCommBuffer;
 
 
 /**
  * @brief Abstract interface for random number generator classes.
  *
- * Some known implementations are <tt>cMersenneTwister</tt>,
+ * Some known implementations are <tt>cMersenneTwister</tt>, <tt>cPhilox</tt>,
  * <tt>cLCG32</tt> and <tt>cAkaroaRNG</tt>. The actual RNG class
  * to be used in simulations can be configured (a feature of the
  * Envir library).
@@ -110,6 +111,30 @@ class SIM_API cRNG : public cObject
      * Random double on the (0,1] interval
      */
     double doubleRandNonzIncl1() {return 1-doubleRand();}
+
+    /**
+     * Fills the given array with n random doubles on the [0,1) interval.
+     * The result must be the same as that of n consecutive doubleRand()
+     * calls. The default implementation does exactly that; subclasses may
+     * override it with a faster bulk implementation.
+     */
+    virtual void fillDoubles(double *dest, size_t n) {for (size_t i = 0; i < n; i++) dest[i] = doubleRand();}
+
+    /**
+     * Writes the complete state of the RNG (including the number of values
+     * drawn) into the buffer, as part of a simulation checkpoint (see
+     * cSimulation::writeCheckpoint()). The RNG is already configured when
+     * restore() is called, and restore() should read back exactly what
+     * checkpoint() wrote. This default implementation throws an error,
+     * i.e. RNG classes do not support checkpointing unless they override
+     * both methods.
+     */
+    virtual void checkpoint(cCommBuffer *buffer) const;
+
+    /**
+     * Restores the RNG state written by checkpoint(). See checkpoint().
+     */
+    virtual void restore(cCommBuffer *buffer);
 };
 
 }  // namespace omnetpp
@@ -22,6 +22,7 @@ namespace omnetpp {
 
 class cConfiguration;
 class cRNG;
+class cCommBuffer;
 
 /**
  * @brief Provides RNG access to simulation components (modules and channels).
@@ -51,6 +52,29 @@ class SIM_API cIRngManager : public cNoncopyableOwnedObject
      */
     virtual void configure(cSimulation *simulation, cConfiguration *cfg, int parsimProcId, int parsimNumPartitions) = 0;
 
+    /**
+     * Reseeds the RNGs according to the seed set of the given configuration,
+     * keeping the RNG objects and the mapping of component RNGs. It allows
+     * a network that has been set up for one run to continue as another run
+     * that only differs in the seeds (see `cmdenv-fork-replications`).
+     * This default implementation throws an error.
+     */
+    virtual void reseed(cConfiguration *cfg);
+
+    /**
+     * Writes the state of the RNGs into the buffer, as part of a simulation
+     * checkpoint (see cSimulation::writeCheckpoint()). restore() is called
+     * on an already configured RNG manager, and should read back exactly
+     * what checkpoint() wrote. This default implementation throws an error.
+     */
+    virtual void checkpoint(cCommBuffer *buffer) const;
+
+    /**
+     * Restores the state of the RNGs written by checkpoint().
+     * This default implementation throws an error.
+     */
+    virtual void restore(cCommBuffer *buffer);
+
     /**
      * Sets up RNGs for the given component.
      */
@@ -84,6 +108,8 @@ class SIM_API cRngManager : public cIRngManager
 {
   private:
     cConfiguration *cfg = nullptr;
+    int parsimProcId = 0;
+    int parsimNumPartitions = 1;
     int numRNGs = 0;
     cRNG **rngs = nullptr;
 
@@ -97,6 +123,9 @@ class SIM_API cRngManager : public cIRngManager
     /** @name Redefined cIRngManager methods. */
     //@{
     virtual void configure(cSimulation *simulation, cConfiguration *cfg, int parsimProcId, int parsimNumPartitions) override;
+    virtual void reseed(cConfiguration *cfg) override;
+    virtual void checkpoint(cCommBuffer *buffer) const override;
+    virtual void restore(cCommBuffer *buffer) override;
     virtual void configureRNGs(cComponent *component) override;
     virtual int getNumRNGs(const cComponent *component) const override;
     virtual cRNG *getRNG(const cComponent *component, int k) override;
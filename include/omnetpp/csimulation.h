@@ -55,6 +55,8 @@ class cIEventLoopRunner;
 
 namespace internal {
 class Stopwatch;
+class ModulePathCache;
+class Profiler;
 }
 
 SIM_API extern OPP_THREAD_LOCAL cSoftOwner globalOwningContext; // also in globals.h
@@ -152,6 +154,13 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
     simtime_t simTimeLimit = 0;         // simulation time limit (0 -> no limit)
     cEvent *endSimulationEvent = nullptr; // only present if simulation time limit is set
     internal::Stopwatch *stopwatch;        // elapsed time, CPU usage time, and related time limits
+    internal::ModulePathCache *modulePathCache; // results of absolute module path lookups
+    internal::Profiler *profiler = nullptr; // only present if profiling is enabled
+    simtime_t checkpointTime;           // time to write a checkpoint at (negative: none); only valid if checkpointFile is set, see configure()
+    std::string checkpointFile;         // file to write the checkpoint into
+    std::string restoreCheckpointFile;  // checkpoint to resume the simulation from instead of initializing it (empty: none)
+    std::map<msgid_t,cMessage*> *restoredMessages = nullptr; // only while restoring a checkpoint: message ID -> restored message
+    std::vector<int> pendingDisplayStringChanges; // IDs of components whose displayStringChanged() notification is deferred to the end of the event
 
     State state = SIM_NONETWORK;        // simulation state
     Stage stage = STAGE_NONE;           // what the simulation is currently doing
@@ -208,6 +217,10 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
     void notifyLifecycleListenersOnError(cRuntimeError& exceptionBeingHandled);
     void notifyLifecycleListeners(SimulationLifecycleEventType eventType, cObject *details=nullptr);
     void setTerminationReason(cTerminationException *e);
+    void doFlushPendingDisplayStringChanges();
+    struct FullEventHooks;
+    struct NoEventHooks;
+    template <class Hooks> void doExecuteEvent(cEvent *event);
 
     struct StageSwitcher {
         cSimulation *simulation;
@@ -219,9 +232,15 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
   public:
     // internal
     static void setEnvirFactoryFunction(EnvirFactoryFunction f);
+    internal::ModulePathCache *getModulePathCache() const {return modulePathCache;}
+    internal::Profiler *getProfiler() const {return profiler;}
+    void invalidateModulePathCache();
+    void addPendingDisplayStringChange(cComponent *component);
+    void flushPendingDisplayStringChanges() {if (!pendingDisplayStringChanges.empty()) doFlushPendingDisplayStringChanges();}
     void setParameterMutabilityCheck(bool b) {parameterMutabilityCheck = b;}
     bool getParameterMutabilityCheck() const {return parameterMutabilityCheck;}
     void setUniqueNumberRange(uint64_t start, uint64_t end) {nextUniqueNumber = start; uniqueNumbersEnd = end;}
+    void switchToRun(cConfiguration *cfg);
     void printUnusedConfigEntriesIfAny(std::ostream& out);
 
 #ifdef WITH_PYTHON
@@ -559,6 +578,34 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
      */
     virtual void callFinish();
 
+    /**
+     * Writes the state of the simulation into the given checkpoint file:
+     * the simulation time and event number, the messages in the future event
+     * set, the state of the RNGs and result recorders, and the state saved
+     * by the checkpoint() methods of modules and channels. It may only be
+     * called between events. Usually invoked via the `checkpoint-at`
+     * configuration option.
+     */
+    virtual void writeCheckpoint(const char *fileName);
+
+    /**
+     * Resumes the simulation from the given checkpoint file. It should be
+     * called after setupNetwork() instead of callInitialize(), with the
+     * same network and configuration as the one the checkpoint was written
+     * with. Components are restored by calling their restore() method
+     * instead of initialize(). callInitialize() invokes this method when
+     * the `restore-checkpoint` configuration option is set.
+     */
+    virtual void restoreCheckpoint(const char *fileName);
+
+    /**
+     * Returns the message with the given ID that has been restored into the
+     * future event set from the checkpoint, or nullptr if there is no such
+     * message. It may only be called while restoring a checkpoint, i.e.
+     * from the restore() methods of modules and channels.
+     */
+    cMessage *getRestoredMessage(msgid_t id) const;
+
     /**
      * To be called after the simulation has terminated, it verifies that
      * the fingerprint computed from the simulation matches the expected
@@ -708,6 +755,25 @@ class SIM_API cSimulation : public cNamedObject, noncopyable
      */
     virtual void executeEvent(cEvent *event);
 
+    /**
+     * A leaner variant of executeEvent() for tight express-mode event loops.
+     * It leaves out the per-event hooks: the cEnvir::simulationEvent()
+     * notification, fingerprint calculation, profiling, and the debugger
+     * trap of non-message events. It may only be used while
+     * canExecuteEventLean() returns true, and if the environment does not
+     * need to be notified about events (e.g. no eventlog recording, and
+     * logging is disabled). Like executeEvent(), it may only be called from
+     * run() via runners.
+     */
+    void executeEventLean(cEvent *event);  // note: intentionally non-virtual
+
+    /**
+     * Returns true if the simulation does not need the per-event hooks
+     * left out by executeEventLean(): there is no fingerprint calculation,
+     * no profiling, and no pending debugger trap request.
+     */
+    bool canExecuteEventLean() const {return !fingerprint && !profiler && !trapOnNextEvent;}  // note: intentionally non-virtual
+
     /**
      * Runs the simulation with the given runner. The network is initialized
      * if it has not been initialized already. After the simulation completes
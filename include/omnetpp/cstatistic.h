@@ -126,6 +126,21 @@ class SIM_API cStatistic : public cRandom
      */
     virtual void collectWeighted(SimTime value, SimTime weight) {collectWeighted(value.dbl(), weight.dbl());}
 
+    /**
+     * Collects n values. The default implementation calls collect(double)
+     * for each value; subclasses may redefine it to process the whole
+     * array at once. The result is the same as that of calling collect(double)
+     * for each value, up to the rounding errors of the computed sums.
+     */
+    virtual void collect(const double *values, size_t n);
+
+    /**
+     * Collects n values with the corresponding weights. The default
+     * implementation calls collectWeighted(double, double) for each pair;
+     * see also collect(const double *, size_t).
+     */
+    virtual void collectWeighted(const double *values, const double *weights, size_t n);
+
     /**
      * Updates this object with data coming from another statistics
      * object. The result is as if this object had collected all the
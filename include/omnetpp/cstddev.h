@@ -121,6 +121,29 @@ class SIM_API cStdDev : public cStatistic
     virtual void collectWeighted(double value, double weight) override;
     using cStatistic::collectWeighted;
 
+    /**
+     * Collects n observations at once. This is considerably faster than
+     * calling collect(double) in a loop: the values are accumulated in
+     * independent SIMD lanes (SSE2 where available), and the partial sums
+     * of blocks are added with Kahan compensation.
+     * Count, minimum and maximum are exactly the same as with collect(double);
+     * the sums may differ in the last few bits due to the different order
+     * of additions, with a relative error that does not grow with n (it is
+     * typically smaller than that of the one-by-one summation). Nothing is
+     * collected if the array contains a NaN.
+     *
+     * Subclasses that redefine collect(double) should also redefine this
+     * method.
+     */
+    virtual void collect(const double *values, size_t n) override;
+
+    /**
+     * Collects n observations with the corresponding weights at once,
+     * with the same precision guarantees as collect(const double *, size_t).
+     * Nothing is collected if any value is NaN or any weight is invalid.
+     */
+    virtual void collectWeighted(const double *values, const double *weights, size_t n) override;
+
     /**
      * Merge another statistics object into this one.
      */
@@ -77,6 +77,9 @@ class SIM_API cTopology : public cOwnedObject
         double dist = INFINITY;
         Link *outPath = nullptr;
 
+        // index in the snapshot used by the all-pairs shortest path algorithms
+        int snapshotIndex = -1;
+
       public:
         /**
          * Constructor
@@ -347,12 +350,19 @@ class SIM_API cTopology : public cOwnedObject
     std::vector<Node*> nodes;
     Node *target = nullptr;
 
+    // compact (CSR) copy of the graph, and the results of the all-pairs shortest path algorithms
+    struct Snapshot;
+    Snapshot *snapshot = nullptr;
+
     // note: the purpose of the (unsigned int) cast is that nodes with moduleId==-1 are inserted at the end of the vector
     static bool lessByModuleId(Node *a, Node *b) { return (unsigned int)a->moduleId < (unsigned int)b->moduleId; }
     static bool isModuleIdLess(Node *a, int moduleId) { return (unsigned int)a->moduleId < (unsigned int)moduleId; }
 
     void unlinkFromSourceNode(Link *link);
     void unlinkFromDestNode(Link *link);
+    void graphChanged();
+    void calculateAllShortestPaths(bool weighted, int numThreads);
+    int getSnapshotIndex(Node *node, const char *func) const;
 
   private:
     virtual void parsimPack(cCommBuffer *) const override {throw cRuntimeError(this, E_CANTPACK);}
@@ -573,6 +583,63 @@ class SIM_API cTopology : public cOwnedObject
     virtual Node *getTargetNode() const {return target;}
     //@}
 
+    /** @name Algorithms to find shortest paths between all pairs of nodes.
+     *
+     * These methods compute the shortest paths towards every node of the graph
+     * at once, on a compact copy (snapshot) of the graph that is taken when
+     * they are called. The per-target computations run in parallel on
+     * numThreads threads (0 means the number of hardware threads). The results
+     * are stored in the cTopology object, and can be queried with getDistance()
+     * and getNextLink(); they do not affect the path information in the nodes
+     * (see Node::getDistanceToTarget() and Node::getPath()), which belongs to
+     * the single-target methods.
+     *
+     * Memory usage is proportional to the square of the number of nodes.
+     * Results are discarded when nodes or links are added to or removed from
+     * the graph. When several paths have the same length, the path chosen may
+     * differ from that of the single-target methods.
+     */
+    //@{
+
+    /**
+     * Finds the shortest paths (in hops) between all pairs of nodes, in the
+     * same way calculateUnweightedSingleShortestPathsTo() does for one target.
+     */
+    virtual void calculateUnweightedAllShortestPaths(int numThreads=0);
+
+    /**
+     * Finds the shortest paths between all pairs of nodes, in the same way
+     * calculateWeightedSingleShortestPathsTo() does for one target. Uses
+     * weights in nodes and links, which must not be negative.
+     */
+    virtual void calculateWeightedAllShortestPaths(int numThreads=0);
+
+    /**
+     * Updates the results of the last calculateUnweightedAllShortestPaths()
+     * or calculateWeightedAllShortestPaths() call after link weights or link
+     * enabled states have changed. The shortest paths are only recomputed
+     * for those targets whose shortest path tree may be affected by the
+     * changed links, which is much cheaper than a full recalculation if only
+     * a few links have changed. Changes to nodes (weight, enabled state) and
+     * to the graph structure result in a full recalculation.
+     */
+    virtual void updateAllShortestPaths(int numThreads=0);
+
+    /**
+     * Returns the length of the shortest path from src to target found by
+     * the all-pairs shortest path methods, or INFINITY if target is not
+     * reachable from src.
+     */
+    virtual double getDistance(Node *src, Node *target) const;
+
+    /**
+     * Returns the first link of the shortest path from src to target found by
+     * the all-pairs shortest path methods, or nullptr if target is not reachable
+     * from src (or src is the target).
+     */
+    virtual LinkOut *getNextLink(Node *src, Node *target) const;
+    //@}
+
   protected:
     /**
      * Node factory.
@@ -100,6 +100,7 @@ class SIM_API cValue
     cValue(const char *s)  {set(s);}
     cValue(const std::string& s)  {set(s);}
     cValue(const opp_string& s)  {set(s);}
+    cValue(const opp_pooledstring& s)  {set(s.c_str());}
     cValue(any_ptr ptr)  {set(ptr);}
     cValue(cObject *obj)  {set(obj);}
     cValue(const void *) = delete; // prevent non-cObject pointers from silently being converted to bool
@@ -33,6 +33,36 @@ inline uint32_t intrand(cRNG *rng, uint32_t r)  {return rng->intRand(r);}
  * @brief Produces a random double in the range [0,1) using the RNG given with its index.
  */
 inline double dblrand(cRNG *rng)  {return rng->doubleRand();}
+
+/**
+ * @brief Algorithm sets for random variate generation.
+ *
+ * DISTRIB_ALGORITHMS_CLASSIC produces the same variate streams as earlier
+ * versions of OMNeT++. DISTRIB_ALGORITHMS_FAST uses the ziggurat method for
+ * the normal and exponential distributions (and thus for everything built
+ * on them, e.g. gamma, lognormal, truncnormal), and the PTRS method
+ * for poisson() with lambda >= 10. The two produce different variate
+ * streams from the same random numbers.
+ *
+ * The algorithm set is selected with the <tt>distribution-algorithms</tt>
+ * configuration option.
+ */
+enum DistributionAlgorithms {
+    DISTRIB_ALGORITHMS_CLASSIC,
+    DISTRIB_ALGORITHMS_FAST
+};
+
+/**
+ * @brief Selects the algorithm set used by the random variate generator
+ * functions in the current thread.
+ */
+SIM_API void setDistributionAlgorithms(DistributionAlgorithms algorithms);
+
+/**
+ * @brief Returns the algorithm set used by the random variate generator
+ * functions in the current thread.
+ */
+SIM_API DistributionAlgorithms getDistributionAlgorithms();
 /** @} */
 
 /**
@@ -400,6 +430,9 @@ SIM_API int negbinomial(cRNG *rng, int n, double p);
  *   - 0<lambda<=30: count number of events
  *   - lambda>30: Acceptance-Rejection due to Atkinson (see Banks, page 166)
  *
+ * With DISTRIB_ALGORITHMS_FAST, lambda>=10 uses transformed rejection with
+ * squeeze (PTRS) due to Hormann instead.
+ *
  * @param lambda  > 0
  * @param rng the underlying random number generator
  */
@@ -407,6 +440,40 @@ SIM_API int poisson(cRNG *rng, double lambda);
 
 /** @} */
 
+/**
+ * @defgroup RandomNumbersBatch Batched Generation
+ * @ingroup RandomNumbers
+ * @brief Generators that fill an array with random variates in one call
+ *
+ * These functions draw the underlying uniform numbers with
+ * cRNG::fillDoubles(), which may be significantly faster than drawing them
+ * one by one (see cPhilox). The generated values are exactly the same as
+ * the ones n consecutive calls to the corresponding single-value function
+ * would produce, so the two can be mixed freely without affecting
+ * reproducibility.
+ * @{
+ */
+
+/**
+ * @brief Fills the array with n random variates with uniform distribution
+ * in the range [a,b). See uniform(cRNG*,double,double).
+ */
+SIM_API void uniform(cRNG *rng, double a, double b, double *dest, size_t n);
+
+/**
+ * @brief Fills the array with n random variates from the exponential
+ * distribution with the given mean. See exponential(cRNG*,double).
+ */
+SIM_API void exponential(cRNG *rng, double mean, double *dest, size_t n);
+
+/**
+ * @brief Fills the array with n random variates from the normal distribution
+ * with the given mean and standard deviation. See normal(cRNG*,double,double).
+ */
+SIM_API void normal(cRNG *rng, double mean, double stddev, double *dest, size_t n);
+
+/** @} */
+
 }  // namespace omnetpp
 
 
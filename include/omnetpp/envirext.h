@@ -86,6 +86,9 @@ class SIM_API cIOutputVectorManager : public cObject, public cISimulationLifecyc
 
     /**
      * Sets the configuration database to use for configuring this object.
+     * It may also be called again after startRun() but before anything has
+     * been written, to direct the output into the file of another run
+     * (see the `cmdenv-fork-replications` option).
      */
     virtual void configure(cSimulation *simulation, cConfiguration *cfg) = 0;
 
@@ -201,6 +204,9 @@ class SIM_API cIOutputScalarManager : public cObject, public cISimulationLifecyc
 
     /**
      * Sets the configuration database to use for configuring this object.
+     * It may also be called again after startRun() but before anything has
+     * been written, to direct the output into the file of another run
+     * (see the `cmdenv-fork-replications` option).
      */
     virtual void configure(cSimulation *simulation, cConfiguration *cfg) = 0;
 
@@ -311,6 +317,9 @@ class SIM_API cISnapshotManager : public cObject, public cISimulationLifecycleLi
 
     /**
      * Sets the configuration database to use for configuring this object.
+     * It may also be called again after startRun() but before anything has
+     * been written, to direct the output into the file of another run
+     * (see the `cmdenv-fork-replications` option).
      */
     virtual void configure(cSimulation *simulation, cConfiguration *cfg) = 0;
 
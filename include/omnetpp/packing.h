@@ -17,6 +17,7 @@
 #define __OMNETPP_PACKING_H
 
 #include "ccommbuffer.h"
+#include "opp_pooledstring.h"
 
 namespace omnetpp {
 
@@ -47,6 +48,9 @@ DOPACKING(opp_string,&)
 #undef _
 #undef DOPACKING
 
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const opp_pooledstring& a) {b->pack(a.c_str());}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, opp_pooledstring& a) {opp_string s; b->unpack(s); a = s.c_str();}
+
 }  // namespace omnetpp
 
 #endif
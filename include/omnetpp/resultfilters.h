@@ -79,6 +79,8 @@ class SIM_API DemuxFilter : public cResultFilter
         virtual void receiveSignal(cResultFilter *prev, simtime_t_cref t, cObject *obj, cObject *details) override;
     public:
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -101,6 +103,8 @@ class SIM_API TotalCountFilter : public cResultFilter
         intval_t getCount() const {return count;}
         virtual double getInitialDoubleValue() const override {return getCount();}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -239,6 +243,8 @@ class SIM_API CountNanFilter : public cNumericResultFilter
         intval_t getCount() const {return count;}
         virtual double getInitialDoubleValue() const override {return getCount();}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -255,6 +261,8 @@ class SIM_API SumFilter : public cNumericResultFilter
         double getSum() const {return sum;}
         virtual double getInitialDoubleValue() const override {return getSum();}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -278,6 +286,8 @@ class SIM_API MeanFilter : public cNumericResultFilter
         virtual void init(Context *ctx) override;
         double getMean() const;
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -294,6 +304,8 @@ class SIM_API MinFilter : public cNumericResultFilter
         MinFilter() {min = INFINITY;}
         double getMin() const {return min;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -310,6 +322,8 @@ class SIM_API MaxFilter : public cNumericResultFilter
         MaxFilter() {max = -INFINITY;}
         double getMax() const {return max;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -327,6 +341,8 @@ class SIM_API AverageFilter : public cNumericResultFilter
         AverageFilter() {count = 0; sum = 0;}
         double getAverage() const {return sum/count;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -346,6 +362,8 @@ class SIM_API TimeAverageFilter : public cNumericResultFilter
         TimeAverageFilter() {}
         double getTimeAverage() const;
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -361,6 +379,8 @@ class SIM_API RemoveRepeatsFilter : public cNumericResultFilter
         RemoveRepeatsFilter() {prev = NAN;}
         double getLastValue() const {return prev;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -402,6 +422,8 @@ class SIM_API SumPerDurationFilter : public cNumericResultFilter
         double getSumPerDuration() const;
         virtual double getInitialDoubleValue() const override {return getSumPerDuration();}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /** @} */
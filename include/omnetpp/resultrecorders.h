@@ -46,6 +46,8 @@ class SIM_API VectorRecorder : public cNumericResultRecorder
         virtual simtime_t getLastWriteTime() const {return lastTime;}
         virtual double getLastValue() const {return lastValue;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -68,6 +70,8 @@ class SIM_API TotalCountRecorder : public cResultRecorder
         TotalCountRecorder() {count = 0;}
         long getCount() const {return count;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -98,6 +102,8 @@ class SIM_API LastValueRecorder : public cNumericResultRecorder
         LastValueRecorder() {lastValue = NAN;}
         double getLastValue() const {return lastValue;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -127,6 +133,8 @@ class SIM_API SumRecorder : public cNumericResultRecorder
         SumRecorder() {sum = 0;}
         double getSum() const {return sum;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -151,6 +159,8 @@ class SIM_API MeanRecorder : public cNumericResultRecorder
         virtual void collect(simtime_t_cref t, double value, cObject *details) override;
         double getMean() const;
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -168,6 +178,8 @@ class SIM_API MinRecorder : public cNumericResultRecorder
         MinRecorder() {min = INFINITY;}
         double getMin() const {return min;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -185,6 +197,8 @@ class SIM_API MaxRecorder : public cNumericResultRecorder
         MaxRecorder() {max = -INFINITY;}
         double getMax() const {return max;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -203,6 +217,8 @@ class SIM_API AverageRecorder : public cNumericResultRecorder
         AverageRecorder() {count = 0; sum = 0;}
         double getAverage() const {return sum/count;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -223,6 +239,8 @@ class SIM_API TimeAverageRecorder : public cNumericResultRecorder
         TimeAverageRecorder() {}
         double getTimeAverage() const;
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 /**
@@ -246,6 +264,8 @@ class SIM_API StatisticsRecorder : public cNumericResultRecorder
         virtual void setStatistic(cStatistic* stat);
         virtual cStatistic *getStatistic() const {return statistic;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
 };
 
 class SIM_API StatsRecorder : public StatisticsRecorder
@@ -278,6 +298,20 @@ class SIM_API KSplitRecorder : public StatisticsRecorder
         virtual void init(Context *ctx) override;
 };
 
+/**
+ * @brief Records a quantile sketch (cDDSketch) of the input values, together
+ * with the estimates of selected quantiles as result attributes.
+ */
+class SIM_API QuantilesRecorder : public StatisticsRecorder
+{
+    protected:
+        std::vector<double> quantiles;
+    protected:
+        virtual void finish(cResultFilter *prev) override;
+    public:
+        virtual void init(Context *ctx) override;
+};
+
 /** @} */
 
 }  // namespace omnetpp
@@ -20,6 +20,7 @@
 #include "omnetpp/cproperties.h"
 #include "omnetpp/cproperty.h"
 #include "envir/appbase.h"
+#include "envir/resultfileutils.h"
 
 using namespace omnetpp::common;
 using namespace omnetpp::internal;
@@ -31,6 +32,10 @@ Register_GlobalConfigOptionU(CFGID_CMDENV_EXTRA_STACK, "cmdenv-extra-stack", "B"
 Register_GlobalConfigOption(CFGID_CMDENV_INTERACTIVE, "cmdenv-interactive", CFG_BOOL, "false", "Defines what Cmdenv should do when the model contains unassigned parameters. In interactive mode, it asks the user. In non-interactive mode (which is more suitable for batch execution), Cmdenv stops with an error.")
 Register_GlobalConfigOption(CFGID_CMDENV_LOG_PREFIX, "cmdenv-log-prefix", CFG_STRING, "[%l]\t", "Specifies the format string that determines the prefix of each log line. The format string may contain format directives in the syntax `%x` (a `%` followed by a single format character).  For example `%l` stands for log level, and `%J` for source component. See the manual for the list of available format characters.");
 Register_GlobalConfigOption(CFGID_CMDENV_FAKE_GUI, "cmdenv-fake-gui", CFG_BOOL, "false", "Causes Cmdenv to lie to simulations that is a GUI (isGui()=true), and to periodically invoke refreshDisplay() during simulation execution.");
+Register_GlobalConfigOption(CFGID_CMDENV_LOG_BINARY, "cmdenv-log-binary", CFG_BOOL, "false", "When enabled, log lines are not written to the standard output but recorded into a compact binary file (see `cmdenv-log-binary-file`). Log prefixes are not formatted during the simulation; the file can be converted to text afterwards with `opp_logtool decode`. This makes logging considerably cheaper in long runs.");
+Register_GlobalConfigOption(CFGID_CMDENV_LOG_BINARY_FILE, "cmdenv-log-binary-file", CFG_FILENAME, "${resultdir}/${configname}-${iterationvarsf}#${repetition}.blog", "When `cmdenv-log-binary=true`: name of the binary log file to generate.");
+Register_GlobalConfigOptionU(CFGID_CMDENV_LOG_BINARY_MAX_SIZE, "cmdenv-log-binary-max-size", "B", nullptr, "When `cmdenv-log-binary=true`: maximum size of the binary log file. When the file reaches this size, recording stops, i.e. unlike with `eventlog-max-size`, the beginning of the log is kept. `opp_logtool decode` reports truncated files. The default is no limit.");
+Register_GlobalConfigOptionU(CFGID_CMDENV_LOG_BINARY_BUFFER_SIZE, "cmdenv-log-binary-buffer-size", "B", "1MiB", "When `cmdenv-log-binary=true`: size of the in-memory buffer where log records are collected before being written to the file.");
 Register_PerObjectConfigOption(CFGID_CMDENV_LOGLEVEL, "cmdenv-log-level", KIND_MODULE, CFG_STRING, "TRACE", "Specifies the per-component level of detail recorded by log statements, output below the specified level is omitted. Available values are (case insensitive): `off`, `fatal`, `error`, `warn`, `info`, `detail`, `debug` or `trace`. Note that the level of detail is also controlled by the globally specified runtime log level and the `COMPILETIME_LOGLEVEL` macro that is used to completely remove log statements from the executable.")
 
 extern cConfigOption *CFGID_CMDENV_EXPRESS_MODE;
@@ -52,6 +57,17 @@ void CmdenvEnvir::configure(cConfiguration *cfg)
     setLogFormat(cfg->getAsString(CFGID_CMDENV_LOG_PREFIX).c_str());
     setExtraStackForEnvir((size_t)cfg->getAsDouble(CFGID_CMDENV_EXTRA_STACK));
 
+    delete binaryLogWriter;
+    binaryLogWriter = nullptr;
+    if (cfg->getAsBool(CFGID_CMDENV_LOG_BINARY)) {
+        binaryLogWriter = new BinaryLogWriter((size_t)cfg->getAsDouble(CFGID_CMDENV_LOG_BINARY_BUFFER_SIZE));
+        binaryLogWriter->setMaxSize((int64_t)cfg->getAsDouble(CFGID_CMDENV_LOG_BINARY_MAX_SIZE, -1));
+        binaryLogFileName = ResultFileUtils(cfg).augmentFileName(cfg->getAsFilename(CFGID_CMDENV_LOG_BINARY_FILE));
+    }
+
+    // clock() is only worth calling for each log statement if the result is used
+    cLog::captureUserTime = !binaryLogWriter && logFormatter.usesUserTime();
+
     bool useFakeGUI = cfg->getAsBool(CFGID_CMDENV_FAKE_GUI);
     FakeGUI *fakeGUI = useFakeGUI ? new FakeGUI() : nullptr;
     setFakeGUI(fakeGUI);
@@ -78,6 +94,13 @@ void CmdenvEnvir::componentInitBegin(cComponent *component, int stage)
         out << "Initializing " << (component->isModule() ? "module" : "channel") << " " << component->getFullPath() << ", stage " << stage << endl;
 }
 
+void CmdenvEnvir::switchToRun(cConfiguration *cfg)
+{
+    if (binaryLogWriter)
+        throw cRuntimeError("Cannot switch to another run while writing a binary log file");
+    GenericEnvir::switchToRun(cfg);
+}
+
 void CmdenvEnvir::configureComponent(cComponent *component)
 {
     GenericEnvir::configureComponent(component);
@@ -118,10 +141,39 @@ void CmdenvEnvir::alert(const char *msg)
     out << "\n<!> " << msg << endl << endl;
 }
 
+void CmdenvEnvir::lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details)
+{
+    GenericEnvir::lifecycleEvent(eventType, details);
+
+    if (binaryLogWriter) {
+        switch (eventType) {
+            case LF_PRE_NETWORK_SETUP:
+                if (binaryLogWriter->isOpen())
+                    binaryLogWriter->close();
+                binaryLogWriter->open(binaryLogFileName.c_str());
+                break;
+            case LF_ON_SIMULATION_PAUSE:
+                binaryLogWriter->flush();
+                break;
+            case LF_ON_RUN_END:
+                if (binaryLogWriter->isOpen())
+                    binaryLogWriter->close();
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 void CmdenvEnvir::log(cLogEntry *entry)
 {
     GenericEnvir::log(entry);
 
+    if (binaryLogWriter && binaryLogWriter->isOpen()) {
+        binaryLogWriter->writeEntry(getSimulation(), entry);
+        return;
+    }
+
     if (!logFormatter.isBlank())
         out << logFormatter.formatPrefix(entry);
 
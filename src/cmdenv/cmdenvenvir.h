@@ -19,6 +19,7 @@
 #include "cmddefs.h"
 #include "fakegui.h"
 #include "envir/genericenvir.h"
+#include "envir/binarylogwriter.h"
 
 namespace omnetpp {
 namespace cmdenv {
@@ -39,10 +40,17 @@ class CMDENV_API CmdenvEnvir : public GenericEnvir
     bool autoflush = false;
     bool interactive = false;
 
+    BinaryLogWriter *binaryLogWriter = nullptr; // owned; non-null if log is recorded in binary form
+    std::string binaryLogFileName;
+
+   protected:
+    virtual void lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details) override;
+
    public:
     CmdenvEnvir(std::ostream& out, bool& sigintReceived);
-    virtual ~CmdenvEnvir() {delete fakeGUI;}
+    virtual ~CmdenvEnvir() {delete fakeGUI; delete binaryLogWriter;}
     virtual void configure(cConfiguration *cfg) override;
+    virtual void switchToRun(cConfiguration *cfg) override;
 
     void setFakeGUI(FakeGUI *fakeGUI);
     virtual FakeGUI *getFakeGui() const override {return fakeGUI;}
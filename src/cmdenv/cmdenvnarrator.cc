@@ -34,6 +34,41 @@ void CmdenvNarrator::usingThreads(int numThreads)
         out << "Running simulations on " << numThreads << " threads\n";
 }
 
+void CmdenvNarrator::usingProcesses(int numProcesses)
+{
+    if (verbose)
+        out << "Running simulations in " << numProcesses << " worker processes\n";
+}
+
+void CmdenvNarrator::workerRunFinished(int runNumber, int workerPid, bool success, eventnumber_t numEvents, simtime_t simTime, double elapsedTime, double peakRSS, int numFinished, int numRuns)
+{
+    if (verbose) {
+        out << "\nRun #" << runNumber << (success ? " completed" : " failed") << " in worker " << workerPid << ": "
+            << numEvents << " events, t=" << simTime.ustr() << ", " << elapsedTime << "s elapsed";
+        if (elapsedTime > 0)
+            out << " (" << (int64_t)(numEvents / elapsedTime) << " ev/sec)";
+        out << ", peak RSS " << (int64_t)(peakRSS / (1024*1024)) << " MiB  [" << numFinished << "/" << numRuns << " finished]" << endl;
+    }
+}
+
+void CmdenvNarrator::workerCrashed(int runNumber, int workerPid, const char *reason, bool willRetry)
+{
+    if (verbose)
+        out << "\nWorker " << workerPid << " died while executing run #" << runNumber << " (" << reason << ")" << (willRetry ? ", retrying the run" : "") << endl;
+}
+
+void CmdenvNarrator::forkingReplications(int numReplications, simtime_t branchTime)
+{
+    if (verbose)
+        out << "Forking " << numReplications << " replications at t=" << branchTime.ustr() << endl;
+}
+
+void CmdenvNarrator::notForkingReplications(const char *reason)
+{
+    if (verbose)
+        out << "Not forking replications (" << reason << "), running them from scratch" << endl;
+}
+
 void CmdenvNarrator::preparing(const char *configName, int runNumber)
 {
     if (verbose)
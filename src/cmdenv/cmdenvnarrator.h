@@ -52,6 +52,11 @@ class ICmdenvNarrator
     virtual void setUseStderr(bool useStderr) {this->useStderr = useStderr;}
 
     virtual void usingThreads(int numThreads) = 0;
+    virtual void usingProcesses(int numProcesses) = 0;
+    virtual void workerRunFinished(int runNumber, int workerPid, bool success, eventnumber_t numEvents, simtime_t simTime, double elapsedTime, double peakRSS, int numFinished, int numRuns) = 0;
+    virtual void workerCrashed(int runNumber, int workerPid, const char *reason, bool willRetry) = 0;
+    virtual void forkingReplications(int numReplications, simtime_t branchTime) = 0;
+    virtual void notForkingReplications(const char *reason) = 0;
     virtual void preparing(const char *configName, int runNumber) = 0;
     virtual void summary(int numRuns, int runsTried, int numErrors) = 0;
     virtual void beforeRedirecting(cConfiguration *cfg) = 0;
@@ -69,6 +74,11 @@ class CmdenvNarrator : public ICmdenvNarrator
   public:
     CmdenvNarrator(std::ostream& out) : ICmdenvNarrator(out) {}
     virtual void usingThreads(int numThreads) override;
+    virtual void usingProcesses(int numProcesses) override;
+    virtual void workerRunFinished(int runNumber, int workerPid, bool success, eventnumber_t numEvents, simtime_t simTime, double elapsedTime, double peakRSS, int numFinished, int numRuns) override;
+    virtual void workerCrashed(int runNumber, int workerPid, const char *reason, bool willRetry) override;
+    virtual void forkingReplications(int numReplications, simtime_t branchTime) override;
+    virtual void notForkingReplications(const char *reason) override;
     virtual void preparing(const char *configName, int runNumber) override;
     virtual void summary(int numRuns, int runsTried, int numErrors) override;
     virtual void beforeRedirecting(cConfiguration *cfg) override;
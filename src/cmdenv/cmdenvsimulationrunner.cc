@@ -15,14 +15,25 @@
 *--------------------------------------------------------------*/
 
 #include <algorithm>
+#include <cinttypes>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <set>
 #include <sstream>
 #include <thread>
 
+#ifndef _WIN32
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
 #include "cmddefs.h"
 #include "cmdenvapp.h"
 #include "common/fileutil.h"
@@ -36,6 +47,8 @@
 #include "omnetpp/cconfigoption.h"
 #include "omnetpp/checkandcast.h"
 #include "omnetpp/ceventlooprunner.h"
+#include "omnetpp/crng.h"
+#include "omnetpp/crngmanager.h"
 #include "sim/netbuilder/cnedloader.h"
 #include "cmdenvsimulationrunner.h"
 #include "cmdenvnarrator.h"
@@ -57,7 +70,13 @@ namespace cmdenv {
 Register_GlobalConfigOption(CFGID_CMDENV_CONFIG_NAME, "cmdenv-config-name", CFG_STRING, nullptr, "Specifies the name of the configuration to be run (for a value `Foo`, section `[Config Foo]` will be used from the ini file). See also `cmdenv-runs-to-execute`. The `-c` command line option overrides this setting.")
 Register_GlobalConfigOption(CFGID_CMDENV_RUNS_TO_EXECUTE, "cmdenv-runs-to-execute", CFG_STRING, nullptr, "Specifies which runs to execute from the selected configuration (see `cmdenv-config-name` option). It accepts a filter expression of iteration variables such as `$numHosts>10 && $iatime==1s`, or a comma-separated list of run numbers or run number ranges, e.g. `1,3..4,7..9`. If the value is missing, CmdenvCore executes all runs in the selected configuration. The `-r` command line option overrides this setting.")
 Register_GlobalConfigOption(CFGID_CMDENV_STOP_BATCH_ON_ERROR, "cmdenv-stop-batch-on-error", CFG_BOOL, "true", "Decides whether CmdenvCore should skip the rest of the runs when an error occurs during the execution of one run.")
-Register_GlobalConfigOption(CFGID_CMDENV_NUM_THREADS, "cmdenv-num-threads", CFG_INT, "1", "Specifies the number of threads to use when running multiple simulations is requested. (Each simulation will still run sequentially in its thread.) When -1 is given, the number of concurrent threads supported by the hardware will be used.");
+Register_GlobalConfigOption(CFGID_CMDENV_NUM_THREADS, "cmdenv-num-threads", CFG_INT, "1", "Specifies the number of threads to use when running multiple simulations is requested. (Each simulation will still run sequentially in its thread.) When -1 is given, the number of concurrent threads supported by the hardware will be used. With `cmdenv-fork-replications=true`, it limits the number of concurrently running replication processes.");
+Register_GlobalConfigOption(CFGID_CMDENV_NUM_PROCESSES, "cmdenv-num-processes", CFG_INT, "0", "Specifies the number of worker processes to use when running multiple simulations is requested. With a nonzero value, Cmdenv acts as a supervisor that hands out runs one by one to worker processes forked from it, so that crashes, leaks or thread-safety problems of one run cannot affect the others, and collects their results and performance data. When -1 is given, the number of concurrent threads supported by the hardware will be used. The default 0 means that runs are executed in the Cmdenv process itself. Only supported on POSIX systems. See also `cmdenv-worker-max-runs`, `cmdenv-worker-memory-limit`, `cmdenv-run-retries`.");
+Register_GlobalConfigOption(CFGID_CMDENV_WORKER_MAX_RUNS, "cmdenv-worker-max-runs", CFG_INT, "0", "When `cmdenv-num-processes` is nonzero: the number of runs after which a worker process is replaced with a fresh one, e.g. to reclaim memory leaked by the model. 0 means no limit.");
+Register_GlobalConfigOptionU(CFGID_CMDENV_WORKER_MEMORY_LIMIT, "cmdenv-worker-memory-limit", "B", "0B", "When `cmdenv-num-processes` is nonzero: a worker process whose peak resident memory size has exceeded this limit is replaced with a fresh one after finishing its current run. 0 means no limit.");
+Register_GlobalConfigOption(CFGID_CMDENV_RUN_RETRIES, "cmdenv-run-retries", CFG_INT, "1", "When `cmdenv-num-processes` is nonzero: how many more times a run is attempted in a new worker process if the worker crashed (was killed by a signal, or exited unexpectedly) while executing it. Runs that end with an error are not retried.");
+Register_GlobalConfigOption(CFGID_CMDENV_FORK_REPLICATIONS, "cmdenv-fork-replications", CFG_BOOL, "false", "When enabled, runs that only differ in the repetition (i.e. in the RNG seeds) are not started from scratch: the network is set up only once for them, and the replications are continued in child processes created with `fork()` after reseeding the RNGs. Results are identical to those of separate runs as long as no random numbers are drawn during network setup (otherwise the replications are run from scratch), and model parameters do not depend on `${repetition}` or `${runnumber}`. See also `cmdenv-fork-branch-time`. Only supported on POSIX systems, and not together with parallel simulation, eventlog recording and binary logging.");
+Register_GlobalConfigOptionU(CFGID_CMDENV_FORK_BRANCH_TIME, "cmdenv-fork-branch-time", "s", "0s", "When `cmdenv-fork-replications=true`: the simulation time up to which replications share the same trajectory. With a nonzero value, the network is also initialized and simulated once up to this point (with the seeds of the first replication) before forking, which saves time when much of the warm-up period is spent there. It must not be later than `warmup-period`. With 0s, the network is forked right after setup, before initialization, and results are identical to those of separate runs.");
 
 Register_GlobalConfigOption(CFGID_CMDENV_OUTPUT_FILE, "cmdenv-output-file", CFG_FILENAME, "${resultdir}/${configname}-${iterationvarsf}#${repetition}.out", "When `cmdenv-record-output=true`: file name to redirect standard output to. See also `fname-append-host`.")
 Register_GlobalConfigOption(CFGID_CMDENV_REDIRECT_OUTPUT, "cmdenv-redirect-output", CFG_BOOL, "false", "Causes Cmdenv to redirect standard output of simulation runs to a file or separate files per run. This option can be useful with running simulation campaigns (e.g. using opp_runall), and also with parallel simulation. See also: `cmdenv-output-file`, `fname-append-host`.");
@@ -67,6 +86,7 @@ Register_GlobalConfigOption(CFGID_CMDENV_EVENT_BANNERS, "cmdenv-event-banners",
 Register_GlobalConfigOption(CFGID_CMDENV_EVENT_BANNER_DETAILS, "cmdenv-event-banner-details", CFG_BOOL, "false", "When `cmdenv-express-mode=false`: print extra information after event banners.")
 Register_GlobalConfigOptionU(CFGID_CMDENV_STATUS_FREQUENCY, "cmdenv-status-frequency", "s", "2s", "When `cmdenv-express-mode=true`: print status update every n seconds.")
 Register_GlobalConfigOption(CFGID_CMDENV_PERFORMANCE_DISPLAY, "cmdenv-performance-display", CFG_BOOL, "true", "When `cmdenv-express-mode=true`: print detailed performance information. Turning it on results in a 3-line entry printed on each update, containing ev/sec, simsec/sec, ev/simsec, number of messages created/still present/currently scheduled in FES.")
+Register_GlobalConfigOption(CFGID_CMDENV_LEAN_EVENT_LOOP, "cmdenv-lean-event-loop", CFG_BOOL, "true", "When `cmdenv-express-mode=true`: use a specialized event loop that executes events in batches, without per-event notifications to the user interface, and that only checks for status updates, time limits and interrupts between batches. It is only used when no eventlog is recorded, and no fingerprint is calculated. Turning it off is only useful for benchmarking.")
 
 // Used for graceful exit when Ctrl-C is hit during simulation. We want to finish the
 // current event, then normally exit via callFinish() so that simulation results are not lost.
@@ -120,9 +140,21 @@ CmdenvSimulationRunner::BatchResult CmdenvSimulationRunner::runParameterStudy(In
 
     cConfiguration *masterCfg = ini->extractConfig(configName, runNumbers[0]);
     int numThreads = masterCfg->getAsInt(CFGID_CMDENV_NUM_THREADS);
+    int numProcesses = masterCfg->getAsInt(CFGID_CMDENV_NUM_PROCESSES);
+    bool forkReplications = masterCfg->getAsBool(CFGID_CMDENV_FORK_REPLICATIONS);
     delete masterCfg;
 
-    bool threaded = numThreads != 1;
+    if (numProcesses != 0 && (numThreads != 1 || forkReplications))
+        throw cRuntimeError("cmdenv-num-processes cannot be combined with cmdenv-num-threads or cmdenv-fork-replications");
+
+    bool threaded = numThreads != 1 && !forkReplications;
+
+#ifdef _WIN32
+    if (forkReplications)
+        throw cRuntimeError("Forking replications (cmdenv-fork-replications=true) is not supported on Windows");
+    if (numProcesses != 0)
+        throw cRuntimeError("Running simulations in worker processes (cmdenv-num-processes) is not supported on Windows");
+#endif
 
 #if defined(_WIN32) && defined(WITH_SHARED_LIBS)
     if (threaded)
@@ -132,7 +164,11 @@ CmdenvSimulationRunner::BatchResult CmdenvSimulationRunner::runParameterStudy(In
     BatchResult result;
     result.numRuns = (int)runNumbers.size();
 
-    if (!threaded)
+    if (numProcesses != 0)
+        result = runSimulationsInProcesses(ini, configName, runNumbers, numProcesses); // throws only on supervisor errors
+    else if (forkReplications)
+        result = runSimulationsForked(ini, configName, runNumbers, numThreads); // does not throw
+    else if (!threaded)
         result = runSimulations(ini, configName, runNumbers); // does not throw
     else
         result = runSimulationsInThreads(ini, configName, runNumbers, numThreads); // does not throw
@@ -201,6 +237,599 @@ CmdenvSimulationRunner::BatchResult CmdenvSimulationRunner::runSimulationsInThre
     return extractResult(state);
 }
 
+#ifndef _WIN32
+
+static double getPeakResidentSetSize()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss;  // in bytes
+#else
+    return usage.ru_maxrss * 1024.0;  // in kilobytes
+#endif
+}
+
+static std::string describeExitStatus(int status)
+{
+    if (WIFSIGNALED(status))
+        return opp_stringf("killed by signal %d (%s)", WTERMSIG(status), strsignal(WTERMSIG(status)));
+    else if (WIFEXITED(status))
+        return opp_stringf("exited with code %d", WEXITSTATUS(status));
+    else
+        return "terminated abnormally";
+}
+
+static void writeFully(int fd, const std::string& data)
+{
+    const char *p = data.c_str();
+    size_t remaining = data.size();
+    while (remaining > 0) {
+        ssize_t n = write(fd, p, remaining);
+        if (n == -1) {
+            if (errno == EINTR)
+                continue;
+            return;  // the other side is gone; it will notice
+        }
+        p += n;
+        remaining -= n;
+    }
+}
+
+#endif
+
+CmdenvSimulationRunner::BatchResult CmdenvSimulationRunner::runSimulationsInProcesses(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numProcesses)
+{
+#ifdef _WIN32
+    throw cRuntimeError("Running simulations in worker processes is not supported on Windows");
+#else
+    if (numProcesses <= 0) {
+        numProcesses = std::thread::hardware_concurrency();
+        if (numProcesses <= 0)
+            numProcesses = 1;
+    }
+    numProcesses = std::min(numProcesses, (int)runNumbers.size());
+
+    // load NED files before forking, so that workers inherit them
+    cConfiguration *firstCfg = ini->extractConfig(configName, runNumbers[0]);
+    ensureNedLoader(firstCfg);
+    int maxRunsPerWorker = firstCfg->getAsInt(CFGID_CMDENV_WORKER_MAX_RUNS);
+    double memoryLimit = firstCfg->getAsDouble(CFGID_CMDENV_WORKER_MEMORY_LIMIT);
+    int maxRetries = firstCfg->getAsInt(CFGID_CMDENV_RUN_RETRIES);
+    bool stopBatchOnError = firstCfg->getAsBool(CFGID_CMDENV_STOP_BATCH_ON_ERROR);
+    delete firstCfg;
+
+    narrator->usingProcesses(numProcesses);
+
+    struct Worker {
+        pid_t pid = -1;
+        int taskFd = -1;     // write end of the pipe that carries run numbers to the worker
+        int resultFd = -1;   // read end of the pipe that carries results from the worker
+        std::string buffer;  // incomplete line received from the worker
+        int runNumber = -1;  // the run being executed, or -1
+    };
+
+    BatchState state;
+    state.numRuns = (int)runNumbers.size();
+    std::deque<int> queue(runNumbers.begin(), runNumbers.end());
+    std::map<int,int> numAttempts;
+    std::vector<Worker> workers(numProcesses);
+    int numFinished = 0;
+    bool stopping = false;
+
+    // hand out the next run to the worker, or let it exit if there is none
+    auto assignRun = [&](Worker& worker) {
+        if (stopping || queue.empty()) {
+            close(worker.taskFd);
+            worker.taskFd = -1;
+            return;
+        }
+        worker.runNumber = queue.front();
+        queue.pop_front();
+        if (numAttempts[worker.runNumber]++ == 0)
+            state.runsTried++;
+        writeFully(worker.taskFd, opp_stringf("run %d %d\n", worker.runNumber, (int)state.runsTried));
+    };
+
+    auto startWorker = [&](Worker& worker) {
+        int taskPipe[2], resultPipe[2];
+        if (pipe(taskPipe) != 0 || pipe(resultPipe) != 0)
+            throw cRuntimeError("Cannot create pipe for worker process: %s", strerror(errno));
+
+        out.flush();
+        fflush(stdout);
+        fflush(stderr);
+
+        pid_t pid = fork();
+        if (pid == -1)
+            throw cRuntimeError("Cannot fork worker process: %s", strerror(errno));
+        if (pid == 0) {
+            // child: the pipes of other workers must be closed, otherwise they would not see EOF
+            for (Worker& other : workers) {
+                if (other.taskFd != -1)
+                    close(other.taskFd);
+                if (other.resultFd != -1)
+                    close(other.resultFd);
+            }
+            close(taskPipe[1]);
+            close(resultPipe[0]);
+            signal(SIGPIPE, SIG_DFL);
+            runWorker(ini, configName, state.numRuns, taskPipe[0], resultPipe[1], maxRunsPerWorker, memoryLimit); // does not return
+        }
+        close(taskPipe[0]);
+        close(resultPipe[1]);
+
+        worker = Worker();
+        worker.pid = pid;
+        worker.taskFd = taskPipe[1];
+        worker.resultFd = resultPipe[0];
+        assignRun(worker);
+    };
+
+    auto processLine = [&](Worker& worker, const std::string& line) {
+        int runNumber, success;
+        int64_t numEvents;
+        double simTime, elapsedTime, peakRSS;
+        char recycle[16] = "";
+        if (sscanf(line.c_str(), "done %d %d %" SCNd64 " %lg %lg %lg %15s", &runNumber, &success, &numEvents, &simTime, &elapsedTime, &peakRSS, recycle) < 6 || runNumber != worker.runNumber)
+            throw cRuntimeError("Unexpected message from worker process %d: '%s'", (int)worker.pid, line.c_str());
+
+        worker.runNumber = -1;
+        numFinished++;
+        if (success)
+            state.numCompleted++;
+        else {
+            state.numErrors++;
+            if (stopBatchOnError)
+                stopping = true;
+        }
+        narrator->workerRunFinished(runNumber, worker.pid, success, numEvents, simTime, elapsedTime, peakRSS, numFinished, state.numRuns);
+
+        // when recycled, the worker exits by itself, and is replaced on EOF
+        if (strcmp(recycle, "recycle") != 0)
+            assignRun(worker);
+    };
+
+    auto workerExited = [&](Worker& worker) {
+        close(worker.resultFd);
+        worker.resultFd = -1;
+        if (worker.taskFd != -1) {
+            close(worker.taskFd);
+            worker.taskFd = -1;
+        }
+
+        int status = 0;
+        while (waitpid(worker.pid, &status, 0) == -1 && errno == EINTR)
+            ;
+
+        if (worker.runNumber != -1) {
+            // crashed while executing a run
+            int runNumber = worker.runNumber;
+            bool retry = !stopping && numAttempts[runNumber] <= maxRetries;
+            narrator->workerCrashed(runNumber, worker.pid, describeExitStatus(status).c_str(), retry);
+            if (retry)
+                queue.push_front(runNumber);
+            else {
+                numFinished++;
+                state.numErrors++;
+                cRuntimeError e("Run #%d could not be completed: worker process %s", runNumber, describeExitStatus(status).c_str());
+                narrator->displayException(e);
+                if (stopBatchOnError)
+                    stopping = true;
+            }
+        }
+        worker.pid = -1;
+        worker.runNumber = -1;
+
+        if (!stopping && !queue.empty())
+            startWorker(worker);
+    };
+
+    // note: writing to the pipe of a worker that has just crashed must not kill us
+    auto oldSigpipeHandler = signal(SIGPIPE, SIG_IGN);
+
+    for (Worker& worker : workers)
+        startWorker(worker);
+
+    while (true) {
+        if (sigintReceived)
+            stopping = true;  // note: workers also receive the signal, and finish their current runs
+
+        std::vector<pollfd> fds;
+        std::vector<Worker*> polledWorkers;
+        for (Worker& worker : workers) {
+            if (worker.resultFd != -1) {
+                fds.push_back(pollfd{worker.resultFd, POLLIN, 0});
+                polledWorkers.push_back(&worker);
+            }
+        }
+        if (fds.empty())
+            break;
+
+        if (poll(fds.data(), fds.size(), -1) == -1) {
+            if (errno == EINTR)
+                continue;
+            throw cRuntimeError("Error waiting for worker processes: %s", strerror(errno));
+        }
+
+        for (size_t i = 0; i < fds.size(); i++) {
+            if (fds[i].revents == 0)
+                continue;
+            Worker& worker = *polledWorkers[i];
+            char buf[4096];
+            ssize_t n = read(worker.resultFd, buf, sizeof(buf));
+            if (n > 0) {
+                worker.buffer.append(buf, n);
+                size_t pos;
+                while ((pos = worker.buffer.find('\n')) != std::string::npos) {
+                    std::string line = worker.buffer.substr(0, pos);
+                    worker.buffer.erase(0, pos + 1);
+                    processLine(worker, line);
+                }
+            }
+            else if (n == 0 || errno != EINTR)
+                workerExited(worker);
+        }
+    }
+
+    signal(SIGPIPE, oldSigpipeHandler);
+
+    return extractResult(state);
+#endif
+}
+
+void CmdenvSimulationRunner::runWorker(InifileContents *ini, const char *configName, int numRuns, int taskFd, int resultFd, int maxRuns, double memoryLimit)
+{
+#ifdef _WIN32
+    throw cRuntimeError("Running simulations in worker processes is not supported on Windows");
+#else
+    FILE *tasks = fdopen(taskFd, "r");
+    BatchState state;
+    state.numRuns = numRuns;
+    int numRunsDone = 0;
+    int exitCode = 0;
+
+    char line[64];
+    while (!sigintReceived && fgets(line, sizeof(line), tasks) != nullptr) {
+        int runNumber, runIndex;
+        if (sscanf(line, "run %d %d", &runNumber, &runIndex) != 2) {
+            exitCode = 1;
+            break;
+        }
+
+        // execute the run
+        state.runsTried = runIndex;
+        RunStats stats;
+        bool success = true;
+        try {
+            doRunSimulation(state, ini, configName, runNumber, &stats);
+        }
+        catch (std::exception& e) {
+            narrator->displayException(e);
+            success = false;
+        }
+        numRunsDone++;
+
+        // report the result, and decide whether this worker should be replaced
+        double peakRSS = getPeakResidentSetSize();
+        bool recycle = (maxRuns > 0 && numRunsDone >= maxRuns) || (memoryLimit > 0 && peakRSS > memoryLimit);
+
+        out.flush();
+        fflush(stdout);
+        fflush(stderr);
+
+        writeFully(resultFd, opp_stringf("done %d %d %" PRId64 " %.17g %.17g %.17g%s\n", runNumber, success ? 1 : 0, (int64_t)stats.numEvents,
+                stats.simTime.dbl(), stats.elapsedTime, peakRSS, recycle ? " recycle" : ""));
+        if (recycle)
+            break;
+    }
+
+    // exit without running destructors or atexit handlers of the supervisor's state
+    out.flush();
+    fflush(stdout);
+    fflush(stderr);
+    _exit(exitCode);
+#endif
+}
+
+CmdenvSimulationRunner::BatchResult CmdenvSimulationRunner::runSimulationsForked(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int maxProcesses)
+{
+    if (maxProcesses <= 0) {
+        maxProcesses = std::thread::hardware_concurrency();
+        if (maxProcesses <= 0)
+            maxProcesses = 1;
+    }
+
+    // group runs that only differ in the repetition, preserving their order
+    std::vector<std::vector<int>> groups;
+    std::map<std::string,int> groupIndexByIterationVars;
+    for (int runNumber : runNumbers) {
+        std::unique_ptr<cConfiguration> cfg(ini->extractConfig(configName, runNumber));
+        std::string iterationVars = opp_nulltoempty(cfg->getVariable(CFGVAR_ITERATIONVARS));
+        auto it = groupIndexByIterationVars.find(iterationVars);
+        if (it != groupIndexByIterationVars.end())
+            groups[it->second].push_back(runNumber);
+        else {
+            groupIndexByIterationVars[iterationVars] = groups.size();
+            groups.push_back({runNumber});
+        }
+    }
+
+    BatchState state;
+    state.numRuns = (int)runNumbers.size();
+    for (const std::vector<int>& group : groups) {
+        int numErrors = state.numErrors;
+        try {
+            if (group.size() == 1) {
+                state.runsTried++;
+                doRunSimulation(state, ini, configName, group[0]);
+                state.numCompleted++;
+            }
+            else {
+                doRunForkedReplications(state, ini, configName, group, maxProcesses);
+            }
+        }
+        catch (std::exception& e) {
+            narrator->displayException(e);
+            state.numErrors++;
+        }
+
+        // skip further runs if signal was caught, or on error if so requested
+        if (sigintReceived || (state.numErrors > numErrors && state.stopBatchOnError))
+            break;
+    }
+    return extractResult(state);
+}
+
+/**
+ * Runs the simulation until the next event would occur at or after the given
+ * simulation time, and then returns (i.e. pauses the simulation).
+ */
+class BranchPointEventLoopRunner : public cIEventLoopRunner
+{
+  private:
+    simtime_t branchTime;
+    bool& sigintReceived;
+
+  public:
+    BranchPointEventLoopRunner(cSimulation *simulation, simtime_t branchTime, bool& sigintReceived) :
+        cIEventLoopRunner(simulation), branchTime(branchTime), sigintReceived(sigintReceived) {}
+    virtual void configure(cConfiguration *cfg) override {}
+    virtual void runEventLoop() override;
+};
+
+void BranchPointEventLoopRunner::runEventLoop()
+{
+    while (true) {
+        cEvent *nextEvent = simulation->guessNextEvent();
+        if (nextEvent == nullptr || nextEvent->getArrivalTime() >= branchTime)
+            return;
+        cEvent *event = simulation->takeNextEvent();
+        if (!event)
+            throw cTerminationException("Scheduler interrupted while waiting");
+        simulation->executeEvent(event);
+        if (sigintReceived)
+            throw cTerminationException("SIGINT or SIGTERM received, exiting");
+    }
+}
+
+static uint64_t getNumRandomNumbersDrawn(cSimulation *simulation)
+{
+    cRngManager *rngManager = check_and_cast<cRngManager *>(simulation->getRngManager());
+    uint64_t numDrawn = 0;
+    for (int i = 0; i < rngManager->getNumRNGs(); i++)
+        numDrawn += rngManager->getRNG(i)->getNumbersDrawn();
+    return numDrawn;
+}
+
+void CmdenvSimulationRunner::doRunForkedReplications(BatchState& state, InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int maxProcesses)
+{
+#ifdef _WIN32
+    throw cRuntimeError("Forking replications is not supported on Windows");
+#else
+    narrator->preparing(configName, runNumbers[0]);
+
+    std::unique_ptr<cConfiguration> cfg(ini->extractConfig(configName, runNumbers[0]));
+    state.stopBatchOnError = cfg->getAsBool(CFGID_CMDENV_STOP_BATCH_ON_ERROR);
+    simtime_t branchTime = cfg->getAsDouble(CFGID_CMDENV_FORK_BRANCH_TIME);
+
+    ensureNedLoader(cfg.get());
+
+    // the common part goes to the console; each replication redirects its own
+    // output after the fork by switching the stream buffer of simout
+    std::ostream simout(out.rdbuf());
+    std::ofstream fout;
+
+    std::unique_ptr<cSimulation> tmp(createSimulation(simout));
+    cSimulation *simulation = tmp.get();
+
+    narrator->simulationCreated(simulation, fout);
+
+    cSimulation::setActiveSimulation(simulation);
+
+    // set up the network, and run it until the branch point
+    state.runsTried++;  // the first replication
+    bool forkable = true;
+    try {
+        simulation->setupNetwork(cfg.get());
+
+        if (simulation->isParsimEnabled())
+            throw cRuntimeError("Forking replications is not supported with parallel simulation");
+        if (branchTime > simulation->getWarmupPeriod())
+            throw cRuntimeError("The branch point for forking replications (cmdenv-fork-branch-time=%s) must not be later than the end of the warm-up period (%s)",
+                    branchTime.ustr().c_str(), simulation->getWarmupPeriod().ustr().c_str());
+
+        if (branchTime > SIMTIME_ZERO) {
+            BranchPointEventLoopRunner runner(simulation, branchTime, sigintReceived);
+            if (!simulation->run(&runner, false))
+                throw cRuntimeError("Simulation terminated before reaching the branch point for forking replications: %s", simulation->getTerminationReason()->what());
+        }
+        else if (getNumRandomNumbersDrawn(simulation) != 0) {
+            // reseeding would not make the replications identical to separate runs
+            narrator->notForkingReplications("random numbers were drawn during network setup");
+            simulation->deleteNetwork();
+            forkable = false;
+        }
+    }
+    catch (cRuntimeError& e) {
+        simulation->deleteNetworkOnError(e);
+        throw;
+    }
+    catch (std::exception& e) {
+        cRuntimeError re(e);
+        simulation->deleteNetworkOnError(re);
+        throw re;
+    }
+
+    if (!forkable) {
+        tmp.reset();
+        for (int i = 0; i < (int)runNumbers.size() && !sigintReceived; i++) {
+            if (i > 0)
+                state.runsTried++;
+            doRunSimulation(state, ini, configName, runNumbers[i]); // note: throws on error
+            state.numCompleted++;
+        }
+        return;
+    }
+
+    narrator->forkingReplications((int)runNumbers.size(), branchTime);
+
+    std::set<pid_t> children;
+    int numErrors = state.numErrors;
+
+    auto waitForChild = [&]() {
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid == -1) {
+            if (errno == EINTR)
+                return; // SIGINT arrived, children get it too
+            children.clear();
+            throw cRuntimeError("Error waiting for replication processes: %s", strerror(errno));
+        }
+        if (children.erase(pid) == 0)
+            return;
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0)
+            state.numCompleted++;
+        else
+            state.numErrors++;
+    };
+
+    // fork a child process for all but the first replication, and continue
+    // as the first one in this process when all have been started
+    for (int i = 1; i < (int)runNumbers.size(); i++) {
+        while ((int)children.size() >= std::max(maxProcesses - 1, 1))
+            waitForChild();
+        if (sigintReceived || (state.numErrors > numErrors && state.stopBatchOnError))
+            break;
+
+        narrator->preparing(configName, runNumbers[i]);
+        std::unique_ptr<cConfiguration> childCfg(ini->extractConfig(configName, runNumbers[i]));
+
+        out.flush();
+        fflush(stdout);
+        fflush(stderr);
+
+        pid_t pid = fork();
+        if (pid == -1) {
+            cRuntimeError e("Cannot fork replication process: %s", strerror(errno));
+            narrator->displayException(e);
+            state.numErrors++;
+            break;
+        }
+        if (pid == 0) {
+            // child: continue as the given replication, and exit without
+            // running destructors or atexit handlers of the parent's state
+            int exitCode = 0;
+            try {
+                runReplication(state, simulation, simout, fout, childCfg.get(), true);
+            }
+            catch (std::exception& e) {
+                narrator->displayException(e);
+                exitCode = 1;
+            }
+            out.flush();
+            fflush(stdout);
+            fflush(stderr);
+            _exit(exitCode);
+        }
+        children.insert(pid);
+        state.runsTried++;
+    }
+
+    if (!sigintReceived && !(state.numErrors > numErrors && state.stopBatchOnError)) {
+        narrator->preparing(configName, runNumbers[0]);
+        try {
+            runReplication(state, simulation, simout, fout, cfg.get(), false);
+            state.numCompleted++;
+        }
+        catch (std::exception& e) {
+            narrator->displayException(e);
+            state.numErrors++;
+        }
+    }
+    else {
+        state.runsTried--;  // skipped
+        simulation->deleteNetwork();
+    }
+
+    while (!children.empty())
+        waitForChild();
+#endif
+}
+
+void CmdenvSimulationRunner::runReplication(BatchState& state, cSimulation *simulation, std::ostream& simout, std::ofstream& fout, cConfiguration *cfg, bool switchRun)
+{
+    bool redirectOutput = cfg->getAsBool(CFGID_CMDENV_REDIRECT_OUTPUT);
+    std::string outputFile = redirectOutput ? ResultFileUtils(cfg).augmentFileName(cfg->getAsFilename(CFGID_CMDENV_OUTPUT_FILE)) : "";
+    const char *redirectFileName = outputFile.c_str();
+
+    try {
+        if (switchRun) {
+            simulation->switchToRun(cfg);
+            check_and_cast<GenericEnvir *>(simulation->getEnvir())->switchToRun(cfg);
+        }
+
+        narrator->beforeRedirecting(cfg);
+
+        if (redirectOutput) {
+            narrator->redirectingTo(cfg, redirectFileName);
+            mkPath(directoryOf(redirectFileName).c_str());
+            fout.open(redirectFileName);
+            if (!fout.is_open())
+                throw cRuntimeError("Cannot open file '%s' for write", redirectFileName);
+            narrator->onRedirectionFileOpen(fout, cfg, redirectFileName);
+            simout.rdbuf(fout.rdbuf());
+        }
+
+        narrator->afterRedirecting(cfg, fout);
+
+        std::unique_ptr<cIEventLoopRunner> runner(createEventLoopRunner(state, simulation, simout, cfg));
+
+        bool isTerminated = !simulation->run(runner.get(), true);
+        if (!isTerminated)
+            throw cRuntimeError("Simulation paused before running to completion");
+
+        if (redirectOutput)
+            narrator->logException(fout, *simulation->getTerminationReason());
+
+        simulation->deleteNetwork();
+    }
+    catch (cRuntimeError& e) {
+        simulation->deleteNetworkOnError(e);
+        if (redirectOutput && fout.is_open())
+            narrator->logException(fout, e);
+        throw;
+    }
+    catch (std::exception& e) {
+        cRuntimeError re(e);
+        simulation->deleteNetworkOnError(re);
+        if (redirectOutput && fout.is_open())
+            narrator->logException(fout, re);
+        throw re;
+    }
+}
+
 CmdenvSimulationRunner::BatchResult CmdenvSimulationRunner::runSimulations(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers)
 {
     BatchState state;
@@ -236,16 +865,16 @@ void CmdenvSimulationRunner::runSimulation(InifileContents *ini, const char *con
     doRunSimulation(state, ini, configName, runNumber);
 }
 
-void CmdenvSimulationRunner::doRunSimulation(BatchState& state, InifileContents *ini, const char *configName, int runNumber)
+void CmdenvSimulationRunner::doRunSimulation(BatchState& state, InifileContents *ini, const char *configName, int runNumber, RunStats *stats)
 {
     narrator->preparing(configName, runNumber);
 
     std::unique_ptr<cConfiguration> cfg(ini->extractConfig(configName, runNumber));
-    cTerminationException *reason = setupAndRunSimulation(state, cfg.get());
+    cTerminationException *reason = setupAndRunSimulation(state, cfg.get(), stats);
     delete reason;
 }
 
-cTerminationException *CmdenvSimulationRunner::setupAndRunSimulation(BatchState& state, cConfiguration *cfg)
+cTerminationException *CmdenvSimulationRunner::setupAndRunSimulation(BatchState& state, cConfiguration *cfg, RunStats *stats)
 {
     state.stopBatchOnError = cfg->getAsBool(CFGID_CMDENV_STOP_BATCH_ON_ERROR);
 
@@ -293,6 +922,12 @@ cTerminationException *CmdenvSimulationRunner::setupAndRunSimulation(BatchState&
         if (redirectOutput)
             narrator->logException(fout, *terminationReason);  //TODO why not from listener?
 
+        if (stats) {
+            stats->numEvents = simulation->getEventNumber();
+            stats->simTime = simulation->getSimTime();
+            stats->elapsedTime = simulation->getElapsedTime();
+        }
+
         simulation->deleteNetwork();  // note: without this, exceptions during teardown would be swallowed by cSimulation dtor
 
         return terminationReason;
@@ -330,6 +965,7 @@ cIEventLoopRunner *CmdenvSimulationRunner::createEventLoopRunner(BatchState& sta
     runner->setPrintThreadId(std::this_thread::get_id() != homeThreadId);
     runner->setPrintEventBanners(cfg->getAsBool(CFGID_CMDENV_EVENT_BANNERS));
     runner->setDetailedEventBanners(cfg->getAsBool(CFGID_CMDENV_EVENT_BANNER_DETAILS));
+    runner->setLeanEventLoop(cfg->getAsBool(CFGID_CMDENV_LEAN_EVENT_LOOP));
     runner->setBatchProgress(state.runsTried, state.numRuns);
     return runner;
 }
@@ -43,6 +43,12 @@ class CMDENV_API CmdenvSimulationRunner
          int numErrors;
     };
 
+    struct RunStats {
+         eventnumber_t numEvents = 0;
+         simtime_t simTime;
+         double elapsedTime = 0; // seconds
+    };
+
    protected:
      std::ostream& out;
      cINedLoader *nedLoader = nullptr;
@@ -70,9 +76,12 @@ class CMDENV_API CmdenvSimulationRunner
      // internal
      virtual void ensureNedLoader(cConfiguration *cfg);
      virtual void doRunSimulations(BatchState& state, InifileContents *ini, const char *configName, const std::vector<int>& runNumbers);
-     virtual void doRunSimulation(BatchState& state, InifileContents *ini, const char *configName, int runNumber); // note: throws on error
+     virtual void doRunSimulation(BatchState& state, InifileContents *ini, const char *configName, int runNumber, RunStats *stats=nullptr); // note: throws on error
      virtual BatchResult extractResult(const BatchState& state);
-     virtual cTerminationException *setupAndRunSimulation(BatchState& state, cConfiguration *cfg);
+     virtual cTerminationException *setupAndRunSimulation(BatchState& state, cConfiguration *cfg, RunStats *stats=nullptr);
+     virtual void doRunForkedReplications(BatchState& state, InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int maxProcesses); // note: throws on error before forking
+     virtual void runWorker(InifileContents *ini, const char *configName, int numRuns, int taskFd, int resultFd, int maxRuns, double memoryLimit); // in a worker process; does not return
+     virtual void runReplication(BatchState& state, cSimulation *simulation, std::ostream& simout, std::ofstream& fout, cConfiguration *cfg, bool switchRun); // note: throws on error
      static void sigintHandler(int signum);
 
    public:
@@ -89,6 +98,8 @@ class CMDENV_API CmdenvSimulationRunner
      virtual BatchResult runParameterStudy(InifileContents *ini, const char *configName, const char *runFilter);
      virtual BatchResult runSimulations(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers);
      virtual BatchResult runSimulationsInThreads(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numThreads=-1);
+     virtual BatchResult runSimulationsInProcesses(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int numProcesses=-1);
+     virtual BatchResult runSimulationsForked(InifileContents *ini, const char *configName, const std::vector<int>& runNumbers, int maxProcesses=-1);
      virtual void runSimulation(InifileContents *ini, const char *configName, int runNumber); // note: throws on error
 };
 
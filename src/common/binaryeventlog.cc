@@ -0,0 +1,865 @@
+//==========================================================================
+//  BINARYEVENTLOG.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstring>
+#include <cerrno>
+#include <cinttypes>
+#include <algorithm>
+#include "opp_ctype.h"
+#include "exception.h"
+#include "stringutil.h"
+#include "linetokenizer.h"
+#include "binaryeventlog.h"
+
+namespace omnetpp {
+namespace common {
+
+#define TRAILER_SIZE    16
+
+static const int64_t powersOfTen[] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+    10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+    1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL
+};
+
+// the length of the decoded form of a string value, see BinaryEventlogReader::appendStringValue()
+static int getStringTextSize(const char *s, size_t length)
+{
+    return opp_needsquotes(s) ? opp_quotestr(s).size() : length;
+}
+
+//----
+
+BinaryEventlogWriter::BinaryEventlogWriter(FILE *f, const char *fileName, int simtimeScaleExp) :
+    f(f), fileName(fileName), simtimeScaleExp(simtimeScaleExp)
+{
+    fileOffset = opp_ftell(f);
+    std::string header = BINARY_EVENTLOG_MAGIC;
+    appendSignedVarint(header, simtimeScaleExp);
+    writeBuffer(header);
+}
+
+BinaryEventlogWriter::~BinaryEventlogWriter()
+{
+    delete tokenizer;
+}
+
+void BinaryEventlogWriter::appendVarint(std::string& buffer, uint64_t value)
+{
+    while (value >= 0x80) {
+        buffer.push_back((char)(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back((char)value);
+}
+
+void BinaryEventlogWriter::writeBuffer(const std::string& buffer)
+{
+    if (fwrite(buffer.data(), 1, buffer.size(), f) != buffer.size())
+        throw opp_runtime_error("Cannot write eventlog file '%s', disk full?", fileName.c_str());
+    fileOffset += buffer.size();
+}
+
+void BinaryEventlogWriter::flushEntry()
+{
+    if (!definitions.empty()) {
+        writeBuffer(definitions);
+        definitions.clear();
+    }
+    writeBuffer(entry);
+    entry.clear();
+}
+
+int BinaryEventlogWriter::getIntTextSize(int64_t value)
+{
+    int size = 1;
+    uint64_t absValue = value;
+    if (value < 0) {
+        size++;
+        absValue = -absValue;
+    }
+    while (absValue >= 10) {
+        absValue /= 10;
+        size++;
+    }
+    return size;
+}
+
+int BinaryEventlogWriter::internString(const char *s, size_t length)
+{
+    auto it = stringIds.find(std::string_view(s, length));
+    if (it != stringIds.end())
+        return it->second;
+    if (strings.size() >= maxStrings)
+        return 0;
+    strings.emplace_back(s, length);
+    stringTextSizes.push_back(-1);
+    int id = strings.size();
+    stringIds[std::string_view(strings.back())] = id;
+    definitions.push_back('S');
+    appendVarint(definitions, length);
+    definitions.append(s, length);
+    return id;
+}
+
+int BinaryEventlogWriter::defineLayout(const char *code, const std::vector<std::pair<std::string, char>>& fields)
+{
+    std::string body;
+    size_t codeLength = strlen(code);
+    appendVarint(body, internString(code, codeLength));
+    appendVarint(body, fields.size());
+    int textSize = codeLength + 1;
+    for (auto& field : fields) {
+        appendVarint(body, internString(field.first.data(), field.first.size()));
+        body.push_back(field.second);
+        textSize += field.first.size() + 2;
+    }
+    definitions.push_back('D');
+    definitions.append(body);
+    layoutDefinitions.append(body);
+    layoutTextSizes.push_back(textSize);
+    return numLayouts++;
+}
+
+void BinaryEventlogWriter::addLayoutReference(int layoutId)
+{
+    entry.push_back('R');
+    appendVarint(entry, layoutId);
+    textOffset += layoutTextSizes[layoutId];
+}
+
+void BinaryEventlogWriter::beginEntry(const EntryDescriptor *descriptor, uint64_t presentFields)
+{
+    int layoutId;
+    auto key = std::make_pair((const void *)descriptor, presentFields);
+    auto it = layoutIds.find(key);
+    if (it != layoutIds.end())
+        layoutId = it->second;
+    else {
+        std::vector<std::pair<std::string, char>> fields;
+        for (int i = 0; i < descriptor->numFields; i++)
+            if (presentFields & ((uint64_t)1 << i))
+                fields.push_back(std::make_pair(std::string(descriptor->fields[i].code), (char)descriptor->fields[i].type));
+        layoutId = defineLayout(descriptor->code, fields);
+        layoutIds[key] = layoutId;
+    }
+    addLayoutReference(layoutId);
+}
+
+void BinaryEventlogWriter::writeSimtime(int64_t rawValue)
+{
+    appendSignedVarint(entry, rawValue);
+    char buf[64], *endp;
+    const char *text = opp_ttoa(buf, rawValue, simtimeScaleExp, endp);
+    textOffset += endp - text;
+}
+
+void BinaryEventlogWriter::writeString(const char *value)
+{
+    if (!value) {
+        entry.push_back(0);
+        textOffset += 2;  // decoded as ""
+    }
+    else {
+        size_t length = strlen(value);
+        int id = internString(value, length);
+        if (id != 0) {
+            appendVarint(entry, 2 * (uint64_t)id + 1);
+            int& textSize = stringTextSizes[id - 1];
+            if (textSize == -1)
+                textSize = getStringTextSize(value, length);
+            textOffset += textSize;
+        }
+        else {
+            appendVarint(entry, 2 * ((uint64_t)length + 1));
+            entry.append(value, length);
+            textOffset += getStringTextSize(value, length);
+        }
+    }
+}
+
+void BinaryEventlogWriter::writeText(const char *value)
+{
+    if (!value) {
+        entry.push_back(0);
+        textOffset += 2;  // decoded as ""
+    }
+    else {
+        size_t length = strlen(value);
+        appendVarint(entry, 2 * ((uint64_t)length + 1));
+        entry.append(value, length);
+        textOffset += getStringTextSize(value, length);
+    }
+}
+
+void BinaryEventlogWriter::writeEmptyLine()
+{
+    lastEmptyLineOffset = fileOffset;
+    lastEmptyLineTextOffset = textOffset;
+    entry.push_back('N');
+    textOffset += 1;
+    flushEntry();
+}
+
+void BinaryEventlogWriter::writeLogLine(const char *prefix, const char *line, int lineLength)
+{
+    size_t prefixLength = strlen(prefix);
+    entry.push_back('L');
+    appendVarint(entry, prefixLength + lineLength);
+    entry.append(prefix, prefixLength);
+    entry.append(line, lineLength);
+    textOffset += 2 + prefixLength + lineLength + 1;  // decoded as "- " prefix line "\n"
+    flushEntry();
+}
+
+void BinaryEventlogWriter::addIndexPoint(int64_t eventNumber, int64_t simtimeRaw)
+{
+    if (lastEmptyLineOffset == -1)
+        return;
+    if (indexPoints.empty() || lastEmptyLineOffset - indexPoints.back().offset >= indexInterval)
+        indexPoints.push_back(IndexPoint{eventNumber, simtimeRaw, lastEmptyLineOffset, lastEmptyLineTextOffset});
+}
+
+static bool parseInt(const char *s, int64_t& value)
+{
+    char *end;
+    errno = 0;
+    value = strtoll(s, &end, 10);
+    if (errno || *end || end == s)
+        return false;
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%" PRId64, value);
+    return !strcmp(buf, s);  // only canonical forms, so that decoding reproduces the text
+}
+
+static bool parseSimtime(const char *s, int scaleExp, int64_t& raw)
+{
+    if (scaleExp > 0 || scaleExp < -18)
+        return false;
+    const char *p = s;
+    bool negative = *p == '-';
+    if (negative)
+        p++;
+    int64_t intPart = 0, fracPart = 0;
+    int intDigits = 0, fracDigits = 0;
+    for ( ; opp_isdigit(*p); p++, intDigits++) {
+        if (intPart > (INT64_MAX - 9) / 10)
+            return false;
+        intPart = 10 * intPart + (*p - '0');
+    }
+    if (*p == '.') {
+        for (p++; opp_isdigit(*p); p++, fracDigits++) {
+            if (fracDigits == -scaleExp)
+                return false;
+            fracPart = 10 * fracPart + (*p - '0');
+        }
+    }
+    if (*p || intDigits == 0)
+        return false;
+    int64_t scale = powersOfTen[-scaleExp];
+    if (intPart > INT64_MAX / scale)
+        return false;
+    raw = intPart * scale + fracPart * powersOfTen[-scaleExp - fracDigits];
+    if (negative)
+        raw = -raw;
+    char buf[64], *endp;
+    return !strcmp(opp_ttoa(buf, raw, scaleExp, endp), s);
+}
+
+bool BinaryEventlogWriter::encodeTextEntry(const char *line, int length)
+{
+    if (!tokenizer)
+        tokenizer = new LineTokenizer(64 * 1024);
+    int numTokens;
+    try {
+        numTokens = tokenizer->tokenize(line, length);
+    }
+    catch (std::exception& e) {
+        return false;
+    }
+    if (numTokens == 0 || numTokens % 2 == 0)
+        return false;
+    char **tokens = tokenizer->tokens();
+    const char *code = tokens[0];
+    bool isEventEntry = !strcmp(code, "E");
+    bool hasFileOffsets = !strcmp(code, "S") || !strcmp(code, "I");
+
+    // infer field types, and check that decoding would reproduce the line exactly
+    int numFields = numTokens / 2;
+    std::vector<std::pair<std::string, char>> fields(numFields);
+    std::vector<int64_t> values(numFields);
+    std::string decoded = code;
+    std::string layoutKey = code;
+    int64_t eventNumber = -1, simtimeRaw = -1;
+    bool hasEventNumber = false, hasSimtime = false;
+    for (int i = 0; i < numFields; i++) {
+        const char *key = tokens[2 * i + 1];
+        const char *value = tokens[2 * i + 2];
+        char type;
+        if (parseInt(value, values[i]))
+            type = BinaryEventlogWriter::FIELD_INT;
+        else if (parseSimtime(value, simtimeScaleExp, values[i]))
+            type = BinaryEventlogWriter::FIELD_SIMTIME;
+        else if (isEventEntry && !strcmp(key, "f"))
+            type = BinaryEventlogWriter::FIELD_TEXT;  // fingerprints are different for each event
+        else
+            type = BinaryEventlogWriter::FIELD_STRING;
+        fields[i] = std::make_pair(std::string(key), type);
+        decoded.append(" ").append(key).append(" ").append(type == FIELD_STRING || type == FIELD_TEXT ? QUOTE(value) : value);
+        layoutKey.append(1, '\0').append(key).append(1, type);
+
+        if (isEventEntry && !strcmp(key, "#") && type == FIELD_INT) {
+            eventNumber = values[i];
+            hasEventNumber = true;
+        }
+        else if (isEventEntry && !strcmp(key, "t")) {
+            if (type == FIELD_SIMTIME) {
+                simtimeRaw = values[i];
+                hasSimtime = true;
+            }
+            else if (type == FIELD_INT && simtimeScaleExp <= 0 && llabs(values[i]) <= INT64_MAX / powersOfTen[-simtimeScaleExp]) {
+                simtimeRaw = values[i] * powersOfTen[-simtimeScaleExp];
+                hasSimtime = true;
+            }
+        }
+    }
+    if (decoded.size() != (size_t)length || memcmp(decoded.data(), line, length))
+        return false;
+
+    // file offsets in snapshot and index entries refer to the input, translate them to the decoded text
+    if (hasFileOffsets) {
+        for (int i = 0; i < numFields; i++) {
+            if (fields[i].second != FIELD_INT)
+                continue;
+            const std::string& key = fields[i].first;
+            if (key == "f") {
+                inputToTextOffsets[values[i]] = textOffset;
+                values[i] = textOffset;
+            }
+            else if ((key == "i" || key == "s") && values[i] != -1) {
+                auto it = inputToTextOffsets.find(values[i]);
+                values[i] = it != inputToTextOffsets.end() ? it->second : -1;
+            }
+        }
+    }
+
+    int layoutId;
+    auto it = textLayoutIds.find(layoutKey);
+    if (it != textLayoutIds.end())
+        layoutId = it->second;
+    else
+        layoutId = textLayoutIds[layoutKey] = defineLayout(code, fields);
+
+    if (isEventEntry && hasEventNumber && hasSimtime)
+        addIndexPoint(eventNumber, simtimeRaw);
+
+    addLayoutReference(layoutId);
+    for (int i = 0; i < numFields; i++) {
+        switch (fields[i].second) {
+            case FIELD_INT: writeInt(values[i]); break;
+            case FIELD_SIMTIME: writeSimtime(values[i]); break;
+            case FIELD_STRING: writeString(tokens[2 * i + 2]); break;
+            case FIELD_TEXT: writeText(tokens[2 * i + 2]); break;
+        }
+    }
+    flushEntry();
+    return true;
+}
+
+void BinaryEventlogWriter::writeTextLine(const char *line, int length)
+{
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+        length--;
+    if (length == 0)
+        writeEmptyLine();
+    else if (length >= 2 && line[0] == '-' && line[1] == ' ')
+        writeLogLine("", line + 2, length - 2);
+    else if (!encodeTextEntry(line, length)) {
+        entry.push_back('X');
+        appendVarint(entry, length);
+        entry.append(line, length);
+        textOffset += length + 1;
+        flushEntry();
+    }
+}
+
+void BinaryEventlogWriter::writeFooter()
+{
+    file_offset_t footerOffset = fileOffset;
+    std::string footer;
+    footer.push_back('F');
+    appendVarint(footer, strings.size());
+    for (auto& s : strings) {
+        appendVarint(footer, s.size());
+        footer.append(s);
+    }
+    appendVarint(footer, numLayouts);
+    footer.append(layoutDefinitions);
+    appendVarint(footer, indexPoints.size());
+    IndexPoint previous {0, 0, 0, 0};
+    for (auto& point : indexPoints) {
+        appendSignedVarint(footer, point.eventNumber - previous.eventNumber);
+        appendSignedVarint(footer, point.simtimeRaw - previous.simtimeRaw);
+        appendVarint(footer, point.offset - previous.offset);
+        appendVarint(footer, point.textOffset - previous.textOffset);
+        previous = point;
+    }
+    appendVarint(footer, textOffset);
+    for (int i = 0; i < 8; i++)
+        footer.push_back((char)((uint64_t)footerOffset >> (8 * i)));
+    footer.append(BINARY_EVENTLOG_TRAILER_MAGIC);
+    writeBuffer(footer);
+}
+
+//----
+
+BinaryEventlogReader::BinaryEventlogReader(const char *fileName) : fileName(fileName)
+{
+    f = fopen(fileName, "rb");
+    if (!f)
+        throw opp_runtime_error("Cannot open binary eventlog file '%s'", fileName);
+    buffer.resize(1024 * 1024);
+    strings.push_back("");
+
+    dataEndOffset = fileSize = getCurrentFileSize();
+    seekTo(0);
+    std::string magic;
+    readBytes(magic, strlen(BINARY_EVENTLOG_MAGIC));
+    if (magic != BINARY_EVENTLOG_MAGIC)
+        throw opp_runtime_error("'%s' is not a binary eventlog file", fileName);
+    simtimeScaleExp = (int)readSignedVarint();
+    dataBeginOffset = definitionsEndOffset = scannedOffset = tell();
+
+    // read the footer if present
+    if (dataEndOffset >= dataBeginOffset + TRAILER_SIZE) {
+        unsigned char trailer[TRAILER_SIZE];
+        opp_fseek(f, dataEndOffset - TRAILER_SIZE, SEEK_SET);
+        if (fread(trailer, 1, TRAILER_SIZE, f) == TRAILER_SIZE && !memcmp(trailer + 8, BINARY_EVENTLOG_TRAILER_MAGIC, 8)) {
+            file_offset_t footerOffset = 0;
+            for (int i = 0; i < 8; i++)
+                footerOffset |= (file_offset_t)trailer[i] << (8 * i);
+            if (footerOffset >= dataBeginOffset && footerOffset < dataEndOffset) {
+                seekTo(footerOffset);
+                readFooter();
+                dataEndOffset = definitionsEndOffset = footerOffset;
+            }
+        }
+    }
+    seekToBeginning();
+}
+
+BinaryEventlogReader::~BinaryEventlogReader()
+{
+    if (f)
+        fclose(f);
+}
+
+bool BinaryEventlogReader::isBinaryEventlogFile(const char *fileName)
+{
+    FILE *f = fopen(fileName, "rb");
+    if (!f)
+        return false;
+    size_t length = strlen(BINARY_EVENTLOG_MAGIC);
+    char magic[64];
+    bool result = fread(magic, 1, length, f) == length && !memcmp(magic, BINARY_EVENTLOG_MAGIC, length);
+    fclose(f);
+    return result;
+}
+
+void BinaryEventlogReader::seekTo(file_offset_t offset)
+{
+    if (opp_fseek(f, offset, SEEK_SET) != 0)
+        throw opp_runtime_error("Cannot seek in binary eventlog file '%s'", fileName.c_str());
+    bufferFileOffset = offset;
+    bufferPos = bufferEnd = 0;
+}
+
+bool BinaryEventlogReader::fillBuffer()
+{
+    bufferFileOffset += bufferEnd;
+    bufferPos = bufferEnd = 0;
+    bufferEnd = fread(buffer.data(), 1, buffer.size(), f);
+    if (ferror(f))
+        throw opp_runtime_error("Read error in binary eventlog file '%s'", fileName.c_str());
+    return bufferEnd != 0;
+}
+
+int BinaryEventlogReader::readByte()
+{
+    if (bufferPos == bufferEnd && !fillBuffer())
+        throw opp_runtime_error("Unexpected end of binary eventlog file '%s'", fileName.c_str());
+    return (unsigned char)buffer[bufferPos++];
+}
+
+uint64_t BinaryEventlogReader::readVarint()
+{
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int b = readByte();
+        result |= (uint64_t)(b & 0x7f) << shift;
+        if (b < 0x80)
+            return result;
+    }
+    throw opp_runtime_error("Corrupt binary eventlog file '%s': invalid varint at offset %" PRId64, fileName.c_str(), (int64_t)tell());
+}
+
+void BinaryEventlogReader::readBytes(std::string& result, size_t length)
+{
+    result.clear();
+    while (length > 0) {
+        if (bufferPos == bufferEnd && !fillBuffer())
+            throw opp_runtime_error("Unexpected end of binary eventlog file '%s'", fileName.c_str());
+        size_t n = std::min(length, bufferEnd - bufferPos);
+        result.append(buffer.data() + bufferPos, n);
+        bufferPos += n;
+        length -= n;
+    }
+}
+
+file_offset_t BinaryEventlogReader::getCurrentFileSize()
+{
+    struct opp_stat_t s;
+    if (opp_fstat(fileno(f), &s) != 0)
+        throw opp_runtime_error("Cannot stat binary eventlog file '%s'", fileName.c_str());
+    return s.st_size;
+}
+
+const std::string& BinaryEventlogReader::getString(uint64_t id)
+{
+    if (id == 0 || id >= strings.size())
+        throw opp_runtime_error("Corrupt binary eventlog file '%s': undefined string %" PRIu64 " at offset %" PRId64, fileName.c_str(), id, (int64_t)tell());
+    return strings[id];
+}
+
+void BinaryEventlogReader::addLayout(int codeId, std::vector<std::pair<int, char>>& fields)
+{
+    Layout layout;
+    layout.codeId = codeId;
+    layout.fields.swap(fields);
+    layout.isEventEntry = getString(codeId) == "E";
+    layouts.push_back(layout);
+}
+
+void BinaryEventlogReader::readLayout(bool define)
+{
+    int codeId = readVarint();
+    int numFields = readVarint();
+    std::vector<std::pair<int, char>> fields(numFields);
+    for (int i = 0; i < numFields; i++) {
+        fields[i].first = readVarint();
+        fields[i].second = (char)readByte();
+    }
+    if (define)
+        addLayout(codeId, fields);
+}
+
+void BinaryEventlogReader::readFooter()
+{
+    if (readByte() != 'F')
+        return;
+    std::string s;
+    uint64_t numStrings = readVarint();
+    for (uint64_t i = 0; i < numStrings; i++) {
+        readBytes(s, readVarint());
+        strings.push_back(s);
+    }
+    uint64_t numLayouts = readVarint();
+    for (uint64_t i = 0; i < numLayouts; i++)
+        readLayout(true);
+    uint64_t numIndexPoints = readVarint();
+    IndexPoint point {0, 0, 0, 0};
+    for (uint64_t i = 0; i < numIndexPoints; i++) {
+        point.eventNumber += readSignedVarint();
+        point.simtimeRaw += readSignedVarint();
+        point.offset += readVarint();
+        point.textOffset += readVarint();
+        indexPoints.push_back(point);
+    }
+    textSize = readVarint();
+    hasFooter = true;
+}
+
+void BinaryEventlogReader::scanIndex()
+{
+    if (hasFooter)
+        return;
+    dataEndOffset = fileSize = getCurrentFileSize();
+    seekTo(scannedOffset);
+    textOffset = scannedTextOffset;
+    std::string line;
+    while (true) {
+        file_offset_t offset = tell();
+        file_offset_t lineTextOffset = textOffset;
+        if (!readLine(line))
+            break;
+        // the same points as BinaryEventlogWriter::addIndexPoint() would add: at the empty line directly preceding an event
+        if (line.size() == 1) {
+            emptyLineOffset = offset;
+            emptyLineTextOffset = lineTextOffset;
+        }
+        else {
+            if (line[0] == 'E' && line[1] == ' ' && emptyLineOffset != -1 && lastEventNumber != -1 &&
+                (indexPoints.empty() || emptyLineOffset - indexPoints.back().offset >= 64 * 1024))
+                indexPoints.push_back(IndexPoint{lastEventNumber, lastSimtimeRaw, emptyLineOffset, emptyLineTextOffset});
+            emptyLineOffset = -1;
+        }
+    }
+    scannedOffset = tell();
+    scannedTextOffset = textOffset;
+}
+
+file_offset_t BinaryEventlogReader::getTextSize()
+{
+    if (hasFooter)
+        return textSize;
+    if (scannedOffset == dataBeginOffset || getCurrentFileSize() != fileSize)
+        scanIndex();
+    return scannedTextOffset;
+}
+
+bool BinaryEventlogReader::isOverwritten()
+{
+    file_offset_t currentFileSize = getCurrentFileSize();
+    return hasFooter ? currentFileSize != fileSize : currentFileSize < fileSize;
+}
+
+void BinaryEventlogReader::seekToIndexPoint(const IndexPoint& point)
+{
+    seekTo(point.offset);
+    textOffset = point.textOffset;
+}
+
+void BinaryEventlogReader::seekToBeginning()
+{
+    seekTo(dataBeginOffset);
+    textOffset = 0;
+}
+
+void BinaryEventlogReader::seekToEvent(int64_t eventNumber)
+{
+    auto it = std::upper_bound(indexPoints.begin(), indexPoints.end(), eventNumber, [] (int64_t e, const IndexPoint& point) {return e < point.eventNumber;});
+    if (it == indexPoints.begin())
+        seekToBeginning();
+    else
+        seekToIndexPoint(*(it - 1));
+}
+
+void BinaryEventlogReader::seekToSimulationTime(int64_t simtimeRaw)
+{
+    // find the last point strictly before the given time, because events with the same time may precede later points
+    auto it = std::lower_bound(indexPoints.begin(), indexPoints.end(), simtimeRaw, [] (const IndexPoint& point, int64_t t) {return point.simtimeRaw < t;});
+    if (it == indexPoints.begin())
+        seekToBeginning();
+    else
+        seekToIndexPoint(*(it - 1));
+}
+
+void BinaryEventlogReader::seekToTextOffset(file_offset_t offset)
+{
+    auto it = std::upper_bound(indexPoints.begin(), indexPoints.end(), offset, [] (file_offset_t o, const IndexPoint& point) {return o < point.textOffset;});
+    file_offset_t pointTextOffset = it == indexPoints.begin() ? 0 : (it - 1)->textOffset;
+    if (pointTextOffset <= textOffset && textOffset <= offset)
+        return;  // continuing from the current position is not slower
+    if (it == indexPoints.begin())
+        seekToBeginning();
+    else
+        seekToIndexPoint(*(it - 1));
+}
+
+void BinaryEventlogReader::appendStringValue(std::string& line)
+{
+    uint64_t v = readVarint();
+    if (v == 0)
+        line.append("\"\"");
+    else if (v & 1) {
+        const std::string& s = getString(v >> 1);
+        line.append(opp_needsquotes(s.c_str()) ? opp_quotestr(s) : s);
+    }
+    else {
+        std::string s;
+        readBytes(s, (v >> 1) - 1);
+        line.append(opp_needsquotes(s.c_str()) ? opp_quotestr(s) : s);
+    }
+}
+
+bool BinaryEventlogReader::readRecord(std::string& line, file_offset_t recordOffset)
+{
+    std::string s;
+    int tag = readByte();
+    switch (tag) {
+        case 'S':
+            readBytes(s, readVarint());
+            if (recordOffset >= definitionsEndOffset) {  // otherwise already known from the footer or from an earlier pass
+                strings.push_back(s);
+                definitionsEndOffset = tell();
+            }
+            break;
+
+        case 'D': {
+            bool define = recordOffset >= definitionsEndOffset;
+            readLayout(define);
+            if (define)
+                definitionsEndOffset = tell();
+            break;
+        }
+
+        case 'N':
+            line = "\n";
+            break;
+
+        case 'L':
+            readBytes(s, readVarint());
+            line.append("- ").append(s).append("\n");
+            break;
+
+        case 'X':
+            readBytes(s, readVarint());
+            line.append(s).append("\n");
+            break;
+
+        case 'R': {
+            uint64_t layoutId = readVarint();
+            if (layoutId >= layouts.size())
+                throw opp_runtime_error("Corrupt binary eventlog file '%s': undefined layout at offset %" PRId64, fileName.c_str(), (int64_t)tell());
+            const Layout& layout = layouts[layoutId];
+            line.append(getString(layout.codeId));
+            char buf[64], *endp;
+            for (auto& field : layout.fields) {
+                const std::string& key = getString(field.first);
+                line.append(" ").append(key).append(" ");
+                switch (field.second) {
+                    case BinaryEventlogWriter::FIELD_INT: {
+                        int64_t value = readSignedVarint();
+                        snprintf(buf, sizeof(buf), "%" PRId64, value);
+                        line.append(buf);
+                        if (layout.isEventEntry && key == "#")
+                            lastEventNumber = value;
+                        else if (layout.isEventEntry && key == "t" && simtimeScaleExp <= 0 && simtimeScaleExp >= -18)
+                            lastSimtimeRaw = value * powersOfTen[-simtimeScaleExp];  // integer times of converted text files, see encodeTextEntry()
+                        break;
+                    }
+                    case BinaryEventlogWriter::FIELD_SIMTIME: {
+                        int64_t value = readSignedVarint();
+                        line.append(opp_ttoa(buf, value, simtimeScaleExp, endp));
+                        if (layout.isEventEntry && key == "t")
+                            lastSimtimeRaw = value;
+                        break;
+                    }
+                    case BinaryEventlogWriter::FIELD_STRING: case BinaryEventlogWriter::FIELD_TEXT:
+                        appendStringValue(line);
+                        break;
+                    default:
+                        throw opp_runtime_error("Corrupt binary eventlog file '%s': unknown field type at offset %" PRId64, fileName.c_str(), (int64_t)tell());
+                }
+            }
+            line.append("\n");
+            break;
+        }
+
+        case 'F':
+            if (hasFooter)
+                throw opp_runtime_error("Corrupt binary eventlog file '%s': unexpected footer at offset %" PRId64, fileName.c_str(), (int64_t)recordOffset);
+            // the writer has finished since the file was opened
+            dataEndOffset = recordOffset;
+            return false;
+
+        default:
+            throw opp_runtime_error("Corrupt binary eventlog file '%s': unknown record type at offset %" PRId64, fileName.c_str(), (int64_t)recordOffset);
+    }
+    return true;
+}
+
+bool BinaryEventlogReader::readLine(std::string& line)
+{
+    line.clear();
+    while (tell() < dataEndOffset) {
+        file_offset_t recordOffset = tell();
+        try {
+            if (!readRecord(line, recordOffset)) {
+                seekTo(recordOffset);
+                return false;
+            }
+        }
+        catch (opp_runtime_error& e) {
+            // the last record of a file without a footer may be incomplete, because it is still being written
+            if (hasFooter || !feof(f))
+                throw;
+            seekTo(recordOffset);
+            line.clear();
+            return false;
+        }
+        if (!line.empty()) {
+            textOffset += line.size();
+            return true;
+        }
+    }
+    return false;
+}
+
+//----
+
+BinaryEventlogDecoder::BinaryEventlogDecoder(const char *fileName) : fileName(fileName)
+{
+    reader = new BinaryEventlogReader(fileName);
+}
+
+BinaryEventlogDecoder::~BinaryEventlogDecoder()
+{
+    delete reader;
+}
+
+void BinaryEventlogDecoder::setupFileReader(FileReader *fileReader)
+{
+    const char *fileName = fileReader->getFileName();
+    if (BinaryEventlogReader::isBinaryEventlogFile(fileName))
+        fileReader->setContentDecoder(new BinaryEventlogDecoder(fileName));
+}
+
+int64_t BinaryEventlogDecoder::getDecodedSize()
+{
+    if (reader->isOverwritten()) {
+        BinaryEventlogReader *newReader = new BinaryEventlogReader(fileName.c_str());
+        delete reader;
+        reader = newReader;
+        line.clear();
+        lineOffset = 0;
+    }
+    return reader->getTextSize();
+}
+
+size_t BinaryEventlogDecoder::readDecoded(file_offset_t offset, char *buffer, size_t length)
+{
+    size_t count = 0;
+    while (count < length) {
+        // decode up to the line that contains offset, unless it is the last decoded one
+        if (offset < lineOffset || offset >= lineOffset + (file_offset_t)line.size()) {
+            reader->seekToTextOffset(offset);
+            do {
+                lineOffset = reader->getTextOffset();
+                if (!reader->readLine(line)) {
+                    line.clear();
+                    return count;
+                }
+            } while (offset >= lineOffset + (file_offset_t)line.size());
+        }
+        size_t n = std::min(length - count, (size_t)(lineOffset + line.size() - offset));
+        memcpy(buffer + count, line.data() + (offset - lineOffset), n);
+        count += n;
+        offset += n;
+    }
+    return count;
+}
+
+}  // namespace common
+}  // namespace omnetpp
@@ -0,0 +1,399 @@
+//==========================================================================
+//  BINARYEVENTLOG.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_BINARYEVENTLOG_H
+#define __OMNETPP_COMMON_BINARYEVENTLOG_H
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include "commondefs.h"
+#include "filereader.h"
+#include "omnetpp/platdep/platmisc.h"  // file_offset_t
+
+namespace omnetpp {
+namespace common {
+
+class LineTokenizer;
+
+#define BINARY_EVENTLOG_MAGIC          "OMNETPP-BINARY-EVENTLOG 1\n"
+#define BINARY_EVENTLOG_TRAILER_MAGIC  "OPPELIDX"
+
+/*
+ * Binary eventlog file format. The binary format carries exactly the same
+ * information as the text format (see eventlogentries.txt), and decoding
+ * a binary file reproduces the text eventlog line by line.
+ *
+ * The file starts with BINARY_EVENTLOG_MAGIC and the simulation time scale
+ * exponent, followed by a sequence of records. All integers are LEB128
+ * varints, signed ones are zigzag-encoded. Records start with a one-byte tag:
+ *  - 'S' length bytes: string definition; string IDs are assigned sequentially from 1
+ *  - 'D' codeStringId numFields (keyStringId type)*: entry layout definition;
+ *        layout IDs are assigned sequentially from 0, type is one of the
+ *        FieldType characters
+ *  - 'R' layoutId value*: an eventlog entry line (see below for the values)
+ *  - 'N': an empty line
+ *  - 'L' length bytes: a log line, without the leading "- " and the newline
+ *  - 'X' length bytes: a verbatim text line without the newline
+ *
+ * Field values in 'R' records are encoded according to the layout: FIELD_INT
+ * and FIELD_SIMTIME values (the latter as raw simtime) as signed varints;
+ * FIELD_STRING and FIELD_TEXT values as a varint v followed by optional
+ * bytes, where v=0 means nullptr, odd v refers to string ID v/2, and even v
+ * means the string follows inline with length v/2-1.
+ *
+ * Definitions always precede the entry that first uses them, so a file can
+ * be decoded sequentially even if the writer did not finish. When the writer
+ * is closed properly, a footer is appended which repeats all string and
+ * layout definitions, and contains a sparse index of (event number, raw
+ * simulation time, file offset, text offset) points; this allows readers to
+ * start decoding at any indexed event. Footer layout: 'F' numStrings (length
+ * bytes)* numLayouts (layout)* numIndexPoints (eventNumberDelta simtimeDelta
+ * offsetDelta textOffsetDelta)* textSize, followed by the 8-byte
+ * little-endian file offset of the 'F' tag and BINARY_EVENTLOG_TRAILER_MAGIC.
+ *
+ * All offsets seen by eventlog readers are offsets in the decoded text, i.e.
+ * the file offsets stored in snapshot ('S') and index ('I') entries, and the
+ * text offsets of the index points. The writer keeps track of the size of the
+ * decoded text, so no translation is needed when reading.
+ */
+
+/**
+ * Writes binary eventlog files. Simulation-side code (the generated
+ * EventLogWriter functions) writes typed entries via beginEntry(),
+ * write...() and endEntry(); conversion tools may use writeTextLine()
+ * to encode text eventlog lines.
+ *
+ * All functions throw class opp_runtime_error on error.
+ */
+class COMMON_API BinaryEventlogWriter
+{
+  public:
+    enum FieldType {
+        FIELD_INT = 'i',     // all integer and bool fields
+        FIELD_SIMTIME = 't', // raw simulation time
+        FIELD_STRING = 's',  // strings which are likely to repeat, interned
+        FIELD_TEXT = 'x'     // strings which are not worth interning, always stored inline
+    };
+
+    struct FieldDescriptor {
+        const char *code;
+        FieldType type;
+    };
+
+    /**
+     * Describes an entry type with all its fields (optional ones included).
+     * Instances are expected to be static; they are identified by address.
+     */
+    struct EntryDescriptor {
+        const char *code;
+        int numFields;
+        const FieldDescriptor *fields;
+    };
+
+    struct IndexPoint {
+        int64_t eventNumber;
+        int64_t simtimeRaw;
+        file_offset_t offset;      // of the empty line preceding the event
+        file_offset_t textOffset;  // the same in the decoded text
+    };
+
+  private:
+    struct LayoutKeyHash {
+        size_t operator()(const std::pair<const void *, uint64_t>& key) const {
+            return std::hash<const void *>()(key.first) ^ std::hash<uint64_t>()(key.second * 0x9E3779B97F4A7C15ULL);
+        }
+    };
+
+    FILE *f;
+    std::string fileName;
+    int simtimeScaleExp;
+    file_offset_t fileOffset;  // the current end of the file
+    file_offset_t textOffset = 0;  // the current end of the equivalent text file
+    LineTokenizer *tokenizer = nullptr;  // for writeTextLine()
+
+    std::string definitions;  // definition records preceding the current entry
+    std::string entry;        // the entry record being built
+
+    std::deque<std::string> strings;  // in ID order, starting with ID 1
+    std::vector<int> stringTextSizes; // decoded (possibly quoted) length of the strings as values, -1 if not yet computed
+    std::unordered_map<std::string_view, int> stringIds;
+    size_t maxStrings = 1 << 20;
+
+    int numLayouts = 0;
+    std::unordered_map<std::pair<const void *, uint64_t>, int, LayoutKeyHash> layoutIds;  // by (descriptor, present fields)
+    std::map<std::string, int> textLayoutIds;  // layouts created by writeTextLine(), keyed by code and field keys/types
+    std::string layoutDefinitions;  // the bodies of all 'D' records, repeated in the footer
+    std::vector<int> layoutTextSizes; // decoded length of the code and the keys of each layout, including the spaces and the newline
+
+    std::vector<IndexPoint> indexPoints;
+    file_offset_t indexInterval = 64 * 1024;
+    file_offset_t lastEmptyLineOffset = -1;
+    file_offset_t lastEmptyLineTextOffset = -1;
+
+    std::map<file_offset_t, file_offset_t> inputToTextOffsets;  // of snapshot and index entries seen by writeTextLine()
+
+  private:
+    static void appendVarint(std::string& buffer, uint64_t value);
+    static void appendSignedVarint(std::string& buffer, int64_t value) {appendVarint(buffer, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));}
+    void writeBuffer(const std::string& buffer);
+    void flushEntry();
+    int internString(const char *s, size_t length);
+    int defineLayout(const char *code, const std::vector<std::pair<std::string, char>>& fields);
+    void addLayoutReference(int layoutId);
+    bool encodeTextEntry(const char *line, int length);
+    static int getIntTextSize(int64_t value);
+
+  public:
+    /**
+     * Writes the file header into the given file which must be open for
+     * binary write. The file is not closed by this object.
+     */
+    BinaryEventlogWriter(FILE *f, const char *fileName, int simtimeScaleExp);
+    ~BinaryEventlogWriter();
+
+    int getSimtimeScaleExp() const {return simtimeScaleExp;}
+
+    /**
+     * Returns the size of the equivalent text eventlog written so far, i.e.
+     * the offset of the next line in the decoded text. File offsets recorded
+     * in snapshot and index entries must be text offsets.
+     */
+    file_offset_t getTextOffset() const {return textOffset;}
+
+    /**
+     * Sets the approximate distance in bytes between subsequent index points
+     * in the footer index.
+     */
+    void setIndexInterval(file_offset_t indexInterval) {this->indexInterval = indexInterval;}
+
+    /**
+     * Strings are interned until the string table reaches this size, and
+     * stored inline afterwards.
+     */
+    void setMaxStrings(size_t maxStrings) {this->maxStrings = maxStrings;}
+
+    /**
+     * Starts an entry. The bits of presentFields tell which fields of the
+     * descriptor follow; the values of those fields must be written with the
+     * write...() functions in field order, then the entry must be closed
+     * with endEntry().
+     */
+    void beginEntry(const EntryDescriptor *descriptor, uint64_t presentFields);
+    void writeInt(int64_t value) {appendSignedVarint(entry, value); textOffset += getIntTextSize(value);}
+    void writeSimtime(int64_t rawValue);
+    void writeString(const char *value);
+    void writeText(const char *value);
+    void endEntry() {flushEntry();}
+
+    void writeEmptyLine();
+    void writeLogLine(const char *prefix, const char *line, int lineLength);
+
+    /**
+     * Records an index point for the event whose entry follows the last
+     * empty line, provided enough data was written since the previous one.
+     */
+    void addIndexPoint(int64_t eventNumber, int64_t simtimeRaw);
+
+    /**
+     * Encodes a line of a text eventlog file (with or without the trailing
+     * newline). Lines that cannot be reproduced exactly from a typed encoding
+     * are stored verbatim. File offsets in snapshot and index entries are
+     * converted to offsets in the decoded text, which differ from the input
+     * if it has CR/LF line ends.
+     */
+    void writeTextLine(const char *line, int length);
+
+    /**
+     * Appends the footer with the string table, the layouts and the index.
+     */
+    void writeFooter();
+};
+
+/**
+ * Decodes binary eventlog files into text eventlog lines. Text offsets, i.e.
+ * offsets of the decoded lines in the equivalent text eventlog file, are
+ * maintained across seeks.
+ *
+ * Files without a footer (the simulation is still running, or it crashed)
+ * can be read sequentially; an incomplete record at the end of such a file
+ * is treated as the end of the data. Seeking in them is possible after
+ * scanIndex() has built the index points in memory.
+ *
+ * All functions throw class opp_runtime_error on error.
+ */
+class COMMON_API BinaryEventlogReader
+{
+  public:
+    typedef BinaryEventlogWriter::IndexPoint IndexPoint;
+
+  private:
+    struct Layout {
+        int codeId;
+        std::vector<std::pair<int, char>> fields;  // key string ID and FieldType
+        bool isEventEntry = false;
+    };
+
+    std::string fileName;
+    FILE *f = nullptr;
+    int simtimeScaleExp = 0;
+
+    std::vector<char> buffer;
+    size_t bufferPos = 0;
+    size_t bufferEnd = 0;
+    file_offset_t bufferFileOffset = 0;
+    file_offset_t dataBeginOffset = 0;
+    file_offset_t dataEndOffset = 0;  // start of the footer, or the file size if there is no footer
+    file_offset_t fileSize = 0;       // when last checked
+
+    bool hasFooter = false;
+    std::vector<std::string> strings;  // indexed by ID, strings[0] is unused
+    std::vector<Layout> layouts;
+    std::vector<IndexPoint> indexPoints;
+    file_offset_t textSize = -1;                // of the whole decoded text, stored in the footer
+    file_offset_t definitionsEndOffset = 0;     // string and layout definitions before this offset are already known
+
+    file_offset_t textOffset = 0;     // offset of the next decoded line in the decoded text
+    int64_t lastEventNumber = -1;     // of the last decoded event entry
+    int64_t lastSimtimeRaw = -1;
+
+    // state of scanIndex()
+    file_offset_t scannedOffset = -1;
+    file_offset_t scannedTextOffset = 0;
+    file_offset_t emptyLineOffset = -1;
+    file_offset_t emptyLineTextOffset = -1;
+
+  private:
+    void seekTo(file_offset_t offset);
+    bool fillBuffer();
+    int readByte();
+    uint64_t readVarint();
+    int64_t readSignedVarint() {uint64_t v = readVarint(); return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);}
+    void readBytes(std::string& result, size_t length);
+    file_offset_t tell() const {return bufferFileOffset + bufferPos;}
+    file_offset_t getCurrentFileSize();
+    void readFooter();
+    void readLayout(bool define);
+    void addLayout(int codeId, std::vector<std::pair<int, char>>& fields);
+    const std::string& getString(uint64_t id);
+    void appendStringValue(std::string& line);
+    void seekToIndexPoint(const IndexPoint& point);
+    bool readRecord(std::string& line, file_offset_t recordOffset);
+
+  public:
+    BinaryEventlogReader(const char *fileName);
+    ~BinaryEventlogReader();
+
+    /**
+     * Returns true if the file starts with the binary eventlog magic.
+     */
+    static bool isBinaryEventlogFile(const char *fileName);
+
+    int getSimtimeScaleExp() const {return simtimeScaleExp;}
+
+    /**
+     * Returns true if the file has a footer, i.e. the index points are
+     * available without scanning the file.
+     */
+    bool hasIndex() const {return hasFooter;}
+    const std::vector<IndexPoint>& getIndexPoints() const {return indexPoints;}
+
+    /**
+     * For files without a footer: decodes the file from where the previous
+     * call stopped up to its current end, and adds index points the same way
+     * as the writer would. Moves the current position to the end of the
+     * scanned data. No-op for files with a footer.
+     */
+    void scanIndex();
+
+    /**
+     * Returns the size of the decoded text. For files without a footer, the
+     * part of the file appended since the last call is scanned first.
+     */
+    file_offset_t getTextSize();
+
+    /**
+     * Returns true if the file has become shorter than it was when last
+     * checked, or it has changed although it has a footer. The reader cannot
+     * be used in this case, and must be reopened.
+     */
+    bool isOverwritten();
+
+    /**
+     * Positions the reader to the last index point at or before the given
+     * event number or raw simulation time (or to the beginning of the file).
+     * Decoding continues with the empty line preceding that event.
+     */
+    void seekToEvent(int64_t eventNumber);
+    void seekToSimulationTime(int64_t simtimeRaw);
+    void seekToBeginning();
+
+    /**
+     * Positions the reader to a line at or before the given offset of the
+     * decoded text: to the nearest index point, or to the current position if
+     * that is not farther. Use getTextOffset() to learn where decoding
+     * continues.
+     */
+    void seekToTextOffset(file_offset_t offset);
+
+    /**
+     * Returns the offset of the next decoded line in the decoded text.
+     */
+    file_offset_t getTextOffset() const {return textOffset;}
+
+    /**
+     * Decodes the next line, including the trailing newline. Returns false
+     * at the end of the data.
+     */
+    bool readLine(std::string& line);
+};
+
+/**
+ * Lets FileReader read a binary eventlog file as the equivalent text eventlog
+ * file. File offsets and the file size seen via FileReader are those of the
+ * decoded text, which is generated on demand starting from the nearest index
+ * point; nothing is written to the disk.
+ */
+class COMMON_API BinaryEventlogDecoder : public IFileContentDecoder
+{
+  private:
+    std::string fileName;
+    BinaryEventlogReader *reader;
+    std::string line;              // the last decoded line
+    file_offset_t lineOffset = 0;  // its offset in the decoded text
+
+  public:
+    BinaryEventlogDecoder(const char *fileName);
+    virtual ~BinaryEventlogDecoder();
+
+    /**
+     * Installs a decoder into the reader if its file is a binary eventlog
+     * file. Must be called before the reader opens the file.
+     */
+    static void setupFileReader(FileReader *reader);
+
+    virtual int64_t getDecodedSize() override;
+    virtual size_t readDecoded(file_offset_t offset, char *buffer, size_t length) override;
+};
+
+}  // namespace common
+}  // namespace omnetpp
+
+
+#endif
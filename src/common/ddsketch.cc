@@ -0,0 +1,242 @@
+//=========================================================================
+//  DDSKETCH.CC - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+#include "ddsketch.h"
+#include "exception.h"
+
+namespace omnetpp {
+namespace common {
+
+void DDSketch::Store::clear()
+{
+    counts.clear();
+    offset = 0;
+    minIndex = INT_MAX;
+    maxIndex = INT_MIN;
+    totalWeight = 0;
+}
+
+void DDSketch::Store::extendRange(int lo, int hi)
+{
+    int size = counts.size();
+    if (lo >= offset && hi < offset + size)
+        return;
+
+    // reallocate with some slack on both sides, so that growing is O(1) amortized
+    if (!isEmpty()) {
+        lo = std::min(lo, minIndex);
+        hi = std::max(hi, maxIndex);
+    }
+    int margin = std::max(16, (hi - lo) / 4);
+    int newOffset = lo - margin;
+    std::vector<double> newCounts(hi - lo + 1 + 2*margin, 0.0);
+    if (!isEmpty()) {
+        int from = std::max(minIndex, offset), to = std::min(maxIndex, offset + size - 1);
+        for (int i = from; i <= to; i++)
+            newCounts[i - newOffset] = counts[i - offset];
+    }
+    counts.swap(newCounts);
+    offset = newOffset;
+}
+
+void DDSketch::Store::collapseBelow(int newMinIndex)
+{
+    if (newMinIndex <= minIndex)
+        return;
+    double sum = 0;
+    int to = std::min(maxIndex, newMinIndex - 1);
+    for (int i = minIndex; i <= to; i++) {
+        sum += counts[i - offset];
+        counts[i - offset] = 0;
+    }
+    minIndex = newMinIndex;
+    maxIndex = std::max(maxIndex, newMinIndex);
+    extendRange(minIndex, maxIndex);
+    counts[newMinIndex - offset] += sum;
+}
+
+void DDSketch::Store::add(int index, double weight, int maxBuckets)
+{
+    if (isEmpty()) {
+        extendRange(index, index);
+        minIndex = maxIndex = index;
+    }
+    else if (index < minIndex) {
+        // values that would not fit are counted in the lowest bucket
+        index = std::max(index, maxIndex - maxBuckets + 1);
+        if (index < minIndex) {
+            extendRange(index, maxIndex);
+            minIndex = index;
+        }
+    }
+    else if (index > maxIndex) {
+        if (index - minIndex >= maxBuckets)
+            collapseBelow(index - maxBuckets + 1);
+        extendRange(minIndex, index);
+        maxIndex = index;
+    }
+    counts[index - offset] += weight;
+    totalWeight += weight;
+}
+
+DDSketch::DDSketch(double relativeAccuracy, int maxBuckets) : relativeAccuracy(relativeAccuracy), maxBuckets(maxBuckets)
+{
+    if (!(relativeAccuracy > 0 && relativeAccuracy < 1))
+        throw opp_runtime_error("DDSketch: Relative accuracy must be in the (0,1) interval, %g given", relativeAccuracy);
+    if (maxBuckets < 1)
+        throw opp_runtime_error("DDSketch: Maximum number of buckets must be positive, %d given", maxBuckets);
+    gamma = (1 + relativeAccuracy) / (1 - relativeAccuracy);
+    multiplier = 1 / std::log(gamma);
+    minIndexableValue = DBL_MIN * gamma;
+}
+
+void DDSketch::clear()
+{
+    positive.clear();
+    negative.clear();
+    zeroWeight = 0;
+}
+
+int DDSketch::getIndex(double value) const
+{
+    return (int)std::floor(std::log(value) * multiplier);
+}
+
+double DDSketch::getLowerBound(int index) const
+{
+    return std::exp(index / multiplier);
+}
+
+double DDSketch::getQuantileValue(int index) const
+{
+    // the value with the same relative distance from both bucket bounds
+    return getLowerBound(index) * (1 + relativeAccuracy);
+}
+
+void DDSketch::add(double value, double weight)
+{
+    if (!std::isfinite(value))
+        throw opp_runtime_error("DDSketch: Cannot add non-finite value %g", value);
+    if (value >= minIndexableValue)
+        addToStore(positive, getIndex(value), weight);
+    else if (value <= -minIndexableValue)
+        addToStore(negative, getIndex(-value), weight);
+    else
+        zeroWeight += weight;
+}
+
+void DDSketch::merge(const DDSketch& other)
+{
+    if (other.relativeAccuracy != relativeAccuracy)
+        throw opp_runtime_error("DDSketch: Cannot merge sketches with different relative accuracies (%g and %g)", relativeAccuracy, other.relativeAccuracy);
+    for (int i = other.positive.minIndex; i <= other.positive.maxIndex; i++)
+        if (other.positive.get(i) != 0)
+            addToStore(positive, i, other.positive.get(i));
+    for (int i = other.negative.maxIndex; i >= other.negative.minIndex; i--)
+        if (other.negative.get(i) != 0)
+            addToStore(negative, i, other.negative.get(i));
+    zeroWeight += other.zeroWeight;
+}
+
+double DDSketch::getQuantile(double q) const
+{
+    if (q < 0 || q > 1)
+        throw opp_runtime_error("DDSketch: Quantile must be in the [0,1] interval, %g given", q);
+    double totalWeight = getTotalWeight();
+    if (totalWeight == 0)
+        return NAN;
+
+    // walk the buckets in increasing order of value
+    double rank = q * totalWeight;
+    double cumWeight = 0;
+    for (int i = negative.maxIndex; i >= negative.minIndex; i--) {
+        cumWeight += negative.get(i);
+        if (cumWeight > rank)
+            return -getQuantileValue(i);
+    }
+    cumWeight += zeroWeight;
+    if (cumWeight > rank || positive.isEmpty())
+        return 0;
+    for (int i = positive.minIndex; i <= positive.maxIndex; i++) {
+        cumWeight += positive.get(i);
+        if (cumWeight > rank)
+            return getQuantileValue(i);
+    }
+    return getQuantileValue(positive.maxIndex);
+}
+
+void DDSketch::getBins(std::vector<double>& edges, std::vector<double>& values) const
+{
+    edges.clear();
+    values.clear();
+    if (isEmpty())
+        return;
+
+    bool hasNegative = !negative.isEmpty(), hasPositive = !positive.isEmpty();
+    if (hasNegative) {
+        edges.push_back(-getLowerBound(negative.maxIndex + 1));
+        for (int i = negative.maxIndex; i >= negative.minIndex; i--) {
+            edges.push_back(-getLowerBound(i));
+            values.push_back(negative.get(i));
+        }
+    }
+    if (zeroWeight != 0 || (hasNegative && hasPositive)) {
+        if (!hasNegative)
+            edges.push_back(-minIndexableValue);
+        edges.push_back(hasPositive ? getLowerBound(positive.minIndex) : minIndexableValue);
+        values.push_back(zeroWeight);
+    }
+    if (hasPositive) {
+        if (edges.empty())
+            edges.push_back(getLowerBound(positive.minIndex));
+        for (int i = positive.minIndex; i <= positive.maxIndex; i++) {
+            edges.push_back(getLowerBound(i + 1));
+            values.push_back(positive.get(i));
+        }
+    }
+}
+
+void DDSketch::addBins(const std::vector<double>& edges, const std::vector<double>& values)
+{
+    if (values.empty())
+        return;
+    if (edges.size() != values.size() + 1)
+        throw opp_runtime_error("DDSketch: Inconsistent histogram, number of bin edges must be one more than number of bins");
+
+    auto bucketIndex = [this](double bound) {
+        double exactIndex = std::log(bound) * multiplier;
+        double index = std::round(exactIndex);
+        if (std::fabs(exactIndex - index) > 0.01)  // tolerate edges printed with limited precision
+            throw opp_runtime_error("DDSketch: Histogram bin edge %g does not match the buckets of a sketch with relative accuracy %g", bound, relativeAccuracy);
+        return (int)index;
+    };
+
+    for (size_t k = 0; k < values.size(); k++) {
+        double lo = edges[k], hi = edges[k+1], value = values[k];
+        if (value == 0)
+            continue;
+        if (hi <= 0)
+            addToStore(negative, bucketIndex(-hi), value);
+        else if (lo >= 0)
+            addToStore(positive, bucketIndex(lo), value);
+        else
+            zeroWeight += value;
+    }
+}
+
+}  // namespace common
+}  // namespace omnetpp
@@ -0,0 +1,131 @@
+//=========================================================================
+//  DDSKETCH.H - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_COMMON_DDSKETCH_H
+#define __OMNETPP_COMMON_DDSKETCH_H
+
+#include <vector>
+#include <climits>
+#include "commondefs.h"
+
+namespace omnetpp {
+namespace common {
+
+/**
+ * Mergeable quantile sketch with relative-error guarantees (DDSketch).
+ *
+ * Values are counted in logarithmically sized buckets: bucket i covers
+ * [gamma^i, gamma^(i+1)) for positive values (and the mirror image for
+ * negative ones), where gamma = (1+alpha)/(1-alpha) for the relative
+ * accuracy alpha. Any quantile is then estimated with a relative error of
+ * at most alpha. Values closer to zero than getMinIndexableValue() are
+ * counted in a separate zero bucket.
+ *
+ * Adding a value is O(1) amortized. The number of buckets per sign is
+ * bounded by maxBuckets; when exceeded, the buckets closest to zero are
+ * collapsed, keeping the accuracy guarantee for the larger magnitudes.
+ *
+ * Two sketches with the same relative accuracy can be merged losslessly,
+ * i.e. the result is the same as if all values had been added to one sketch
+ * (unless collapsing occurs). The buckets can also be converted to and from
+ * histogram bins, which is how sketches are stored in result files.
+ *
+ * Source: Charles Masson, Jee E. Rim, Homin K. Lee: DDSketch: A Fast and
+ * Fully-Mergeable Quantile Sketch with Relative-Error Guarantees. VLDB 2019.
+ */
+class COMMON_API DDSketch
+{
+    protected:
+        // dense bucket store for one sign; counts[k] belongs to bucket offset+k
+        struct Store {
+            std::vector<double> counts;
+            int offset = 0;
+            int minIndex = INT_MAX, maxIndex = INT_MIN; // range of nonempty buckets
+            double totalWeight = 0;
+
+            bool isEmpty() const {return minIndex > maxIndex;}
+            double get(int index) const {return counts[index - offset];}
+            void add(int index, double weight, int maxBuckets);
+            void clear();
+          private:
+            void extendRange(int lo, int hi);
+            void collapseBelow(int newMinIndex);
+        };
+
+        double relativeAccuracy;
+        int maxBuckets;
+        double gamma;
+        double multiplier;  // 1/log(gamma)
+        double minIndexableValue;
+        Store positive, negative;
+        double zeroWeight = 0;
+
+    protected:
+        double getQuantileValue(int index) const; // representative value of bucket
+        void addToStore(Store& store, int index, double weight) {store.add(index, weight, maxBuckets);}
+
+    public:
+        DDSketch(double relativeAccuracy=0.01, int maxBuckets=2048);
+        DDSketch(const DDSketch& other) = default;
+        DDSketch& operator=(const DDSketch& other) = default;
+
+        void clear();
+        void add(double value, double weight=1);
+        void merge(const DDSketch& other);
+
+        double getRelativeAccuracy() const {return relativeAccuracy;}
+        int getMaxBuckets() const {return maxBuckets;}
+        double getGamma() const {return gamma;}
+        double getMinIndexableValue() const {return minIndexableValue;}
+        bool isEmpty() const {return getTotalWeight() == 0;}
+        double getTotalWeight() const {return positive.totalWeight + negative.totalWeight + zeroWeight;}
+
+        /**
+         * Returns the index of the bucket that contains the given positive value.
+         */
+        int getIndex(double value) const;
+
+        /**
+         * Returns the lower bound of bucket i (gamma^i).
+         */
+        double getLowerBound(int index) const;
+
+        /**
+         * Returns the estimate for the q-quantile (0 <= q <= 1),
+         * or NaN if the sketch is empty.
+         */
+        double getQuantile(double q) const;
+
+        /**
+         * Returns the buckets as histogram bins, from the most negative values
+         * to the most positive ones. Bins for empty buckets between nonempty
+         * ones are included, so the bins are contiguous. The zero bucket
+         * becomes a bin around zero.
+         */
+        void getBins(std::vector<double>& edges, std::vector<double>& values) const;
+
+        /**
+         * Adds the contents of histogram bins produced by getBins() (possibly
+         * by a sketch with a different maxBuckets but the same relative
+         * accuracy) to this sketch. Throws an error if the bins do not line up
+         * with the buckets of this sketch.
+         */
+        void addBins(const std::vector<double>& edges, const std::vector<double>& values);
+};
+
+}  // namespace common
+}  // namespace omnetpp
+
+
+#endif
@@ -18,8 +18,18 @@
 #include <cstdio>
 #include <cstdarg>
 #include <cstring>
+#include <cerrno>
 #include <cinttypes>
 #include <algorithm>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAVE_MMAP
+#endif
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define FILEREADER_USE_SSE2
+#endif
 #include "omnetpp/platdep/platmisc.h"
 #include "commonutil.h"
 #include "filereader.h"
@@ -33,6 +43,44 @@ namespace common {
 
 OPP_THREAD_LOCAL std::string FileReader::staticBuffer;
 
+// Returns a pointer to the first CR or LF in [s, end), or end if there is none.
+static inline char *findLineTerminator(char *s, char *end)
+{
+#ifdef FILEREADER_USE_SSE2
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    while (end - s >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)s);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+        if (mask != 0)
+            return s + __builtin_ctz(mask);
+        s += 16;
+    }
+#endif
+    while (s < end && *s != '\r' && *s != '\n')
+        s++;
+    return s;
+}
+
+// Returns a pointer to the last CR or LF in [begin, s], or begin-1 if there is none.
+static inline char *findPreviousLineTerminator(char *begin, char *s)
+{
+#ifdef FILEREADER_USE_SSE2
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    while (s - begin >= 15) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(s - 15));
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr)));
+        if (mask != 0)
+            return s - 15 + (31 - __builtin_clz(mask));
+        s -= 16;
+    }
+#endif
+    while (s >= begin && *s != '\r' && *s != '\n')
+        s--;
+    return s;
+}
+
 FileChangedError::FileChangedError(FileReader::FileChange change, const char *messagefmt, ...) : change(change)
 {
     char buf[1024];
@@ -42,7 +90,8 @@ FileChangedError::FileChangedError(FileReader::FileChange change, const char *me
 
 FileReader::FileReader(const char *fileName, size_t bufferSize)
    : fileName(fileName), bufferSize(bufferSize),
-     bufferBegin(new char[bufferSize]),
+     heapBuffer(new char[bufferSize]),
+     bufferBegin(heapBuffer),
      bufferEnd(bufferBegin + bufferSize),
      maxLineSize(bufferSize / 2),
      savedBufferSize(bufferSize / 1024),
@@ -77,10 +126,84 @@ FileReader::~FileReader()
 #ifdef TRACE_FILEREADER
     TRACE_CALL("FileReader::~FileReader(%s)", fileName.c_str());
 #endif
-    delete[] bufferBegin;
+    ensureFileClosed();
+    delete contentDecoder;
+    delete[] heapBuffer;
     delete[] lastSavedBufferBegin;
     delete[] newSavedBufferBegin;
-    ensureFileClosed();
+}
+
+void FileReader::setContentDecoder(IFileContentDecoder *decoder)
+{
+    if (file)
+        throw opp_runtime_error("Cannot set content decoder while file '%s' is open", fileName.c_str());
+    delete contentDecoder;
+    contentDecoder = decoder;
+}
+
+void FileReader::setMemoryMapping(bool value)
+{
+    if (file)
+        throw opp_runtime_error("Cannot change memory mapping while file '%s' is open", fileName.c_str());
+#ifdef HAVE_MMAP
+    enableMemoryMapping = value;
+#endif
+}
+
+void FileReader::setAccessPattern(AccessPattern pattern)
+{
+    accessPattern = pattern;
+    if (mapped)
+        adviseAccessPattern();
+}
+
+void FileReader::adviseAccessPattern()
+{
+#ifdef HAVE_MMAP
+    if (mappedSize > 0) {
+        int advice = accessPattern == ACCESS_SEQUENTIAL ? MADV_SEQUENTIAL : accessPattern == ACCESS_RANDOM ? MADV_RANDOM : MADV_NORMAL;
+        madvise((void *)bufferBegin, mappedSize, advice);  // only a hint, errors are ignored
+    }
+#endif
+}
+
+void FileReader::mapFile()
+{
+#ifdef HAVE_MMAP
+    Assert(file && !mapped && lastFileSize >= 0);
+    mappedSize = lastFileSize;
+    if (mappedSize == 0)
+        bufferBegin = heapBuffer;  // mmap() does not accept zero length
+    else {
+        void *mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(file), 0);
+        if (mapping == MAP_FAILED)
+            throw opp_runtime_error("Cannot map file '%s' into memory: %s", fileName.c_str(), strerror(errno));
+        bufferBegin = (char *)mapping;
+    }
+    mapped = true;
+    bufferEnd = bufferBegin + mappedSize;
+    bufferFileOffset = 0;
+    dataBegin = (char *)bufferBegin;
+    dataEnd = (char *)bufferEnd;
+    currentDataPointer = dataBegin + std::min((file_offset_t)mappedSize, unmappedCurrentOffset);
+    numReadBytes += mappedSize;
+    adviseAccessPattern();
+#endif
+}
+
+void FileReader::unmapFile()
+{
+#ifdef HAVE_MMAP
+    Assert(mapped);
+    unmappedCurrentOffset = currentDataPointer ? currentDataPointer - bufferBegin : 0;
+    if (mappedSize > 0)
+        munmap((void *)bufferBegin, mappedSize);
+    mapped = false;
+    mappedSize = 0;
+    bufferBegin = heapBuffer;
+    bufferEnd = bufferBegin + bufferSize;
+    dataBegin = dataEnd = currentDataPointer = nullptr;
+#endif
 }
 
 void FileReader::ensureFileOpenInternal()
@@ -91,25 +214,36 @@ void FileReader::ensureFileOpenInternal()
         if (!file)
             throw opp_runtime_error("Cannot open file '%s'", fileName.c_str());
         fileLock = new FileLock(file, fileName.c_str());
-        if (bufferFileOffset == -1)
+        if (enableMemoryMapping && !contentDecoder) {
+            getFileInformation(lastFileSize, lastModificationTime);
+            mapFile();
+        }
+        else if (bufferFileOffset == -1)
             seekTo(0);
     }
 }
 
-size_t FileReader::readFileEnd(file_offset_t fileSize, size_t size, const char *dataPointer)
+size_t FileReader::readFileData(file_offset_t fileOffset, char *dataPointer, size_t length)
 {
-    FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_SHARED, enableFileLocking);
     if (!file)
         throw opp_runtime_error("File is not open '%s'", fileName.c_str());
-    opp_fseek(file, std::max((file_offset_t)0, (file_offset_t)(fileSize - size)), SEEK_SET);
+    if (contentDecoder)
+        return contentDecoder->readDecoded(fileOffset, dataPointer, length);
+    opp_fseek(file, fileOffset, SEEK_SET);
     if (ferror(file))
         throw opp_runtime_error("Cannot seek in file '%s', error code %d", fileName.c_str(), ferror(file));
-    int bytesRead = fread((char *)dataPointer, 1, std::min((int64_t)size, fileSize), file);
+    size_t bytesRead = fread(dataPointer, 1, length, file);
     if (ferror(file))
         throw opp_runtime_error("Read error in file '%s', error code %d", fileName.c_str(), ferror(file));
     return bytesRead;
 }
 
+size_t FileReader::readFileEnd(file_offset_t fileSize, size_t size, const char *dataPointer)
+{
+    FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_SHARED, enableFileLocking);
+    return readFileData(std::max((file_offset_t)0, (file_offset_t)(fileSize - size)), (char *)dataPointer, std::min((int64_t)size, fileSize));
+}
+
 void FileReader::ensureFileOpen()
 {
     if (!file) {
@@ -120,6 +254,8 @@ void FileReader::ensureFileOpen()
 
 void FileReader::ensureFileClosed()
 {
+    if (mapped)
+        unmapFile();
     if (file) {
         fclose(file);
         file = nullptr;
@@ -148,7 +284,7 @@ char *FileReader::fileOffsetToPointer(file_offset_t fileOffset) const
 
 void FileReader::checkConsistency(bool checkDataPointer) const
 {
-    bool ok = (size_t)(bufferEnd - bufferBegin) == bufferSize &&
+    bool ok = (size_t)(bufferEnd - bufferBegin) == (mapped ? mappedSize : bufferSize) &&
       ((!dataBegin && !dataEnd) ||
        (dataBegin <= dataEnd && bufferBegin <= dataBegin && dataEnd <= bufferEnd &&
         (!checkDataPointer || (dataBegin <= currentDataPointer && currentDataPointer <= dataEnd))));
@@ -218,8 +354,15 @@ void FileReader::synchronize(FileChange change)
     FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_SHARED, enableFileLocking);
     getFileInformation(lastFileSize, lastModificationTime);
     lastSavedSize = readFileEnd(lastFileSize, savedBufferSize, lastSavedBufferBegin);
-    dataBegin = nullptr;
-    dataEnd = nullptr;
+    if (mapped) {
+        // the mapping must follow the file size; this keeps the current position
+        unmapFile();
+        mapFile();
+    }
+    else {
+        dataBegin = nullptr;
+        dataEnd = nullptr;
+    }
 }
 
 void FileReader::setCurrentDataPointer(char *dataPointer)
@@ -239,6 +382,15 @@ void FileReader::fillBuffer(bool forward)
     TRACE_CALL("FileReader::fillBuffer %s", forward ? "forward" : "backward");
 #endif
 
+    if (mapped) {
+        // the whole file is in memory; only look for appended data when getting close to the end
+        if (enableCheckFileForChanges && forward && currentDataPointer && (size_t)(dataEnd - currentDataPointer) < maxLineSize) {
+            FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_SHARED, enableFileLocking);
+            processFileChange(getFileChange());
+        }
+        return;
+    }
+
     char *dataPointer;
     int dataLength;
 
@@ -285,15 +437,8 @@ void FileReader::fillBuffer(bool forward)
         }
 
         file_offset_t fileOffset = pointerToFileOffset(dataPointer);
-        if (!file)
-            throw opp_runtime_error("File is not open '%s'", fileName.c_str());
-        opp_fseek(file, fileOffset, SEEK_SET);
-        if (ferror(file))
-            throw opp_runtime_error("Cannot seek in file '%s', error code %d", fileName.c_str(), ferror(file));
         dataLength = std::min((int64_t)dataLength, lastFileSize - fileOffset);
-        int bytesRead = fread(dataPointer, 1, dataLength, file);
-        if (ferror(file))
-            throw opp_runtime_error("Read error in file '%s', error code %d", fileName.c_str(), ferror(file));
+        int bytesRead = readFileData(fileOffset, dataPointer, dataLength);
         if (bytesRead != dataLength)
             throw opp_runtime_error("Cannot read %d bytes (got %d) from file '%s'", dataLength, bytesRead, fileName.c_str());
 
@@ -336,15 +481,8 @@ bool FileReader::isLineStart(char *s)
         else { // slow path
             FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_SHARED, enableFileLocking);
             file_offset_t fileOffset = pointerToFileOffset(s) - 1;
-            if (!file)
-                throw opp_runtime_error("File is not open '%s'", fileName.c_str());
-            opp_fseek(file, fileOffset, SEEK_SET);
-            if (ferror(file))
-                throw opp_runtime_error("Cannot seek in file '%s', error code %d", fileName.c_str(), ferror(file));
             char previousChar;
-            int bytesRead = fread(&previousChar, 1, 1, file);
-            if (ferror(file))
-                throw opp_runtime_error("Read error in file '%s', error code %d", fileName.c_str(), ferror(file));
+            int bytesRead = readFileData(fileOffset, &previousChar, 1);
             if (bytesRead != 1)
                 throw opp_runtime_error("Cannot read 1 bytes (got %d) from file '%s'", bytesRead, fileName.c_str());
             return previousChar == '\n';
@@ -367,8 +505,7 @@ char *FileReader::findNextLineStart(char *start, bool bufferFilled)
     char *s = start;
 
     // find next CR/LF (fast path)
-    while (s < dataEnd && *s != '\r' && *s != '\n')
-        s++;
+    s = findLineTerminator(s, dataEnd);
 
     if (s < dataEnd && *s == '\r')
         s++;
@@ -426,8 +563,7 @@ char *FileReader::findPreviousLineStart(char *start, bool bufferFilled)
         s--;
 
     // find previous CR/LF (fast path)
-    while (s >= dataBegin && *s != '\r' && *s != '\n')
-        s--;
+    s = findPreviousLineTerminator(dataBegin, s);
 
     s++;
 
@@ -620,7 +756,7 @@ void FileReader::getFileInformation(int64_t& size, time_t& lastModificationTime)
     if (opp_fstat(fileno(file), &s) != 0)
         throw opp_runtime_error("Cannot stat file '%s'", fileName.c_str());
     lastModificationTime = s.st_mtime;
-    size = s.st_size;
+    size = contentDecoder ? contentDecoder->getDecodedSize() : s.st_size;
 }
 
 void FileReader::seekTo(file_offset_t fileOffset, size_t ensureBufferSizeAround)
@@ -637,6 +773,23 @@ void FileReader::seekTo(file_offset_t fileOffset, size_t ensureBufferSizeAround)
 
     ensureFileOpen();
 
+    if (mapped) {
+        // the whole file is in memory
+        setCurrentDataPointer(fileOffsetToPointer(fileOffset));
+#ifdef HAVE_MMAP
+        if (accessPattern == ACCESS_RANDOM && mappedSize > 0) {
+            // random access turns off read-ahead, so ask for the surroundings of the target explicitly
+            static const size_t pageSize = sysconf(_SC_PAGESIZE);
+            size_t around = std::max(ensureBufferSizeAround, maxLineSize);
+            size_t begin = std::max((file_offset_t)0, fileOffset - (file_offset_t)around) / pageSize * pageSize;
+            size_t end = std::min((file_offset_t)mappedSize, fileOffset + (file_offset_t)around);
+            if (end > begin)
+                madvise((void *)(bufferBegin + begin), end - begin, MADV_WILLNEED);
+        }
+#endif
+        return;
+    }
+
     // check if requested offset is already in memory
     if (bufferFileOffset != -1 &&
         (file_offset_t)(bufferFileOffset + ensureBufferSizeAround) <= fileOffset &&
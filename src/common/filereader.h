@@ -26,6 +26,31 @@
 namespace omnetpp {
 namespace common {
 
+/**
+ * Lets FileReader present a file in a different form than it is stored in,
+ * e.g. a binary eventlog file as the equivalent text eventlog file (see
+ * FileReader::setContentDecoder()). File offsets and the file size seen by
+ * the users of FileReader are then those of the decoded content.
+ */
+class COMMON_API IFileContentDecoder
+{
+  public:
+    virtual ~IFileContentDecoder() {}
+
+    /**
+     * Returns the size of the decoded content. The file may have been
+     * appended to or overwritten since the last call.
+     */
+    virtual int64_t getDecodedSize() = 0;
+
+    /**
+     * Copies decoded content starting at the given offset into the buffer.
+     * Returns the number of bytes copied, which is less than length only at
+     * the end of the decoded content.
+     */
+    virtual size_t readDecoded(file_offset_t offset, char *buffer, size_t length) = 0;
+};
+
 /**
  * Reads a file line by line. It has to be very efficient since
  * it may be used up to several gigabyte-sized files (output vector files
@@ -40,6 +65,15 @@ namespace common {
  * thrown. When this happens the buffer is cleared, so the reader can be used
  * again.
  *
+ * Alternatively, the whole file can be memory-mapped (see setMemoryMapping()).
+ * In that mode no data is copied at all, seeks are free, and the returned
+ * line pointers point directly into the mapping. Appends are followed the
+ * same way as in buffered mode, i.e. according to the FileChangeAction
+ * settings.
+ *
+ * Files that need to be decoded are read through an IFileContentDecoder;
+ * memory mapping is not possible for them.
+ *
  * All functions throw class opp_runtime_error on error.
  */
 class COMMON_API FileReader
@@ -57,6 +91,12 @@ class COMMON_API FileReader
         SYNCHRONIZE
     };
 
+    enum AccessPattern {
+        ACCESS_NORMAL,
+        ACCESS_SEQUENTIAL,
+        ACCESS_RANDOM
+    };
+
   private:
     // the file
     const std::string fileName;
@@ -67,11 +107,13 @@ class COMMON_API FileReader
 //    bool enableIgnoreAppendChanges = true;
     FileChangeAction fileAppendedAction;
     FileChangeAction fileOverwrittenAction;
+    IFileContentDecoder *contentDecoder = nullptr;
 
     // the buffer
     const size_t bufferSize = 0;
-    const char *bufferBegin = nullptr;
-    const char *bufferEnd = nullptr; // = buffer + bufferSize
+    char *heapBuffer = nullptr; // allocated buffer of bufferSize
+    const char *bufferBegin = nullptr; // heapBuffer, or the beginning of the mapping
+    const char *bufferEnd = nullptr; // = buffer + bufferSize, or the end of the mapping
     const size_t maxLineSize = 0;
 
     // file positions and size
@@ -104,6 +146,13 @@ class COMMON_API FileReader
     // total bytes read in so far
     int64_t numReadBytes = 0;
 
+    // memory mapping; when mapped, the buffer covers the whole file and bufferFileOffset is 0
+    bool enableMemoryMapping = false;
+    AccessPattern accessPattern = ACCESS_NORMAL;
+    bool mapped = false;
+    size_t mappedSize = 0;
+    file_offset_t unmappedCurrentOffset = 0; // restored when the file is mapped again
+
   private:
     /**
      * Reads data into the buffer till the end of the buffer in the given direction
@@ -111,11 +160,15 @@ class COMMON_API FileReader
      * May read from 0 up to bufferSize number of bytes.
      */
     void fillBuffer(bool forward);
+    size_t readFileData(file_offset_t fileOffset, char *dataPointer, size_t length);
     size_t readFileEnd(file_offset_t fileSize, size_t size, const char *dataPointer);
     void ensureFileOpenInternal();
     void getFileInformation(int64_t& size, time_t& lastModificationTime);
     void processFileChange(FileChange change);
     void checkConsistency(bool checkDataPointer = false) const;
+    void mapFile();
+    void unmapFile();
+    void adviseAccessPattern();
 
     file_offset_t pointerToFileOffset(char *dataPointer) const;
     char *fileOffsetToPointer(file_offset_t fileOffset) const;
@@ -176,6 +229,40 @@ class COMMON_API FileReader
      */
     void setFileLocking(bool value) { enableFileLocking = value; }
 
+    /**
+     * Makes the reader return the content decoded by the given object instead
+     * of the raw file content. The decoder will be deleted with this object.
+     * Must be called before the file is opened.
+     */
+    void setContentDecoder(IFileContentDecoder *decoder);
+
+    /**
+     * Controls whether the whole file is memory-mapped instead of being read
+     * through the buffer. Must be called before the file is opened. It is
+     * silently ignored on platforms without mmap(). Note that truncating
+     * a memory-mapped file from another process may crash the reader when it
+     * touches the removed part, so this mode is meant for files which are
+     * only appended to.
+     */
+    void setMemoryMapping(bool value);
+
+    /**
+     * Returns true if the file is read via memory mapping.
+     */
+    bool isMemoryMapping() const { return enableMemoryMapping && !contentDecoder; }
+
+    /**
+     * Tells the operating system how the file is going to be accessed
+     * (sequential reading, or random seeks like in the sequence chart).
+     * Only has effect in memory mapping mode.
+     */
+    void setAccessPattern(AccessPattern pattern);
+
+    /**
+     * Returns the access pattern hint set with setAccessPattern().
+     */
+    AccessPattern getAccessPattern() const { return accessPattern; }
+
     /**
      * Returns true if the file is open, otherwise returns false.
      */
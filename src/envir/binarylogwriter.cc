@@ -0,0 +1,216 @@
+//==========================================================================
+//  BINARYLOGWRITER.CC - part of
+//                     OMNeT++/OMNEST
+//             Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstring>
+#include "common/fileutil.h"
+#include "omnetpp/csimulation.h"
+#include "omnetpp/ccomponent.h"
+#include "omnetpp/ccomponenttype.h"
+#include "omnetpp/cexception.h"
+#include "binarylogwriter.h"
+
+using namespace omnetpp::common;
+
+namespace omnetpp {
+namespace envir {
+
+BinaryLogWriter::BinaryLogWriter(size_t bufferSize)
+{
+    buffer.resize(bufferSize < 4096 ? 4096 : bufferSize);
+}
+
+BinaryLogWriter::~BinaryLogWriter()
+{
+    if (f)
+        close();
+}
+
+void BinaryLogWriter::open(const char *filename)
+{
+    ASSERT(!f);
+    this->filename = filename;
+    mkPath(directoryOf(filename).c_str());
+    f = fopen(filename, "wb");
+    if (!f)
+        throw cRuntimeError("Cannot open binary log file '%s' for write", filename);
+
+    bufferUsed = 0;
+    fileSize = 0;
+    truncated = false;
+    stringIdsByPointer.clear();
+    stringIdsByValue.clear();
+    siteIds.clear();
+    componentDefined.clear();
+    lastStringId = lastSiteId = 0;
+    lastEventNumber = -1;
+
+    write(BINARYLOG_MAGIC, strlen(BINARYLOG_MAGIC));
+    writeSignedVarint(SimTime::getScaleExp());
+}
+
+void BinaryLogWriter::close()
+{
+    ASSERT(f);
+    flush();
+    fclose(f);
+    f = nullptr;
+}
+
+void BinaryLogWriter::flush()
+{
+    if (f && bufferUsed > 0) {
+        if (fwrite(buffer.data(), 1, bufferUsed, f) != bufferUsed)
+            throw cRuntimeError("Cannot write binary log file '%s'", filename.c_str());
+        fileSize += bufferUsed;
+        bufferUsed = 0;
+    }
+}
+
+void BinaryLogWriter::write(const void *data, size_t length)
+{
+    if (bufferUsed + length > buffer.size()) {
+        flush();
+        if (length > buffer.size()) {
+            if (fwrite(data, 1, length, f) != length)
+                throw cRuntimeError("Cannot write binary log file '%s'", filename.c_str());
+            fileSize += length;
+            return;
+        }
+    }
+    memcpy(buffer.data() + bufferUsed, data, length);
+    bufferUsed += length;
+}
+
+void BinaryLogWriter::writeVarint(uint64_t value)
+{
+    unsigned char bytes[10];
+    int n = 0;
+    while (value >= 0x80) {
+        bytes[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    bytes[n++] = (unsigned char)value;
+    write(bytes, n);
+}
+
+int BinaryLogWriter::defineString(const char *s, size_t length)
+{
+    int id = ++lastStringId;
+    writeTag('S');
+    writeVarint(id);
+    writeVarint(length);
+    write(s, length);
+    return id;
+}
+
+int BinaryLogWriter::internLiteral(const char *s)
+{
+    if (!s)
+        return 0;
+    auto it = stringIdsByPointer.find(s);
+    if (it != stringIdsByPointer.end())
+        return it->second;
+    int id = defineString(s, strlen(s));
+    stringIdsByPointer[s] = id;
+    return id;
+}
+
+int BinaryLogWriter::internCategory(const char *category)
+{
+    if (!category)
+        return 0;
+    auto it = stringIdsByValue.find(category);
+    if (it != stringIdsByValue.end())
+        return it->second;
+    int id = defineString(category, strlen(category));
+    stringIdsByValue[category] = id;
+    return id;
+}
+
+int BinaryLogWriter::getSiteId(cLogEntry *entry)
+{
+    SiteKey key { entry->sourceFile, entry->sourceLine, entry->logLevel, internCategory(entry->category) };
+    auto it = siteIds.find(key);
+    if (it != siteIds.end())
+        return it->second;
+
+    int fileId = internLiteral(entry->sourceFile);
+    int functionId = internLiteral(entry->sourceFunction);
+    int id = ++lastSiteId;
+    writeTag('P');
+    writeVarint(id);
+    writeVarint(entry->logLevel);
+    writeVarint(key.categoryId);
+    writeVarint(fileId);
+    writeVarint(entry->sourceLine);
+    writeVarint(functionId);
+    siteIds[key] = id;
+    return id;
+}
+
+void BinaryLogWriter::ensureComponentDefined(cComponent *component)
+{
+    int id = component->getId();
+    if (id < (int)componentDefined.size() && componentDefined[id])
+        return;
+    if (id >= (int)componentDefined.size())
+        componentDefined.resize(id + 1024, false);
+    componentDefined[id] = true;
+
+    std::string path = component->getFullPath();
+    int pathId = defineString(path.c_str(), path.size());
+    const char *nedTypeName = component->getComponentType() ? component->getComponentType()->getFullName() : component->getClassName();
+    int nedTypeId = internLiteral(nedTypeName);
+    writeTag('C');
+    writeVarint(id);
+    writeVarint(pathId);
+    writeVarint(nedTypeId);
+}
+
+void BinaryLogWriter::writeEntry(cSimulation *simulation, cLogEntry *entry)
+{
+    ASSERT(f);
+    if (truncated)
+        return;
+    if (maxSize >= 0 && fileSize + (int64_t)bufferUsed >= maxSize) {
+        writeTag('T');
+        truncated = true;
+        return;
+    }
+
+    int siteId = getSiteId(entry);
+
+    cComponent *contextComponent = simulation->getContext();
+    int contextComponentId = contextComponent ? contextComponent->getId() : -1;
+    if (contextComponentId != -1)
+        ensureComponentDefined(contextComponent);
+
+    int64_t eventNumber = simulation->getEventNumber();
+    if (eventNumber != lastEventNumber) {
+        writeTag('E');
+        writeVarint(eventNumber);
+        writeSignedVarint(simulation->getSimTime().raw());
+        lastEventNumber = eventNumber;
+    }
+
+    writeTag('L');
+    writeVarint(siteId);
+    writeVarint(contextComponentId + 1);
+    writeVarint(entry->textLength);
+    write(entry->text, entry->textLength);
+}
+
+}  // namespace envir
+}  // namespace omnetpp
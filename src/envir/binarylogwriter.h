@@ -0,0 +1,135 @@
+//==========================================================================
+//  BINARYLOGWRITER.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 1992-2017 Andras Varga
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_ENVIR_BINARYLOGWRITER_H
+#define __OMNETPP_ENVIR_BINARYLOGWRITER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "omnetpp/clog.h"
+#include "envirdefs.h"
+
+namespace omnetpp {
+
+class cSimulation;
+class cComponent;
+
+namespace envir {
+
+#define BINARYLOG_MAGIC    "OMNETPP-BINLOG 1\n"
+
+/**
+ * Records log lines into a compact binary file instead of formatting them
+ * as text. The log prefix is not formatted at all during the simulation:
+ * each line is stored as a reference to a log site (source file, line,
+ * function, log level and category, defined once per site and identified
+ * by a numeric ID), the ID of the context component, and the raw text.
+ * Event numbers and simulation times are only written when they change.
+ * Records are collected in an in-memory buffer that is written out in one
+ * go when it fills up, so the cost of a log line is a few varints and a
+ * memcpy. Files can be decoded into text with `opp_logtool decode`.
+ *
+ * File format: the BINARYLOG_MAGIC string, the simtime scale exponent,
+ * then a sequence of records. All integers are LEB128 varints (signed ones
+ * are zigzag-encoded). Records start with a one-character tag:
+ *  - 'S' id length bytes: string definition
+ *  - 'C' componentId pathStringId nedTypeStringId: component definition
+ *  - 'P' siteId logLevel categoryStringId fileStringId line functionStringId:
+ *        log site definition (string ID 0 means none)
+ *  - 'E' eventNumber rawSimtime: start of a new event
+ *  - 'L' siteId contextComponentId+1 length bytes: log line
+ *  - 'T': end of the recorded log, because the file has reached its maximum
+ *        size (see setMaxSize()); no records follow
+ */
+class ENVIR_API BinaryLogWriter
+{
+  private:
+    struct SiteKey {
+        const char *sourceFile;
+        int sourceLine;
+        LogLevel logLevel;
+        int categoryId;
+        bool operator==(const SiteKey& other) const {
+            return sourceFile == other.sourceFile && sourceLine == other.sourceLine && logLevel == other.logLevel && categoryId == other.categoryId;
+        }
+    };
+    struct SiteKeyHash {
+        size_t operator()(const SiteKey& key) const {
+            return std::hash<const void *>()(key.sourceFile) ^ (key.sourceLine * 31) ^ (key.logLevel << 24) ^ (key.categoryId << 16);
+        }
+    };
+
+    std::string filename;
+    FILE *f = nullptr;
+    std::vector<char> buffer;
+    size_t bufferUsed = 0;
+    int64_t fileSize = 0;  // number of bytes written to the file, not counting the buffer
+    int64_t maxSize = -1;  // negative means no limit
+    bool truncated = false;
+
+    std::unordered_map<const void *, int> stringIdsByPointer; // for string literals (__FILE__, __FUNCTION__)
+    std::unordered_map<std::string, int> stringIdsByValue;    // for categories which may be dynamically created strings
+    std::unordered_map<SiteKey, int, SiteKeyHash> siteIds;
+    std::vector<bool> componentDefined; // indexed by component ID
+    int lastStringId = 0;
+    int lastSiteId = 0;
+    int64_t lastEventNumber = -1;
+
+  private:
+    void write(const void *data, size_t length);
+    void writeTag(char tag) {write(&tag, 1);}
+    void writeVarint(uint64_t value);
+    void writeSignedVarint(int64_t value) {writeVarint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));}
+    int defineString(const char *s, size_t length);
+    int internLiteral(const char *s);
+    int internCategory(const char *category);
+    int getSiteId(cLogEntry *entry);
+    void ensureComponentDefined(cComponent *component);
+
+  public:
+    BinaryLogWriter(size_t bufferSize = 1024*1024);
+    ~BinaryLogWriter();
+
+    void open(const char *filename);
+    void close();
+    bool isOpen() const {return f != nullptr;}
+    const char *getFilename() const {return filename.c_str();}
+
+    /**
+     * Limits the size of the file. When it is reached, recording stops
+     * and the rest of the log is discarded. A negative value means no limit.
+     */
+    void setMaxSize(int64_t maxSize) {this->maxSize = maxSize;}
+    bool isTruncated() const {return truncated;}
+
+    /**
+     * Appends the log line(s) in the entry to the buffer, together with
+     * the definitions of the strings, log site and components it refers to
+     * if they have not been recorded yet.
+     */
+    void writeEntry(cSimulation *simulation, cLogEntry *entry);
+
+    /**
+     * Writes the buffer contents to the file.
+     */
+    void flush();
+};
+
+}  // namespace envir
+}  // namespace omnetpp
+
+#endif
@@ -43,6 +43,9 @@ using namespace omnetpp::common;
 namespace omnetpp {
 namespace envir {
 
+// calls the text or binary variant of the given EventLogWriter function, depending on the file format
+#define RECORD_ENTRY(function, ...)  (binaryWriter ? EventLogWriter::function(binaryWriter, __VA_ARGS__) : EventLogWriter::function(feventlog, __VA_ARGS__))
+
 Register_Class(EventlogFileManager)
 
 Register_GlobalConfigOption(CFGID_EVENTLOG_FILE, "eventlog-file", CFG_FILENAME, "${resultdir}/${configname}-${iterationvarsf}#${repetition}.elog", "Name of the eventlog file to generate.");
@@ -50,6 +53,7 @@ Register_GlobalConfigOptionU(CFGID_EVENTLOG_MAX_SIZE, "eventlog-max-size", "B",
 Register_GlobalConfigOptionU(CFGID_EVENTLOG_MIN_TRUNCATED_SIZE, "eventlog-min-truncated-size", "B", "1 GiB", "Specify the minimum size of the eventlog file in bytes after the file is truncated. Truncation means older events are discarded while newer ones are kept.");
 Register_GlobalConfigOptionU(CFGID_EVENTLOG_SNAPSHOT_FREQUENCY, "eventlog-snapshot-frequency", "B", "100 MiB", "The eventlog file contains snapshots periodically. Each one describes the complete simulation state at a specific event. Snapshots help various tools to handle large eventlog files more efficiently. Specifying greater value means less help, while smaller value means bigger eventlog files.");
 Register_GlobalConfigOptionU(CFGID_EVENTLOG_INDEX_FREQUENCY, "eventlog-index-frequency", "B", "1 MiB", "The eventlog file contains incremental snapshots called index. An index is much smaller than a full snapshot, but it only contains the differences since the last index.");
+Register_GlobalConfigOption(CFGID_EVENTLOG_FILE_FORMAT, "eventlog-file-format", CFG_STRING, "text", "Format of the eventlog file: `text` or `binary`. The binary format carries the same information as the text format, but it is considerably smaller and faster to write: strings are interned, numbers are stored as varints, and the end of the file contains an index by event number and simulation time. Binary eventlog files are read transparently by the eventlog tools, and can be converted with `opp_eventlogtool totext` and `opp_eventlogtool tobinary`. Binary eventlog files are not truncated, i.e. `eventlog-max-size` is ignored.");
 Register_GlobalConfigOption(CFGID_EVENTLOG_OPTIONS, "eventlog-options", CFG_CUSTOM, nullptr, "The content of the eventlog is diveded into categories. This option allows to record only certain categories reducing the file size. Specify a comma separated subset of the following keywords: text, message, module, methodcall, displaystring and custom. By default all categories are enabled.");
 Register_GlobalConfigOption(CFGID_EVENTLOG_MESSAGE_DETAIL_PATTERN, "eventlog-message-detail-pattern", CFG_CUSTOM, nullptr,
         "A list of patterns separated by '|' character which will be used to write "
@@ -118,6 +122,8 @@ EventlogFileManager::~EventlogFileManager()
     recordingIntervals = nullptr;
     delete fileLock;
     fileLock = nullptr;
+    delete binaryWriter;
+    binaryWriter = nullptr;
 }
 
 void EventlogFileManager::clearInternalState()
@@ -188,9 +194,16 @@ void EventlogFileManager::configure(cSimulation *simulation, cConfiguration *cfg
     if (text)
         recordingIntervals->parse(text);
 
-    // setup filename
+    // setup filename and format
     filename = cfg->getAsFilename(CFGID_EVENTLOG_FILE);
     filename = ResultFileUtils(cfg).augmentFileName(filename);
+    std::string format = cfg->getAsString(CFGID_EVENTLOG_FILE_FORMAT);
+    if (format == "text")
+        isBinaryFormat = false;
+    else if (format == "binary")
+        isBinaryFormat = true;
+    else
+        throw opp_runtime_error("Unknown eventlog-file-format value '%s', must be 'text' or 'binary'", format.c_str());
 
     // file limits
     maxSize = cfg->getAsDouble(CFGID_EVENTLOG_MAX_SIZE);
@@ -239,12 +252,19 @@ void EventlogFileManager::open()
         throw opp_runtime_error("Cannot open eventlog file `%s' for write", filename.c_str());
     printf("Recording eventlog to file `%s'...\n", filename.c_str());
     fileLock = new FileLock(feventlog, filename.c_str());
+    if (isBinaryFormat)
+        binaryWriter = new BinaryEventlogWriter(feventlog, filename.c_str(), SimTime::getScaleExp());
     clearInternalState();
 }
 
 void EventlogFileManager::close()
 {
     ASSERT(feventlog);
+    if (binaryWriter) {
+        binaryWriter->writeFooter();
+        delete binaryWriter;
+        binaryWriter = nullptr;
+    }
     fclose(feventlog);
     feventlog = nullptr;
     isEventRecordingEnabled = false;
@@ -398,7 +418,7 @@ void EventlogFileManager::simulationEvent(cEvent *event)
         eventNumber = getSimulation()->getEventNumber();
         simulationTime = getSimulation()->getSimTime();
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-        file_offset_t fileOffset = opp_ftell(feventlog);
+        file_offset_t fileOffset = getFileOffset();
         if (lastChunk != INDEX && fileOffset - toRealFileOffset(previousIndexFileOffset) > indexFrequency)
             recordIndex();
         if (lastChunk != SNAPSHOT && fileOffset - toRealFileOffset(previousSnapshotFileOffset) > snapshotFrequency) {
@@ -407,12 +427,14 @@ void EventlogFileManager::simulationEvent(cEvent *event)
             recordSnapshot();
         }
         fileOffset = opp_ftell(feventlog);
-        if (fileOffset > maxSize)
+        if (fileOffset > maxSize && !binaryWriter)
             truncate();
-        fprintf(feventlog, "\n");
+        recordEmptyLine();
+        if (binaryWriter)
+            binaryWriter->addIndexPoint(eventNumber, simulationTime.raw());
         auto fingerprintCalculator = getSimulation()->getFingerprintCalculator();
         if (msg)
-            EventLogWriter::recordEventEntry_e_t_m_ce_msg_f(feventlog, eventNumber, getSimulation()->getSimTime(), mod->getId(), msg->getPreviousEventNumber(), msg->getId(), (fingerprintCalculator ? fingerprintCalculator->str().c_str() : nullptr));
+            RECORD_ENTRY(recordEventEntry_e_t_m_ce_msg_f, eventNumber, getSimulation()->getSimTime(), mod->getId(), msg->getPreviousEventNumber(), msg->getId(), (fingerprintCalculator ? fingerprintCalculator->str().c_str() : nullptr));
         else
             ; // TODO: record non message handling events
         entryIndex = 0;
@@ -433,7 +455,7 @@ void EventlogFileManager::bubble(cComponent *component, const char *text)
         if (dynamic_cast<cModule *>(component)) {
             FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
             cModule *mod = (cModule *)component;
-            EventLogWriter::recordBubbleEntry_id_txt(feventlog, mod->getId(), text);
+            RECORD_ENTRY(recordBubbleEntry_id_txt, mod->getId(), text);
             entryIndex++;
         }
         else if (cChannel *channel = dynamic_cast<cChannel *>(component)) {
@@ -451,8 +473,7 @@ void EventlogFileManager::beginSend(cMessage *msg, const SendOptions& options)
         bool isScheduled = msg->isScheduled();
         bool isPacket = msg->isPacket();
         cPacket *pkt = isPacket ? (cPacket *)msg : nullptr; // note: simply `(cPacket *)msg` would cause sanitizer to complain about illegal cast
-        EventLogWriter::recordBeginSendEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe_sd_up_tx(feventlog,
-            msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
+        RECORD_ENTRY(recordBeginSendEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe_sd_up_tx, msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
             msg->getClassName(), msg->getFullName(),
             msg->getKind(), msg->getSchedulingPriority(), isPacket ? pkt->getBitLength() : 0, isPacket ? pkt->hasBitError() : false,
             ownerModule ? ownerModule->getId() : -1,
@@ -485,8 +506,7 @@ void EventlogFileManager::messageCancelled(cMessage *msg)
         bool isScheduled = msg->isScheduled();
         bool isPacket = msg->isPacket();
         cPacket *pkt = isPacket ? (cPacket *)msg : nullptr;
-        EventLogWriter::recordCancelEventEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe(feventlog,
-            msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
+        RECORD_ENTRY(recordCancelEventEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe, msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
             msg->getClassName(), msg->getFullName(),
             msg->getKind(), msg->getSchedulingPriority(), isPacket ? pkt->getBitLength() : 0, isPacket ? pkt->hasBitError() : false,
             ownerModule ? ownerModule->getId() : -1,
@@ -506,7 +526,7 @@ void EventlogFileManager::messageSendDirect(cMessage *msg, cGate *toGate, const
     if (isEventRecordingEnabled && isMessageRecordingEnabled) {
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
         ASSERT(result.remainingDuration >= 0);
-        EventLogWriter::recordSendDirectEntry_sm_dm_dg_pd_td_rd(feventlog, msg->getSenderModuleId(), toGate->getOwnerModule()->getId(), toGate->getId(), result.delay, result.duration, result.remainingDuration);
+        RECORD_ENTRY(recordSendDirectEntry_sm_dm_dg_pd_td_rd, msg->getSenderModuleId(), toGate->getOwnerModule()->getId(), toGate->getId(), result.delay, result.duration, result.remainingDuration);
         entryIndex++;
     }
 }
@@ -516,7 +536,7 @@ void EventlogFileManager::messageSendHop(cMessage *msg, cGate *srcGate)
     // TODO: store this related the message, so that we can repeat it in snapshots
     if (isEventRecordingEnabled && isMessageRecordingEnabled) {
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-        EventLogWriter::recordSendHopEntry_sm_sg(feventlog, srcGate->getOwnerModule()->getId(), srcGate->getId());
+        RECORD_ENTRY(recordSendHopEntry_sm_sg, srcGate->getOwnerModule()->getId(), srcGate->getId());
         entryIndex++;
     }
 }
@@ -527,7 +547,7 @@ void EventlogFileManager::messageSendHop(cMessage *msg, cGate *srcGate, const Ch
     if (isEventRecordingEnabled && isMessageRecordingEnabled) {
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
         ASSERT(result.remainingDuration >= 0);
-        EventLogWriter::recordSendHopEntry_sm_sg_pd_td_rd_d(feventlog, srcGate->getOwnerModule()->getId(), srcGate->getId(), result.delay, result.duration, result.remainingDuration, result.discard);
+        RECORD_ENTRY(recordSendHopEntry_sm_sg_pd_td_rd_d, srcGate->getOwnerModule()->getId(), srcGate->getId(), result.delay, result.duration, result.remainingDuration, result.discard);
         entryIndex++;
     }
 }
@@ -541,8 +561,7 @@ void EventlogFileManager::endSend(cMessage *msg)
         bool isScheduled = msg->isScheduled();
         bool isPacket = msg->isPacket();
         cPacket *pkt = isPacket ? (cPacket *)msg : nullptr;
-        EventLogWriter::recordEndSendEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe_i(feventlog,
-            msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
+        RECORD_ENTRY(recordEndSendEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe_i, msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
             msg->getClassName(), msg->getFullName(),
             msg->getKind(), msg->getSchedulingPriority(), isPacket ? pkt->getBitLength() : 0, isPacket ? pkt->hasBitError() : false,
             ownerModule ? ownerModule->getId() : -1,
@@ -561,8 +580,7 @@ void EventlogFileManager::messageCreated(cMessage *msg)
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
         bool isPacket = msg->isPacket();
         cPacket *pkt = isPacket ? (cPacket *)msg : nullptr;
-        EventLogWriter::recordCreateMessageEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe(feventlog,
-            msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
+        RECORD_ENTRY(recordCreateMessageEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe, msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
             msg->getClassName(), msg->getFullName(),
             msg->getKind(), msg->getSchedulingPriority(), isPacket ? pkt->getBitLength() : 0, isPacket ? pkt->hasBitError() : false,
             -1, -1, -1, -1, -1, -1, -1,
@@ -581,8 +599,7 @@ void EventlogFileManager::messageCloned(cMessage *msg, cMessage *clone)
         bool isScheduled = clone->isScheduled();
         bool isPacket = clone->isPacket();
         cPacket *pkt = isPacket ? (cPacket *)msg : nullptr;
-        EventLogWriter::recordCloneMessageEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe_cid(feventlog,
-            clone->getId(), clone->getTreeId(), isPacket ? pkt->getEncapsulationId() : clone->getId(), isPacket ? pkt->getEncapsulationTreeId() : clone->getTreeId(),
+        RECORD_ENTRY(recordCloneMessageEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe_cid, clone->getId(), clone->getTreeId(), isPacket ? pkt->getEncapsulationId() : clone->getId(), isPacket ? pkt->getEncapsulationTreeId() : clone->getTreeId(),
             clone->getClassName(), clone->getFullName(),
             clone->getKind(), clone->getSchedulingPriority(), isPacket ? pkt->getBitLength() : 0, isPacket ? pkt->hasBitError() : false,
             ownerModule ? ownerModule->getId() : -1,
@@ -604,8 +621,7 @@ void EventlogFileManager::messageDeleted(cMessage *msg)
         cModule *ownerModule = dynamic_cast<cModule *>(msg->getOwner());
         bool isPacket = msg->isPacket();
         cPacket *pkt = isPacket ? (cPacket *)msg : nullptr;
-        EventLogWriter::recordDeleteMessageEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe(feventlog,
-            msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
+        RECORD_ENTRY(recordDeleteMessageEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe, msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
             msg->getClassName(), msg->getFullName(),
             msg->getKind(), msg->getSchedulingPriority(), isPacket ? pkt->getBitLength() : 0, isPacket ? pkt->hasBitError() : false,
             ownerModule ? ownerModule->getId() : -1,
@@ -629,7 +645,7 @@ void EventlogFileManager::componentMethodBegin(cComponent *from, cComponent *to,
                 methodTextBuf[MAX_METHODCALL-1] = '\0';
                 methodText = methodTextBuf;
             }
-            EventLogWriter::recordComponentMethodBeginEntry_sm_tm_m(feventlog, ((cModule *)from)->getId(), ((cModule *)to)->getId(), methodText);
+            RECORD_ENTRY(recordComponentMethodBeginEntry_sm_tm_m, ((cModule *)from)->getId(), ((cModule *)to)->getId(), methodText);
             entryIndex++;
         }
     }
@@ -641,7 +657,10 @@ void EventlogFileManager::componentMethodEnd()
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
         // TODO: problem when channel method is called: we'll emit an "End" entry but no "Begin"
         // TODO: same problem when the caller is not a module or is nullptr
-        EventLogWriter::recordComponentMethodEndEntry(feventlog);
+        if (binaryWriter)
+            EventLogWriter::recordComponentMethodEndEntry(binaryWriter);
+        else
+            EventLogWriter::recordComponentMethodEndEntry(feventlog);
         entryIndex++;
     }
 }
@@ -654,7 +673,7 @@ void EventlogFileManager::moduleCreated(cModule *module)
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
         bool isCompoundModule = module->hasSubmodules() || !dynamic_cast<cSimpleModule *>(module);
         // FIXME: size() is missing
-        EventLogWriter::recordModuleCreatedEntry_id_c_t_pid_n_cm(feventlog, module->getId(), module->getClassName(), module->getNedTypeName(), module->getParentModule() ? module->getParentModule()->getId() : -1, module->getFullName(), isCompoundModule);
+        RECORD_ENTRY(recordModuleCreatedEntry_id_c_t_pid_n_cm, module->getId(), module->getClassName(), module->getNedTypeName(), module->getParentModule() ? module->getParentModule()->getId() : -1, module->getFullName(), isCompoundModule);
         entryIndex++;
         addIndexEventLogEntry(eventNumber, entryIndex);
         moduleToModuleCreatedEntryReferenceMap[module] = EventLogEntryReference(eventNumber, entryIndex);
@@ -665,7 +684,7 @@ void EventlogFileManager::moduleDeleted(cModule *module)
 {
     if (isEventRecordingEnabled && isModuleRecordingEnabled) {
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-        EventLogWriter::recordModuleDeletedEntry_id(feventlog, module->getId());
+        RECORD_ENTRY(recordModuleDeletedEntry_id, module->getId());
         entryIndex++;
         removeIndexEventLogEntry(moduleToModuleCreatedEntryReferenceMap[module]);
         moduleToModuleCreatedEntryReferenceMap.erase(module);
@@ -680,7 +699,7 @@ void EventlogFileManager::gateCreated(cGate *gate)
 {
     if (isEventRecordingEnabled && isModuleRecordingEnabled) {
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-        EventLogWriter::recordGateCreatedEntry_m_g_n_i_o(feventlog, gate->getOwnerModule()->getId(), gate->getId(), gate->getName(), gate->isVector() ? gate->getIndex() : -1, gate->getType() == cGate::OUTPUT);
+        RECORD_ENTRY(recordGateCreatedEntry_m_g_n_i_o, gate->getOwnerModule()->getId(), gate->getId(), gate->getName(), gate->isVector() ? gate->getIndex() : -1, gate->getType() == cGate::OUTPUT);
         entryIndex++;
         addIndexEventLogEntry(eventNumber, entryIndex);
         gateToGateCreatedEntryReferenceMap[gate] = EventLogEntryReference(eventNumber, entryIndex);
@@ -691,7 +710,7 @@ void EventlogFileManager::gateDeleted(cGate *gate)
 {
     if (isEventRecordingEnabled && isModuleRecordingEnabled) {
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-        EventLogWriter::recordGateDeletedEntry_m_g(feventlog, gate->getOwnerModule()->getId(), gate->getId());
+        RECORD_ENTRY(recordGateDeletedEntry_m_g, gate->getOwnerModule()->getId(), gate->getId());
         entryIndex++;
         removeIndexEventLogEntry(gateToGateCreatedEntryReferenceMap[gate]);
         gateToGateCreatedEntryReferenceMap.erase(gate);
@@ -704,7 +723,7 @@ void EventlogFileManager::connectionCreated(cGate *srcgate)
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
         cGate *destgate = srcgate->getNextGate();
         // TODO: channel, channel attributes, etc
-        EventLogWriter::recordConnectionCreatedEntry_sm_sg_dm_dg(feventlog, srcgate->getOwnerModule()->getId(), srcgate->getId(), destgate->getOwnerModule()->getId(), destgate->getId());
+        RECORD_ENTRY(recordConnectionCreatedEntry_sm_sg_dm_dg, srcgate->getOwnerModule()->getId(), srcgate->getId(), destgate->getOwnerModule()->getId(), destgate->getId());
         entryIndex++;
         addIndexEventLogEntry(eventNumber, entryIndex);
         channelToConnectionCreatedEntryReferenceMap[srcgate] = EventLogEntryReference(eventNumber, entryIndex);
@@ -719,7 +738,7 @@ void EventlogFileManager::connectionDeleted(cGate *srcgate)
 {
     if (isEventRecordingEnabled && isModuleRecordingEnabled) {
         FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-        EventLogWriter::recordConnectionDeletedEntry_sm_sg(feventlog, srcgate->getOwnerModule()->getId(), srcgate->getId());
+        RECORD_ENTRY(recordConnectionDeletedEntry_sm_sg, srcgate->getOwnerModule()->getId(), srcgate->getId());
         entryIndex++;
         removeIndexEventLogEntry(channelToConnectionCreatedEntryReferenceMap[srcgate]);
         channelToConnectionCreatedEntryReferenceMap.erase(srcgate);
@@ -732,7 +751,7 @@ void EventlogFileManager::displayStringChanged(cComponent *component)
         if (dynamic_cast<cModule *>(component)) {
             FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
             cModule *module = (cModule *)component;
-            EventLogWriter::recordModuleDisplayStringChangedEntry_id_d(feventlog, module->getId(), module->getDisplayString().str());
+            RECORD_ENTRY(recordModuleDisplayStringChangedEntry_id_d, module->getId(), module->getDisplayString().str());
             entryIndex++;
             addIndexEventLogEntry(eventNumber, entryIndex);
             std::map<cModule *, EventLogEntryReference>::iterator it = moduleToModuleDisplayStringChangedEntryReferenceMap.find(module);
@@ -744,7 +763,7 @@ void EventlogFileManager::displayStringChanged(cComponent *component)
             FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
             cChannel *channel = (cChannel *)component;
             cGate *gate = channel->getSourceGate();
-            EventLogWriter::recordConnectionDisplayStringChangedEntry_sm_sg_d(feventlog, gate->getOwnerModule()->getId(), gate->getId(), channel->getDisplayString().str());
+            RECORD_ENTRY(recordConnectionDisplayStringChangedEntry_sm_sg_d, gate->getOwnerModule()->getId(), gate->getId(), channel->getDisplayString().str());
             entryIndex++;
             addIndexEventLogEntry(eventNumber, entryIndex);
             std::map<cGate *, EventLogEntryReference>::iterator it = channelToConnectionDisplayStringChangedEntryReferenceMap.find(gate);
@@ -765,11 +784,12 @@ void EventlogFileManager::logLine(const char *prefix, const char *text, int leng
             char *lineEnd = line;
             while (lineEnd != textEnd && *lineEnd != '\n')
                 lineEnd++;
-            EventLogWriter::recordLogLine(feventlog, prefix, line, lineEnd - line);
+            RECORD_ENTRY(recordLogLine, prefix, line, lineEnd - line);
             // TODO: write the escaped new lines into the eventlog file and handle this from the gui
 //            if (*lineEnd == '\n')
 //                fprintf(feventlog, "\\n");
-            fprintf(feventlog, "\n");
+            if (!binaryWriter)  // binary log lines include the line end
+                fprintf(feventlog, "\n");
             line = lineEnd + 1;
             entryIndex++;
         }
@@ -872,12 +892,20 @@ void EventlogFileManager::removeMessageEntryReference(cMessage *msg)
     }
 }
 
+void EventlogFileManager::recordEmptyLine()
+{
+    if (binaryWriter)
+        binaryWriter->writeEmptyLine();
+    else
+        fprintf(feventlog, "\n");
+}
+
 void EventlogFileManager::recordSimulationBegin()
 {
     FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
     beginningFileOffset = 0;
     const char *runId = cfg->getVariable(CFGVAR_RUNID);
-    EventLogWriter::recordSimulationBeginEntry_ov_ev_rid(feventlog, OMNETPP_VERSION, EVENTLOG_VERSION, runId);
+    RECORD_ENTRY(recordSimulationBeginEntry_ov_ev_rid, OMNETPP_VERSION, EVENTLOG_VERSION, runId);
     eventNumber = -1;
     entryIndex = 0;
     lastChunk = BEGIN;
@@ -887,8 +915,8 @@ void EventlogFileManager::recordSimulationBegin()
 void EventlogFileManager::recordSimulationEnd(bool isError, int resultCode, const char *message)
 {
     FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-    fprintf(feventlog, "\n");
-    EventLogWriter::recordSimulationEndEntry_e_c_m(feventlog, isError, resultCode, message);
+    recordEmptyLine();
+    RECORD_ENTRY(recordSimulationEndEntry_e_c_m, isError, resultCode, message);
     eventNumber = -1;
     entryIndex = 0;
     lastChunk = END;
@@ -898,10 +926,10 @@ void EventlogFileManager::recordSimulationEnd(bool isError, int resultCode, cons
 void EventlogFileManager::recordInitialize()
 {
     FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-    fprintf(feventlog, "\n");
+    recordEmptyLine();
     // we can't use getSimulation()->getEventNumber() and getSimulation()->getSimTime(), because when we start a new run
     // these numbers are still set from the previous run (i.e. not zero)
-    EventLogWriter::recordEventEntry_e_t_m_ce_msg(feventlog, 0, 0, 1, -1, -1);
+    RECORD_ENTRY(recordEventEntry_e_t_m_ce_msg, 0, 0, 1, -1, -1);
     eventNumber = 0;
     entryIndex = 0;
     fflush(feventlog);
@@ -911,9 +939,9 @@ void EventlogFileManager::recordSnapshot()
 {
     // TODO: shouldn't we clear the index here?
     FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-    fprintf(feventlog, "\n");
-    file_offset_t snapshotFileOffset = toVirtualFileOffset(opp_ftell(feventlog));
-    EventLogWriter::recordSnapshotEntry_f_e_t(feventlog, toVirtualFileOffset(opp_ftell(feventlog)), eventNumber, simulationTime);
+    recordEmptyLine();
+    file_offset_t snapshotFileOffset = toVirtualFileOffset(getFileOffset());
+    RECORD_ENTRY(recordSnapshotEntry_f_e_t, snapshotFileOffset, eventNumber, simulationTime);
     entryIndex = 0;
     previousSnapshotFileOffset = snapshotFileOffset;
     cModule *systemModule = getSimulation()->getSystemModule();
@@ -928,7 +956,7 @@ void EventlogFileManager::recordSnapshot()
     for (std::map<eventnumber_t, std::vector<EventLogEntryRange> >::iterator it = eventNumberToSnapshotEventLogEntryRanges.begin(); it != eventNumberToSnapshotEventLogEntryRanges.end(); it++) {
         std::vector<EventLogEntryRange> &ranges = it->second;
         for (std::vector<EventLogEntryRange>::iterator jt = ranges.begin(); jt != ranges.end(); jt++)
-            EventLogWriter::recordReferenceFoundEntry_e_b_e(feventlog, jt->eventNumber, jt->beginEntryIndex, jt->endEntryIndex);
+            RECORD_ENTRY(recordReferenceFoundEntry_e_b_e, jt->eventNumber, jt->beginEntryIndex, jt->endEntryIndex);
     }
     lastChunk = SNAPSHOT;
     fflush(feventlog);
@@ -943,16 +971,16 @@ void EventlogFileManager::recordModules(cModule *module)
     bool isCompoundModule = module->hasSubmodules() || !dynamic_cast<cSimpleModule *>(module);
     // FIXME: size() is missing
     std::map<cModule *, EventLogEntryReference>::iterator mit = moduleToModuleCreatedEntryReferenceMap.find(module);
-    EventLogWriter::recordModuleFoundEntry_id_c_t_pid_n_cm_e_ei(feventlog, module->getId(), module->getClassName(), module->getNedTypeName(), parentModule ? parentModule->getId() : -1, module->getFullName(), isCompoundModule, mit->second.eventNumber, mit->second.entryIndex);
+    RECORD_ENTRY(recordModuleFoundEntry_id_c_t_pid_n_cm_e_ei, module->getId(), module->getClassName(), module->getNedTypeName(), parentModule ? parentModule->getId() : -1, module->getFullName(), isCompoundModule, mit->second.eventNumber, mit->second.entryIndex);
     entryIndex++;
     for (cModule::GateIterator it(module); !it.end(); it++) {
         cGate *gate = *it;
         std::map<cGate *, EventLogEntryReference>::iterator git = gateToGateCreatedEntryReferenceMap.find(gate);
-        EventLogWriter::recordGateFoundEntry_m_g_n_i_o_e_ei(feventlog, gate->getOwnerModule()->getId(), gate->getId(), gate->getName(), gate->isVector() ? gate->getIndex() : -1, gate->getType() == cGate::OUTPUT, git->second.eventNumber, git->second.entryIndex);
+        RECORD_ENTRY(recordGateFoundEntry_m_g_n_i_o_e_ei, gate->getOwnerModule()->getId(), gate->getId(), gate->getName(), gate->isVector() ? gate->getIndex() : -1, gate->getType() == cGate::OUTPUT, git->second.eventNumber, git->second.entryIndex);
         entryIndex++;
     }
     std::map<cModule *, EventLogEntryReference>::iterator dit = moduleToModuleDisplayStringChangedEntryReferenceMap.find(module);
-    EventLogWriter::recordModuleDisplayStringFoundEntry_id_d_e_ei(feventlog, module->getId(), module->getDisplayString().str(), dit->second.eventNumber, dit->second.entryIndex);
+    RECORD_ENTRY(recordModuleDisplayStringFoundEntry_id_d_e_ei, module->getId(), module->getDisplayString().str(), dit->second.eventNumber, dit->second.entryIndex);
     entryIndex++;
     for (cModule::SubmoduleIterator it(module); !it.end(); it++)
         recordModules(*it);
@@ -967,12 +995,12 @@ void EventlogFileManager::recordConnections(cModule *module)
         if (srcgate->getNextGate()) {
             cGate *destgate = srcgate->getNextGate();
             std::map<cGate *, EventLogEntryReference>::iterator cit = channelToConnectionCreatedEntryReferenceMap.find(srcgate);
-            EventLogWriter::recordConnectionFoundEntry_sm_sg_dm_dg_e_ei(feventlog, srcgate->getOwnerModule()->getId(), srcgate->getId(), destgate->getOwnerModule()->getId(), destgate->getId(), cit->second.eventNumber, cit->second.entryIndex);
+            RECORD_ENTRY(recordConnectionFoundEntry_sm_sg_dm_dg_e_ei, srcgate->getOwnerModule()->getId(), srcgate->getId(), destgate->getOwnerModule()->getId(), destgate->getId(), cit->second.eventNumber, cit->second.entryIndex);
             entryIndex++;
         }
         if (channel) {
             std::map<cGate *, EventLogEntryReference>::iterator dit = channelToConnectionDisplayStringChangedEntryReferenceMap.find(srcgate);
-            EventLogWriter::recordConnectionDisplayStringFoundEntry_sm_sg_d_e_ei(feventlog, srcgate->getOwnerModule()->getId(), srcgate->getId(), channel->getDisplayString().str(), dit->second.eventNumber, dit->second.entryIndex);
+            RECORD_ENTRY(recordConnectionDisplayStringFoundEntry_sm_sg_d_e_ei, srcgate->getOwnerModule()->getId(), srcgate->getId(), channel->getDisplayString().str(), dit->second.eventNumber, dit->second.entryIndex);
             entryIndex++;
         }
     }
@@ -1009,8 +1037,7 @@ void EventlogFileManager::recordMessage(cMessage *msg)
     bool isScheduled = msg->isScheduled();
     bool isPacket = msg->isPacket();
     cPacket *pkt = isPacket ? (cPacket *)msg : nullptr;
-    EventLogWriter::recordMessageFoundEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe(feventlog,
-        msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
+    RECORD_ENTRY(recordMessageFoundEntry_id_tid_eid_etid_c_n_k_p_l_er_m_sm_sg_st_am_ag_at_d_pe, msg->getId(), msg->getTreeId(), isPacket ? pkt->getEncapsulationId() : msg->getId(), isPacket ? pkt->getEncapsulationTreeId() : msg->getTreeId(),
         msg->getClassName(), msg->getFullName(),
         msg->getKind(), msg->getSchedulingPriority(), isPacket ? pkt->getBitLength() : 0, isPacket ? pkt->hasBitError() : false,
         ownerModule ? ownerModule->getId() : -1,
@@ -1024,21 +1051,21 @@ void EventlogFileManager::recordMessage(cMessage *msg)
 void EventlogFileManager::recordIndex()
 {
     FileLockAcquirer fileLockAcquirer(fileLock, FILE_LOCK_EXCLUSIVE);
-    fprintf(feventlog, "\n");
-    file_offset_t indexFileOffset = toVirtualFileOffset(opp_ftell(feventlog));
-    EventLogWriter::recordIndexEntry_f_i_s_e_t(feventlog, indexFileOffset, previousIndexFileOffset, previousSnapshotFileOffset, eventNumber, simulationTime);
+    recordEmptyLine();
+    file_offset_t indexFileOffset = toVirtualFileOffset(getFileOffset());
+    RECORD_ENTRY(recordIndexEntry_f_i_s_e_t, indexFileOffset, previousIndexFileOffset, previousSnapshotFileOffset, eventNumber, simulationTime);
     entryIndex = 0;
     for (std::map<eventnumber_t, std::vector<EventLogEntryRange> >::iterator it = eventNumberToRemovedIndexEventLogEntryRanges.begin(); it != eventNumberToRemovedIndexEventLogEntryRanges.end(); it++) {
         std::vector<EventLogEntryRange> &ranges = it->second;
         for (std::vector<EventLogEntryRange>::iterator jt = ranges.begin(); jt != ranges.end(); jt++) {
-            EventLogWriter::recordReferenceRemovedEntry_e_b_e(feventlog, jt->eventNumber, jt->beginEntryIndex, jt->endEntryIndex);
+            RECORD_ENTRY(recordReferenceRemovedEntry_e_b_e, jt->eventNumber, jt->beginEntryIndex, jt->endEntryIndex);
             entryIndex++;
         }
     }
     for (std::map<eventnumber_t, std::vector<EventLogEntryRange> >::iterator it = eventNumberToAddedIndexEventLogEntryRanges.begin(); it != eventNumberToAddedIndexEventLogEntryRanges.end(); it++) {
         std::vector<EventLogEntryRange> &ranges = it->second;
         for (std::vector<EventLogEntryRange>::iterator jt = ranges.begin(); jt != ranges.end(); jt++) {
-            EventLogWriter::recordReferenceAddedEntry_e_b_e(feventlog, jt->eventNumber, jt->beginEntryIndex, jt->endEntryIndex);
+            RECORD_ENTRY(recordReferenceAddedEntry_e_b_e, jt->eventNumber, jt->beginEntryIndex, jt->endEntryIndex);
             entryIndex++;
         }
     }
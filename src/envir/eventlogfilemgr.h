@@ -18,6 +18,7 @@
 
 #include <sstream>
 #include "common/filelock.h"
+#include "common/binaryeventlog.h"
 #include "omnetpp/simkerneldefs.h"
 #include "omnetpp/opp_string.h"
 #include "omnetpp/envirext.h"
@@ -42,6 +43,8 @@ namespace envir {
  * Responsible for writing the eventlog file. The file format is line oriented,
  * each line contains exactly one eventlog entry. Snapshots and index entries
  * are written periodically to be able to read large eventlog files efficiently.
+ * Alternatively, the same content can be written in the binary eventlog format
+ * (see common/binaryeventlog.h).
  */
 class ENVIR_API EventlogFileManager : public cIEventlogManager
 {
@@ -106,10 +109,12 @@ class ENVIR_API EventlogFileManager : public cIEventlogManager
     int64_t minTruncatedSize = -1;
     int64_t snapshotFrequency = -1;
     int64_t indexFrequency = -1;
+    bool isBinaryFormat = false;
     ObjectPrinter *messageDetailPrinter = nullptr;
 
     // internal state
     FILE *feventlog = nullptr;
+    common::BinaryEventlogWriter *binaryWriter = nullptr; // non-null if the file is being written in the binary format
     common::FileLock *fileLock = nullptr;
     Intervals *recordingIntervals = nullptr;
 
@@ -216,6 +221,8 @@ class ENVIR_API EventlogFileManager : public cIEventlogManager
      * new file, deletes the old one and renames the new to the old name. The
      * new eventlog file will start with the same simulation begin entry. The
      * rest of the file is copied from the old one starting at a snapshot.
+     * Binary eventlog files are never truncated, because entries refer to
+     * string definitions that may precede the snapshot.
      */
     virtual void truncate();
 
@@ -275,6 +282,7 @@ class ENVIR_API EventlogFileManager : public cIEventlogManager
 
     /** @name Record functions */
     //@{
+    void recordEmptyLine();
     void recordSimulationBegin();
     void recordSimulationEnd(bool isError, int resultCode, const char *message);
     void recordInitialize();
@@ -299,6 +307,8 @@ class ENVIR_API EventlogFileManager : public cIEventlogManager
     void removeMessageEntryReference(cMessage *msg);
     //@}
 
+    // the current end of the file; for binary files, the end of the equivalent text file, which snapshot and index entries refer to
+    file_offset_t getFileOffset() const { return binaryWriter ? binaryWriter->getTextOffset() : opp_ftell(feventlog); }
     file_offset_t toRealFileOffset(file_offset_t virtualFileOffset) const { return virtualFileOffset - beginningFileOffset; }
     file_offset_t toVirtualFileOffset(file_offset_t realFileOffset) const { return realFileOffset + beginningFileOffset; }
 };
@@ -102,6 +102,20 @@ while (<FILE>)
          $classHasOptField = 1;
       }
 
+      if ($fieldType eq "string")
+      {
+         # strings which are different in almost every entry are not worth interning
+         $fieldBinaryType = ($fieldName eq "fingerprints") ? "FIELD_TEXT" : "FIELD_STRING";
+      }
+      elsif ($fieldType eq "simtime_t")
+      {
+         $fieldBinaryType = "FIELD_SIMTIME";
+      }
+      else
+      {
+         $fieldBinaryType = "FIELD_INT";
+      }
+
       $fieldCType = $fieldType;
       $fieldCType =~ s/string/const char */;
       $field = {
@@ -110,6 +124,7 @@ while (<FILE>)
          CTYPE => $fieldCType,
          PRINTFTYPE => $fieldPrintfType,
          PRINTFVALUE => $fieldPrintfValue,
+         BINARYTYPE => $fieldBinaryType,
          NAME => $fieldName,
          DEFAULTVALUE => $fieldDefault,
       };
@@ -151,22 +166,32 @@ print H
 #define __OMNETPP_ENVIR_EVENTLOGWRITER_H
 
 #include <cstdio>
+#include \"common/binaryeventlog.h\"
 #include \"envirdefs.h\"
 #include \"omnetpp/simtime_t.h\"
 
 namespace omnetpp {
 namespace envir {
 
+using omnetpp::common::BinaryEventlogWriter;
+
 class EventLogWriter
 {
   public:
     static void recordLogLine(FILE *f, const char *prefix, const char *line, int lineLength);
+    static void recordLogLine(BinaryEventlogWriter *w, const char *prefix, const char *line, int lineLength);
 ";
 
 foreach $class (@classes)
 {
-   print H "    static void " . makeMethodDecl($class,0) . ";\n";
-   print H "    static void " . makeMethodDecl($class,1) . ";\n" if (getEffectiveHasOpt($class));
+   print H "    static void " . makeMethodDecl($class,0,0) . ";\n";
+   print H "    static void " . makeMethodDecl($class,1,0) . ";\n" if (getEffectiveHasOpt($class));
+}
+
+foreach $class (@classes)
+{
+   print H "    static void " . makeMethodDecl($class,0,1) . ";\n";
+   print H "    static void " . makeMethodDecl($class,1,1) . ";\n" if (getEffectiveHasOpt($class));
 }
 
 print H "};
@@ -212,6 +237,11 @@ void EventLogWriter::recordLogLine(FILE *f, const char *prefix, const char *line
     CHECK(fwrite(line, 1, lineLength, f));
 }
 
+void EventLogWriter::recordLogLine(BinaryEventlogWriter *w, const char *prefix, const char *line, int lineLength)
+{
+    w->writeLogLine(prefix, line, lineLength);
+}
+
 ";
 
 foreach $class (@classes)
@@ -220,6 +250,13 @@ foreach $class (@classes)
    print CC makeMethodImpl($class,1) if (getEffectiveHasOpt($class));
 }
 
+foreach $class (@classes)
+{
+   print CC makeEntryDescriptor($class);
+   print CC makeBinaryMethodImpl($class,0);
+   print CC makeBinaryMethodImpl($class,1) if (getEffectiveHasOpt($class));
+}
+
 print CC "
 } // namespace envir\n
 }  // namespace omnetpp
@@ -232,7 +269,7 @@ sub makeMethodImpl ()
    my $class = shift;
    my $wantOptFields = shift;
 
-   my $txt = "void EventLogWriter::" . makeMethodDecl($class,$wantOptFields) . "\n{\n";
+   my $txt = "void EventLogWriter::" . makeMethodDecl($class,$wantOptFields,0) . "\n{\n";
    $txt .= "    ASSERT(f!=nullptr);\n";
 
    # class code goes into initial fprintf
@@ -267,10 +304,95 @@ sub makeMethodImpl ()
    $txt;
 }
 
+sub makeEntryDescriptor ()
+{
+   my $class = shift;
+   my @fields = getEffectiveFields($class);
+   my $numFields = scalar(@fields);
+   my $txt = "";
+
+   if ($numFields > 0)
+   {
+      $txt .= "static const BinaryEventlogWriter::FieldDescriptor $class->{NAME}Fields[] = {\n";
+      foreach $field (@fields)
+      {
+         $txt .= "    {\"$field->{CODE}\", BinaryEventlogWriter::$field->{BINARYTYPE}},\n";
+      }
+      $txt .= "};\n";
+      $txt .= "static const BinaryEventlogWriter::EntryDescriptor $class->{NAME}Descriptor = {\"$class->{CODE}\", $numFields, $class->{NAME}Fields};\n\n";
+   }
+   else
+   {
+      $txt .= "static const BinaryEventlogWriter::EntryDescriptor $class->{NAME}Descriptor = {\"$class->{CODE}\", 0, nullptr};\n\n";
+   }
+   $txt;
+}
+
+sub makeBinaryMethodImpl ()
+{
+   my $class = shift;
+   my $wantOptFields = shift;
+
+   my $txt = "void EventLogWriter::" . makeMethodDecl($class,$wantOptFields,1) . "\n{\n";
+   $txt .= "    ASSERT(w!=nullptr);\n";
+
+   # bit i of presentFields tells whether the ith field of the descriptor is written
+   my $mandatoryMask = 0;
+   my $i = 0;
+   foreach $field ( getEffectiveFields($class) )
+   {
+      $mandatoryMask |= (1 << $i) if ($field->{DEFAULTVALUE} eq "");
+      $i++;
+   }
+   $txt .= sprintf("    uint64_t presentFields = 0x%x;\n", $mandatoryMask);
+   if ($wantOptFields)
+   {
+      $i = 0;
+      foreach $field ( getEffectiveFields($class) )
+      {
+         $txt .= "    if ($field->{NAME}!=$field->{DEFAULTVALUE})\n        presentFields |= (uint64_t)1 << $i;\n" if ($field->{DEFAULTVALUE} ne "");
+         $i++;
+      }
+   }
+   $txt .= "    w->beginEntry(&$class->{NAME}Descriptor, presentFields);\n";
+
+   $i = 0;
+   foreach $field ( getEffectiveFields($class) )
+   {
+      if ($field->{DEFAULTVALUE} eq "" || $wantOptFields)
+      {
+         my $write;
+         if ($field->{BINARYTYPE} eq "FIELD_STRING") {
+            $write = "w->writeString($field->{NAME});";
+         }
+         elsif ($field->{BINARYTYPE} eq "FIELD_TEXT") {
+            $write = "w->writeText($field->{NAME});";
+         }
+         elsif ($field->{BINARYTYPE} eq "FIELD_SIMTIME") {
+            $write = "w->writeSimtime($field->{NAME}.raw());";
+         }
+         else {
+            $write = "w->writeInt($field->{NAME});";
+         }
+         if ($field->{DEFAULTVALUE} eq "") {
+            $txt .= "    $write\n";
+         }
+         else {
+            $txt .= "    if (presentFields & ((uint64_t)1 << $i))\n        $write\n";
+         }
+      }
+      $i++;
+   }
+   $txt .= "    w->endEntry();\n";
+   $txt .= "}\n\n";
+   $txt;
+}
+
 sub makeMethodDecl ()
 {
    my $class = shift;
    my $wantOptFields = shift;
+   my $binary = shift;
 
    my $txt = "record$class->{NAME}";
    foreach $field ( getEffectiveFields($class) )
@@ -278,7 +400,7 @@ sub makeMethodDecl ()
       my $code = ($field->{CODE} eq "#") ? "e" : $field->{CODE};
       $txt .= "_$code" if ($wantOptFields || $field->{DEFAULTVALUE} eq "");
    }
-   $txt .= "(FILE *f";
+   $txt .= $binary ? "(BinaryEventlogWriter *w" : "(FILE *f";
    foreach $field ( getEffectiveFields($class) )
    {
       $txt .= ", $field->{CTYPE} $field->{NAME}" if ($wantOptFields || $field->{DEFAULTVALUE} eq "");
@@ -44,12 +44,17 @@ void FileSnapshotManager::configure(cSimulation *simulation, cConfiguration *cfg
 
     fname = cfg->getAsFilename(CFGID_SNAPSHOT_FILE);
     fname = ResultFileUtils(cfg).augmentFileName(fname);
+
+    // reconfigured after startRun(), see GenericEnvir::switchToRun()
+    if (started)
+        removeFile(fname.c_str(), "old snapshot file");
 }
 
 void FileSnapshotManager::startRun()
 {
     // clean up file from previous runs
     removeFile(fname.c_str(), "old snapshot file");
+    started = true;
 }
 
 void FileSnapshotManager::endRun()
@@ -34,6 +34,7 @@ class ENVIR_API FileSnapshotManager : public cISnapshotManager
   protected:
     cConfiguration *cfg = nullptr;
     std::string fname;  // output file name
+    bool started = false;
 
   public:
     /** @name Constructor, destructor */
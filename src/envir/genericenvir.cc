@@ -122,6 +122,21 @@ void GenericEnvir::configure(cConfiguration *cfg)
     setDebugOnErrors(cfg->getAsBool(CFGID_DEBUG_ON_ERRORS));  // note: handling overridden in Qtenv::readPerRunOptions() due to interference with GUI
     setPrintUndisposed(cfg->getAsBool(CFGID_PRINT_UNDISPOSED));
     recordEventlog = cfg->getAsBool(CFGID_RECORD_EVENTLOG);  // TODO tmp solution: cannot call setEventlogRecording(), because it calls eventlogRecorder->suspend()/resume(), which is NOT what we want here
+    suppressSendHopNotifications = !needsSendHopNotifications();
+    coalesceDisplayStringNotifications = !needsImmediateDisplayStringNotifications();
+}
+
+void GenericEnvir::switchToRun(cConfiguration *cfg)
+{
+    if (recordEventlog)
+        throw cRuntimeError("Cannot switch to another run while recording an eventlog file");
+
+    this->cfg = cfg;
+
+    // note: the managers keep their registered output vectors, etc.
+    outVectorManager->configure(simulation, cfg);
+    outScalarManager->configure(simulation, cfg);
+    snapshotManager->configure(simulation, cfg);
 }
 
 std::string GenericEnvir::extractImagePath(cConfiguration *cfg, ArgList *args)
@@ -497,6 +512,7 @@ void GenericEnvir::setEventlogRecording(bool enabled)
         else
             eventlogManager->suspend();
         recordEventlog = enabled;
+        suppressSendHopNotifications = !needsSendHopNotifications();
     }
 }
 
@@ -111,6 +111,15 @@ class ENVIR_API GenericEnvir : public cEnvir, protected cISimulationLifecycleLis
 
     virtual void lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details) override;
 
+    // Whether messageSendHop() needs to be called for connections without
+    // a channel or with a cIdealChannel (see suppressSendHopNotifications)
+    virtual bool needsSendHopNotifications() const {return recordEventlog;}
+
+    // Whether displayStringChanged() needs to be called after each change,
+    // as opposed to once per component at the end of the event (see
+    // coalesceDisplayStringNotifications). The eventlog does not need it.
+    virtual bool needsImmediateDisplayStringNotifications() const {return false;}
+
   public:
     GenericEnvir();
     virtual ~GenericEnvir();
@@ -119,6 +128,11 @@ class ENVIR_API GenericEnvir : public cEnvir, protected cISimulationLifecycleLis
     virtual void setSimulation(cSimulation *simulation) override;
     virtual void configure(cConfiguration *cfg) override;
 
+    // Directs result recording into the files of another run that only differs
+    // from the current one in the RNG seeds. Must be called after network setup
+    // but before anything has been recorded (see cmdenv-fork-replications).
+    virtual void switchToRun(cConfiguration *cfg);
+
     // getters/setters
     virtual cSimulation *getSimulation() const override {return simulation;}
     virtual cConfiguration *getConfig() override;
@@ -152,6 +166,10 @@ class ENVIR_API GenericEnvir : public cEnvir, protected cISimulationLifecycleLis
     virtual void setEventlogRecording(bool enabled);  //TODO note: currently this does suspend()/resume(), which is mostly only useful for Qtenv
     virtual bool getEventlogRecording() const {return recordEventlog;}
 
+    // for event loops that bypass simulationEvent() (see cSimulation::executeEventLean()):
+    // maintains the only state of it that is needed without eventlog and logging
+    void setCurrentEventModuleId(int moduleId) {currentModuleId = moduleId;}
+
     virtual bool getCheckSignals() const {return cComponent::getCheckSignals();}
     virtual void setCheckSignals(bool checkSignals) {cComponent::setCheckSignals(checkSignals);}
     virtual const char *getImagePath() const {return imagePath.c_str();}
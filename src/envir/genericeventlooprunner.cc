@@ -16,6 +16,7 @@
 
 #include <thread>
 #include "common/stringutil.h"
+#include "omnetpp/checkandcast.h"
 #include "omnetpp/cevent.h"
 #include "omnetpp/cmessage.h"
 #include "omnetpp/cmodule.h"
@@ -24,6 +25,7 @@
 #include "omnetpp/cfutureeventset.h"
 #include "omnetpp/cconfiguration.h"
 #include "omnetpp/cconfigoption.h"
+#include "omnetpp/clog.h"
 #include "ifakegui.h"
 #include "genericenvir.h"
 #include "genericeventlooprunner.h"
@@ -195,6 +197,81 @@ void GenericEventLoopRunner::doRunExpressNoStatusUpdates()
     }
 }
 
+bool GenericEventLoopRunner::canRunExpressLean()
+{
+    // the lean loop leaves out cEnvir::simulationEvent() calls, which only
+    // matter for eventlog recording and for log prefixes
+    GenericEnvir *envir = dynamic_cast<GenericEnvir*>(simulation->getEnvir());
+    return leanEventLoop && !fakeGUI && envir && !envir->getEventlogRecording() &&
+           !cLog::isLoggingEnabled() && simulation->canExecuteEventLean();
+}
+
+void GenericEventLoopRunner::doRunExpressLean()
+{
+    ASSERT(fakeGUI == nullptr);
+
+    bool withStatusUpdates = statusFrequencyMs > 0;
+    bool withRealTimeLimit = simulation->hasRealTimeLimit();
+    if (withStatusUpdates && withRealTimeLimit)
+        runExpressLeanLoop<true, true>();
+    else if (withStatusUpdates)
+        runExpressLeanLoop<true, false>();
+    else if (withRealTimeLimit)
+        runExpressLeanLoop<false, true>();
+    else
+        runExpressLeanLoop<false, false>();
+}
+
+template <bool withStatusUpdates, bool withRealTimeLimit>
+void GenericEventLoopRunner::runExpressLeanLoop()
+{
+    // Events are executed in batches, without the per-event hooks (see
+    // cSimulation::executeEventLean()). The checks that the other loops
+    // do after every event (SIGINT, status update, real-time limits) and
+    // the speedometer update are only done between batches.
+    const int BATCH_SIZE = 1024;
+
+    speedometer.start(simulation->getSimTime());
+
+    int64_t lastUpdateTime = opp_get_monotonic_clock_usecs();
+    eventnumber_t lastEventNumber = simulation->getEventNumber();
+
+    // executeEventLean() does not call simulationEvent(), so the module of the
+    // current event (see cEnvir::getCurrentEventModule()) is maintained here
+    GenericEnvir *envir = check_and_cast<GenericEnvir*>(simulation->getEnvir());
+
+    if (withStatusUpdates)
+        printStatusUpdate();
+
+    try {
+        while (true) {
+            for (int i = 0; i < BATCH_SIZE; i++) {
+                cEvent *event = simulation->takeNextEvent();
+                if (!event)
+                    throw cTerminationException("Scheduler interrupted while waiting");
+                envir->setCurrentEventModuleId(event->isMessage() ? static_cast<cMessage *>(event)->getArrivalModuleId() : -1);
+                simulation->executeEventLean(event);
+            }
+
+            eventnumber_t eventNumber = simulation->getEventNumber();
+            speedometer.addEvents(eventNumber - lastEventNumber, simulation->getSimTime());
+            lastEventNumber = eventNumber;
+
+            if (withStatusUpdates && elapsed(statusFrequencyMs, lastUpdateTime))
+                printStatusUpdate();
+            if (withRealTimeLimit)
+                simulation->checkRealTimeLimits();
+            if (sigintReceived)
+                throw cTerminationException("SIGINT or SIGTERM received, exiting");
+        }
+    }
+    catch (std::exception&) {
+        // account for the events of the last, incomplete batch
+        speedometer.addEvents(simulation->getEventNumber() - lastEventNumber, simulation->getSimTime());
+        throw;
+    }
+}
+
 void GenericEventLoopRunner::runEventLoop()
 {
     if (simulation != cSimulation::getActiveSimulation())
@@ -216,6 +293,8 @@ void GenericEventLoopRunner::runEventLoop()
             doRunNormal();
         else if (fakeGUI)
             doRunExpressWithFakeGUI();
+        else if (canRunExpressLean())
+            doRunExpressLean();
         else if (simulation->hasRealTimeLimit())
             doRunExpressNoFakeGui();
         else if (statusFrequencyMs > 0)
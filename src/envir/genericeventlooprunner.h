@@ -45,6 +45,7 @@ class ENVIR_API GenericEventLoopRunner : public cIEventLoopRunner
     bool printThreadId = false;
     bool printEventBanners = false;
     bool detailedEventBanners = false;
+    bool leanEventLoop = true;
 
     Speedometer speedometer;
     simtime_t simulatedTime;  // sim. time after finishing simulation
@@ -55,6 +56,9 @@ class ENVIR_API GenericEventLoopRunner : public cIEventLoopRunner
     virtual void doRunExpressNoFakeGui();
     virtual void doRunExpressNoFakeGuiNoTimelimit();
     virtual void doRunExpressNoStatusUpdates();
+    virtual void doRunExpressLean();
+    virtual bool canRunExpressLean();
+    template <bool withStatusUpdates, bool withRealTimeLimit> void runExpressLeanLoop();
 
     virtual void printEventBanner(eventnumber_t eventNumber, cEvent *event);
     virtual void printStatusUpdate();
@@ -75,6 +79,7 @@ class ENVIR_API GenericEventLoopRunner : public cIEventLoopRunner
     virtual void setPrintThreadId(bool print) {printThreadId = print;}
     virtual void setPrintEventBanners(bool print) {printEventBanners = print;}
     virtual void setDetailedEventBanners(bool enable) {detailedEventBanners = enable;}
+    virtual void setLeanEventLoop(bool enable) {leanEventLoop = enable;}
     virtual void setBatchProgress(int runsTried, int numRuns) {this->runsTried = runsTried; this->numRuns = numRuns;}
 
     virtual void runEventLoop() override;
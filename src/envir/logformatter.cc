@@ -123,7 +123,8 @@ bool LogFormatter::containsDirective(FormatDirective directive) const
 std::string LogFormatter::formatPrefix(cLogEntry *entry)
 {
     bool lastPartEmpty = true;
-    std::stringstream stream;
+    stream.str("");
+    stream.clear();
     int adaptiveTabIndex = 0;
     cSimulation *simulation = cSimulation::getActiveSimulation();
     cEnvir *ev = simulation->getEnvir();
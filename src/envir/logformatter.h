@@ -17,6 +17,7 @@
 #define __OMNETPP_ENVIR_LOGFORMATTER_H
 
 #include <ostream>
+#include <sstream>
 #include <vector>
 #include "omnetpp/clog.h"
 #include "envirdefs.h"
@@ -181,6 +182,7 @@ class ENVIR_API LogFormatter
     bool isBlank_ = true;
     std::vector<FormatPart> formatParts;
     std::vector<int> adaptiveTabColumns;
+    std::stringstream stream; // reused across formatPrefix() calls to avoid constructing a new stream for each log line
 
   public:
     LogFormatter() {}
@@ -190,6 +192,7 @@ class ENVIR_API LogFormatter
     bool isBlank() const { return isBlank_; }
     bool usesEventName() const {return containsDirective(EVENT_OBJECT) || containsDirective(EVENT_OBJECT_NAME);}
     bool usesEventClassName() const {return containsDirective(EVENT_OBJECT) || containsDirective(EVENT_OBJECT_CLASSNAME);}
+    bool usesUserTime() const {return containsDirective(USERTIME);}
     std::string formatPrefix(cLogEntry *entry);
     void resetAdaptiveTabs();
 
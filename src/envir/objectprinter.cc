@@ -211,14 +211,53 @@ void ObjectPrinter::printIndent(std::ostream& ostream, int level)
         ostream << " ";
 }
 
+namespace {
+
+// Records whether the object pattern refers to attributes (i.e. field values) of the object
+class ProbingMatchableObjectAdapter : public MatchableObjectAdapter
+{
+  public:
+    mutable bool attributesUsed = false;
+    ProbingMatchableObjectAdapter(cObject *object) : MatchableObjectAdapter(CLASSNAME, object) {}
+    virtual const char *getAsString(const char *attribute) const override {attributesUsed = true; return MatchableObjectAdapter::getAsString(attribute);}
+};
+
+}  // namespace
+
 bool ObjectPrinter::matchesObjectField(cObject *object, int fieldIndex)
 {
-    const MatchableObjectAdapter matchableObject(MatchableObjectAdapter::CLASSNAME, object);
+    // Unless the patterns refer to field values, the result only depends on
+    // the class of the object (the class name, and the name, type and declaring
+    // class of the field), so it can be cached
+    auto it = fieldMatchCache.find(typeid(*object));
+    if (it == fieldMatchCache.end()) {
+        int numFields = object->getDescriptor()->getFieldCount();
+        std::vector<bool> matches(numFields);
+        bool usesObjectAttributes = false;
+        for (int i = 0; i < numFields && !usesObjectAttributes; i++)
+            matches[i] = doMatchesObjectField(object, i, &usesObjectAttributes);
+        if (usesObjectAttributes)
+            matches.clear();
+        it = fieldMatchCache.emplace(typeid(*object), std::move(matches)).first;
+    }
+    const std::vector<bool>& matches = it->second;
+    if (fieldIndex >= 0 && fieldIndex < (int)matches.size())
+        return matches[fieldIndex];
+    else
+        return doMatchesObjectField(object, fieldIndex);  // not cacheable, or the field count of the descriptor has changed (e.g. watches)
+}
+
+bool ObjectPrinter::doMatchesObjectField(cObject *object, int fieldIndex, bool *usesObjectAttributes)
+{
+    const ProbingMatchableObjectAdapter matchableObject(object);
 
     for (int i = 0; i < (int)objectMatchExpressions.size(); i++) {
         MatchExpression *objectMatchExpression = objectMatchExpressions[i];
+        bool objectMatches = objectMatchExpression->matches(&matchableObject);
+        if (usesObjectAttributes && matchableObject.attributesUsed)
+            *usesObjectAttributes = true;
 
-        if (objectMatchExpression->matches(&matchableObject)) {
+        if (objectMatches) {
             std::vector<MatchExpression *>& fieldNameMatchExpressions = fieldNameMatchExpressionsList[i];
 
             for (auto fieldNameMatchExpression : fieldNameMatchExpressions) {
@@ -18,6 +18,8 @@
 
 #include <vector>
 #include <iostream>
+#include <typeindex>
+#include <unordered_map>
 #include "envirdefs.h"
 #include "common/matchexpression.h"
 
@@ -63,6 +65,7 @@ class ENVIR_API ObjectPrinter
         std::vector<MatchExpression*> objectMatchExpressions;
         std::vector<std::vector<MatchExpression*> > fieldNameMatchExpressionsList;
         ObjectPrinterRecursionPredicate recursionPredicate;
+        std::unordered_map<std::type_index,std::vector<bool>> fieldMatchCache; // per class: matchesObjectField() result for each field; empty if not cacheable
 
     public:
         /**
@@ -109,6 +112,7 @@ class ENVIR_API ObjectPrinter
         void printIndent(std::ostream& ostream, int level);
         void printObjectToStream(std::ostream& ostream, any_ptr object, cClassDescriptor *descriptor, any_ptr *objects, int level);
         bool matchesObjectField(cObject *object, int fieldIndex);
+        bool doMatchesObjectField(cObject *object, int fieldIndex, bool *usesObjectAttributes=nullptr);
 };
 
 }  // namespace envir
@@ -56,6 +56,10 @@ Register_Class(OmnetppOutputScalarManager);
 
 void OmnetppOutputScalarManager::configure(cSimulation *simulation, cConfiguration *cfg)
 {
+    // reconfiguring is allowed until the file is opened, see GenericEnvir::switchToRun()
+    if (state == OPENED)
+        throw cRuntimeError("%s: Cannot switch to another output file after results have been written", getClassName());
+
     this->cfg = cfg;
     ResultFileUtils::setConfiguration(cfg);
     simulation->addLifecycleListener(this);
@@ -67,6 +71,10 @@ void OmnetppOutputScalarManager::configure(cSimulation *simulation, cConfigurati
 
     int prec = cfg->getAsInt(CFGID_OUTPUT_SCALAR_PRECISION);
     writer.setPrecision(prec);
+
+    // already started: delete the file of the new run instead
+    if (state == STARTED && !shouldAppend)
+        removeFile(fname.c_str(), "old output scalar file");
 }
 
 void OmnetppOutputScalarManager::startRun()
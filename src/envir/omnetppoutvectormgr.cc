@@ -57,6 +57,10 @@ Register_PerObjectConfigOptionU(CFGID_VECTOR_BUFFER, "vector-buffer", KIND_VECTO
 
 void OmnetppOutputVectorManager::configure(cSimulation *simulation, cConfiguration *cfg)
 {
+    // reconfiguring is allowed until the file is opened, see GenericEnvir::switchToRun()
+    if (state == OPENED)
+        throw cRuntimeError("%s: Cannot switch to another output file after results have been written", getClassName());
+
     this->cfg = cfg;
     ResultFileUtils::setConfiguration(cfg);
     simulation->addLifecycleListener(this);
@@ -71,6 +75,10 @@ void OmnetppOutputVectorManager::configure(cSimulation *simulation, cConfigurati
 
     size_t memoryLimit = (size_t) cfg->getAsDouble(CFGID_OUTPUTVECTOR_MEMORY_LIMIT);
     writer.setOverallMemoryLimit(memoryLimit);
+
+    // already started: delete the file of the new run instead
+    if (state == STARTED)
+        removeFile(fname.c_str(), "old output vector file");
 }
 
 void OmnetppOutputVectorManager::startRun()
@@ -43,6 +43,15 @@ void Speedometer::addEvent(simtime_t t)
     currentSimtime = t;
 }
 
+void Speedometer::addEvents(long n, simtime_t t)
+{
+    // start() must have been called already
+    assert(started);
+
+    numEvents += n;
+    currentSimtime = t;
+}
+
 unsigned long Speedometer::getMillisSinceIntervalStart()
 {
     // start() must have been called already
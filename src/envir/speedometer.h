@@ -45,6 +45,7 @@ class ENVIR_API Speedometer
 
     void start(simtime_t t);
     void addEvent(simtime_t t);
+    void addEvents(long n, simtime_t t);
     void beginNewInterval();
 
     unsigned long getMillisSinceIntervalStart();
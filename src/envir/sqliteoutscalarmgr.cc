@@ -54,6 +54,10 @@ Register_Class(SqliteOutputScalarManager);
 
 void SqliteOutputScalarManager::configure(cSimulation *simulation, cConfiguration *cfg)
 {
+    // reconfiguring is allowed until the file is opened, see GenericEnvir::switchToRun()
+    if (state == OPENED)
+        throw cRuntimeError("%s: Cannot switch to another output file after results have been written", getClassName());
+
     this->cfg = cfg;
     ResultFileUtils::setConfiguration(cfg);
     simulation->addLifecycleListener(this);
@@ -65,6 +69,10 @@ void SqliteOutputScalarManager::configure(cSimulation *simulation, cConfiguratio
 
     int commitFreq = cfg->getAsInt(CFGID_OUTPUT_SCALAR_DB_COMMIT_FREQ);
     writer.setCommitFreq(commitFreq);
+
+    // already started: delete the file of the new run instead
+    if (state == STARTED && !shouldAppend)
+        removeFile(fname.c_str(), "old SQLite output scalar file");
 }
 
 void SqliteOutputScalarManager::startRun()
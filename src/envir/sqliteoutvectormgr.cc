@@ -54,6 +54,10 @@ Register_GlobalConfigOption(CFGID_OUTPUT_VECTOR_DB_INDEXING, "output-vector-db-i
 
 void SqliteOutputVectorManager::configure(cSimulation *simulation, cConfiguration *cfg)
 {
+    // reconfiguring is allowed until the file is opened, see GenericEnvir::switchToRun()
+    if (state == OPENED)
+        throw cRuntimeError("%s: Cannot switch to another output file after results have been written", getClassName());
+
     this->cfg = cfg;
     ResultFileUtils::setConfiguration(cfg);
     simulation->addLifecycleListener(this);
@@ -76,6 +80,10 @@ void SqliteOutputVectorManager::configure(cSimulation *simulation, cConfiguratio
     else
         throw cRuntimeError("Invalid value '%s' for '%s', expecting 'skip', 'ahead' or 'after'",
                 indexModeStr.c_str(), CFGID_OUTPUT_VECTOR_DB_INDEXING->getName());
+
+    // already started: delete the file of the new run instead
+    if (state == STARTED && !shouldAppend)
+        removeFile(fname.c_str(), "old SQLite output vector file");
 }
 
 void SqliteOutputVectorManager::startRun()
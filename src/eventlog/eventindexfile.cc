@@ -0,0 +1,551 @@
+//=========================================================================
+//  EVENTINDEXFILE.CC - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <sys/stat.h>
+#include "common/exception.h"
+#include "common/filereader.h"
+#include "common/binaryeventlog.h"
+#include "common/linetokenizer.h"
+#include "omnetpp/platdep/platmisc.h"
+#include "eventlogentryfactory.h"
+#include "eventindexfile.h"
+
+using namespace omnetpp::common;
+
+namespace omnetpp {
+namespace eventlog {
+
+static_assert(sizeof(EventIndexFile::EventRecord) == 56, "EventRecord must not contain padding, because it is written to disk as is");
+static_assert(sizeof(EventIndexFile::Dependency) == 16, "Dependency must not contain padding, because it is written to disk as is");
+
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+namespace {
+
+// Everything collected from one chunk of the eventlog file
+struct ChunkResult
+{
+    std::vector<EventIndexFile::EventRecord> events;
+    std::vector<std::pair<eventnumber_t, eventnumber_t>> reuseDependencies; // (cause, consequence)
+    std::unordered_map<msgid_t, msgid_t> messageIdToTreeId; // from message creation and send entries
+    std::vector<std::pair<eventnumber_t, msgid_t>> beginSends; // (sender event, message id)
+    std::vector<std::pair<eventnumber_t, msgid_t>> selfMessageSends; // (sender event, message id)
+    std::vector<std::pair<msgid_t, eventnumber_t>> messageTreeSends; // (tree id, sender event)
+    std::string errorMessage;
+};
+
+struct FileInformation
+{
+    int64_t size;
+    int64_t modificationTime;
+};
+
+FileInformation getFileInformation(const char *fileName)
+{
+    struct opp_stat_t s;
+    if (opp_stat(fileName, &s) != 0)
+        throw opp_runtime_error("Cannot stat file '%s'", fileName);
+    return FileInformation { (int64_t)s.st_size, (int64_t)s.st_mtime };
+}
+
+bool isMessageDescriptionEntry(const char *code)
+{
+    return !strcmp(code, "BS") || !strcmp(code, "ES") || !strcmp(code, "CM") || !strcmp(code, "CL") || !strcmp(code, "DM") || !strcmp(code, "CE") || !strcmp(code, "EF");
+}
+
+const char *findValue(char **tokens, int numTokens, const char *key)
+{
+    for (int i = 1; i + 1 < numTokens; i += 2)
+        if (!strcmp(tokens[i], key))
+            return tokens[i + 1];
+    return nullptr;
+}
+
+int64_t findInt(char **tokens, int numTokens, const char *key, int64_t defaultValue)
+{
+    const char *value = findValue(tokens, numTokens, key);
+    return value ? strtoll(value, nullptr, 10) : defaultValue;
+}
+
+// Returns the offset of the first top-level entry (event, snapshot or index) at or after the given offset.
+file_offset_t findChunkBoundary(FileReader& reader, file_offset_t offset)
+{
+    // skip the rest of the line containing offset - 1, so that the next line starts at or after offset
+    reader.seekTo(offset - 1);
+    reader.getNextLineBufferPointer();
+    char *line;
+    while ((line = reader.getNextLineBufferPointer()) != nullptr)
+        if ((line[0] == 'E' || line[0] == 'S' || line[0] == 'I') && line[1] == ' ')
+            return reader.getCurrentLineStartOffset();
+    return reader.getFileSize();
+}
+
+void parseChunk(const char *fileName, file_offset_t beginOffset, file_offset_t endOffset, ChunkResult& result)
+{
+    try {
+        FileReader reader(fileName);
+        BinaryEventlogDecoder::setupFileReader(&reader);
+        reader.setCheckFileForChanges(false);
+        LineTokenizer tokenizer(reader.getMaxLineSize() + 1);
+        EventIndexFile::EventRecord *event = nullptr;
+        msgid_t lastBeginSendMessageId = -1; // of the previous line if it was the first BS line of the message
+        std::vector<msgid_t> eventBeginSendMessageIds; // messages sent in the current event
+        reader.seekTo(beginOffset);
+        char *line;
+        while ((line = reader.getNextLineBufferPointer()) != nullptr) {
+            file_offset_t lineStartOffset = reader.getCurrentLineStartOffset();
+            if (lineStartOffset >= endOffset)
+                break;
+            int length = reader.getCurrentLineLength();
+            if (length == 0 || line[0] == '\r' || line[0] == '\n') {
+                if (event) {
+                    event->endOffset = reader.getCurrentLineEndOffset();
+                    event = nullptr;
+                }
+                lastBeginSendMessageId = -1;
+                continue;
+            }
+            if (line[0] == 'E' && line[1] == ' ') {
+                tokenizer.tokenize(line, length);
+                char **tokens = tokenizer.tokens();
+                int numTokens = tokenizer.numTokens();
+                EventIndexFile::EventRecord record;
+                record.eventNumber = findInt(tokens, numTokens, "#", -1);
+                record.beginOffset = lineStartOffset;
+                record.endOffset = reader.getCurrentLineEndOffset();
+                record.causeEventNumber = findInt(tokens, numTokens, "ce", -1);
+                record.messageId = findInt(tokens, numTokens, "msg", -1);
+                record.messageTreeId = -1;
+                record.moduleId = findInt(tokens, numTokens, "m", -1);
+                record.flags = 0;
+                if (record.eventNumber == -1)
+                    throw opp_runtime_error("Missing event number at file offset %" PRId64, (int64_t)lineStartOffset);
+                result.events.push_back(record);
+                event = &result.events.back();
+                eventBeginSendMessageIds.clear();
+                lastBeginSendMessageId = -1;
+                continue;
+            }
+            if (event && line[0] != '-') {
+                char code[16];
+                int i = 0;
+                while (i < length && i < (int)sizeof(code) - 1 && line[i] != ' ' && line[i] != '\t' && line[i] != '\r' && line[i] != '\n')
+                    code[i] = line[i], i++;
+                code[i] = '\0';
+                // the event ends at the first unknown entry, see Event::parseLines()
+                if (!EventLogEntryFactory::isKnownEntryCode(code)) {
+                    event->endOffset = reader.getCurrentLineEndOffset();
+                    event = nullptr;
+                    lastBeginSendMessageId = -1;
+                    continue;
+                }
+                // only message related entries are interesting, skip everything else without tokenizing
+                if (isMessageDescriptionEntry(code)) {
+                    tokenizer.tokenize(line, length);
+                    char **tokens = tokenizer.tokens();
+                    int numTokens = tokenizer.numTokens();
+                    msgid_t messageId = findInt(tokens, numTokens, "id", -1);
+                    msgid_t messageTreeId = findInt(tokens, numTokens, "tid", -1);
+                    eventnumber_t previousEventNumber = findInt(tokens, numTokens, "pe", -1);
+                    if (messageId != -1 && messageTreeId != -1)
+                        result.messageIdToTreeId[messageId] = messageTreeId;
+                    // see Event::getCauses()
+                    if (previousEventNumber != -1 && previousEventNumber != event->eventNumber)
+                        result.reuseDependencies.push_back(std::make_pair(previousEventNumber, event->eventNumber));
+                    // see Event::isSelfMessage(), only the first send of a message is considered by Event::getCause()
+                    if (!strcmp(code, "ES") && lastBeginSendMessageId != -1)
+                        result.selfMessageSends.push_back(std::make_pair(event->eventNumber, lastBeginSendMessageId));
+                    lastBeginSendMessageId = -1;
+                    if (!strcmp(code, "BS")) {
+                        if (std::find(eventBeginSendMessageIds.begin(), eventBeginSendMessageIds.end(), messageId) == eventBeginSendMessageIds.end()) {
+                            eventBeginSendMessageIds.push_back(messageId);
+                            result.beginSends.push_back(std::make_pair(event->eventNumber, messageId));
+                            lastBeginSendMessageId = messageId;
+                        }
+                        if (messageTreeId != -1)
+                            result.messageTreeSends.push_back(std::make_pair(messageTreeId, event->eventNumber));
+                    }
+                    continue;
+                }
+            }
+            lastBeginSendMessageId = -1;
+        }
+    }
+    catch (std::exception& e) {
+        result.errorMessage = e.what();
+    }
+}
+
+struct MessageSendHash
+{
+    size_t operator()(const std::pair<eventnumber_t, msgid_t>& p) const { return std::hash<int64_t>()(p.first * 0x9E3779B97F4A7C15ULL ^ p.second); }
+};
+
+void writeData(FILE *f, const void *data, size_t size, const char *fileName)
+{
+    if (size > 0 && fwrite(data, 1, size, f) != size)
+        throw opp_runtime_error("Cannot write event index file '%s'", fileName);
+}
+
+void readData(FILE *f, void *data, size_t size, const char *fileName)
+{
+    if (size > 0 && fread(data, 1, size, f) != size)
+        throw opp_runtime_error("Cannot read event index file '%s': file is truncated or corrupt", fileName);
+}
+
+template<typename T> void writeValue(FILE *f, T value, const char *fileName) { writeData(f, &value, sizeof(T), fileName); }
+template<typename T> T readValue(FILE *f, const char *fileName) { T value; readData(f, &value, sizeof(T), fileName); return value; }
+
+template<typename T> void writeVector(FILE *f, const std::vector<T>& v, const char *fileName)
+{
+    writeValue<uint64_t>(f, v.size(), fileName);
+    writeData(f, v.data(), v.size() * sizeof(T), fileName);
+}
+
+template<typename T> void readVector(FILE *f, std::vector<T>& v, const char *fileName)
+{
+    v.resize(readValue<uint64_t>(f, fileName));
+    readData(f, v.data(), v.size() * sizeof(T), fileName);
+}
+
+template<typename K> void writePostingLists(FILE *f, const std::map<K, std::vector<eventnumber_t>>& map, const char *fileName)
+{
+    writeValue<uint64_t>(f, map.size(), fileName);
+    for (auto& it : map) {
+        writeValue<int64_t>(f, it.first, fileName);
+        writeVector(f, it.second, fileName);
+    }
+}
+
+template<typename K> void readPostingLists(FILE *f, std::map<K, std::vector<eventnumber_t>>& map, const char *fileName)
+{
+    uint64_t size = readValue<uint64_t>(f, fileName);
+    for (uint64_t i = 0; i < size; i++) {
+        K key = (K)readValue<int64_t>(f, fileName);
+        readVector(f, map[key], fileName);
+    }
+}
+
+template<typename K> void addPosting(std::map<K, std::vector<eventnumber_t>>& map, K key, eventnumber_t eventNumber)
+{
+    std::vector<eventnumber_t>& eventNumbers = map[key];
+    if (eventNumbers.empty() || eventNumbers.back() != eventNumber)
+        eventNumbers.push_back(eventNumber);
+}
+
+}  // namespace
+
+EventIndexFile::EventIndexFile(const char *fileName) : fileName(fileName)
+{
+    FILE *f = fopen(fileName, "rb");
+    if (!f)
+        throw opp_runtime_error("Cannot open event index file '%s'", fileName);
+    try {
+        char magic[sizeof(EVENTINDEXFILE_MAGIC) - 1];
+        if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) || memcmp(magic, EVENTINDEXFILE_MAGIC, sizeof(magic)))
+            throw opp_runtime_error("File '%s' is not an event index file", fileName);
+        if (readValue<uint32_t>(f, fileName) != BYTE_ORDER_MARK)
+            throw opp_runtime_error("Event index file '%s' was written on a platform with different byte order", fileName);
+        eventLogFileSize = readValue<int64_t>(f, fileName);
+        eventLogModificationTime = readValue<int64_t>(f, fileName);
+        readVector(f, events, fileName);
+        readVector(f, causeBegins, fileName);
+        readVector(f, causes, fileName);
+        readVector(f, consequenceBegins, fileName);
+        readVector(f, consequences, fileName);
+        readPostingLists(f, moduleIdToEventNumbers, fileName);
+        readPostingLists(f, messageTreeIdToEventNumbers, fileName);
+        if (causeBegins.size() != events.size() + 1 || consequenceBegins.size() != events.size() + 1)
+            throw opp_runtime_error("Event index file '%s' is corrupt", fileName);
+    }
+    catch (std::exception&) {
+        fclose(f);
+        throw;
+    }
+    fclose(f);
+}
+
+std::string EventIndexFile::getDefaultFileName(const char *eventLogFileName)
+{
+    return std::string(eventLogFileName) + ".eidx";
+}
+
+bool EventIndexFile::isUpToDate(const char *eventLogFileName, const char *indexFileName)
+{
+    FILE *f = fopen(indexFileName, "rb");
+    if (!f)
+        return false;
+    char magic[sizeof(EVENTINDEXFILE_MAGIC) - 1];
+    uint32_t byteOrderMark;
+    int64_t size, modificationTime;
+    bool ok = fread(magic, 1, sizeof(magic), f) == sizeof(magic) && !memcmp(magic, EVENTINDEXFILE_MAGIC, sizeof(magic)) &&
+              fread(&byteOrderMark, sizeof(byteOrderMark), 1, f) == 1 && byteOrderMark == BYTE_ORDER_MARK &&
+              fread(&size, sizeof(size), 1, f) == 1 && fread(&modificationTime, sizeof(modificationTime), 1, f) == 1;
+    fclose(f);
+    if (!ok)
+        return false;
+    FileInformation information = getFileInformation(eventLogFileName);
+    return information.size == size && information.modificationTime == modificationTime;
+}
+
+void EventIndexFile::build(const char *eventLogFileName, const char *indexFileName, int numThreads)
+{
+    FileInformation information = getFileInformation(eventLogFileName);
+    if (numThreads <= 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    // split the file into chunks, one per thread, but not smaller than a few megabytes;
+    // offsets are in the decoded text for binary eventlog files
+    const file_offset_t minChunkSize = 4 * 1024 * 1024;
+    std::vector<file_offset_t> boundaries;
+    boundaries.push_back(0);
+    file_offset_t size;
+    {
+        FileReader reader(eventLogFileName);
+        BinaryEventlogDecoder::setupFileReader(&reader);
+        reader.setCheckFileForChanges(false);
+        size = reader.getFileSize();
+        int numChunks = std::max((int64_t)1, std::min((int64_t)numThreads, size / minChunkSize));
+        for (int i = 1; i < numChunks; i++) {
+            file_offset_t boundary = findChunkBoundary(reader, size * i / numChunks);
+            if (boundary > boundaries.back() && boundary < size)
+                boundaries.push_back(boundary);
+        }
+    }
+    boundaries.push_back(size);
+
+    // parse the chunks in parallel
+    int numParsedChunks = boundaries.size() - 1;
+    std::vector<ChunkResult> chunks(numParsedChunks);
+    std::vector<std::thread> threads;
+    for (int i = 1; i < numParsedChunks; i++)
+        threads.push_back(std::thread(parseChunk, eventLogFileName, boundaries[i], boundaries[i + 1], std::ref(chunks[i])));
+    parseChunk(eventLogFileName, boundaries[0], boundaries[1], chunks[0]);
+    for (auto& thread : threads)
+        thread.join();
+    for (auto& chunk : chunks)
+        if (!chunk.errorMessage.empty())
+            throw opp_runtime_error("Error indexing eventlog file '%s': %s", eventLogFileName, chunk.errorMessage.c_str());
+
+    // merge
+    EventIndexFile index;
+    index.eventLogFileSize = information.size;
+    index.eventLogModificationTime = information.modificationTime;
+    std::unordered_map<msgid_t, msgid_t> messageIdToTreeId;
+    std::unordered_set<std::pair<eventnumber_t, msgid_t>, MessageSendHash> beginSends;
+    std::unordered_set<std::pair<eventnumber_t, msgid_t>, MessageSendHash> selfMessageSends;
+    std::vector<std::pair<eventnumber_t, eventnumber_t>> dependencies; // (cause, consequence)
+    std::vector<int64_t> dependencyKinds;
+    for (auto& chunk : chunks) {
+        for (auto& event : chunk.events) {
+            if (!index.events.empty() && event.eventNumber <= index.events.back().eventNumber)
+                throw opp_runtime_error("Error indexing eventlog file '%s': event numbers are not increasing at event #%" EVENTNUMBER_PRINTF_FORMAT, eventLogFileName, event.eventNumber);
+            index.events.push_back(event);
+        }
+        messageIdToTreeId.insert(chunk.messageIdToTreeId.begin(), chunk.messageIdToTreeId.end());
+        beginSends.insert(chunk.beginSends.begin(), chunk.beginSends.end());
+        selfMessageSends.insert(chunk.selfMessageSends.begin(), chunk.selfMessageSends.end());
+        for (auto& dependency : chunk.reuseDependencies) {
+            dependencies.push_back(dependency);
+            dependencyKinds.push_back(REUSE_DEPENDENCY);
+        }
+        for (auto& send : chunk.messageTreeSends)
+            addPosting(index.messageTreeIdToEventNumbers, send.first, send.second);
+        chunk = ChunkResult();
+    }
+    for (auto& event : index.events) {
+        // see Event::getCause()
+        if (event.causeEventNumber != -1 && beginSends.find(std::make_pair(event.causeEventNumber, event.messageId)) != beginSends.end()) {
+            dependencies.push_back(std::make_pair(event.causeEventNumber, event.eventNumber));
+            dependencyKinds.push_back(SEND_DEPENDENCY);
+            if (selfMessageSends.find(std::make_pair(event.causeEventNumber, event.messageId)) != selfMessageSends.end())
+                event.flags |= SELF_MESSAGE_PROCESSING;
+        }
+        auto it = messageIdToTreeId.find(event.messageId);
+        if (it != messageIdToTreeId.end()) {
+            event.messageTreeId = it->second;
+            addPosting(index.messageTreeIdToEventNumbers, event.messageTreeId, event.eventNumber);
+        }
+        addPosting(index.moduleIdToEventNumbers, event.moduleId, event.eventNumber);
+    }
+    for (auto& it : index.messageTreeIdToEventNumbers) {
+        std::sort(it.second.begin(), it.second.end());
+        it.second.erase(std::unique(it.second.begin(), it.second.end()), it.second.end());
+    }
+
+    // build the compressed sparse rows, dependencies to events outside the file (e.g. a partial eventlog) are dropped
+    size_t numEvents = index.events.size();
+    std::vector<uint64_t> numCauses(numEvents, 0), numConsequences(numEvents, 0);
+    std::vector<std::pair<int64_t, int64_t>> dependencyIndices(dependencies.size()); // (cause index, consequence index)
+    for (size_t i = 0; i < dependencies.size(); i++) {
+        int64_t causeIndex = index.findEventIndex(dependencies[i].first);
+        int64_t consequenceIndex = index.findEventIndex(dependencies[i].second);
+        dependencyIndices[i] = std::make_pair(causeIndex, consequenceIndex);
+        if (causeIndex != -1 && consequenceIndex != -1) {
+            numCauses[consequenceIndex]++;
+            numConsequences[causeIndex]++;
+        }
+    }
+    index.causeBegins.resize(numEvents + 1);
+    index.consequenceBegins.resize(numEvents + 1);
+    index.causeBegins[0] = index.consequenceBegins[0] = 0;
+    for (size_t i = 0; i < numEvents; i++) {
+        index.causeBegins[i + 1] = index.causeBegins[i] + numCauses[i];
+        index.consequenceBegins[i + 1] = index.consequenceBegins[i] + numConsequences[i];
+    }
+    index.causes.resize(index.causeBegins[numEvents]);
+    index.consequences.resize(index.consequenceBegins[numEvents]);
+    std::fill(numCauses.begin(), numCauses.end(), 0);
+    std::fill(numConsequences.begin(), numConsequences.end(), 0);
+    for (size_t i = 0; i < dependencies.size(); i++) {
+        int64_t causeIndex = dependencyIndices[i].first;
+        int64_t consequenceIndex = dependencyIndices[i].second;
+        if (causeIndex != -1 && consequenceIndex != -1) {
+            index.causes[index.causeBegins[consequenceIndex] + numCauses[consequenceIndex]++] = Dependency { dependencies[i].first, dependencyKinds[i] };
+            index.consequences[index.consequenceBegins[causeIndex] + numConsequences[causeIndex]++] = Dependency { dependencies[i].second, dependencyKinds[i] };
+        }
+    }
+
+    index.write(indexFileName);
+}
+
+void EventIndexFile::write(const char *fileName)
+{
+    FILE *f = fopen(fileName, "wb");
+    if (!f)
+        throw opp_runtime_error("Cannot open event index file '%s' for write", fileName);
+    try {
+        writeData(f, EVENTINDEXFILE_MAGIC, sizeof(EVENTINDEXFILE_MAGIC) - 1, fileName);
+        writeValue<uint32_t>(f, BYTE_ORDER_MARK, fileName);
+        writeValue<int64_t>(f, eventLogFileSize, fileName);
+        writeValue<int64_t>(f, eventLogModificationTime, fileName);
+        writeVector(f, events, fileName);
+        writeVector(f, causeBegins, fileName);
+        writeVector(f, causes, fileName);
+        writeVector(f, consequenceBegins, fileName);
+        writeVector(f, consequences, fileName);
+        writePostingLists(f, moduleIdToEventNumbers, fileName);
+        writePostingLists(f, messageTreeIdToEventNumbers, fileName);
+    }
+    catch (std::exception&) {
+        fclose(f);
+        remove(fileName);
+        throw;
+    }
+    if (fclose(f) != 0)
+        throw opp_runtime_error("Cannot write event index file '%s'", fileName);
+    this->fileName = fileName;
+}
+
+int64_t EventIndexFile::findEventIndex(eventnumber_t eventNumber) const
+{
+    // event numbers are usually contiguous, so try direct addressing first
+    if (!events.empty()) {
+        int64_t guess = eventNumber - events.front().eventNumber;
+        if (guess >= 0 && guess < (int64_t)events.size() && events[guess].eventNumber == eventNumber)
+            return guess;
+    }
+    auto it = std::lower_bound(events.begin(), events.end(), eventNumber, [] (const EventRecord& record, eventnumber_t eventNumber) { return record.eventNumber < eventNumber; });
+    if (it != events.end() && it->eventNumber == eventNumber)
+        return it - events.begin();
+    return -1;
+}
+
+const EventIndexFile::EventRecord *EventIndexFile::getEventRecord(eventnumber_t eventNumber) const
+{
+    int64_t index = findEventIndex(eventNumber);
+    return index == -1 ? nullptr : &events[index];
+}
+
+int EventIndexFile::getNumCauses(eventnumber_t eventNumber) const
+{
+    int64_t index = findEventIndex(eventNumber);
+    return index == -1 ? 0 : causeBegins[index + 1] - causeBegins[index];
+}
+
+const EventIndexFile::Dependency& EventIndexFile::getCause(eventnumber_t eventNumber, int i) const
+{
+    int64_t index = findEventIndex(eventNumber);
+    if (index == -1 || i < 0 || causeBegins[index] + i >= causeBegins[index + 1])
+        throw opp_runtime_error("Cause index %d out of range for event #%" EVENTNUMBER_PRINTF_FORMAT, i, eventNumber);
+    return causes[causeBegins[index] + i];
+}
+
+int EventIndexFile::getNumConsequences(eventnumber_t eventNumber) const
+{
+    int64_t index = findEventIndex(eventNumber);
+    return index == -1 ? 0 : consequenceBegins[index + 1] - consequenceBegins[index];
+}
+
+const EventIndexFile::Dependency& EventIndexFile::getConsequence(eventnumber_t eventNumber, int i) const
+{
+    int64_t index = findEventIndex(eventNumber);
+    if (index == -1 || i < 0 || consequenceBegins[index] + i >= consequenceBegins[index + 1])
+        throw opp_runtime_error("Consequence index %d out of range for event #%" EVENTNUMBER_PRINTF_FORMAT, i, eventNumber);
+    return consequences[consequenceBegins[index] + i];
+}
+
+void EventIndexFile::collectTransitiveCauses(eventnumber_t eventNumber, bool traceSelfMessages, bool traceMessageReuses, eventnumber_t fromEventNumber, std::vector<eventnumber_t>& result) const
+{
+    collectTransitiveDependencies(eventNumber, false, traceSelfMessages, traceMessageReuses, fromEventNumber, result);
+}
+
+void EventIndexFile::collectTransitiveConsequences(eventnumber_t eventNumber, bool traceSelfMessages, bool traceMessageReuses, eventnumber_t toEventNumber, std::vector<eventnumber_t>& result) const
+{
+    collectTransitiveDependencies(eventNumber, true, traceSelfMessages, traceMessageReuses, toEventNumber, result);
+}
+
+void EventIndexFile::collectTransitiveDependencies(eventnumber_t eventNumber, bool forward, bool traceSelfMessages, bool traceMessageReuses, eventnumber_t limitEventNumber, std::vector<eventnumber_t>& result) const
+{
+    // breadth first search over event indices; the same conditions apply as in FilteredEventLog::isCauseOfTracedEvent()
+    result.clear();
+    int64_t startIndex = findEventIndex(eventNumber);
+    if (startIndex == -1)
+        return;
+    const std::vector<uint64_t>& begins = forward ? consequenceBegins : causeBegins;
+    const std::vector<Dependency>& dependencies = forward ? consequences : causes;
+    std::vector<bool> visited(events.size(), false);
+    std::vector<int64_t> queue;
+    visited[startIndex] = true;
+    queue.push_back(startIndex);
+    for (size_t i = 0; i < queue.size(); i++) {
+        int64_t index = queue[i];
+        for (uint64_t j = begins[index]; j < begins[index + 1]; j++) {
+            const Dependency& dependency = dependencies[j];
+            if (!traceMessageReuses && dependency.kind == REUSE_DEPENDENCY)
+                continue;
+            if (limitEventNumber != -1 && (forward ? dependency.eventNumber > limitEventNumber : dependency.eventNumber < limitEventNumber))
+                continue;
+            int64_t otherIndex = findEventIndex(dependency.eventNumber);
+            if (visited[otherIndex])
+                continue;
+            if (!traceSelfMessages && (events[otherIndex].flags & SELF_MESSAGE_PROCESSING))
+                continue;
+            visited[otherIndex] = true;
+            queue.push_back(otherIndex);
+            result.push_back(dependency.eventNumber);
+        }
+    }
+    std::sort(result.begin(), result.end());
+}
+
+}  // namespace eventlog
+}  // namespace omnetpp
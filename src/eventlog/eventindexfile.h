@@ -0,0 +1,144 @@
+//=========================================================================
+//  EVENTINDEXFILE.H - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_EVENTLOG_EVENTINDEXFILE_H
+#define __OMNETPP_EVENTLOG_EVENTINDEXFILE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include "eventlogdefs.h"
+
+namespace omnetpp {
+namespace eventlog {
+
+#define EVENTINDEXFILE_MAGIC  "OMNETPP-EVENTLOG-INDEX 1\n"
+
+/**
+ * A persistent index of an eventlog file, stored in a sidecar file next to it.
+ * It contains the file offset, module and processed message of every event,
+ * the message dependency edges between events (message sends and message
+ * reuses, in both directions), and posting lists of events per module and per
+ * message tree. This allows filtered views to find matching events and to
+ * trace causes and consequences without parsing the events in between.
+ *
+ * The index is built offline by build(), which splits the eventlog file into
+ * chunks aligned to top-level entries (events, snapshots and indices),
+ * parses the chunks on multiple threads, and merges the results. The index
+ * records the size and modification time of the eventlog file, so a stale
+ * index can be detected with isUpToDate().
+ */
+class EVENTLOG_API EventIndexFile
+{
+    public:
+        enum DependencyKind {
+            SEND_DEPENDENCY,
+            REUSE_DEPENDENCY
+        };
+
+        enum EventFlags {
+            SELF_MESSAGE_PROCESSING = 1
+        };
+
+        struct EventRecord {
+            eventnumber_t eventNumber;
+            file_offset_t beginOffset;
+            file_offset_t endOffset; // including the following empty line
+            eventnumber_t causeEventNumber; // the "ce" field of the event entry
+            msgid_t messageId; // the processed message
+            msgid_t messageTreeId; // the tree id of the processed message, or -1 if unknown
+            int32_t moduleId;
+            int32_t flags;
+        };
+
+        struct Dependency {
+            eventnumber_t eventNumber; // the event on the other end of the dependency
+            int64_t kind; // DependencyKind
+        };
+
+    protected:
+        std::string fileName;
+        int64_t eventLogFileSize = -1;
+        int64_t eventLogModificationTime = -1;
+
+        std::vector<EventRecord> events; // ordered by event number
+
+        // dependencies in compressed sparse row form, the dependencies of events[i] are in [begin[i], begin[i+1])
+        std::vector<uint64_t> causeBegins;
+        std::vector<Dependency> causes;
+        std::vector<uint64_t> consequenceBegins;
+        std::vector<Dependency> consequences;
+
+        // posting lists: ordered event numbers
+        std::map<int, std::vector<eventnumber_t>> moduleIdToEventNumbers; // events processed in the module
+        std::map<msgid_t, std::vector<eventnumber_t>> messageTreeIdToEventNumbers; // events processing or sending messages of the tree
+
+    public:
+        /**
+         * Loads the index from the given file.
+         */
+        EventIndexFile(const char *fileName);
+
+        /**
+         * Returns the name of the sidecar index file for the given eventlog file.
+         */
+        static std::string getDefaultFileName(const char *eventLogFileName);
+
+        /**
+         * Returns true if the index file exists, and it was built from the
+         * current content of the eventlog file.
+         */
+        static bool isUpToDate(const char *eventLogFileName, const char *indexFileName);
+
+        /**
+         * Builds the index of the given text eventlog file, and writes it into
+         * indexFileName. Uses the given number of threads, or as many as
+         * there are CPU cores if numThreads is 0.
+         */
+        static void build(const char *eventLogFileName, const char *indexFileName, int numThreads = 0);
+
+        const char *getFileName() const { return fileName.c_str(); }
+        eventnumber_t getNumEvents() const { return events.size(); }
+        const EventRecord *getEventRecord(eventnumber_t eventNumber) const;
+
+        int getNumCauses(eventnumber_t eventNumber) const;
+        const Dependency& getCause(eventnumber_t eventNumber, int index) const;
+        int getNumConsequences(eventnumber_t eventNumber) const;
+        const Dependency& getConsequence(eventnumber_t eventNumber, int index) const;
+
+        /**
+         * Collects the transitive causes (or consequences) of the given event in
+         * increasing event number order, not including the event itself. Events
+         * outside [fromEventNumber, toEventNumber] are not visited (-1 means
+         * unlimited); this does not lose events inside the range, since all
+         * dependencies point forward in event number.
+         */
+        void collectTransitiveCauses(eventnumber_t eventNumber, bool traceSelfMessages, bool traceMessageReuses, eventnumber_t fromEventNumber, std::vector<eventnumber_t>& result) const;
+        void collectTransitiveConsequences(eventnumber_t eventNumber, bool traceSelfMessages, bool traceMessageReuses, eventnumber_t toEventNumber, std::vector<eventnumber_t>& result) const;
+
+        const std::map<int, std::vector<eventnumber_t>>& getModuleIdToEventNumbers() const { return moduleIdToEventNumbers; }
+        const std::map<msgid_t, std::vector<eventnumber_t>>& getMessageTreeIdToEventNumbers() const { return messageTreeIdToEventNumbers; }
+
+    protected:
+        EventIndexFile() {}
+        int64_t findEventIndex(eventnumber_t eventNumber) const;
+        void collectTransitiveDependencies(eventnumber_t eventNumber, bool forward, bool traceSelfMessages, bool traceMessageReuses, eventnumber_t limitEventNumber, std::vector<eventnumber_t>& result) const;
+        void write(const char *fileName);
+};
+
+}  // namespace eventlog
+}  // namespace omnetpp
+
+
+#endif
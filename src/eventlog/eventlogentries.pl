@@ -555,6 +555,27 @@ print FACTORY_CC_FILE "        return nullptr;\n\n";
 print FACTORY_CC_FILE "    entry->parse(tokens, numTokens);\n";
 print FACTORY_CC_FILE "    return entry;\n";
 print FACTORY_CC_FILE "}\n\n";
+
+print FACTORY_CC_FILE "bool EventLogEntryFactory::isKnownEntryCode(const char *code)\n";
+print FACTORY_CC_FILE "{\n";
+print FACTORY_CC_FILE "    if (false)\n";
+print FACTORY_CC_FILE "        ;\n";
+foreach $class (@classes)
+{
+   if ($class->{CODE} ne "abstract")
+   {
+      print FACTORY_CC_FILE "    else if (";
+      $i=0;
+      foreach $c (split(//, $class->{CODE})) {
+          print FACTORY_CC_FILE "code\[$i\]=='$c' && ";
+          $i++;
+      }
+      print FACTORY_CC_FILE "code[$i]==0)  // $class->{CODE}\n";
+      print FACTORY_CC_FILE "        return true;\n";
+   }
+}
+print FACTORY_CC_FILE "    return false;\n";
+print FACTORY_CC_FILE "}\n\n";
 print FACTORY_CC_FILE "} // namespace eventlog\n} // namespace omnetpp\n";
 
 close(FACTORY_CC_FILE);
@@ -25,6 +25,11 @@ class EVENTLOG_API EventLogEntryFactory
 {
    public:
       static EventLogTokenBasedEntry * parseEntry(IChunk *chunk, int index, char **tokens, int numTokens);
+
+      /**
+       * Returns true if parseEntry() would accept an entry with the given code.
+       */
+      static bool isKnownEntryCode(const char *code);
 };
 
 }  // namespace eventlog
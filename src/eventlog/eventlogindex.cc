@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <cinttypes>
 #include "common/exception.h"
+#include "common/binaryeventlog.h"
 #include "eventlogentry.h"
 #include "eventlogindex.h"
 
@@ -93,6 +94,7 @@ void EventLogIndex::CacheEntry::getEndKey(simtime_t& key)
 
 EventLogIndex::EventLogIndex(FileReader *reader): reader(reader)
 {
+    BinaryEventlogDecoder::setupFileReader(reader);  // binary eventlog files are read as text
     this->tokenizer = new LineTokenizer(reader->getMaxLineSize() + 1);
     clearInternalState();
 }
@@ -121,7 +121,8 @@ class EVENTLOG_API EventLogIndex
 
     public:
         /**
-         * The reader will be deleted with this object.
+         * The reader will be deleted with this object. Binary eventlog files
+         * are read as the equivalent text eventlog, see BinaryEventlogDecoder.
          */
         EventLogIndex(FileReader *reader);
         virtual ~EventLogIndex();
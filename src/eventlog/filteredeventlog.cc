@@ -14,6 +14,8 @@
 
 #include <cstdio>
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include "filteredeventlog.h"
 
 namespace omnetpp {
@@ -43,6 +45,11 @@ void FilteredEventLog::clearInternalState()
     eventNumberToTraceableEventFlagMap.clear();
     unseenTracedEventCauseEventNumbers.clear();
     unseenTracedEventConsequenceEventNumbers.clear();
+    candidateEventNumbersComputed = false;
+    hasCandidateEventNumbers = false;
+    candidateEventNumbers.clear();
+    tracedEventCauseEventNumbers.clear();
+    tracedEventConsequenceEventNumbers.clear();
 }
 
 void FilteredEventLog::deleteAllocatedObjects()
@@ -57,6 +64,15 @@ void FilteredEventLog::deleteAllocatedObjects()
 void FilteredEventLog::synchronize(FileReader::FileChange change)
 {
     if (change != FileReader::UNCHANGED) {
+        // the index does not cover the changed content
+        if (eventIndexFile) {
+            eventIndexFile = nullptr;
+            candidateEventNumbersComputed = false;
+            hasCandidateEventNumbers = false;
+            candidateEventNumbers.clear();
+            tracedEventCauseEventNumbers.clear();
+            tracedEventConsequenceEventNumbers.clear();
+        }
         switch (change) {
             case FileReader::OVERWRITTEN:
                 eventLog->synchronize(change);
@@ -86,7 +102,17 @@ void FilteredEventLog::synchronize(FileReader::FileChange change)
 
 void FilteredEventLog::print(FILE *file, eventnumber_t fromEventNumber, eventnumber_t toEventNumber, bool outputEventLogMessages)
 {
-    throw opp_runtime_error("Not implemented");
+    IEventLog::print(file, fromEventNumber, toEventNumber, outputEventLogMessages);
+}
+
+void FilteredEventLog::setEventIndexFile(EventIndexFile *eventIndexFile)
+{
+    this->eventIndexFile = eventIndexFile;
+    candidateEventNumbersComputed = false;
+    hasCandidateEventNumbers = false;
+    candidateEventNumbers.clear();
+    tracedEventCauseEventNumbers.clear();
+    tracedEventConsequenceEventNumbers.clear();
 }
 
 void FilteredEventLog::setPatternMatchers(std::vector<PatternMatcher>& patternMatchers, std::vector<std::string>& patterns, bool dottedPath)
@@ -521,6 +547,12 @@ FilteredEvent *FilteredEventLog::getMatchingEventInDirection(IEvent *event, bool
 
     Assert(event);
 
+    if (eventIndexFile) {
+        ensureCandidateEventNumbers();
+        if (hasCandidateEventNumbers)
+            return getMatchingCandidateEventInDirection(event->getEventNumber(), forward, stopEventNumber);
+    }
+
     // LONG RUNNING OPERATION
     // if none of firstEventNumber, lastEventNumber, stopEventNumber is set this might take a while
     while (event) {
@@ -575,6 +607,11 @@ bool FilteredEventLog::isCauseOfTracedEvent(IEvent *causeEvent)
     // printf("Checking if %ld is cause of %ld\n", causeEvent->getEventNumber(), tracedEventNumber);
 
     eventnumber_t causeEventNumber = causeEvent->getEventNumber();
+    if (eventIndexFile) {
+        ensureCandidateEventNumbers();
+        return std::binary_search(tracedEventCauseEventNumbers.begin(), tracedEventCauseEventNumbers.end(), causeEventNumber);
+    }
+    bool found = false;
     while (!unseenTracedEventCauseEventNumbers.empty() && unseenTracedEventCauseEventNumbers.front() >= causeEventNumber) {
         eventnumber_t unseenTracedEventCauseEventNumber = unseenTracedEventCauseEventNumbers.front();
         unseenTracedEventCauseEventNumbers.pop_front();
@@ -588,14 +625,21 @@ bool FilteredEventLog::isCauseOfTracedEvent(IEvent *causeEvent)
                     (traceMessageReuses || !dynamic_cast<MessageReuseDependency *>(messageDependency)))
                 {
                     eventnumber_t newUnseenTracedEventCauseEventNumber = newUnseenTracedEventCauseEvent->getEventNumber();
+                    // events reachable on multiple paths are visited only once
+                    EventNumberToBooleanMap::iterator jt = eventNumberToTraceableEventFlagMap.find(newUnseenTracedEventCauseEventNumber);
+                    if (jt != eventNumberToTraceableEventFlagMap.end() && jt->second)
+                        continue;
                     eventNumberToTraceableEventFlagMap[newUnseenTracedEventCauseEventNumber] = true;
                     unseenTracedEventCauseEventNumbers.push_back(newUnseenTracedEventCauseEventNumber);
                     if (newUnseenTracedEventCauseEventNumber == causeEventNumber)
-                        return true;
+                        found = true;
                 }
             }
             // TODO: this is far from being optimal, inserting the items in the right place would be more desirable
-            sort(unseenTracedEventCauseEventNumbers.begin(), unseenTracedEventCauseEventNumbers.end());
+            // causes are visited in decreasing event number order, so that the loop condition above is correct
+            sort(unseenTracedEventCauseEventNumbers.begin(), unseenTracedEventCauseEventNumbers.end(), std::greater<eventnumber_t>());
+            if (found)
+                return true;
         }
     }
 
@@ -615,6 +659,11 @@ bool FilteredEventLog::isConsequenceOfTracedEvent(IEvent *consequenceEvent)
 
     // like isCauseOfTracedEvent(), but searching from the opposite direction
     eventnumber_t consequenceEventNumber = consequenceEvent->getEventNumber();
+    if (eventIndexFile) {
+        ensureCandidateEventNumbers();
+        return std::binary_search(tracedEventConsequenceEventNumbers.begin(), tracedEventConsequenceEventNumbers.end(), consequenceEventNumber);
+    }
+    bool found = false;
     while (!unseenTracedEventConsequenceEventNumbers.empty() && unseenTracedEventConsequenceEventNumbers.front() <= consequenceEventNumber) {
         eventnumber_t unseenTracedEventConsequenceEventNumber = unseenTracedEventConsequenceEventNumbers.front();
         unseenTracedEventConsequenceEventNumbers.pop_front();
@@ -628,20 +677,133 @@ bool FilteredEventLog::isConsequenceOfTracedEvent(IEvent *consequenceEvent)
                     (traceMessageReuses || !dynamic_cast<MessageReuseDependency *>(messageDependency)))
                 {
                     eventnumber_t newUnseenTracedEventConsequenceEventNumber = newUnseenTracedEventConsequenceEvent->getEventNumber();
+                    // events reachable on multiple paths are visited only once
+                    EventNumberToBooleanMap::iterator jt = eventNumberToTraceableEventFlagMap.find(newUnseenTracedEventConsequenceEventNumber);
+                    if (jt != eventNumberToTraceableEventFlagMap.end() && jt->second)
+                        continue;
                     eventNumberToTraceableEventFlagMap[newUnseenTracedEventConsequenceEventNumber] = true;
                     unseenTracedEventConsequenceEventNumbers.push_back(newUnseenTracedEventConsequenceEventNumber);
                     if (newUnseenTracedEventConsequenceEventNumber == consequenceEventNumber)
-                        return true;
+                        found = true;
                 }
             }
             // TODO: this is far from being optimal, inserting the items in the right place would be more desirable
             sort(unseenTracedEventConsequenceEventNumbers.begin(), unseenTracedEventConsequenceEventNumbers.end());
+            if (found)
+                return true;
         }
     }
 
     return eventNumberToTraceableEventFlagMap[consequenceEventNumber] = false;
 }
 
+FilteredEvent *FilteredEventLog::getMatchingCandidateEventInDirection(eventnumber_t eventNumber, bool forward, eventnumber_t stopEventNumber)
+{
+    // same as the linear search, but only visits the events the index could not rule out
+    if (forward) {
+        auto it = std::lower_bound(candidateEventNumbers.begin(), candidateEventNumbers.end(), eventNumber);
+        for (; it != candidateEventNumbers.end(); it++) {
+            if ((lastConsideredEventNumber != -1 && *it > lastConsideredEventNumber) || (stopEventNumber != -1 && *it > stopEventNumber))
+                return nullptr;
+            eventLog->progress();
+            IEvent *event = eventLog->getEventForEventNumber(*it);
+            if (event && matchesFilter(event))
+                return cacheFilteredEvent(*it);
+        }
+    }
+    else {
+        auto it = std::upper_bound(candidateEventNumbers.begin(), candidateEventNumbers.end(), eventNumber);
+        while (it != candidateEventNumbers.begin()) {
+            --it;
+            if ((firstConsideredEventNumber != -1 && *it < firstConsideredEventNumber) || (stopEventNumber != -1 && *it < stopEventNumber))
+                return nullptr;
+            eventLog->progress();
+            IEvent *event = eventLog->getEventForEventNumber(*it);
+            if (event && matchesFilter(event))
+                return cacheFilteredEvent(*it);
+        }
+    }
+    return nullptr;
+}
+
+void FilteredEventLog::ensureCandidateEventNumbers()
+{
+    if (candidateEventNumbersComputed)
+        return;
+    candidateEventNumbersComputed = true;
+    bool restricted = false;
+    candidateEventNumbers.clear();
+    auto restrictTo = [&] (std::vector<eventnumber_t>& eventNumbers) {
+        std::sort(eventNumbers.begin(), eventNumbers.end());
+        eventNumbers.erase(std::unique(eventNumbers.begin(), eventNumbers.end()), eventNumbers.end());
+        if (!restricted)
+            candidateEventNumbers.swap(eventNumbers);
+        else {
+            std::vector<eventnumber_t> intersection;
+            std::set_intersection(candidateEventNumbers.begin(), candidateEventNumbers.end(), eventNumbers.begin(), eventNumbers.end(), std::back_inserter(intersection));
+            candidateEventNumbers.swap(intersection);
+        }
+        restricted = true;
+    };
+
+    // see matchesDependency()
+    if (tracedEventNumber != -1) {
+        eventIndexFile->collectTransitiveCauses(tracedEventNumber, traceSelfMessages, traceMessageReuses, firstConsideredEventNumber, tracedEventCauseEventNumbers);
+        eventIndexFile->collectTransitiveConsequences(tracedEventNumber, traceSelfMessages, traceMessageReuses, lastConsideredEventNumber, tracedEventConsequenceEventNumbers);
+        std::vector<eventnumber_t> eventNumbers;
+        eventNumbers.push_back(tracedEventNumber);
+        if (traceCauses)
+            eventNumbers.insert(eventNumbers.end(), tracedEventCauseEventNumbers.begin(), tracedEventCauseEventNumbers.end());
+        if (traceConsequences)
+            eventNumbers.insert(eventNumbers.end(), tracedEventConsequenceEventNumbers.begin(), tracedEventConsequenceEventNumbers.end());
+        restrictTo(eventNumbers);
+    }
+
+    // see matchesEvent(), events in submodules of a matching compound module are candidates too
+    if (enableModuleFilter) {
+        std::vector<eventnumber_t> eventNumbers;
+        for (auto& it : eventIndexFile->getModuleIdToEventNumbers())
+            if (matchesModuleIdOrAncestor(it.first))
+                eventNumbers.insert(eventNumbers.end(), it.second.begin(), it.second.end());
+        restrictTo(eventNumbers);
+    }
+
+    // the index knows message trees only, so other message criteria are left to matchesEvent()
+    if (enableMessageFilter && !messageTreeIds.empty() && !hasMessageExpression && messageNames.empty() && messageClassNames.empty() &&
+        messageIds.empty() && messageEncapsulationIds.empty() && messageEncapsulationTreeIds.empty())
+    {
+        std::vector<eventnumber_t> eventNumbers;
+        const std::map<msgid_t, std::vector<eventnumber_t>>& messageTreeIdToEventNumbers = eventIndexFile->getMessageTreeIdToEventNumbers();
+        for (auto messageTreeId : messageTreeIds) {
+            auto it = messageTreeIdToEventNumbers.find(messageTreeId);
+            if (it != messageTreeIdToEventNumbers.end())
+                eventNumbers.insert(eventNumbers.end(), it->second.begin(), it->second.end());
+        }
+        restrictTo(eventNumbers);
+    }
+
+    hasCandidateEventNumbers = restricted;
+}
+
+bool FilteredEventLog::matchesModuleIdOrAncestor(int moduleId)
+{
+    // modules whose description is not (yet) known are conservatively considered matching
+    ModuleDescriptionEntry *moduleDescriptionEntry = getEventLogEntryCache()->getModuleDescriptionEntry(moduleId);
+    if (!moduleDescriptionEntry)
+        return true;
+    while (moduleDescriptionEntry) {
+        if (matchesModuleDescriptionEntry(moduleDescriptionEntry))
+            return true;
+        int parentModuleId = moduleDescriptionEntry->parentModuleId;
+        if (parentModuleId == -1)
+            return false;
+        moduleDescriptionEntry = getEventLogEntryCache()->getModuleDescriptionEntry(parentModuleId);
+        if (!moduleDescriptionEntry)
+            return true;
+    }
+    return false;
+}
+
 FilteredEvent *FilteredEventLog::cacheFilteredEvent(eventnumber_t eventNumber)
 {
     EventNumberToFilteredEventMap::iterator it = eventNumberToFilteredEventMap.find(eventNumber);
@@ -19,9 +19,11 @@
 #include <deque>
 #include "common/patternmatcher.h"
 #include "common/matchexpression.h"
+#include "common/stringutil.h"
 #include "eventlogdefs.h"
 #include "ieventlog.h"
 #include "eventlog.h"
+#include "eventindexfile.h"
 #include "filteredevent.h"
 
 namespace omnetpp {
@@ -95,6 +97,15 @@ class EVENTLOG_API FilteredEventLog : public IEventLog
         FilteredEvent *firstMatchingEvent;
         FilteredEvent *lastMatchingEvent;
 
+        // optional persistent index, used to avoid parsing events which cannot match
+        EventIndexFile *eventIndexFile = nullptr; // not owned
+        bool hasMessageExpression = false;
+        bool candidateEventNumbersComputed = false;
+        bool hasCandidateEventNumbers = false;
+        std::vector<eventnumber_t> candidateEventNumbers; // ordered superset of the matching events, valid if hasCandidateEventNumbers
+        std::vector<eventnumber_t> tracedEventCauseEventNumbers; // ordered transitive causes of the traced event
+        std::vector<eventnumber_t> tracedEventConsequenceEventNumbers; // ordered transitive consequences of the traced event
+
     public:
         FilteredEventLog(IEventLog *eventLog);
         virtual ~FilteredEventLog();
@@ -118,7 +129,7 @@ class EVENTLOG_API FilteredEventLog : public IEventLog
         void setModuleIds(std::vector<int> &moduleIds) { this->moduleIds = moduleIds; }
 
         void setEnableMessageFilter(bool enableMessageFilter) { this->enableMessageFilter = enableMessageFilter; }
-        void setMessageExpression(const char *messageExpression) { if (messageExpression) this->messageExpression.setPattern(messageExpression, false, true, false); }
+        void setMessageExpression(const char *messageExpression) { if (messageExpression) { this->messageExpression.setPattern(messageExpression, false, true, false); hasMessageExpression = !omnetpp::common::opp_isblank(messageExpression); } }
         void setMessageNames(std::vector<std::string> &messageNames) { setPatternMatchers(this->messageNames, messageNames); }
         void setMessageClassNames(std::vector<std::string> &messageClassNames) { setPatternMatchers(this->messageClassNames, messageClassNames); }
         void setMessageIds(std::vector<msgid_t> &messageIds) { this->messageIds = messageIds; }
@@ -134,6 +145,14 @@ class EVENTLOG_API FilteredEventLog : public IEventLog
 
         IEventLog *getEventLog() { return eventLog; }
 
+        /**
+         * Sets the persistent index of the underlying eventlog file, or nullptr.
+         * The index must be up to date (see EventIndexFile::isUpToDate()), and it
+         * is not deleted by this object. It is dropped when the file changes.
+         */
+        void setEventIndexFile(EventIndexFile *eventIndexFile);
+        EventIndexFile *getEventIndexFile() { return eventIndexFile; }
+
         int getMaximumCauseDepth() { return maximumCauseDepth; }
         void setMaximumCauseDepth(int maximumCauseDepth) { this->maximumCauseDepth = maximumCauseDepth; }
         int getMaximumNumberOfCauses() { return maximumNumberOfCauses; }
@@ -215,6 +234,9 @@ class EVENTLOG_API FilteredEventLog : public IEventLog
         template <typename T> bool matchesList(std::vector<T> &elements, T element);
         bool isCauseOfTracedEvent(IEvent *cause);
         bool isConsequenceOfTracedEvent(IEvent *consequence);
+        void ensureCandidateEventNumbers();
+        bool matchesModuleIdOrAncestor(int moduleId);
+        FilteredEvent *getMatchingCandidateEventInDirection(eventnumber_t eventNumber, bool forward, eventnumber_t stopEventNumber);
         double getApproximateMatchingEventRatio();
         void setPatternMatchers(std::vector<PatternMatcher> &patternMatchers, std::vector<std::string> &patterns, bool dottedPath = false);
 
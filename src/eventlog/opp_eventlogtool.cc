@@ -13,13 +13,16 @@
 *--------------------------------------------------------------*/
 
 #include <ctime>
+#include <chrono>
 #include "common/ver.h"
 #include "common/filereader.h"
 #include "common/linetokenizer.h"
+#include "common/binaryeventlog.h"
 #include "omnetpp/platdep/platmisc.h"
 #include "eventlogindex.h"
 #include "eventlog.h"
 #include "filteredeventlog.h"
+#include "eventindexfile.h"
 
 #if defined(__MINGW32__)
 int _CRT_glob = 0;  // Turn off runtime file globbing support on MinGW. The shell already handles file globbing on the command line.
@@ -67,15 +70,28 @@ class Options
         std::vector<msgid_t> messageEncapsulationIds;
         std::vector<msgid_t> messageEncapsulationTreeIds;
 
+        int simtimeScaleExp = -12;
+
+        bool memoryMapping = false;
+        int numThreads = 0;
         bool verbose = false;
 
     public:
+        FileReader *createFileReader(FileReader::AccessPattern accessPattern);
         IEventLog *createEventLog(FileReader *fileReader);
         void deleteEventLog(IEventLog *eventLog);
         eventnumber_t getFirstEventNumber();
         eventnumber_t getLastEventNumber();
 };
 
+FileReader *Options::createFileReader(FileReader::AccessPattern accessPattern)
+{
+    FileReader *fileReader = new FileReader(inputFileName);
+    fileReader->setMemoryMapping(memoryMapping);
+    fileReader->setAccessPattern(accessPattern);
+    return fileReader;
+}
+
 IEventLog *Options::createEventLog(FileReader *fileReader)
 {
     if (eventNumbers.empty() &&
@@ -86,7 +102,8 @@ IEventLog *Options::createEventLog(FileReader *fileReader)
         return new EventLog(fileReader);
     }
     else {
-        FilteredEventLog *filteredEventLog = new FilteredEventLog(new EventLog(fileReader));
+        EventLog *eventLog = new EventLog(fileReader);
+        FilteredEventLog *filteredEventLog = new FilteredEventLog(eventLog);
 
         if (!eventNumbers.empty())
             filteredEventLog->setTracedEventNumber(eventNumbers.at(0));
@@ -112,6 +129,12 @@ IEventLog *Options::createEventLog(FileReader *fileReader)
         filteredEventLog->setFirstConsideredEventNumber(getFirstEventNumber());
         filteredEventLog->setLastConsideredEventNumber(getLastEventNumber());
 
+        // use the index built by the index command if it is up to date
+        const char *fileName = eventLog->getFileReader()->getFileName();
+        std::string indexFileName = EventIndexFile::getDefaultFileName(fileName);
+        if (EventIndexFile::isUpToDate(fileName, indexFileName.c_str()))
+            filteredEventLog->setEventIndexFile(new EventIndexFile(indexFileName.c_str()));
+
         return filteredEventLog;
     }
 }
@@ -120,8 +143,10 @@ void Options::deleteEventLog(IEventLog *eventLog)
 {
     FilteredEventLog *filteredEventLog = dynamic_cast<FilteredEventLog *>(eventLog);
 
-    if (filteredEventLog)
+    if (filteredEventLog) {
         delete filteredEventLog->getEventLog();
+        delete filteredEventLog->getEventIndexFile();
+    }
 
     delete eventLog;
 }
@@ -132,7 +157,7 @@ eventnumber_t Options::getFirstEventNumber()
         if (fromEventNumber != -1)
             firstEventNumber = fromEventNumber;
         else if (fromSimulationTime != simtime_nil) {
-            FileReader *fileReader = new FileReader(inputFileName);
+            FileReader *fileReader = createFileReader(FileReader::ACCESS_RANDOM);
             EventLog eventLog(fileReader);
             IEvent *event = eventLog.getEventForSimulationTime(fromSimulationTime, FIRST_OR_NEXT);
             if (event)
@@ -153,7 +178,7 @@ eventnumber_t Options::getLastEventNumber()
         if (toEventNumber != -1)
             lastEventNumber = toEventNumber;
         else if (toSimulationTime != simtime_nil) {
-            FileReader *fileReader = new FileReader(inputFileName);
+            FileReader *fileReader = createFileReader(FileReader::ACCESS_RANDOM);
             EventLog eventLog(fileReader);
             IEvent *event = eventLog.getEventForSimulationTime(toSimulationTime, LAST_OR_PREVIOUS);
             if (event)
@@ -173,7 +198,7 @@ void offsets(Options options)
     if (options.verbose)
         fprintf(stdout, "# Printing event offsets from log file %s\n", options.inputFileName);
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = options.createFileReader(FileReader::ACCESS_RANDOM);
     EventLogIndex eventLogIndex(fileReader);
 
     long begin = clock();
@@ -205,7 +230,7 @@ void events(Options options)
     if (options.verbose)
         fprintf(stdout, "# Printing events from log file %s\n", options.inputFileName);
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = options.createFileReader(FileReader::ACCESS_RANDOM);
     EventLog eventLog(fileReader);
 
     long begin = clock();
@@ -232,7 +257,7 @@ void ranges(Options options)
     if (options.verbose)
         fprintf(stdout, "# Printing continuous ranges from log file %s\n", options.inputFileName);
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = options.createFileReader(FileReader::ACCESS_NORMAL);
     EventLog eventLog(fileReader);
 
     long begin = clock();
@@ -262,7 +287,7 @@ void echo(Options options)
     if (options.verbose)
         fprintf(stdout, "# Echoing events from log file %s from event number #%" EVENTNUMBER_PRINTF_FORMAT " to event number #%" EVENTNUMBER_PRINTF_FORMAT "\n", options.inputFileName, options.getFirstEventNumber(), options.getLastEventNumber());
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = options.createFileReader(FileReader::ACCESS_SEQUENTIAL);
     IEventLog *eventLog = options.createEventLog(fileReader);
 
     long begin = clock();
@@ -280,7 +305,8 @@ void cat(Options options)
     if (options.verbose)
         fprintf(stdout, "# Cating from file %s\n", options.inputFileName);
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = options.createFileReader(FileReader::ACCESS_SEQUENTIAL);
+    BinaryEventlogDecoder::setupFileReader(fileReader);
 
     long begin = clock();
     char *line;
@@ -300,7 +326,7 @@ void filter(Options options)
         fprintf(stdout, "# Filtering events from log file %s for traced event number #%" EVENTNUMBER_PRINTF_FORMAT " from event number #%" EVENTNUMBER_PRINTF_FORMAT " to event number #%" EVENTNUMBER_PRINTF_FORMAT "\n",
                 options.inputFileName, tracedEventNumber, options.getFirstEventNumber(), options.getLastEventNumber());
 
-    FileReader *fileReader = new FileReader(options.inputFileName);
+    FileReader *fileReader = options.createFileReader(FileReader::ACCESS_NORMAL);
     IEventLog *eventLog = options.createEventLog(fileReader);
 
     long begin = clock();
@@ -313,6 +339,113 @@ void filter(Options options)
     options.deleteEventLog(eventLog);
 }
 
+void buildIndex(Options options)
+{
+    const char *fileName = options.inputFileName;
+    std::string indexFileName = EventIndexFile::getDefaultFileName(fileName);
+
+    if (options.verbose)
+        fprintf(stdout, "# Indexing log file %s into %s\n", fileName, indexFileName.c_str());
+
+    long begin = clock();
+    auto beginTime = std::chrono::steady_clock::now();
+    EventIndexFile::build(fileName, indexFileName.c_str(), options.numThreads);
+    auto endTime = std::chrono::steady_clock::now();
+    long end = clock();
+
+    if (options.verbose) {
+        EventIndexFile eventIndexFile(indexFileName.c_str());
+        fprintf(stdout, "# Indexing of %" EVENTNUMBER_PRINTF_FORMAT " events from log file %s completed in %g seconds (%g seconds CPU time)\n", eventIndexFile.getNumEvents(), fileName,
+                std::chrono::duration<double>(endTime - beginTime).count(), (double)(end - begin) / CLOCKS_PER_SEC);
+    }
+}
+
+void tobinary(Options options)
+{
+    if (!options.outputFileName)
+        throw opp_runtime_error("The tobinary command requires an output file (-o)");
+    if (BinaryEventlogReader::isBinaryEventlogFile(options.inputFileName))
+        throw opp_runtime_error("'%s' is already a binary eventlog file", options.inputFileName);
+
+    if (options.verbose)
+        fprintf(stdout, "# Converting text eventlog file %s to binary eventlog file %s\n", options.inputFileName, options.outputFileName);
+
+    FileReader *fileReader = options.createFileReader(FileReader::ACCESS_SEQUENTIAL);
+    BinaryEventlogWriter writer(options.outputFile, options.outputFileName, options.simtimeScaleExp);
+
+    long begin = clock();
+    char *line;
+    while ((line = fileReader->getNextLineBufferPointer()))
+        writer.writeTextLine(line, fileReader->getCurrentLineLength());
+    writer.writeFooter();
+    long end = clock();
+
+    if (options.verbose)
+        fprintf(stdout, "# Converting of %" PRId64 " lines and %" PRId64 " bytes from log file %s completed in %g seconds\n", fileReader->getNumReadLines(), fileReader->getNumReadBytes(), options.inputFileName, (double)(end - begin) / CLOCKS_PER_SEC);
+
+    delete fileReader;
+}
+
+void totext(Options options)
+{
+    if (options.verbose)
+        fprintf(stdout, "# Converting binary eventlog file %s to text\n", options.inputFileName);
+
+    BinaryEventlogReader reader(options.inputFileName);
+
+    // use the index to skip to the first requested event, then filter by event lines
+    bool hasFrom = options.fromEventNumber != -1 || options.fromSimulationTime != simtime_nil;
+    bool hasTo = options.toEventNumber != -1 || options.toSimulationTime != simtime_nil;
+    if (options.fromEventNumber != -1)
+        reader.seekToEvent(options.fromEventNumber);
+    else if (options.fromSimulationTime != simtime_nil)
+        reader.seekToSimulationTime(options.fromSimulationTime.getMantissaForScale(reader.getSimtimeScaleExp()));
+
+    long begin = clock();
+    std::string line;
+    int64_t numLines = 0;
+    bool inRange = !hasFrom;
+    int numPendingEmptyLines = 0;  // empty lines belong to the next event
+    LineTokenizer tokenizer;
+    while (reader.readLine(line)) {
+        if (line == "\n") {
+            numPendingEmptyLines++;
+            continue;
+        }
+        if ((hasFrom || hasTo) && line[0] == 'E' && line[1] == ' ') {
+            tokenizer.tokenize(line.c_str(), line.size());
+            char **tokens = tokenizer.tokens();
+            eventnumber_t eventNumber = -1;
+            simtime_t simulationTime = simtime_nil;
+            for (int i = 1; i + 1 < tokenizer.numTokens(); i += 2) {
+                if (!strcmp(tokens[i], "#"))
+                    eventNumber = strtoll(tokens[i + 1], nullptr, 10);
+                else if (!strcmp(tokens[i], "t"))
+                    simulationTime = BigDecimal::parse(tokens[i + 1]);
+            }
+            if ((options.toEventNumber != -1 && eventNumber > options.toEventNumber) ||
+                (options.toSimulationTime != simtime_nil && simulationTime > options.toSimulationTime))
+                break;
+            inRange = (options.fromEventNumber == -1 || eventNumber >= options.fromEventNumber) &&
+                      (options.fromSimulationTime == simtime_nil || simulationTime >= options.fromSimulationTime);
+        }
+        if (inRange) {
+            for ( ; numPendingEmptyLines > 0; numPendingEmptyLines--)
+                fputc('\n', options.outputFile);
+            fwrite(line.data(), 1, line.size(), options.outputFile);
+            numLines++;
+        }
+        numPendingEmptyLines = 0;
+    }
+    if (inRange && !hasTo)
+        for ( ; numPendingEmptyLines > 0; numPendingEmptyLines--)
+            fputc('\n', options.outputFile);
+    long end = clock();
+
+    if (options.verbose)
+        fprintf(stdout, "# Converting of %" PRId64 " lines from log file %s completed in %g seconds\n", numLines, options.inputFileName, (double)(end - begin) / CLOCKS_PER_SEC);
+}
+
 void usage(const char *message)
 {
     if (message)
@@ -332,6 +465,12 @@ void usage(const char *message)
 "      echo        - echos the input to the output, range options are supported.\n"
 "      filter      - filters the input according to the various options and outputs the result, only one event number is traced,\n"
 "                    but it may be outside of the specified event number or simulation time range.\n"
+"      tobinary    - converts a text eventlog file to the binary eventlog format, the output file (-o) must be specified.\n"
+"      totext      - converts a binary eventlog file to text, range options are supported and use the index of the binary file.\n"
+"      index       - builds a persistent event index into <input-file-name>.eidx using multiple threads (-j). The filter\n"
+"                    command uses the index automatically as long as it is up to date.\n"
+"\n"
+"   Binary eventlog files (see the eventlog-file-format configuration option) are accepted as input by all commands.\n"
 "\n"
 "   Options: Not all options may be used for all commands. Some options optionally accept a list of\n"
 "            space separated tokens as a single parameter. Name and class name filters may include patterns.\n"
@@ -364,6 +503,12 @@ void usage(const char *message)
 "      -ob     --omit-causes-trace\n"
 "      -of     --omit-consequences-trace\n"
 "      -ol     --omit-log-lines\n"
+"      -s      --simtime-scale-exponent           <integer>\n"
+"         the simulation time scale exponent used by tobinary, defaults to -12\n"
+"      -m      --memory-mapping\n"
+"         reads the input file via memory mapping instead of buffered reads\n"
+"      -j      --threads                          <integer>\n"
+"         the number of threads used by index, defaults to the number of CPU cores\n"
 "      -v      --verbose\n"
 "         prints performance information\n");
 }
@@ -484,6 +629,12 @@ int main(int argc, char **argv)
                         options.traceConsequences = false;
                     else if (!strcmp(argv[i], "-ol") || !strcmp(argv[i], "--omit-log-lines"))
                         options.outputLogLines = false;
+                    else if (!strcmp(argv[i], "-s") || !strcmp(argv[i], "--simtime-scale-exponent"))
+                        options.simtimeScaleExp = atoi(argv[++i]);
+                    else if (!strcmp(argv[i], "-m") || !strcmp(argv[i], "--memory-mapping"))
+                        options.memoryMapping = true;
+                    else if (!strcmp(argv[i], "-j") || !strcmp(argv[i], "--threads"))
+                        options.numThreads = atoi(argv[++i]);
                     else if (i == argc - 1)
                         options.inputFileName = argv[i];
                 }
@@ -497,7 +648,7 @@ int main(int argc, char **argv)
                 usage("No input file specified");
             else {
                 if (options.outputFileName)
-                    options.outputFile = fopen(options.outputFileName, "w");
+                    options.outputFile = fopen(options.outputFileName, "wb");
                 else
                     options.outputFile = stdout;
 
@@ -513,6 +664,12 @@ int main(int argc, char **argv)
                     echo(options);
                 else if (!strcmp(command, "cat"))
                     cat(options);
+                else if (!strcmp(command, "tobinary"))
+                    tobinary(options);
+                else if (!strcmp(command, "totext"))
+                    totext(options);
+                else if (!strcmp(command, "index"))
+                    buildIndex(options);
                 else
                     usage("Unknown or invalid command");
 
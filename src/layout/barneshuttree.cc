@@ -0,0 +1,154 @@
+//=========================================================================
+//  BARNESHUTTREE.CC - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cfloat>
+#include <cmath>
+#include "barneshuttree.h"
+
+namespace omnetpp {
+namespace layout {
+
+void BarnesHutTree::build(const std::vector<ChargedPoint>& points, const std::vector<int>& groups, int numGroups)
+{
+    this->points = points;
+    int n = points.size();
+    cells.clear();
+    roots.assign(numGroups, -1);
+
+    // sort point indices by group (counting sort keeps the original order within groups)
+    std::vector<int> groupStart(numGroups + 1, 0);
+    for (int i = 0; i < n; i++)
+        groupStart[(groups.empty() ? 0 : groups[i]) + 1]++;
+    for (int g = 0; g < numGroups; g++)
+        groupStart[g + 1] += groupStart[g];
+    order.resize(n);
+    std::vector<int> next(groupStart.begin(), groupStart.end() - 1);
+    for (int i = 0; i < n; i++)
+        order[next[groups.empty() ? 0 : groups[i]]++] = i;
+
+    for (int g = 0; g < numGroups; g++) {
+        int begin = groupStart[g], end = groupStart[g + 1];
+        if (begin == end)
+            continue;
+        double minX = DBL_MAX, minY = DBL_MAX, maxX = -DBL_MAX, maxY = -DBL_MAX;
+        for (int k = begin; k < end; k++) {
+            const ChargedPoint& p = points[order[k]];
+            minX = std::min(minX, p.x);
+            minY = std::min(minY, p.y);
+            maxX = std::max(maxX, p.x);
+            maxY = std::max(maxY, p.y);
+        }
+        double size = std::max(maxX - minX, maxY - minY);
+        size = size * (1 + 1e-9) + 1e-9;  // make sure that all points are strictly inside
+        roots[g] = cells.size();
+        cells.push_back(Cell());
+        buildCell(roots[g], begin, end, minX, minY, size, 0);
+    }
+}
+
+void BarnesHutTree::buildCell(int index, int begin, int end, double x, double y, double size, int depth)
+{
+    Cell cell;
+    cell.x = x;
+    cell.y = y;
+    cell.size = size;
+    cell.begin = begin;
+    cell.end = end;
+    cell.firstChild = -1;
+
+    if (end - begin > LEAF_SIZE && depth < MAX_DEPTH) {
+        // split into quadrants: top-left, top-right, bottom-left, bottom-right
+        double half = size / 2, midX = x + half, midY = y + half;
+        int *first = order.data() + begin, *last = order.data() + end;
+        int *midRow = std::partition(first, last, [&](int i) {return points[i].y < midY;});
+        int *topMid = std::partition(first, midRow, [&](int i) {return points[i].x < midX;});
+        int *bottomMid = std::partition(midRow, last, [&](int i) {return points[i].x < midX;});
+        int tm = topMid - order.data(), mr = midRow - order.data(), bm = bottomMid - order.data();
+
+        // children are consecutive
+        cell.firstChild = cells.size();
+        cells.resize(cells.size() + 4);
+        buildCell(cell.firstChild, begin, tm, x, y, half, depth + 1);
+        buildCell(cell.firstChild + 1, tm, mr, midX, y, half, depth + 1);
+        buildCell(cell.firstChild + 2, mr, bm, x, midY, half, depth + 1);
+        buildCell(cell.firstChild + 3, bm, end, midX, midY, half, depth + 1);
+    }
+
+    // aggregate charge
+    double charge = 0, sx = 0, sy = 0, sz = 0;
+    double minZ = DBL_MAX, maxZ = -DBL_MAX;
+    for (int k = begin; k < end; k++) {
+        const ChargedPoint& p = points[order[k]];
+        charge += p.charge;
+        sx += p.charge * p.x;
+        sy += p.charge * p.y;
+        sz += p.charge * p.z;
+        minZ = std::min(minZ, p.z);
+        maxZ = std::max(maxZ, p.z);
+    }
+    cell.charge = charge;
+    cell.cx = charge > 0 ? sx / charge : x + size / 2;
+    cell.cy = charge > 0 ? sy / charge : y + size / 2;
+    cell.cz = charge > 0 ? sz / charge : 0;
+    cell.minZ = begin == end ? 0 : minZ;
+    cell.maxZ = begin == end ? 0 : maxZ;
+    cells[index] = cell;  // note: 'cells' may have been reallocated meanwhile
+}
+
+void PointGrid::build(const std::vector<ChargedPoint>& points, double range)
+{
+    int n = points.size();
+    items.clear();
+    cellStart.clear();
+    if (n == 0)
+        return;
+
+    double minX = DBL_MAX, minY = DBL_MAX, maxX = -DBL_MAX, maxY = -DBL_MAX;
+    for (const auto& p : points) {
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+
+    // cells must not be smaller than the range; use larger ones if there would be
+    // many more cells than points, so that memory use stays O(n)
+    double width = maxX - minX, height = maxY - minY;
+    cellSize = std::max(range, std::sqrt(width * height / (4.0 * n)));
+    cellSize = std::max(cellSize, std::max(width, height) / (4.0 * n));
+    cellSize = std::max(cellSize, 1e-9);
+    x0 = minX;
+    y0 = minY;
+    numCols = (int)(width / cellSize) + 1;
+    numRows = (int)(height / cellSize) + 1;
+
+    // counting sort of points into cells
+    std::vector<int> cellOf(n);
+    cellStart.assign(numCols * numRows + 1, 0);
+    for (int i = 0; i < n; i++) {
+        int col = std::min(numCols - 1, (int)((points[i].x - x0) / cellSize));
+        int row = std::min(numRows - 1, (int)((points[i].y - y0) / cellSize));
+        cellOf[i] = row * numCols + col;
+        cellStart[cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < numCols * numRows; c++)
+        cellStart[c + 1] += cellStart[c];
+    items.resize(n);
+    std::vector<int> next(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < n; i++)
+        items[next[cellOf[i]]++] = i;
+}
+
+}  // namespace layout
+}  // namespace omnetpp
@@ -0,0 +1,202 @@
+//=========================================================================
+//  BARNESHUTTREE.H - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_LAYOUT_BARNESHUTTREE_H
+#define __OMNETPP_LAYOUT_BARNESHUTTREE_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "layoutdefs.h"
+
+namespace omnetpp {
+namespace layout {
+
+/**
+ * A point with an electric charge, as input for BarnesHutTree and PointGrid.
+ */
+struct ChargedPoint
+{
+    double x, y, z;
+    double charge;
+};
+
+/**
+ * A quadtree over charged points, for computing repulsive forces with the
+ * Barnes-Hut approximation: O(log n) work per point instead of O(n).
+ *
+ * Each cell of the tree stores the total charge and the center of charge
+ * of the points in it. When collecting the interactions of a point, a cell
+ * that is far away compared to its size (size / distance < theta) is
+ * reported as a single point charge; otherwise its children are visited,
+ * and the points of leaf cells are reported one by one. The force law is
+ * up to the caller.
+ *
+ * Points may be partitioned into groups (e.g. connected components), each
+ * group getting a tree of its own. The tree is built on the x and y
+ * coordinates; the extent of the points along z is taken into account in
+ * the opening criterion.
+ *
+ * The tree is read-only after build(), so it may be queried from several
+ * threads at once.
+ */
+class LAYOUT_API BarnesHutTree
+{
+    private:
+        struct Cell {
+            double x, y, size;  // top-left corner and side length of the square
+            double minZ, maxZ;  // extent of the points along z
+            double cx, cy, cz;  // center of charge
+            double charge;      // total charge
+            int firstChild;     // index of the first of 4 consecutive children, or -1 for leaves
+            int begin, end;     // range in 'order'
+        };
+
+        static const int MAX_DEPTH = 40;  // limits subdivision of coincident points
+        static const int LEAF_SIZE = 8;
+
+        double theta;
+        std::vector<ChargedPoint> points;
+        std::vector<int> order;  // point indices; each cell covers a contiguous range
+        std::vector<Cell> cells;
+        std::vector<int> roots;  // root cell of each group, or -1 for empty groups
+
+    public:
+        /**
+         * The accuracy parameter: smaller values are more accurate, 0 means
+         * exact (and O(n) per point) computation. Usual values are 0.5..1.
+         */
+        BarnesHutTree(double theta = 0.7) : theta(theta) {}
+
+        /**
+         * Builds the tree(s). If groups is non-empty, it must contain the group
+         * index (0..numGroups-1) of each point, and a separate tree is built
+         * for each group.
+         */
+        void build(const std::vector<ChargedPoint>& points, const std::vector<int>& groups = std::vector<int>(), int numGroups = 1);
+
+        const ChargedPoint& getPoint(int i) const {return points[i];}
+
+        /**
+         * Collects the interactions of the given location with the points of
+         * the given group: calls far(cx, cy, cz, charge) for the cells that
+         * may be approximated, and near(i) for the other points (including
+         * the point at the location itself, if it is part of the group).
+         */
+        template<typename FarFunc, typename NearFunc>
+        void visit(int group, double x, double y, double z, const FarFunc& far, const NearFunc& near) const {
+            if (group < 0 || group >= (int)roots.size() || roots[group] == -1)
+                return;
+            int stack[3 * MAX_DEPTH + 4];
+            int sp = 0;
+            stack[sp++] = roots[group];
+            double theta2 = theta * theta;
+            while (sp > 0) {
+                const Cell& cell = cells[stack[--sp]];
+                if (cell.begin == cell.end)
+                    continue;
+                bool inside = x >= cell.x && x <= cell.x + cell.size && y >= cell.y && y <= cell.y + cell.size;
+                if (!inside && cell.charge > 0) {
+                    double dx = x - cell.cx, dy = y - cell.cy, dz = z - cell.cz;
+                    double size = std::max(cell.size, cell.maxZ - cell.minZ);
+                    if (size * size < theta2 * (dx * dx + dy * dy + dz * dz)) {
+                        far(cell.cx, cell.cy, cell.cz, cell.charge);
+                        continue;
+                    }
+                }
+                if (cell.firstChild == -1) {
+                    for (int k = cell.begin; k < cell.end; k++)
+                        near(order[k]);
+                }
+                else {
+                    for (int k = 0; k < 4; k++)
+                        stack[sp++] = cell.firstChild + k;
+                }
+            }
+        }
+
+    private:
+        void buildCell(int index, int begin, int end, double x, double y, double size, int depth);
+};
+
+/**
+ * A uniform grid over points, for finding the points within a given
+ * distance of a location (in the x-y plane) in O(1) average time, e.g.
+ * for forces with a finite range.
+ */
+class LAYOUT_API PointGrid
+{
+    private:
+        double x0 = 0, y0 = 0, cellSize = 1;
+        int numCols = 0, numRows = 0;
+        std::vector<int> cellStart;  // index into 'items' for each cell, plus one at the end
+        std::vector<int> items;      // point indices, grouped by cell
+
+    public:
+        /**
+         * Builds the grid so that the points within the given range of a
+         * location can be found by forEachNear().
+         */
+        void build(const std::vector<ChargedPoint>& points, double range);
+
+        /**
+         * Calls f(i) for the points that may be within range of the given
+         * location (and for some that are not); the caller has to check
+         * the distance.
+         */
+        template<typename Func>
+        void forEachNear(double x, double y, const Func& f) const {
+            if (items.empty())
+                return;
+            int col = std::max(0, std::min(numCols - 1, (int)((x - x0) / cellSize)));
+            int row = std::max(0, std::min(numRows - 1, (int)((y - y0) / cellSize)));
+            for (int r = std::max(0, row - 1); r <= std::min(numRows - 1, row + 1); r++) {
+                for (int c = std::max(0, col - 1); c <= std::min(numCols - 1, col + 1); c++) {
+                    int cell = r * numCols + c;
+                    for (int k = cellStart[cell]; k < cellStart[cell + 1]; k++)
+                        f(items[k]);
+                }
+            }
+        }
+};
+
+/**
+ * Calls f(i) for i=0..count-1 on numThreads threads (0 means the number of
+ * hardware threads), each thread processing a contiguous range. Small counts
+ * are processed on the calling thread.
+ */
+template<typename Func>
+void runInParallel(int count, int numThreads, const Func& f)
+{
+    const int minItemsPerThread = 256;
+    if (numThreads <= 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::max(1, std::min(numThreads, count / minItemsPerThread));
+    auto work = [&](int k) {
+        int end = (int)((long long)count * (k + 1) / numThreads);
+        for (int i = (int)((long long)count * k / numThreads); i < end; i++)
+            f(i);
+    };
+    std::vector<std::thread> threads;
+    for (int k = 1; k < numThreads; k++)
+        threads.push_back(std::thread(work, k));
+    work(0);
+    for (auto& thread : threads)
+        thread.join();
+}
+
+}  // namespace layout
+}  // namespace omnetpp
+
+#endif
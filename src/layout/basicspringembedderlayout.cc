@@ -25,6 +25,8 @@
 
 #include "common/commonutil.h"
 #include "basicspringembedderlayout.h"
+#include "barneshuttree.h"
+#include "multilevelembedding.h"
 
 using namespace omnetpp::common;
 
@@ -49,6 +51,7 @@ void BasicSpringEmbedderLayout::setEnvironment(GraphLayouterEnvironment *environ
     attractionForce = environment->getDoubleParameter("bgl", 1, attractionForce);
     defaultEdgeLen = environment->getDoubleParameter("bgl", 2, defaultEdgeLen);
     maxIterations = environment->getLongParameter("bgl", 3, maxIterations);
+    barnesHutThreshold = environment->getLongParameter("bgl", 4, barnesHutThreshold);
 }
 
 BasicSpringEmbedderLayout::Node *BasicSpringEmbedderLayout::findNode(int nodeId)
@@ -207,7 +210,7 @@ void BasicSpringEmbedderLayout::execute()
     }
 
     // partition the graph
-    int numColors = doColoring();
+    numColors = doColoring();
     markNodesConnectedToFixed(numColors);
 
     // now the real job -- stop if max moved distance is <0.05 at least 20 times in a row
@@ -326,6 +329,12 @@ void BasicSpringEmbedderLayout::assignInitialPositions()
         }
     }
 
+    // large graphs are better off with a proper initial layout than with random positions
+    if (!haveFixedNode && (int)nodes.size() >= barnesHutThreshold) {
+        assignMultilevelPositions(initialAreaOffsetX, initialAreaOffsetY);
+        return;
+    }
+
     // initialize variables (also randomize start positions over the initial area)
     for (auto & anchor : anchors) {
         Anchor& a = *anchor;
@@ -354,20 +363,70 @@ void BasicSpringEmbedderLayout::assignInitialPositions()
     }
 }
 
+void BasicSpringEmbedderLayout::assignMultilevelPositions(double offsetX, double offsetY)
+{
+    // one vertex for each anchor (as heavy as the nodes anchored to it), and one for each movable node
+    double edgeLen = 0;
+    for (auto & e : edges)
+        edgeLen += e.len;
+    edgeLen = edges.empty() ? defaultEdgeLen : edgeLen / edges.size();
+
+    MultilevelEmbedding embedding(edgeLen, lcgRandom.getSeed());
+    embedding.numThreads = numThreads;
+    std::map<Anchor *, int> anchorVertices;
+    for (auto anchor : anchors)
+        anchorVertices[anchor] = embedding.addVertex(anchor->refcount);
+    std::map<Node *, int> nodeVertices;
+    for (auto node : nodes)
+        nodeVertices[node] = node->anchor ? anchorVertices[node->anchor] : embedding.addVertex();
+    for (auto & e : edges)
+        embedding.addEdge(nodeVertices[e.src], nodeVertices[e.dest]);
+    embedding.embed();
+
+    // place the center of the anchored nodes' bounding box at the position of the anchor
+    for (auto & anchor : anchors) {
+        Anchor& a = *anchor;
+        const Pt& pt = embedding.getPosition(anchorVertices[anchor]);
+        a.x = offsetX + pt.x - (a.x1off + a.x2off) / 2;
+        a.y = offsetY + pt.y - (a.y1off + a.y2off) / 2;
+        a.vx = a.vy = 0;
+    }
+    for (auto & node : nodes) {
+        Node& n = *node;
+        if (n.anchor) {
+            n.x = n.anchor->x + n.offx;
+            n.y = n.anchor->y + n.offy;
+        }
+        else {
+            const Pt& pt = embedding.getPosition(nodeVertices[node]);
+            n.x = offsetX + pt.x;
+            n.y = offsetY + pt.y;
+        }
+        n.vx = n.vy = 0;
+    }
+}
+
 int BasicSpringEmbedderLayout::doColoring()
 {
-    NodeList::iterator i;
-    for (i = nodes.begin(); i != nodes.end(); ++i)
-        (*i)->color = -1;
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        nodes[i]->color = -1;
+        nodes[i]->index = i;
+    }
+
+    // neighbours of each node
+    std::vector<std::vector<Node *>> neighbours(nodes.size());
+    for (auto & e : edges) {
+        neighbours[e.src->index].push_back(e.dest);
+        neighbours[e.dest->index].push_back(e.src);
+    }
 
     int currentColor = 0;
     std::deque<Node *> todoList;
-    for (i = nodes.begin(); i != nodes.end(); ++i) {
-        Node *n = *i;
+    for (auto n : nodes) {
         if (n->color != -1)
             continue;  // already assigned
 
-        // breadth-width search to color all connected nodes (transitive closure)
+        // depth-first search to color all connected nodes (transitive closure)
         Assert(todoList.empty());
         todoList.push_back(n);  // start at this node
         while (!todoList.empty()) {
@@ -376,17 +435,10 @@ int BasicSpringEmbedderLayout::doColoring()
 
             n->color = currentColor;
 
-            // color and add to list all nodes connected to n.
-            // (edge list data structure is not really good for this, but execution
-            // time is still negligable compared to relax() iterations)
-            EdgeList::iterator k;
-            for (k = edges.begin(); k != edges.end(); ++k) {
-                Edge& e = *k;
-                if (e.src == n && e.dest->color == -1)
-                    todoList.push_back(e.dest);
-                else if (e.dest == n && e.src->color == -1)
-                    todoList.push_back(e.src);
-            }
+            // color and add to list all nodes connected to n
+            for (auto neighbour : neighbours[n->index])
+                if (neighbour->color == -1)
+                    todoList.push_back(neighbour);
         }
 
         // next color
@@ -469,7 +521,7 @@ double BasicSpringEmbedderLayout::relax()
 
     // Note: USE_CONTRACTING_BOX code was removed in version 4.1 -- if needed, it can be retrieved from earlier version
 
-    NodeList::iterator i, j;
+    NodeList::iterator i;
     EdgeList::iterator k;
     AnchorList::iterator l;
 
@@ -496,51 +548,10 @@ double BasicSpringEmbedderLayout::relax()
     }
 
     // nodes repulse each other, update (vx,vy) with this effect
-    //
-    // modification to the original algorithm: only nodes that share the
-    // same color (i.e., are connected) repulse each other -- repulsion between
-    // nodes of *different* colors ceases after a short distance. (This is done
-    // to avoid "blow-up" of non-connected graphs.)
-    //
-    for (i = nodes.begin(); i != nodes.end(); ++i) {
-        Node& n1 = *(*i);
-        if (n1.fixed)
-            continue;
-
-        double fx = 0;
-        double fy = 0;
-
-        // TBD performance improvement: use (i=0..N, j=i+1..N) loop unless more than N/2 nodes are fixed
-        for (j = nodes.begin(); j != nodes.end(); ++j) {
-            if (i == j)
-                continue;
-
-            Node& n2 = *(*j);
-            if (n1.anchor && n1.anchor == n2.anchor)
-                continue;
-
-            double deltax = n1.x - n2.x;
-            double deltay = n1.y - n2.y;
-            double distsq = deltax * deltax + deltay * deltay;
-
-            // different colors repulse only up to 100 units, so that unconnected networks do not blow up
-            if (n1.color == n2.color || distsq < 100*100) {
-                if (distsq < 1.0) {
-                    // use 1.0 instead of distsq, to avoid division by (near) zero;
-                    // plus add random noise to help nodes mode aways from each other
-                    fx += deltax + privRand01()-0.5;
-                    fy += deltay + privRand01()-0.5;
-                }
-                else {
-                    fx += deltax / distsq;
-                    fy += deltay / distsq;
-                }
-            }
-        }
-
-        n1.vx += repulsiveForce * fx;
-        n1.vy += repulsiveForce * fy;
-    }
+    if ((int)nodes.size() >= barnesHutThreshold)
+        applyApproximateRepulsion();
+    else
+        applyExactRepulsion();
 
     if (debug) {
         for (int i = 0; i < (int)nodes.size(); ++i) {
@@ -656,6 +667,140 @@ double BasicSpringEmbedderLayout::relax()
     return maxd;
 }
 
+void BasicSpringEmbedderLayout::applyExactRepulsion()
+{
+    // nodes repulse each other, update (vx,vy) with this effect
+    //
+    // modification to the original algorithm: only nodes that share the
+    // same color (i.e., are connected) repulse each other -- repulsion between
+    // nodes of *different* colors ceases after a short distance. (This is done
+    // to avoid "blow-up" of non-connected graphs.)
+    //
+    NodeList::iterator i, j;
+    for (i = nodes.begin(); i != nodes.end(); ++i) {
+        Node& n1 = *(*i);
+        if (n1.fixed)
+            continue;
+
+        double fx = 0;
+        double fy = 0;
+
+        // TBD performance improvement: use (i=0..N, j=i+1..N) loop unless more than N/2 nodes are fixed
+        for (j = nodes.begin(); j != nodes.end(); ++j) {
+            if (i == j)
+                continue;
+
+            Node& n2 = *(*j);
+            if (n1.anchor && n1.anchor == n2.anchor)
+                continue;
+
+            double deltax = n1.x - n2.x;
+            double deltay = n1.y - n2.y;
+            double distsq = deltax * deltax + deltay * deltay;
+
+            // different colors repulse only up to 100 units, so that unconnected networks do not blow up
+            if (n1.color == n2.color || distsq < 100*100) {
+                if (distsq < 1.0) {
+                    // use 1.0 instead of distsq, to avoid division by (near) zero;
+                    // plus add random noise to help nodes mode aways from each other
+                    fx += deltax + privRand01()-0.5;
+                    fy += deltay + privRand01()-0.5;
+                }
+                else {
+                    fx += deltax / distsq;
+                    fy += deltay / distsq;
+                }
+            }
+        }
+
+        n1.vx += repulsiveForce * fx;
+        n1.vy += repulsiveForce * fy;
+    }
+}
+
+// Replaces privRand01()-0.5 in applyApproximateRepulsion(), because random
+// numbers cannot be drawn from several threads in a reproducible way
+static double noise(int i, int j, int k)
+{
+    uint32_t h = (uint32_t)i * 0x9e3779b1u ^ (uint32_t)j * 0x85ebca77u ^ (uint32_t)k * 0xc2b2ae3du;
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    h ^= h >> 12;
+    return (h & 0xffff) / 65536.0 - 0.5;
+}
+
+void BasicSpringEmbedderLayout::applyApproximateRepulsion()
+{
+    // same as applyExactRepulsion(), except that the repulsion of far away
+    // nodes of the same color is computed via a Barnes-Hut tree (one for
+    // each color), and nodes of different colors are looked up in a grid.
+    // Anchored nodes do not repulse each other in the near field only,
+    // but that does not affect the movement of their anchor.
+    int numNodes = nodes.size();
+    std::vector<ChargedPoint> points(numNodes);
+    std::vector<int> colors(numNodes);
+    for (int k = 0; k < numNodes; k++) {
+        points[k] = ChargedPoint{nodes[k]->x, nodes[k]->y, 0, 1};
+        colors[k] = nodes[k]->color;
+    }
+    BarnesHutTree tree;
+    tree.build(points, colors, numColors);
+    PointGrid grid;
+    if (numColors > 1)
+        grid.build(points, 100);
+
+    // compute forces on several threads, then apply them
+    std::vector<double> fxs(numNodes), fys(numNodes);
+    runInParallel(numNodes, numThreads, [&](int k) {
+        Node& n1 = *nodes[k];
+        if (n1.fixed)
+            return;
+
+        double fx = 0;
+        double fy = 0;
+        auto repulse = [&](int j, bool differentColor) {
+            Node& n2 = *nodes[j];
+            if (j == k || (n1.anchor && n1.anchor == n2.anchor))
+                return;
+            double deltax = n1.x - n2.x;
+            double deltay = n1.y - n2.y;
+            double distsq = deltax * deltax + deltay * deltay;
+            if (differentColor && distsq >= 100*100)
+                return;
+            if (distsq < 1.0) {
+                fx += deltax + noise(k, j, 0);
+                fy += deltay + noise(k, j, 1);
+            }
+            else {
+                fx += deltax / distsq;
+                fy += deltay / distsq;
+            }
+        };
+        tree.visit(n1.color, n1.x, n1.y, 0,
+                [&](double x, double y, double, double charge) {
+                    double deltax = n1.x - x;
+                    double deltay = n1.y - y;
+                    double distsq = deltax * deltax + deltay * deltay;
+                    fx += charge * deltax / distsq;
+                    fy += charge * deltay / distsq;
+                },
+                [&](int j) {repulse(j, false);});
+        if (numColors > 1)
+            grid.forEachNear(n1.x, n1.y, [&](int j) {if (nodes[j]->color != n1.color) repulse(j, true);});
+
+        fxs[k] = fx;
+        fys[k] = fy;
+    });
+
+    for (int k = 0; k < numNodes; k++) {
+        Node& n1 = *nodes[k];
+        if (!n1.fixed) {
+            n1.vx += repulsiveForce * fxs[k];
+            n1.vy += repulsiveForce * fys[k];
+        }
+    }
+}
+
 void BasicSpringEmbedderLayout::debugDraw(int step)
 {
     if (step % 5 != 0)
@@ -29,6 +29,10 @@ namespace layout {
  * Implementation of the Spring Embedder algorithm. This class is the layouter
  * used in OMNeT++ 3.x.
  *
+ * For large graphs (see setBarnesHutThreshold()), initial positions are
+ * computed with MultilevelEmbedding, and repulsive forces are approximated
+ * with a Barnes-Hut tree and computed on several threads.
+ *
  * Simplifications:
  *  - ignores node sizes (this is visible when item is very long, e.g.
  *    500 x 10 pixels)
@@ -58,6 +62,7 @@ class LAYOUT_API BasicSpringEmbedderLayout : public GraphLayouter
 
         double vx, vy;     // internal: distance moved at each step (preserved between relax() calls)
         int color;         // internal: connected nodes share the same color
+        int index;         // internal: index in the nodes list
         bool connectedToFixed; // internal: whether the node is connected (maybe indirectly) to a fixed node
     };
 
@@ -92,6 +97,10 @@ class LAYOUT_API BasicSpringEmbedderLayout : public GraphLayouter
     double repulsiveForce = 50;
     double attractionForce = 0.3;
 
+    int barnesHutThreshold = 500;  // approximate repulsion if there are at least this many nodes
+    int numThreads = 0;            // for computing repulsion; 0 means the number of hardware threads
+    int numColors = 0;             // filled in by execute()
+
   protected:
     // utility
     Node *findNode(int nodeId);
@@ -105,6 +114,9 @@ class LAYOUT_API BasicSpringEmbedderLayout : public GraphLayouter
     // assign an initial layout that relax() will improve
     virtual void assignInitialPositions();
 
+    // for large graphs: compute initial positions with MultilevelEmbedding instead of random ones
+    virtual void assignMultilevelPositions(double offsetX, double offsetY);
+
     // fill in the connectedToFixed fields of nodes
     virtual void markNodesConnectedToFixed(int numColors);
 
@@ -114,6 +126,11 @@ class LAYOUT_API BasicSpringEmbedderLayout : public GraphLayouter
     // main algorithm (modified spring embedder)
     virtual double relax();
 
+    // repulsion part of relax(): exact O(n^2) computation, and one using the
+    // Barnes-Hut approximation for large graphs
+    virtual void applyExactRepulsion();
+    virtual void applyApproximateRepulsion();
+
     // for debugging: draw whole thing in a window
     void debugDraw(int step);
 
@@ -168,6 +185,18 @@ class LAYOUT_API BasicSpringEmbedderLayout : public GraphLayouter
 #endif
         attractionForce = force;
     }
+    void setBarnesHutThreshold(int numNodes) {
+#ifdef TRACE_LAYOUTER
+        TRACE_CALL("BasicSpringEmbedderLayout::setBarnesHutThreshold(numNodes: %d)", numNodes);
+#endif
+        barnesHutThreshold = numNodes;
+    }
+    void setNumThreads(int threads) {
+#ifdef TRACE_LAYOUTER
+        TRACE_CALL("BasicSpringEmbedderLayout::setNumThreads(threads: %d)", threads);
+#endif
+        numThreads = threads;
+    }
 };
 
 }  // namespace layout
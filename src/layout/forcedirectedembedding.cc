@@ -13,6 +13,7 @@
 *--------------------------------------------------------------*/
 
 #include <cfloat>
+#include <map>
 #include "common/lcgrandom.h"
 #include "forcedirectedembedding.h"
 #include "forcedirectedparameters.h"
@@ -117,15 +118,14 @@ void ForceDirectedEmbedding::reinitialize()
         body->reinitialize();
 
     // reinitialize positions and velocities
+    std::map<Variable *, double> variableMasses;
+    for (auto body : bodies)
+        variableMasses[body->getVariable()] += body->getMass();
     for (int i = 0; i < (int)variables.size(); i++) {
         Variable *variable = variables[i];
         pn[i].assign(variable->getPosition());
         vn[i].assign(variable->getVelocity());
-        double variableMass = 0;
-        for (auto body : bodies)
-            if (body->getVariable() == variable)
-                variableMass += body->getMass();
-        variable->setMass(variableMass);
+        variable->setMass(variableMasses[variable]);
         totalMass += variable->getMass();
     }
 
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <ctime>
 #include <iostream>
+#include <set>
 #include "geometry.h"
 #include "forcedirectedparametersbase.h"
 
@@ -109,6 +110,11 @@ class LAYOUT_API ForceDirectedEmbedding
          */
         std::vector<Variable *> variables;
 
+        /**
+         * The same as variables, for fast lookup.
+         */
+        std::set<Variable *> variableSet;
+
         /**
          * Used to generate forces in each cycle of the calculation.
          * Members are destructed.
@@ -193,7 +199,7 @@ class LAYOUT_API ForceDirectedEmbedding
             body->setForceDirectedEmbedding(this);
 
             Variable *variable = body->getVariable();
-            if (std::find(variables.begin(), variables.end(), variable) == variables.end()) {
+            if (variableSet.insert(variable).second) {
                 variable->setForceDirectedEmbedding(this);
                 variables.push_back(variable);
             }
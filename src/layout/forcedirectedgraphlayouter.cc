@@ -25,6 +25,7 @@
 #include "forcedirectedgraphlayouter.h"
 #include "startreeembedding.h"
 #include "heapembedding.h"
+#include "multilevelembedding.h"
 
 using namespace omnetpp::common;
 
@@ -64,8 +65,12 @@ void ForceDirectedGraphLayouter::setParameters()
     threeDFactor = environment->getDoubleParameter("3df", 0, privRand01() < 0.5 ? 0 : privUniform(0, 1));
     threeDCoefficient = environment->getDoubleParameter("3dc", 0, privUniform(0, 10));
 
+    // large graphs
+    barnesHutThreshold = environment->getLongParameter("bht", 0, barnesHutThreshold);
+    bool isLarge = (int)embedding.getBodies().size() >= barnesHutThreshold;
+
     // which embedding to use
-    preEmbedding = environment->getBoolParameter("pe", 0, privRand01() < 0.5);
+    preEmbedding = environment->getBoolParameter("pe", 0, privRand01() < 0.5 || isLarge);
     forceDirectedEmbedding = environment->getBoolParameter("fde", 0, true);
 
     // debug parameters
@@ -247,6 +252,29 @@ void ForceDirectedGraphLayouter::setBorderPositions()
 void ForceDirectedGraphLayouter::addElectricRepulsions()
 {
     const std::vector<IBody *>& bodies = embedding.getBodies();
+
+    // for large graphs, use a single force provider for all pairs (ignoring wall bodies)
+    std::vector<IBody *> chargedBodies;
+    for (auto body : bodies)
+        if (!dynamic_cast<WallBody *>(body))
+            chargedBodies.push_back(body);
+
+    if ((int)chargedBodies.size() >= barnesHutThreshold) {
+        std::map<GraphComponent *, int> componentIndices;
+        for (int i = 0; i < (int)graphComponent.connectedSubComponents.size(); i++)
+            componentIndices[graphComponent.connectedSubComponents[i]] = i;
+
+        std::vector<int> groups;
+        for (auto body : chargedBodies) {
+            Vertex *vertex = graphComponent.findVertex(body->getVariable());
+            Assert(vertex);
+            groups.push_back(componentIndices[vertex->connectedSubComponent]);
+        }
+
+        embedding.addForceProvider(new BarnesHutElectricRepulsion(chargedBodies, groups, componentIndices.size(), expectedEdgeLength / 2, expectedEdgeLength, numThreads));
+        return;
+    }
+
     for (int i = 0; i < (int)bodies.size(); i++)
         for (int j = i + 1; j < (int)bodies.size(); j++) {
             IBody *body1 = bodies[i];
@@ -386,6 +414,28 @@ void ForceDirectedGraphLayouter::addEdgeToBorder(int srcNodeId, double len)
     embedding.addForceProvider(new LeastExpandedSpring(springs));
 }
 
+void ForceDirectedGraphLayouter::executeMultilevelEmbedding(GraphComponent *childComponent)
+{
+    MultilevelEmbedding multilevelEmbedding(expectedEdgeLength, lcgRandom.getSeed());
+    multilevelEmbedding.numThreads = numThreads;
+
+    std::map<Vertex *, int> vertexIndices;
+    for (int i = 0; i < childComponent->getVertexCount(); i++)
+        vertexIndices[childComponent->getVertex(i)] = multilevelEmbedding.addVertex();
+    for (int i = 0; i < childComponent->getEdgeCount(); i++) {
+        Edge *edge = childComponent->getEdge(i);
+        multilevelEmbedding.addEdge(vertexIndices[edge->source], vertexIndices[edge->target]);
+    }
+    multilevelEmbedding.embed();
+
+    // the embedding positions the centers of the vertices
+    for (int i = 0; i < childComponent->getVertexCount(); i++) {
+        Vertex *vertex = childComponent->getVertex(i);
+        const Pt& pt = multilevelEmbedding.getPosition(i);
+        vertex->rc.pt = Pt(pt.x - vertex->rc.rs.width / 2, pt.y - vertex->rc.rs.height / 2, 0);
+    }
+}
+
 void ForceDirectedGraphLayouter::executePreEmbedding()
 {
     GraphComponent childrenComponentsStar;
@@ -395,8 +445,10 @@ void ForceDirectedGraphLayouter::executePreEmbedding()
     for (auto childComponent : graphComponent.connectedSubComponents) {
         childComponent->calculateSpanningTree();
 
-        // use tree embedding if connected component is a tree
-        if (childComponent->getVertexCount() == childComponent->getEdgeCount() + 1 || privRand01() < 0.5) {
+        // use multilevel embedding for large components, and tree embedding if connected component is a tree
+        if (childComponent->getVertexCount() >= barnesHutThreshold)
+            executeMultilevelEmbedding(childComponent);
+        else if (childComponent->getVertexCount() == childComponent->getEdgeCount() + 1 || privRand01() < 0.5) {
             StarTreeEmbedding starTreeEmbedding(childComponent, expectedEdgeLength);
             starTreeEmbedding.embed();
         }
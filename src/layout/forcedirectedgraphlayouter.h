@@ -86,6 +86,17 @@ class LAYOUT_API ForceDirectedGraphLayouter : public GraphLayouter
     double threeDFactor;
     double threeDCoefficient;
 
+    /**
+     * Use BarnesHutElectricRepulsion and MultilevelEmbedding (as pre embedding)
+     * if there are at least this many bodies.
+     */
+    int barnesHutThreshold = 200;
+
+    /**
+     * Number of threads for computing forces; 0 means the number of hardware threads.
+     */
+    int numThreads = 0;
+
     /**
      * Various measures calculated before the actual layout.
      */
@@ -168,6 +179,7 @@ class LAYOUT_API ForceDirectedGraphLayouter : public GraphLayouter
     /**
      * Adds electric repulsions between bodies. Bodies being part of different connected
      * subcomponents will have a finite repulsion range determined by default spring repose length.
+     * For large graphs, a single BarnesHutElectricRepulsion is added instead of one per pair.
      */
     void addElectricRepulsions();
 
@@ -193,6 +205,11 @@ class LAYOUT_API ForceDirectedGraphLayouter : public GraphLayouter
      */
     void executePreEmbedding();
 
+    /**
+     * Pre embedding for large connected components, using MultilevelEmbedding.
+     */
+    void executeMultilevelEmbedding(GraphComponent *childComponent);
+
     /**
      * Adds border bodies to the force directed embedding.
      * Adds springs between left-right and top-bottom walls and electric repulsions to other bodies.
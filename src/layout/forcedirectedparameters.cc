@@ -17,6 +17,116 @@
 namespace omnetpp {
 namespace layout {
 
+void BarnesHutElectricRepulsion::updatePoints()
+{
+    // take a snapshot, because IBody::getPosition() may not be called from several threads
+    int n = bodies.size();
+    positions.resize(n);
+    sizes.resize(n);
+    points.resize(n);
+    for (int i = 0; i < n; i++) {
+        IBody *body = bodies[i];
+        positions[i] = body->getPosition();
+        sizes[i] = body->getSize();
+        points[i] = ChargedPoint{positions[i].x, positions[i].y, positions[i].z, body->getCharge()};
+    }
+}
+
+double BarnesHutElectricRepulsion::getPower(double charge1, double charge2, double distance, double linearityDistance, double maxDistance)
+{
+    // see AbstractElectricRepulsion::applyForces()
+    double power;
+    if (distance == 0)
+        power = maxForce;
+    else
+        power = getValidForce(embedding->parameters.electricRepulsionCoefficient * charge1 * charge2 / distance / distance);
+
+    if (linearityDistance != -1 && distance > linearityDistance)
+        power *= 1 - std::min(1.0, (distance - linearityDistance) / (maxDistance - linearityDistance));
+
+    return power;
+}
+
+void BarnesHutElectricRepulsion::applyForces()
+{
+    updatePoints();
+    int n = bodies.size();
+
+    BarnesHutTree tree(theta);
+    tree.build(points, groups, numGroups);
+
+    // repulsion between groups has a finite range, measured between the body rectangles
+    PointGrid grid;
+    if (numGroups > 1) {
+        double maxDiagonal = 0;
+        for (auto& size : sizes)
+            maxDiagonal = std::max(maxDiagonal, size.getDiagonalLength());
+        grid.build(points, maxDistance + maxDiagonal);
+    }
+
+    double defaultLinearityDistance = embedding->parameters.defaultElectricRepulsionLinearityDistance;
+    double defaultMaxDistance = embedding->parameters.defaultElectricRepulsionMaxDistance;
+
+    forces.resize(n);
+    runInParallel(n, numThreads, [&](int i) {
+        const Pt& pt = positions[i];
+        Variable *variable = bodies[i]->getVariable();
+        Pt force = Pt::getZero();
+
+        auto repulse = [&](int j, double linearityDistance, double maxDistance) {
+            if (j == i || bodies[j]->getVariable() == variable)
+                return;
+            double distance;
+            Pt vector = getDistanceAndVector(pt, sizes[i], positions[j], sizes[j], distance);
+            force.add(vector.multiply(getPower(points[i].charge, points[j].charge, distance, linearityDistance, maxDistance)));
+        };
+
+        tree.visit(groups[i], pt.x, pt.y, pt.z,
+                [&](double x, double y, double z, double charge) {
+                    Pt vector = Pt(pt).subtract(Pt(x, y, z));
+                    double distance = vector.getLength();
+                    vector.divide(distance);
+                    force.add(vector.multiply(getPower(points[i].charge, charge, distance, defaultLinearityDistance, defaultMaxDistance)));
+                },
+                [&](int j) {repulse(j, defaultLinearityDistance, defaultMaxDistance);});
+
+        if (numGroups > 1)
+            grid.forEachNear(pt.x, pt.y, [&](int j) {if (groups[j] != groups[i]) repulse(j, linearityDistance, maxDistance);});
+
+        forces[i] = force;
+    });
+
+    for (int i = 0; i < n; i++)
+        bodies[i]->getVariable()->addForce(forces[i]);
+}
+
+double BarnesHutElectricRepulsion::getPotentialEnergy()
+{
+    // approximates the sum of ElectricRepulsion::getPotentialEnergy() over all pairs
+    updatePoints();
+    BarnesHutTree tree(theta);
+    tree.build(points);
+
+    double energy = 0;
+    for (int i = 0; i < (int)bodies.size(); i++) {
+        const Pt& pt = positions[i];
+        Variable *variable = bodies[i]->getVariable();
+        tree.visit(0, pt.x, pt.y, pt.z,
+                [&](double x, double y, double z, double charge) {
+                    energy += points[i].charge * charge / pt.getDistance(Pt(x, y, z));
+                },
+                [&](int j) {
+                    if (j != i && bodies[j]->getVariable() != variable) {
+                        double distance;
+                        getDistanceAndVector(pt, sizes[i], positions[j], sizes[j], distance);
+                        energy += points[i].charge * points[j].charge / distance;
+                    }
+                });
+    }
+
+    // each pair was counted twice
+    return embedding->parameters.electricRepulsionCoefficient * energy / 2;
+}
+
 }  // namespace layout
 }  // namespace omnetpp
-
@@ -16,7 +16,9 @@
 #define __OMNETPP_LAYOUT_FORCEDIRECTEDPARAMETERS_H
 
 #include <cmath>
+#include <vector>
 #include "geometry.h"
+#include "barneshuttree.h"
 #include "forcedirectedparametersbase.h"
 #include "forcedirectedembedding.h"
 
@@ -233,16 +235,23 @@ class AbstractForceProvider : public IForceProvider {
                 return getStandardDistanceAndVector(body1, body2, distance);
         }
 
+        Pt getDistanceAndVector(const Pt& pt1, const Rs& rs1, const Pt& pt2, const Rs& rs2, double &distance) {
+            if (slippery)
+                return getSlipperyDistanceAndVector(pt1, rs1, pt2, rs2, distance);
+            else
+                return getStandardDistanceAndVector(pt1, rs1, pt2, rs2, distance);
+        }
+
         Pt getStandardDistanceAndVector(IBody *body1, IBody *body2, double &distance) {
-            const Pt& pt1 = body1->getPosition();
-            const Pt& pt2 = body2->getPosition();
+            return getStandardDistanceAndVector(body1->getPosition(), body1->getSize(), body2->getPosition(), body2->getSize(), distance);
+        }
+
+        Pt getStandardDistanceAndVector(const Pt& pt1, const Rs& rs1, const Pt& pt2, const Rs& rs2, double &distance) {
             Pt vector = Pt(pt1).subtract(pt2);
             distance = vector.getLength();
             vector.divide(distance);
 
             if (!pointLikeDistance) {
-                const Rs& rs1 = body1->getSize();
-                const Rs& rs2 = body2->getSize();
                 double dx = fabs(pt1.x - pt2.x);
                 double dy = fabs(pt1.y - pt2.y);
                 double dHalf = vector.getBasePlaneProjectionLength() / 2;
@@ -278,8 +287,12 @@ class AbstractForceProvider : public IForceProvider {
         }
 
         Pt getSlipperyDistanceAndVector(IBody *body1, IBody *body2, double &distance) {
-            Rc rc1 = Rc::getRcFromCenterSize(body1->getPosition(), body1->getSize());
-            Rc rc2 = Rc::getRcFromCenterSize(body2->getPosition(), body2->getSize());
+            return getSlipperyDistanceAndVector(body1->getPosition(), body1->getSize(), body2->getPosition(), body2->getSize(), distance);
+        }
+
+        Pt getSlipperyDistanceAndVector(const Pt& pt1, const Rs& rs1, const Pt& pt2, const Rs& rs2, double &distance) {
+            Rc rc1 = Rc::getRcFromCenterSize(pt1, rs1);
+            Rc rc2 = Rc::getRcFromCenterSize(pt2, rs2);
             Ln ln = rc1.getBasePlaneProjectionDistance(rc2, distance);
             Pt vector = ln.begin;
             vector.subtract(ln.end);
@@ -419,6 +432,66 @@ class HorizontalElectricRepulsion : public AbstractElectricRepulsion {
         }
 };
 
+/**
+ * Electric repulsion between all pairs of a set of bodies, in O(n log n) time
+ * instead of the O(n^2) of having an ElectricRepulsion for each pair.
+ *
+ * Bodies are partitioned into groups (e.g. connected subcomponents). Bodies in
+ * the same group repulse each other like ElectricRepulsion with the default
+ * parameters, except that far away bodies are approximated with their center
+ * of charge (see BarnesHutTree). Bodies in different groups repulse each other
+ * like ElectricRepulsion with the given linearity and (finite) max distance,
+ * and are found via a PointGrid. Bodies sharing the same variable do not repulse each
+ * other in the near field.
+ *
+ * Forces are computed on several threads.
+ */
+class LAYOUT_API BarnesHutElectricRepulsion : public AbstractForceProvider {
+    protected:
+        std::vector<IBody *> bodies;
+
+        std::vector<int> groups;
+
+        int numGroups;
+
+        double linearityDistance;
+
+        double maxDistance;
+
+        double theta;
+
+        int numThreads;
+
+        // internal: state of the bodies while computing forces
+        std::vector<Pt> positions;
+        std::vector<Rs> sizes;
+        std::vector<ChargedPoint> points;
+        std::vector<Pt> forces;
+
+    public:
+        BarnesHutElectricRepulsion(const std::vector<IBody *>& bodies, const std::vector<int>& groups, int numGroups, double linearityDistance, double maxDistance, int numThreads = 0, double theta = 0.7) : AbstractForceProvider(-1) {
+            this->bodies = bodies;
+            this->groups = groups;
+            this->numGroups = numGroups;
+            this->linearityDistance = linearityDistance;
+            this->maxDistance = maxDistance;
+            this->theta = theta;
+            this->numThreads = numThreads;
+        }
+
+        virtual const char *getClassName() override {
+            return "BarnesHutElectricRepulsion";
+        }
+
+        virtual void applyForces() override;
+
+        virtual double getPotentialEnergy() override;
+
+    protected:
+        void updatePoints();
+        double getPower(double charge1, double charge2, double distance, double linearityDistance, double maxDistance);
+};
+
 /**
  * An attractive force which increases in a linear way proportional to the distance of the bodies.
  * Abstract base class for spring attractive forces.
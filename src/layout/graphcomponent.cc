@@ -43,6 +43,7 @@ GraphComponent::~GraphComponent()
 int GraphComponent::addVertex(Vertex *vertex)
 {
     vertices.push_back(vertex);
+    identityToVertexMap.insert(std::make_pair(vertex->identity, vertex));
     return vertices.size() - 1;
 }
 
@@ -68,12 +69,8 @@ int GraphComponent::indexOfVertex(Vertex *vertex)
 
 Vertex *GraphComponent::findVertex(void *identity)
 {
-    for (auto vertex : vertices) {
-        if (vertex->identity == identity)
-            return vertex;
-    }
-
-    return nullptr;
+    std::map<void *, Vertex *>::iterator it = identityToVertexMap.find(identity);
+    return it == identityToVertexMap.end() ? nullptr : it->second;
 }
 
 Rc GraphComponent::getBoundingRectangle()
@@ -177,21 +174,36 @@ void GraphComponent::calculateConnectedSubComponents()
 
 void GraphComponent::colorizeConnectedSubComponent(GraphComponent *childComponent, Vertex *vertex, int color)
 {
-    vertex->color = color;
-    vertex->connectedSubComponent = childComponent;
-    childComponent->vertices.push_back(vertex);
-
-    for (auto edge : vertex->edges) {
-        if (!edge->color) {
-            edge->color = color;
-            edge->connectedSubComponent = childComponent;
-            childComponent->edges.push_back(edge);
+    // depth first traversal; uses an explicit stack of (vertex, next neighbour index)
+    // pairs instead of recursion, because components may be very large
+    std::vector<std::pair<Vertex *, int>> stack;
+    stack.push_back(std::make_pair(vertex, 0));
+
+    while (!stack.empty()) {
+        Vertex *current = stack.back().first;
+        int& neighbourIndex = stack.back().second;
+
+        if (neighbourIndex == 0 && !current->color) {
+            current->color = color;
+            current->connectedSubComponent = childComponent;
+            childComponent->addVertex(current);
+
+            for (auto edge : current->edges) {
+                if (!edge->color) {
+                    edge->color = color;
+                    edge->connectedSubComponent = childComponent;
+                    childComponent->edges.push_back(edge);
+                }
+            }
         }
-    }
 
-    for (auto neighbour : vertex->neighbours) {
-        if (!neighbour->color)
-            colorizeConnectedSubComponent(childComponent, neighbour, color);
+        if (neighbourIndex == (int)current->neighbours.size())
+            stack.pop_back();
+        else {
+            Vertex *neighbour = current->neighbours[neighbourIndex++];
+            if (!neighbour->color)
+                stack.push_back(std::make_pair(neighbour, 0));
+        }
     }
 }
 
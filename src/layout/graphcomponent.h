@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <vector>
 #include <deque>
+#include <map>
 #include "geometry.h"
 
 namespace omnetpp {
@@ -150,6 +151,11 @@ class LAYOUT_API GraphComponent {
          */
         std::vector<Edge *> edges;
 
+        /**
+         * Vertices by identity, for findVertex. Contains the first vertex added with each identity.
+         */
+        std::map<void *, Vertex *> identityToVertexMap;
+
     public:
         /**
          * The root of the spanning tree. Filled by calculateSpanningTree.
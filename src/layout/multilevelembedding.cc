@@ -0,0 +1,291 @@
+//=========================================================================
+//  MULTILEVELEMBEDDING.CC - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cfloat>
+#include <cmath>
+#include <algorithm>
+#include "barneshuttree.h"
+#include "multilevelembedding.h"
+
+namespace omnetpp {
+namespace layout {
+
+// stop coarsening at this size, or when a level does not shrink the graph enough
+static const int MAX_COARSEST_VERTEX_COUNT = 20;
+static const double MIN_COARSENING_RATIO = 0.75;
+static const int MAX_LEVEL_COUNT = 30;
+
+// spring-electrical model (see Y. Hu: Efficient and high quality force-directed
+// graph drawing): attraction is d^2/K along edges, repulsion is C*K^2*w1*w2/d
+static const double REPULSION_COEFFICIENT = 0.2;
+static const double GRAVITY_COEFFICIENT = 0.02;  // keeps unconnected parts together
+static const double BARNES_HUT_THETA = 1.2;
+
+// adaptive step length: cooling factor, and the number of improving steps before heating up
+static const double STEP_MULTIPLIER = 0.9;
+static const int PROGRESS_LIMIT = 5;
+static const double MIN_STEP = 0.02;  // relative to the natural length
+
+MultilevelEmbedding::MultilevelEmbedding(double edgeLength, int32_t seed) :
+    edgeLength(edgeLength), random(seed)
+{
+}
+
+int MultilevelEmbedding::addVertex(double weight)
+{
+    weights.push_back(weight);
+    return weights.size() - 1;
+}
+
+void MultilevelEmbedding::addEdge(int vertex1, int vertex2)
+{
+    Assert(vertex1 >= 0 && vertex1 < getVertexCount() && vertex2 >= 0 && vertex2 < getVertexCount());
+    edges.push_back(std::make_pair(vertex1, vertex2));
+}
+
+static void fillAdjacency(int vertexCount, std::vector<std::pair<int, int>>& arcs, std::vector<int>& adjacencyStart, std::vector<int>& adjacency)
+{
+    // arcs must contain both directions; duplicates are removed
+    std::sort(arcs.begin(), arcs.end());
+    arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+    adjacencyStart.assign(vertexCount + 1, 0);
+    adjacency.clear();
+    adjacency.reserve(arcs.size());
+    for (auto& arc : arcs) {
+        adjacencyStart[arc.first + 1]++;
+        adjacency.push_back(arc.second);
+    }
+    for (int v = 0; v < vertexCount; v++)
+        adjacencyStart[v + 1] += adjacencyStart[v];
+}
+
+void MultilevelEmbedding::buildGraph(Graph& graph)
+{
+    graph.weights = weights;
+    std::vector<std::pair<int, int>> arcs;
+    for (auto& edge : edges) {
+        if (edge.first != edge.second) {
+            arcs.push_back(edge);
+            arcs.push_back(std::make_pair(edge.second, edge.first));
+        }
+    }
+    fillAdjacency(weights.size(), arcs, graph.adjacencyStart, graph.adjacency);
+}
+
+bool MultilevelEmbedding::coarsen(const Graph& graph, Graph& coarseGraph, std::vector<int>& parents)
+{
+    int n = graph.getVertexCount();
+
+    // visit vertices in random order
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++)
+        order[i] = i;
+    for (int i = n - 1; i > 0; i--)
+        std::swap(order[i], order[random.draw(i + 1)]);
+
+    // match each vertex with its lightest unmatched neighbour; isolated vertices are paired up with each other
+    parents.assign(n, -1);
+    int coarseCount = 0;
+    int unmatchedIsolated = -1;
+    for (int v : order) {
+        if (parents[v] != -1)
+            continue;
+        int match = -1;
+        for (int k = graph.adjacencyStart[v]; k < graph.adjacencyStart[v + 1]; k++) {
+            int u = graph.adjacency[k];
+            if (parents[u] == -1 && (match == -1 || graph.weights[u] < graph.weights[match]))
+                match = u;
+        }
+        if (graph.adjacencyStart[v] == graph.adjacencyStart[v + 1]) {
+            if (unmatchedIsolated == -1) {
+                unmatchedIsolated = v;
+                continue;
+            }
+            match = unmatchedIsolated;
+            unmatchedIsolated = -1;
+        }
+        parents[v] = coarseCount;
+        if (match != -1)
+            parents[match] = coarseCount;
+        coarseCount++;
+    }
+    if (unmatchedIsolated != -1)
+        parents[unmatchedIsolated] = coarseCount++;
+
+    if (coarseCount > MIN_COARSENING_RATIO * n)
+        return false;
+
+    // build the coarse graph
+    coarseGraph.weights.assign(coarseCount, 0);
+    std::vector<std::pair<int, int>> arcs;
+    for (int v = 0; v < n; v++) {
+        coarseGraph.weights[parents[v]] += graph.weights[v];
+        for (int k = graph.adjacencyStart[v]; k < graph.adjacencyStart[v + 1]; k++) {
+            int u = graph.adjacency[k];
+            if (parents[u] != parents[v])
+                arcs.push_back(std::make_pair(parents[v], parents[u]));
+        }
+    }
+    fillAdjacency(coarseCount, arcs, coarseGraph.adjacencyStart, coarseGraph.adjacency);
+    return true;
+}
+
+void MultilevelEmbedding::refine(const Graph& graph, std::vector<Pt>& positions, int maxIterations, double initialStep, bool adaptiveStep)
+{
+    // a vertex of a coarse graph stands for several vertices, so the natural
+    // length is scaled to make the layout occupy about the same area on all levels
+    int n = graph.getVertexCount();
+    double totalWeight = 0;
+    for (double weight : graph.weights)
+        totalWeight += weight;
+    double meanWeight = totalWeight / n;
+    double k = edgeLength * sqrt(meanWeight);
+    double repulsion = REPULSION_COEFFICIENT * k * k;
+    double step = initialStep * k;
+    double lastEnergy = DBL_MAX;
+    int progress = 0;
+
+    BarnesHutTree tree(BARNES_HUT_THETA);
+    std::vector<ChargedPoint> points(n);
+    std::vector<Pt> forces(n);
+
+    for (int iteration = 0; iteration < maxIterations && step > MIN_STEP * k; iteration++) {
+        Pt center = Pt::getZero();
+        for (int i = 0; i < n; i++) {
+            const Pt& pt = positions[i];
+            points[i] = ChargedPoint{pt.x, pt.y, 0, graph.weights[i] / meanWeight};
+            center.x += pt.x * graph.weights[i];
+            center.y += pt.y * graph.weights[i];
+        }
+        center.divide(totalWeight);
+        tree.build(points);
+
+        runInParallel(n, numThreads, [&](int i) {
+            const Pt& pt = positions[i];
+            double rx = 0, ry = 0;
+            auto repulse = [&](double x, double y, double charge) {
+                double dx = pt.x - x, dy = pt.y - y;
+                double d2 = dx * dx + dy * dy;
+                if (d2 > 0) {
+                    rx += charge * dx / d2;
+                    ry += charge * dy / d2;
+                }
+            };
+            tree.visit(0, pt.x, pt.y, 0,
+                    [&](double x, double y, double, double charge) {repulse(x, y, charge);},
+                    [&](int j) {if (j != i) repulse(points[j].x, points[j].y, points[j].charge);});
+            double weight = points[i].charge;
+            double fx = repulsion * weight * rx + GRAVITY_COEFFICIENT * weight * (center.x - pt.x);
+            double fy = repulsion * weight * ry + GRAVITY_COEFFICIENT * weight * (center.y - pt.y);
+            for (int a = graph.adjacencyStart[i]; a < graph.adjacencyStart[i + 1]; a++) {
+                const Pt& other = positions[graph.adjacency[a]];
+                double dx = other.x - pt.x, dy = other.y - pt.y;
+                double d = sqrt(dx * dx + dy * dy);
+                fx += dx * d / k;
+                fy += dy * d / k;
+            }
+            forces[i] = Pt(fx, fy, 0);
+        });
+
+        // move each vertex by the step length in the direction of the force
+        double energy = 0;
+        for (int i = 0; i < n; i++) {
+            double length = forces[i].getLength();
+            if (length > 0)
+                positions[i].add(forces[i].multiply(step / length));
+            energy += length * length;
+        }
+
+        // cooling; the adaptive scheme heats up again while the energy keeps decreasing
+        if (!adaptiveStep)
+            step *= STEP_MULTIPLIER;
+        else if (energy < lastEnergy) {
+            if (++progress >= PROGRESS_LIMIT) {
+                progress = 0;
+                step /= STEP_MULTIPLIER;
+            }
+        }
+        else {
+            progress = 0;
+            step *= STEP_MULTIPLIER;
+        }
+        lastEnergy = energy;
+    }
+}
+
+void MultilevelEmbedding::embed()
+{
+    positions.clear();
+    int n = getVertexCount();
+    if (n == 0)
+        return;
+
+    // coarsen
+    std::vector<Graph> graphs(1);
+    std::vector<std::vector<int>> parents;
+    buildGraph(graphs[0]);
+    while (graphs.back().getVertexCount() > MAX_COARSEST_VERTEX_COUNT && (int)graphs.size() < MAX_LEVEL_COUNT) {
+        Graph coarseGraph;
+        std::vector<int> levelParents;
+        if (!coarsen(graphs.back(), coarseGraph, levelParents))
+            break;
+        graphs.push_back(coarseGraph);
+        parents.push_back(levelParents);
+    }
+
+    // lay out the coarsest graph from random positions
+    const Graph& coarsestGraph = graphs.back();
+    double totalWeight = 0;
+    for (double weight : coarsestGraph.weights)
+        totalWeight += weight;
+    double size = edgeLength * sqrt(totalWeight);
+    std::vector<Pt> levelPositions(coarsestGraph.getVertexCount());
+    for (auto& pt : levelPositions)
+        pt = Pt(size * random.next01(), size * random.next01(), 0);
+    refine(coarsestGraph, levelPositions, 300, 1, true);
+
+    // interpolate and refine level by level
+    for (int level = graphs.size() - 2; level >= 0; level--) {
+        std::vector<Pt> finePositions(graphs[level].getVertexCount());
+        for (int v = 0; v < (int)finePositions.size(); v++) {
+            finePositions[v] = levelPositions[parents[level][v]];
+            finePositions[v].x += (random.next01() - 0.5) * 0.2 * edgeLength;
+            finePositions[v].y += (random.next01() - 0.5) * 0.2 * edgeLength;
+        }
+        levelPositions.swap(finePositions);
+        refine(graphs[level], levelPositions, 30, 0.5, false);
+    }
+    positions.swap(levelPositions);
+
+    // scale to the requested average edge length, and move to the origin
+    double sum = 0;
+    int count = 0;
+    for (auto& edge : edges) {
+        if (edge.first != edge.second) {
+            sum += positions[edge.first].getBasePlaneProjectionDistance(positions[edge.second]);
+            count++;
+        }
+    }
+    double scale = count > 0 && sum > 0 ? edgeLength * count / sum : 1;
+    double minX = DBL_MAX, minY = DBL_MAX;
+    for (auto& pt : positions) {
+        minX = std::min(minX, pt.x);
+        minY = std::min(minY, pt.y);
+    }
+    for (auto& pt : positions)
+        pt = Pt((pt.x - minX) * scale, (pt.y - minY) * scale, 0);
+}
+
+}  // namespace layout
+}  // namespace omnetpp
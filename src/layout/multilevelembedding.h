@@ -0,0 +1,92 @@
+//=========================================================================
+//  MULTILEVELEMBEDDING.H - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_LAYOUT_MULTILEVELEMBEDDING_H
+#define __OMNETPP_LAYOUT_MULTILEVELEMBEDDING_H
+
+#include <vector>
+#include "common/lcgrandom.h"
+#include "geometry.h"
+
+namespace omnetpp {
+namespace layout {
+
+/**
+ * A fast embedding for large graphs, meant to produce the initial positions
+ * for the force directed layouters.
+ *
+ * The graph is repeatedly coarsened by merging matched pairs of neighbouring
+ * vertices, the coarsest graph is laid out from random positions, and then
+ * the layout is interpolated back level by level, refining it on each level
+ * with a few iterations of a spring-electrical model. Repulsive forces are
+ * computed with the Barnes-Hut approximation, on several threads.
+ *
+ * Vertices are treated as points; the result is scaled so that the average
+ * edge length equals the given edge length, and its bounding box starts at
+ * the origin.
+ */
+class LAYOUT_API MultilevelEmbedding
+{
+    public:
+        /**
+         * Number of threads to compute forces with; 0 means the number of
+         * hardware threads.
+         */
+        int numThreads = 0;
+
+    private:
+        struct Graph {
+            std::vector<double> weights;
+            std::vector<int> adjacencyStart;  // index into 'adjacency' for each vertex, plus one at the end
+            std::vector<int> adjacency;       // neighbours of vertices, grouped by vertex
+            int getVertexCount() const {return weights.size();}
+        };
+
+        double edgeLength;
+        common::LCGRandom random;
+        std::vector<double> weights;
+        std::vector<std::pair<int, int>> edges;
+        std::vector<Pt> positions;
+
+    public:
+        MultilevelEmbedding(double edgeLength, int32_t seed = 1);
+
+        /**
+         * Adds a vertex, and returns its index. The weight is the number
+         * of nodes the vertex represents; heavier vertices get more room.
+         */
+        int addVertex(double weight = 1);
+
+        void addEdge(int vertex1, int vertex2);
+
+        int getVertexCount() const {return weights.size();}
+
+        void embed();
+
+        /**
+         * Returns the position computed by embed(); z is always 0.
+         */
+        const Pt& getPosition(int vertex) const {return positions[vertex];}
+
+    private:
+        void buildGraph(Graph& graph);
+        bool coarsen(const Graph& graph, Graph& coarseGraph, std::vector<int>& parents);
+        void refine(const Graph& graph, std::vector<Pt>& positions, int maxIterations, double initialStep, bool adaptiveStep);
+};
+
+}  // namespace layout
+}  // namespace omnetpp
+
+
+#endif
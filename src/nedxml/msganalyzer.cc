@@ -18,6 +18,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <cstdlib>
 
 #include "common/stringtokenizer.h"
 #include "common/fileutil.h"
@@ -337,6 +338,9 @@ void MsgAnalyzer::analyzeClassOrStruct(ClassInfo& classInfo, const std::string&
         classInfo.fieldNameSuffix = "_var";
     }
 
+    // packed layout
+    classInfo.isPacked = getPropertyAsBool(classInfo.props, PROP_PACKED, false);
+
     // beforeChange
     classInfo.beforeChange = getProperty(classInfo.props, PROP_BEFORECHANGE, "");
     if (classInfo.beforeChange.empty() && baseClassInfo != nullptr)
@@ -444,6 +448,26 @@ void MsgAnalyzer::analyzeField(ClassInfo& classInfo, FieldInfo *field, const std
     field->isDynamicArray = field->isArray && field->arraySize.empty();
     field->isFixedArray = field->isArray && !field->arraySize.empty();
 
+    std::string inlineArraySize = getProperty(field->props, PROP_INLINEARRAY);
+    if (!inlineArraySize.empty()) {
+        char *end;
+        long n = strtol(inlineArraySize.c_str(), &end, 10);
+        if (!field->isDynamicArray)
+            errors->addWarning(field->astNode, "ignoring @inlineArray property for field '%s' which is not a dynamic array", field->name.c_str());
+        else if (*end || n <= 0)
+            errors->addError(field->astNode, "@inlineArray for field '%s' must be a positive integer", field->name.c_str());
+        else if (!field->isPointer && field->iscOwnedObject)
+            errors->addError(field->astNode, "@inlineArray cannot be used for field '%s': arrays of cOwnedObject values are not supported", field->name.c_str());
+        else
+            field->inlineArraySize = inlineArraySize;
+    }
+
+    bool isPooled = getPropertyAsBool(field->props, PROP_POOLED, false);
+    if (isPooled && (field->typeQName != "string" || field->isPointer)) {
+        errors->addWarning(field->astNode, "ignoring @pooled property for non-string field '%s'", field->name.c_str());
+        isPooled = false;
+    }
+
     field->nopack = getPropertyAsBool(field->props, PROP_NOPACK, false);
     field->isOpaque = getPropertyAsBool(field->props, PROP_OPAQUE, fieldClassInfo.isOpaque);
     field->overrideGetter = getPropertyAsBool(field->props, PROP_OVERRIDEGETTER, false) || getPropertyAsBool(field->props, "override", false);
@@ -571,6 +595,8 @@ void MsgAnalyzer::analyzeField(ClassInfo& classInfo, FieldInfo *field, const std
             field->var += "_";
         field->argName = field->name;
     }
+    if (!field->inlineArraySize.empty())
+        field->inlineVar = field->var + "_inline";
 
     field->sizeVar = field->arraySize.empty() ? (field->name + "_arraysize") : field->arraySize;
     std::string sizetypeprop = getProperty(field->props, PROP_SIZETYPE);
@@ -582,6 +608,8 @@ void MsgAnalyzer::analyzeField(ClassInfo& classInfo, FieldInfo *field, const std
     std::string argtypeBase = getProperty(field->props, PROP_ARGTYPE, cpptypeBase);
     std::string returntypeBase = getProperty(field->props, PROP_RETURNTYPE, cpptypeBase);
 
+    if (isPooled)
+        datatypeBase = "omnetpp::opp_pooledstring";
     if (datatypeBase.empty())
         datatypeBase = makeRelative(fieldClassInfo.dataTypeBase, classInfo.namespaceName);
     if (argtypeBase.empty())
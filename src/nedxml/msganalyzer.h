@@ -123,6 +123,9 @@ class NEDXML_API MsgAnalyzer
     static constexpr const char* PROP_BEFORECHANGE = "beforeChange";
     static constexpr const char* PROP_IMPLEMENTS = "implements";
     static constexpr const char* PROP_NOPACK = "nopack";
+    static constexpr const char* PROP_PACKED = "packed";
+    static constexpr const char* PROP_POOLED = "pooled";
+    static constexpr const char* PROP_INLINEARRAY = "inlineArray";
     static constexpr const char* PROP_OWNED = "owned";
     static constexpr const char* PROP_EDITABLE = "editable";
     static constexpr const char* PROP_REPLACEABLE = "replaceable";
@@ -67,23 +67,38 @@ void MsgCodeGenerator::openFiles(const char *hFile, const char *ccFile)
     hFilename = hFile;
     ccFilename = ccFile;
 
-    hStream.open(hFile);
-    if (hStream.fail())
-        throw opp_runtime_error("Cannot open '%s' for write", hFile);
+    hStream.str("");
+    ccStream.str("");
+}
+
+static bool fileContentEquals(const char *fileName, const std::string& content)
+{
+    std::ifstream in(fileName);  // text mode, like the output
+    if (!in)
+        return false;
+    std::string existingContent((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return existingContent == content;
+}
 
-    ccStream.open(ccFile);
-    if (ccStream.fail())
-        throw opp_runtime_error("Cannot open '%s' for write", ccFile);
+static void writeFileIfChanged(const char *fileName, const std::string& content)
+{
+    // leave the file (and its timestamp) alone if the content is unchanged,
+    // so that the C++ sources that include it do not need to be recompiled
+    if (fileContentEquals(fileName, content))
+        return;
+    std::ofstream out(fileName);
+    if (out.fail())
+        throw opp_runtime_error("Cannot open '%s' for write", fileName);
+    out << content;
+    out.close();
+    if (!out)
+        throw opp_runtime_error("Could not write '%s'", fileName);
 }
 
 void MsgCodeGenerator::closeFiles()
 {
-    hStream.close();
-    ccStream.close();
-    if (!hStream)
-        throw opp_runtime_error("Could not write '%s'", hFilename.c_str());
-    if (!ccStream)
-        throw opp_runtime_error("Could not write '%s'", ccFilename.c_str());
+    writeFileIfChanged(hFilename.c_str(), hStream.str());
+    writeFileIfChanged(ccFilename.c_str(), ccStream.str());
 }
 
 void MsgCodeGenerator::deleteFiles()
@@ -289,6 +304,7 @@ void MsgCodeGenerator::generateProlog(const std::string& msgFileName, const std:
     CC << "#  pragma GCC diagnostic ignored \"-Wfloat-conversion\"\n";
     CC << "#endif\n\n";
 
+    CC << "#include <algorithm>\n";
     CC << "#include <iostream>\n";
     CC << "#include <sstream>\n";
     CC << "#include <memory>\n";
@@ -326,6 +342,53 @@ void MsgCodeGenerator::generateClass(const ClassInfo& classInfo, const std::stri
     generateClassImpl(classInfo);
 }
 
+// Size of a data member with a primitive type, or 0 if unknown or if it differs
+// across platforms (long, pointers); see @packed. Members in order of decreasing
+// size need no padding, as the alignment of these types never exceeds their size.
+static int getDataMemberSize(const MsgTypeTable::FieldInfo& field)
+{
+    static const std::map<std::string,int> sizes = {
+        {"bool", 1}, {"char", 1}, {"unsigned char", 1}, {"int8_t", 1}, {"uint8_t", 1},
+        {"short", 2}, {"unsigned short", 2}, {"int16_t", 2}, {"uint16_t", 2},
+        {"int", 4}, {"unsigned int", 4}, {"float", 4}, {"int32_t", 4}, {"uint32_t", 4},
+        {"double", 8}, {"int64_t", 8}, {"uint64_t", 8},
+        {"omnetpp::simtime_t", 8}, {"simtime_t", 8}, {"omnetpp::SimTime", 8},
+    };
+    if (field.isDynamicArray || field.isOwnedPointer || field.isPointer)
+        return 0;
+    auto it = sizes.find(field.baseDataType);
+    if (it != sizes.end())
+        return it->second;
+    return field.props.get("enum") != nullptr ? 4 : 0;  // enums are int-sized
+}
+
+// Returns the fields in the order their data members should be declared in.
+// For @packed classes, members of non-primitive types (objects, strings, dynamic
+// arrays, owned pointers) and those of platform-dependent size come first,
+// followed by the other primitive ones in decreasing order of size, so that no
+// padding is needed between them.
+static std::vector<const MsgTypeTable::FieldInfo*> getDataMemberOrder(const MsgTypeTable::ClassInfo& classInfo)
+{
+    std::vector<const MsgTypeTable::FieldInfo*> result;
+    for (const auto& field : classInfo.fieldList)
+        if (!field.isAbstract && !field.isCustom)
+            result.push_back(&field);
+    if (classInfo.isPacked) {
+        auto rank = [](const MsgTypeTable::FieldInfo *field) {int size = getDataMemberSize(*field); return size == 0 ? 16 : size;};
+        std::stable_sort(result.begin(), result.end(), [&](const MsgTypeTable::FieldInfo *a, const MsgTypeTable::FieldInfo *b) {return rank(a) > rank(b);});
+    }
+    return result;
+}
+
+// In @packed classes, accessors of primitive by-value fields are defined inline in the class declaration
+static bool hasInlineAccessors(const MsgTypeTable::ClassInfo& classInfo, const MsgTypeTable::FieldInfo& field)
+{
+    return classInfo.isPacked && !field.isArray && !field.isPointer && field.byValue &&
+            !field.isAbstract && !field.isCustom && !field.isCustomImpl &&
+            !containsKey(classInfo.methodCplusplusBlocks, field.getter) &&
+            !containsKey(classInfo.methodCplusplusBlocks, field.setter);
+}
+
 void MsgCodeGenerator::generateClassDecl(const ClassInfo& classInfo, const std::string& exportDef)
 {
     H << "/**\n";
@@ -384,12 +447,16 @@ void MsgCodeGenerator::generateClassDecl(const ClassInfo& classInfo, const std::
 
     H << "\n{\n";
     H << "  protected:\n";
-    for (const FieldInfo& field : classInfo.fieldList) {
-        if (field.isAbstract || field.isCustom)
-            continue;
+    for (const FieldInfo *fieldPtr : getDataMemberOrder(classInfo)) {
+        const FieldInfo& field = *fieldPtr;
         if (field.isFixedArray) {
             H << "    " << field.dataType << " " << field.var << "[" << field.arraySize << "]" << (field.value == "0" ? " = {0}" : "") << ";\n"; // note: C++ has no syntax for filling a full array with a (nonzero) value in an expression
         }
+        else if (field.isDynamicArray && !field.inlineArraySize.empty()) {
+            H << "    " << field.dataType << " " << field.inlineVar << "[" << field.inlineArraySize << "];\n";
+            H << "    " << field.dataType << " *" << field.var << " = " << field.inlineVar << ";\n";
+            H << "    " << field.sizeType << " " << field.sizeVar << " = 0;\n";
+        }
         else if (field.isDynamicArray) {
             H << "    " << field.dataType << " *" << field.var << " = nullptr;\n";
             H << "    " << field.sizeType << " " << field.sizeVar << " = 0;\n";
@@ -471,6 +538,12 @@ void MsgCodeGenerator::generateClassDecl(const ClassInfo& classInfo, const std::
         }
 
         // getter, setter, remover
+        if (hasInlineAccessors(classInfo, field)) {
+            H << "    virtual " << field.returnType << " " << field.getter << "() const" << overrideGetter << " {return " << makeFuncall(str("this->") + field.var, false, field.getterConversion) << ";}\n";
+            if (!field.isConst)
+                H << "    virtual void " << field.setter << "(" << field.argType << " " << field.argName << ")" << overrideSetter << " {" << maybe_handleChange << "this->" << field.var << " = " << field.argName << ";}\n";
+            continue;
+        }
         H << "    virtual " << field.returnType << " " << field.getter << "(" << getterIndexArg << ") const" << overrideGetter << pure << ";\n";
         if (field.hasGetterForUpdate) {
             H << "    virtual " << field.mutableReturnType << " " << field.getterForUpdate << "(" << getterIndexArg << ")" << overrideGetter;
@@ -514,6 +587,20 @@ inline std::string forEachIndex(const MsgTypeTable::FieldInfo& field)
     return str("    for (") + field.sizeType + " i = 0; i < " + field.sizeVar + "; i++)";
 }
 
+// for dynamic arrays with @inlineArray: storage for the given number of elements
+inline std::string inlineArrayAlloc(const MsgTypeTable::FieldInfo& field, const std::string& size)
+{
+    return str("(") + size + " <= " + field.inlineArraySize + ") ? this->" + field.inlineVar + " : new " + field.dataType + "[" + size + "]";
+}
+
+// deallocates the storage of a dynamic array, unless it is the inline buffer
+inline std::string deleteArray(const MsgTypeTable::FieldInfo& field, const std::string& ptr)
+{
+    if (field.inlineArraySize.empty())
+        return str("delete [] ") + ptr + ";";
+    return str("if (") + ptr + " != this->" + field.inlineVar + ") delete [] " + ptr + ";";
+}
+
 void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
 {
     std::string maybe_handleChange_line = classInfo.beforeChange.empty() ? "" : (str("    ") + classInfo.beforeChange + ";\n");
@@ -595,7 +682,7 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             if (!releaseElem.str().empty())
                 CC << forEachIndex(field) << "\n" << opp_indentlines(releaseElem.str(), "    ");
             if (field.isDynamicArray)
-                CC << "    delete [] " << var(field) << ";\n";
+                CC << "    " << deleteArray(field, var(field)) << "\n";
         }
         else {
             CC << releaseElem.str();
@@ -638,11 +725,14 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
         if (field.isArray && !releaseElem.str().empty())
             CC << forEachIndex(field) << "\n" << opp_indentlines(releaseElem.str(), "    ");
         if (field.isDynamicArray)
-            CC << "    delete [] " << var(field) << ";\n";
+            CC << "    " << deleteArray(field, var(field)) << "\n";
 
         // allocate new dynamic array
         if (field.isDynamicArray) {
-            CC << "    " << var(field) << " = (other." << field.sizeVar << "==0) ? nullptr : new " << field.dataType << "[other." << field.sizeVar << "];\n";
+            if (field.inlineArraySize.empty())
+                CC << "    " << var(field) << " = (other." << field.sizeVar << "==0) ? nullptr : new " << field.dataType << "[other." << field.sizeVar << "];\n";
+            else
+                CC << "    " << var(field) << " = " << inlineArrayAlloc(field, "other." + field.sizeVar) << ";\n";
             CC << "    " << field.sizeVar << " = other." << field.sizeVar << ";\n";
         }
 
@@ -671,7 +761,12 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             }
         }
 
-        if (field.isArray) {
+        bool isPlainAssignment = field.isPointer ? !field.isOwnedPointer : !field.iscNamedObject && !field.iscOwnedObject;
+        if (field.isArray && isPlainAssignment) {
+            // lets the compiler turn it into a memmove for trivially copyable element types
+            CC << "    std::copy(other." << field.var << ", other." << field.var << " + " << (field.isDynamicArray ? "other." : "") << field.sizeVar << ", " << var(field) << ");\n";
+        }
+        else if (field.isArray) {
             CC << forEachIndex(field) << " {\n";
             CC << opp_indentlines(copyElem.str(), "    ");
             CC << "    }\n";
@@ -751,6 +846,12 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
                 if (field.isFixedArray) {
                     CC << "    doParsimArrayUnpacking(b," << var(field) << "," << field.arraySize << ");\n";
                 }
+                else if (!field.inlineArraySize.empty()) {
+                    CC << "    " << deleteArray(field, var(field)) << "\n";
+                    CC << "    b->unpack(" << field.sizeVar << ");\n";
+                    CC << "    " << var(field) << " = " << inlineArrayAlloc(field, field.sizeVar) << ";\n";
+                    CC << "    doParsimArrayUnpacking(b," << var(field) << "," << field.sizeVar << ");\n";
+                }
                 else {
                     CC << "    delete [] " << var(field) << ";\n";
                     CC << "    b->unpack(" << field.sizeVar << ");\n";
@@ -788,6 +889,9 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << "}\n\n";
         }
 
+        if (hasInlineAccessors(classInfo, field))
+            continue;  // already defined in the class declaration
+
         CC << field.returnType << " " << classInfo.className << "::" << field.getter << "(" << idxarg << ")" << " const\n";
         CC << "{\n";
         if (field.isArray)
@@ -801,14 +905,25 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << "void " << classInfo.className << "::" << field.sizeSetter << "(" << field.sizeType << " newSize)\n";
             CC << "{\n";
             CC << maybe_handleChange_line;
-            CC << "    " << field.dataType << " *" << field.var << "2 = (newSize==0) ? nullptr : new " << field.dataType << "[newSize];\n";
+            // note: with @inlineArray, the old and the new storage may be the same buffer
+            if (field.inlineArraySize.empty())
+                CC << "    " << field.dataType << " *" << field.var << "2 = (newSize==0) ? nullptr : new " << field.dataType << "[newSize];\n";
+            else
+                CC << "    " << field.dataType << " *" << field.var << "2 = " << inlineArrayAlloc(field, "newSize") << ";\n";
             CC << "    " << field.sizeType << " minSize = " << field.sizeVar << " < newSize ? " << field.sizeVar << " : newSize;\n";
+            if (!field.inlineArraySize.empty())
+                CC << "    if (" << field.var << "2 != " << var(field) << ")\n    ";
             CC << "    for (" << field.sizeType << " i = 0; i < minSize; i++)\n";
-            CC << "        " << field.var << "2[i] = " << var(field) << "[i];\n";
+            CC << (field.inlineArraySize.empty() ? "" : "    ") << "        " << field.var << "2[i] = " << var(field) << "[i];\n";
             if (!field.value.empty()) {
                 CC << "    for (" << field.sizeType << " i = minSize; i < newSize; i++)\n";
                 CC << "        " << field.var << "2[i] = " << field.value << ";\n";
             }
+            else if (!field.inlineArraySize.empty()) {
+                // a reused inline buffer may contain stale elements
+                CC << "    for (" << field.sizeType << " i = minSize; i < newSize; i++)\n";
+                CC << "        " << field.var << "2[i] = std::remove_reference<decltype(" << field.var << "2[i])>::type();\n";
+            }
             if (!field.isPointer && field.iscOwnedObject)
                 CC << forEachIndex(field) << "\n" << "        drop(&" << varElem(field) << ");\n";
             if (field.isPointer && field.isOwnedPointer) {
@@ -818,7 +933,7 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
                 else
                     CC << "        delete " << field.var << "[i];\n";
             }
-            CC << "    delete [] " << var(field) << ";\n";
+            CC << "    " << deleteArray(field, var(field)) << "\n";
             CC << "    " << var(field) << " = " << field.var << "2;\n";
             CC << "    " << field.sizeVar << " = newSize;\n";
             if (!field.isPointer && field.iscOwnedObject)
@@ -876,23 +991,45 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << maybe_handleChange_line;
             generateMethodCplusplusBlock(classInfo, field.inserter);
             CC << "    " << field.sizeType << " newSize = " << field.sizeVar << " + 1;\n";
-            CC << "    " << field.dataType << " *" << field.var << "2 = new " << field.dataType << "[newSize];\n";
-            CC << "    " << field.sizeType << " i;\n";
-            CC << "    for (i = 0; i < k; i++)\n";
-            CC << "        " << field.var << "2[i] = " << var(field) << "[i];\n";
-            CC << "    " << field.var << "2[k] = " << field.argName << ";\n";
-            if (field.isOwnedPointer)
-                generateOwnershipOp(field, field.var + "2[k]", "take");
-            CC << "    for (i = k + 1; i < newSize; i++)\n";
-            CC << "        " << field.var << "2[i] = " << var(field) << "[i-1];\n";
-            if (!field.isPointer && field.iscOwnedObject)
-                CC << forEachIndex(field) << "\n" << "        drop(&" << varElem(field) << ");\n";
-            CC << "    delete [] " << var(field) << ";\n";
-            CC << "    " << var(field) << " = " << field.var << "2;\n";
-            CC << "    " << field.sizeVar << " = newSize;\n";
-            if (!field.isPointer && field.iscOwnedObject)
-                CC << forEachIndex(field) << "\n" << "        take(&" << varElem(field) << ");\n";
-            CC << "}\n\n";
+            if (!field.inlineArraySize.empty()) {
+                // the old and the new storage may be the same (inline) buffer: shift elements
+                // from the end, and copy the argument first as it may refer into the array
+                std::string elem = field.var + "Elem";
+                CC << "    " << field.dataType << " " << elem << " = " << field.argName << ";\n";
+                CC << "    " << field.dataType << " *" << field.var << "2 = " << inlineArrayAlloc(field, "newSize") << ";\n";
+                CC << "    " << field.sizeType << " i;\n";
+                CC << "    for (i = newSize - 1; i > k; i--)\n";
+                CC << "        " << field.var << "2[i] = " << var(field) << "[i-1];\n";
+                CC << "    if (" << field.var << "2 != " << var(field) << ")\n";
+                CC << "        for (i = 0; i < k; i++)\n";
+                CC << "            " << field.var << "2[i] = " << var(field) << "[i];\n";
+                CC << "    " << field.var << "2[k] = " << elem << ";\n";
+                if (field.isOwnedPointer)
+                    generateOwnershipOp(field, field.var + "2[k]", "take");
+                CC << "    " << deleteArray(field, var(field)) << "\n";
+                CC << "    " << var(field) << " = " << field.var << "2;\n";
+                CC << "    " << field.sizeVar << " = newSize;\n";
+                CC << "}\n\n";
+            }
+            else {
+                CC << "    " << field.dataType << " *" << field.var << "2 = new " << field.dataType << "[newSize];\n";
+                CC << "    " << field.sizeType << " i;\n";
+                CC << "    for (i = 0; i < k; i++)\n";
+                CC << "        " << field.var << "2[i] = " << var(field) << "[i];\n";
+                CC << "    " << field.var << "2[k] = " << field.argName << ";\n";
+                if (field.isOwnedPointer)
+                    generateOwnershipOp(field, field.var + "2[k]", "take");
+                CC << "    for (i = k + 1; i < newSize; i++)\n";
+                CC << "        " << field.var << "2[i] = " << var(field) << "[i-1];\n";
+                if (!field.isPointer && field.iscOwnedObject)
+                    CC << forEachIndex(field) << "\n" << "        drop(&" << varElem(field) << ");\n";
+                CC << "    delete [] " << var(field) << ";\n";
+                CC << "    " << var(field) << " = " << field.var << "2;\n";
+                CC << "    " << field.sizeVar << " = newSize;\n";
+                if (!field.isPointer && field.iscOwnedObject)
+                    CC << forEachIndex(field) << "\n" << "        take(&" << varElem(field) << ");\n";
+                CC << "}\n\n";
+            }
 
             CC << "void " << classInfo.className << "::" << field.appender << "(" << field.argType << " " << field.argName << ")\n";
             CC << "{\n";
@@ -908,22 +1045,41 @@ void MsgCodeGenerator::generateClassImpl(const ClassInfo& classInfo)
             CC << maybe_handleChange_line;
             generateMethodCplusplusBlock(classInfo, field.eraser);
             CC << "    " << field.sizeType << " newSize = " << field.sizeVar << " - 1;\n";
-            CC << "    " << field.dataType << " *" << field.var << "2 = (newSize == 0) ? nullptr : new " << field.dataType << "[newSize];\n";
-            CC << "    " << field.sizeType << " i;\n";
-            CC << "    for (i = 0; i < k; i++)\n";
-            CC << "        " << field.var << "2[i] = " << var(field) << "[i];\n";
-            CC << "    for (i = k; i < newSize; i++)\n";
-            CC << "        " << field.var << "2[i] = " << var(field) << "[i+1];\n";
-            if (!field.isPointer && field.iscOwnedObject)
-                CC << forEachIndex(field) << "\n" << "        drop(&" << varElem(field) << ");\n";
-            if (field.isOwnedPointer)
-                generateOwnershipOp(field, var(field) + "[k]", "delete");
-            CC << "    delete [] " << var(field) << ";\n";
-            CC << "    " << var(field) << " = " << field.var << "2;\n";
-            CC << "    " << field.sizeVar << " = newSize;\n";
-            if (!field.isPointer && field.iscOwnedObject)
-                CC << forEachIndex(field) << "\n" << "        take(&" << varElem(field) << ");\n";
-            CC << "}\n\n";
+            if (!field.inlineArraySize.empty()) {
+                // the old and the new storage may be the same (inline) buffer: release
+                // the erased element first, and only shift down the ones after it
+                if (field.isOwnedPointer)
+                    generateOwnershipOp(field, var(field) + "[k]", "delete");
+                CC << "    " << field.dataType << " *" << field.var << "2 = " << inlineArrayAlloc(field, "newSize") << ";\n";
+                CC << "    " << field.sizeType << " i;\n";
+                CC << "    if (" << field.var << "2 != " << var(field) << ")\n";
+                CC << "        for (i = 0; i < k; i++)\n";
+                CC << "            " << field.var << "2[i] = " << var(field) << "[i];\n";
+                CC << "    for (i = k; i < newSize; i++)\n";
+                CC << "        " << field.var << "2[i] = " << var(field) << "[i+1];\n";
+                CC << "    " << deleteArray(field, var(field)) << "\n";
+                CC << "    " << var(field) << " = " << field.var << "2;\n";
+                CC << "    " << field.sizeVar << " = newSize;\n";
+                CC << "}\n\n";
+            }
+            else {
+                CC << "    " << field.dataType << " *" << field.var << "2 = (newSize == 0) ? nullptr : new " << field.dataType << "[newSize];\n";
+                CC << "    " << field.sizeType << " i;\n";
+                CC << "    for (i = 0; i < k; i++)\n";
+                CC << "        " << field.var << "2[i] = " << var(field) << "[i];\n";
+                CC << "    for (i = k; i < newSize; i++)\n";
+                CC << "        " << field.var << "2[i] = " << var(field) << "[i+1];\n";
+                if (!field.isPointer && field.iscOwnedObject)
+                    CC << forEachIndex(field) << "\n" << "        drop(&" << varElem(field) << ");\n";
+                if (field.isOwnedPointer)
+                    generateOwnershipOp(field, var(field) + "[k]", "delete");
+                CC << "    delete [] " << var(field) << ";\n";
+                CC << "    " << var(field) << " = " << field.var << "2;\n";
+                CC << "    " << field.sizeVar << " = newSize;\n";
+                if (!field.isPointer && field.iscOwnedObject)
+                    CC << forEachIndex(field) << "\n" << "        take(&" << varElem(field) << ");\n";
+                CC << "}\n\n";
+            }
         }
     }
 
@@ -955,9 +1111,8 @@ void MsgCodeGenerator::generateStructDecl(const ClassInfo& classInfo, const std:
 
     H << "\n{\n";
     H << "    " << classInfo.className << "();\n";
-    for (const auto& field : classInfo.fieldList) {
-        if (field.isCustom)
-            continue;
+    for (const FieldInfo *fieldPtr : getDataMemberOrder(classInfo)) {
+        const FieldInfo& field = *fieldPtr;
         H << "    " << field.dataType << " " << field.var;
         if (field.isArray)
             H << "[" << field.arraySize << "]";
@@ -1193,7 +1348,7 @@ void MsgCodeGenerator::generateDescriptorClass(const ClassInfo& classInfo)
     CC << "int " << classInfo.descriptorClass << "::getFieldCount() const\n";
     CC << "{\n";
     CC << "    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();\n";
-    CC << "    return base ? " << numFields << "+base->getFieldCount() : " << numFields << ";\n";
+    CC << "    return base ? " << numFields << "+getBaseClassFieldCount() : " << numFields << ";\n";
     CC << "}\n";
     CC << "\n";
 
@@ -1202,9 +1357,9 @@ void MsgCodeGenerator::generateDescriptorClass(const ClassInfo& classInfo)
     CC << "{\n";
     CC << "    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();\n";
     CC << "    if (base) {\n";
-    CC << "        if (field < base->getFieldCount())\n";
+    CC << "        if (field < getBaseClassFieldCount())\n";
     CC << "            return base->getFieldTypeFlags(field);\n";
-    CC << "        field -= base->getFieldCount();\n";
+    CC << "        field -= getBaseClassFieldCount();\n";
     CC << "    }\n";
     if (numFields == 0) {
         CC << "    return 0;\n";
@@ -1269,7 +1424,7 @@ void MsgCodeGenerator::generateDescriptorClass(const ClassInfo& classInfo)
     CC << "{\n";
     CC << "    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();\n";
     if (numFields > 0) {
-        CC << "    int baseIndex = base ? base->getFieldCount() : 0;\n";
+        CC << "    int baseIndex = base ? getBaseClassFieldCount() : 0;\n";
         for (size_t i = 0; i < classInfo.fieldList.size(); ++i) {
             const FieldInfo& field = classInfo.fieldList[i];
             CC << "    if (strcmp(fieldName, \"" << field.name << "\") == 0) return baseIndex + " << i << ";\n";
@@ -1650,13 +1805,13 @@ void MsgCodeGenerator::generateDelegationForBaseClassFields(const std::string& c
 
     CC << "    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();\n";
     CC << "    if (base) {\n";
-    CC << "        if (field < base->getFieldCount())" << (needsBraces ? "{" : "") << "\n";
+    CC << "        if (field < getBaseClassFieldCount())" << (needsBraces ? "{" : "") << "\n";
     CC << "            " << code << "\n";
     if (!containsReturn)
         CC << "            return;\n";
     if (needsBraces)
         CC << "        }\n";
-    CC << "        field -= base->getFieldCount();\n";
+    CC << "        field -= getBaseClassFieldCount();\n";
     CC << "    }\n";
 }
 
@@ -1814,7 +1969,7 @@ void MsgCodeGenerator::generateImplCplusplusBlock(const std::string& body)
     CC << "\n";
 }
 
-void MsgCodeGenerator::generateCplusplusBlock(std::ofstream& out, const std::string& body)
+void MsgCodeGenerator::generateCplusplusBlock(std::ostream& out, const std::string& body)
 {
     std::string trimmedBody = body;
     size_t pos0 = trimmedBody.find_first_not_of("\r\n");
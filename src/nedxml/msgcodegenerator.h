@@ -50,8 +50,8 @@ class NEDXML_API MsgCodeGenerator
   protected:
     std::string hFilename;
     std::string ccFilename;
-    std::ofstream hStream;
-    std::ofstream ccStream;
+    std::ostringstream hStream;  // written to hFilename in closeFiles()
+    std::ostringstream ccStream; // written to ccFilename in closeFiles()
     std::string headerGuard;
     ErrorStore *errors;
 
@@ -64,7 +64,7 @@ class NEDXML_API MsgCodeGenerator
     void generateClassImpl(const ClassInfo& classInfo);
     void generateStructDecl(const ClassInfo& classInfo, const std::string& exportDef);
     void generateStructImpl(const ClassInfo& classInfo);
-    void generateCplusplusBlock(std::ofstream& out, const std::string& body);
+    void generateCplusplusBlock(std::ostream& out, const std::string& body);
     void generateMethodCplusplusBlock(const ClassInfo& classInfo, const std::string& method);
     void reportUnusedMethodCplusplusBlocks(const ClassInfo& classInfo);
     void generateDelegationForBaseClassFields(const std::string& code);
@@ -63,6 +63,9 @@ const char *MsgCompiler::BUILTIN_DEFINITIONS =
         @property[beforeChange](type=string; usage=class; desc="Method to be called before mutator code (in setters, non-const getters, operator=, etc.).");
         @property[implements](type=stringlist; usage=class; desc="Names of additional base classes.");
         @property[nopack](type=bool; usage=field; desc="If true: Ignore this field in parsimPack/parsimUnpack methods.");
+        @property[packed](type=bool; usage=class; desc="If true: Lay out the data members of the generated class or struct for minimal padding (members of primitive types with a fixed size last, in order of decreasing size), and define the accessors of primitive by-value fields inline in the header.");
+        @property[pooled](type=bool; usage=field; desc="For string fields: Store the value as an interned, reference-counted omnetpp::opp_pooledstring instead of omnetpp::opp_string, which makes copying the field cheap and saves memory when many objects hold the same string.");
+        @property[inlineArray](type=int; usage=field; desc="For dynamic arrays: The number of elements to store inside the object itself. Arrays up to this size need no heap allocation; larger arrays are allocated on the heap.");
         @property[editable](type=bool; usage=field,class; desc="Affects descriptor class only. If true: Value of the field (or value of fields that are instances of this type) can be set via the class descriptor's setFieldValueFromString() and setFieldValue() methods.");
         @property[replaceable](type=bool; usage=field; desc="Affects descriptor class only. If true: Field is a pointer whose value can be set via the class descriptor's setFieldStructValuePointer() and setFieldValue() methods.");
         @property[resizable](type=bool; usage=field; desc="Affects descriptor class only. If true: Field is a variable-size array whose size can be set via the class descriptor's setFieldArraySize() method.");
@@ -138,8 +141,29 @@ P check_and_cast(T *p)
     return ret;
 }
 
-MsgCompiler::MsgCompiler(const MsgCompilerOptions& opts, ErrorStore *errors) :
-    opts(opts), analyzer(opts, &typeTable, errors), codegen(errors), errors(errors)
+MsgFileCache::~MsgFileCache()
+{
+    for (auto& pair : entries)
+        delete pair.second.tree;
+}
+
+ASTNode *MsgFileCache::get(const std::string& fileName, const std::string& content) const
+{
+    auto it = entries.find(fileName);
+    return (it != entries.end() && it->second.content == content) ? it->second.tree : nullptr;
+}
+
+void MsgFileCache::put(const std::string& fileName, const std::string& content, ASTNode *tree)
+{
+    Entry& entry = entries[fileName];
+    if (entry.tree != tree)
+        delete entry.tree;
+    entry.content = content;
+    entry.tree = tree;
+}
+
+MsgCompiler::MsgCompiler(const MsgCompilerOptions& opts, ErrorStore *errors, MsgFileCache *fileCache) :
+    opts(opts), analyzer(opts, &typeTable, errors), codegen(errors), errors(errors), fileCache(fileCache)
 {
 }
 
@@ -177,25 +201,62 @@ void MsgCompiler::importBuiltinDefinitions()
 
 void MsgCompiler::processBuiltinImport(const char *txt, const char *fname)
 {
-    MsgParser parser(errors);
-    ASTNode *tree = parser.parseMsgText(txt, fname);
-    if (errors->containsError()) {
-        delete tree;
+    ASTNode *tree = parseImport(txt, fname, true);
+    if (!tree)
         return;
+
+    // extract declarations
+    MsgFileElement *fileElement = check_and_cast<MsgFileElement*>(tree);
+    collectTypes(fileElement, true);
+}
+
+static bool readFileContent(const char *fname, std::string& content)
+{
+    std::ifstream in(fname, std::ios::binary);
+    if (!in)
+        return false;
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !in.bad();
+}
+
+ASTNode *MsgCompiler::parseImport(const char *txt, const char *fname, bool validate)
+{
+    // txt==nullptr means the file is to be read. With a file cache, we need the
+    // content up front to check whether the cached tree is up to date; if the file
+    // cannot be read, we leave it to the parser to report the error.
+    std::string content;
+    bool useCache = false;
+    if (fileCache) {
+        if (txt)
+            content = txt;
+        useCache = txt || readFileContent(fname, content);
+        if (useCache)
+            if (ASTNode *tree = fileCache->get(fname, content))
+                return tree;
     }
 
-    MsgDtdValidator dtdvalidator(errors);
-    dtdvalidator.validate(tree);
+    MsgParser parser(errors);
+    ASTNode *tree = useCache ? parser.parseMsgText(content.c_str(), fname) : txt ? parser.parseMsgText(txt, fname) : parser.parseMsgFile(fname);
     if (errors->containsError()) {
         delete tree;
-        return;
+        return nullptr;
     }
 
-    typeTable.storeMsgFile(tree); // keep AST until we're done because ClassInfo/FieldInfo refer to it...
+    if (validate) {
+        MsgDtdValidator dtdvalidator(errors);
+        dtdvalidator.validate(tree);
+        if (errors->containsError()) {
+            delete tree;
+            return nullptr;
+        }
+    }
 
-    // extract declarations
-    MsgFileElement *fileElement = check_and_cast<MsgFileElement*>(tree);
-    collectTypes(fileElement, true);
+    // keep AST until we're done because ClassInfo/FieldInfo refer to it...
+    if (useCache)
+        fileCache->put(fname, content, tree);
+    else
+        typeTable.storeMsgFile(tree);
+    return tree;
 }
 
 void MsgCompiler::collectTypes(MsgFileElement *fileElement, bool isImported)
@@ -289,14 +350,9 @@ void MsgCompiler::processImport(ImportElement *importElem, const std::string& cu
 
     importedFiles.insert(fileName);
 
-    MsgParser parser(errors);
-    ASTNode *tree = parser.parseMsgFile(fileName.c_str());
-    if (errors->containsError()) {
-        delete tree;
+    ASTNode *tree = parseImport(nullptr, fileName.c_str(), false);
+    if (!tree)
         return;
-    }
-
-    typeTable.storeMsgFile(tree); // keep AST until we're done because ClassInfo/FieldInfo refer to it...
 
     // extract declarations
     MsgFileElement *fileElement = check_and_cast<MsgFileElement*>(tree);
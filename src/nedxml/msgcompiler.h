@@ -34,6 +34,50 @@
 namespace omnetpp {
 namespace nedxml {
 
+/**
+ * @brief Cache of parsed MSG files (imports and built-in definitions), to be
+ * shared by MsgCompiler instances that compile several MSG files in the same
+ * process, so that common imports only need to be parsed once.
+ *
+ * Entries are validated against the current file contents on lookup, so the
+ * cache remains usable if files change between compilations. Trees are owned
+ * by the cache; a tree may be replaced (deleted) when its file changes, so
+ * compilers using the cache must not live longer than one compilation.
+ *
+ * @ingroup CppGenerator
+ */
+class NEDXML_API MsgFileCache
+{
+  private:
+    struct Entry {
+        std::string content;
+        ASTNode *tree;
+    };
+    std::map<std::string,Entry> entries;  // by file name
+
+  public:
+    MsgFileCache() {}
+    MsgFileCache(const MsgFileCache&) = delete;
+    ~MsgFileCache();
+
+    /**
+     * Returns the tree for the given file if it was parsed from the given
+     * content, otherwise nullptr.
+     */
+    ASTNode *get(const std::string& fileName, const std::string& content) const;
+
+    /**
+     * Stores the tree parsed from the given file content. The cache takes
+     * ownership of the tree.
+     */
+    void put(const std::string& fileName, const std::string& content, ASTNode *tree);
+
+    /**
+     * Returns the number of cached files.
+     */
+    int size() const {return entries.size();}
+};
+
 /**
  * @brief Generates C++ code from a MSG file object tree.
  *
@@ -61,6 +105,7 @@ class NEDXML_API MsgCompiler
 
     bool used = false;
     ErrorStore *errors;
+    MsgFileCache *fileCache;
     StringSet importsSeen;
     StringSet importedFiles;
 
@@ -72,6 +117,7 @@ class NEDXML_API MsgCompiler
     void importBuiltinDefinitions();
     void processBuiltinImport(const char *txt, const char *fname);
 
+    ASTNode *parseImport(const char *txt, const char *fname, bool validate);
     void processImport(ImportElement *importElem, const std::string& currentDir);
     std::string resolveImport(const std::string& importName, const std::string& currentDir);
     void collectTypes(MsgFileElement *fileElement, bool isImport);
@@ -81,9 +127,10 @@ class NEDXML_API MsgCompiler
 
   public:
     /**
-     * Constructor.
+     * Constructor. If a file cache is given, parsed imports are taken from
+     * and stored into it; otherwise they are parsed for every compilation.
      */
-    MsgCompiler(const MsgCompilerOptions& options, ErrorStore *errors);
+    MsgCompiler(const MsgCompilerOptions& options, ErrorStore *errors, MsgFileCache *fileCache=nullptr);
 
     /**
      * Destructor.
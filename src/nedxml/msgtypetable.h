@@ -92,6 +92,7 @@ class NEDXML_API MsgTypeTable
         bool isDynamicArray;    // if field is a dynamic array
         bool isFixedArray;      // if field is a fixed-size array
         std::string arraySize;  // if field is an array: array size (string inside the square brackets)
+        std::string inlineArraySize; // @inlineArray; if nonempty: number of dynamic array elements stored inside the object, without heap allocation
         Properties props;       // field properties (name, first value of default key)
 
         // data needed for code generation
@@ -107,6 +108,7 @@ class NEDXML_API MsgTypeTable
         std::string var;        // name of data member variable
         std::string argName;    // setter argument name
         std::string sizeVar;    // data member to store size of dynamic array
+        std::string inlineVar;  // data member providing inline storage for the dynamic array (see inlineArraySize)
         std::string sizeType;   // type of array sizes and array indices
         std::string getter;     // getter function name:  "T getter() const;" "const T& getter() const"  default value is getFoo
         std::string getterForUpdate; // mutable getter function name:  "T& getterForUpdate();" default value is getFooForUpdate
@@ -169,6 +171,7 @@ class NEDXML_API MsgTypeTable
         std::string extendsName;       // base type's name from MSG
         bool customize;                // from @customize
         bool omitGetVerb;              // from @omitGetVerb
+        bool isPacked = false;         // from @packed
         bool isClass;                  // true=class, false=struct
         bool isPolymorphic;            // whether the type is polymorphic (has virtual member functions)
         bool iscObject;                // whether type is subclassed from cObject
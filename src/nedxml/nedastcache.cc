@@ -0,0 +1,223 @@
+//==========================================================================
+// NEDASTCACHE.CC -
+//
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include "common/fileutil.h"
+#include "common/stringutil.h"
+#include "exception.h"
+#include "nedelements.h"
+#include "nedastcache.h"
+
+using namespace omnetpp::common;
+
+namespace omnetpp {
+namespace nedxml {
+
+// must be changed whenever the binary format or the NED DTD changes
+static const char MAGIC[8] = {'O', 'P', 'P', 'N', 'A', 'S', 'T', '1'};
+
+namespace {
+
+class Writer
+{
+  private:
+    std::string& buffer;
+  public:
+    Writer(std::string& buffer) : buffer(buffer) {}
+    void writeInt(int32_t value) {buffer.append((const char *)&value, sizeof(value));}
+    void writeString(const char *s) {
+        int32_t len = strlen(s);
+        writeInt(len);
+        buffer.append(s, len);
+    }
+};
+
+class Reader
+{
+  private:
+    const char *p;
+    const char *end;
+  public:
+    Reader(const std::string& data) : p(data.data()), end(data.data() + data.size()) {}
+    bool atEnd() const {return p == end;}
+    int32_t readInt() {
+        int32_t value;
+        if (end - p < (ptrdiff_t)sizeof(value))
+            throw NedException("Truncated data in NED AST cache entry");
+        memcpy(&value, p, sizeof(value));
+        p += sizeof(value);
+        return value;
+    }
+    std::string readString() {
+        int32_t len = readInt();
+        if (len < 0 || end - p < len)
+            throw NedException("Invalid string in NED AST cache entry");
+        std::string s(p, len);
+        p += len;
+        return s;
+    }
+};
+
+}  // namespace
+
+static void writeNode(Writer& writer, ASTNode *node)
+{
+    writer.writeInt(node->getTagCode());
+
+    const char *file = node->getSourceFileName();
+    writer.writeInt(opp_isempty(file) ? -2 : node->getSourceLineNumber());  // -2: no source location
+    const SourceRegion& region = node->getSourceRegion();
+    writer.writeInt(region.startLine);
+    writer.writeInt(region.startColumn);
+    writer.writeInt(region.endLine);
+    writer.writeInt(region.endColumn);
+
+    int numAttrs = node->getNumAttributes();
+    writer.writeInt(numAttrs);
+    for (int i = 0; i < numAttrs; i++)
+        writer.writeString(opp_nulltoempty(node->getAttribute(i)));
+
+    writer.writeInt(node->getNumChildren());
+    for (ASTNode *child = node->getFirstChild(); child; child = child->getNextSibling())
+        writeNode(writer, child);
+}
+
+static ASTNode *readNode(Reader& reader, NedAstNodeFactory& factory, const char *fileName)
+{
+    ASTNode *node = factory.createElementWithTag(reader.readInt());
+    try {
+        int line = reader.readInt();
+        if (line != -2)
+            node->setSourceLocation(FileLine(fileName, line));
+        SourceRegion region;
+        region.startLine = reader.readInt();
+        region.startColumn = reader.readInt();
+        region.endLine = reader.readInt();
+        region.endColumn = reader.readInt();
+        node->setSourceRegion(region);
+
+        int numAttrs = reader.readInt();
+        if (numAttrs != node->getNumAttributes())
+            throw NedException("Attribute count mismatch in NED AST cache entry");
+        for (int i = 0; i < numAttrs; i++)
+            node->setAttribute(i, reader.readString().c_str());
+
+        int numChildren = reader.readInt();
+        for (int i = 0; i < numChildren; i++)
+            node->appendChild(readNode(reader, factory, fileName));
+    }
+    catch (std::exception&) {
+        delete node;
+        throw;
+    }
+    return node;
+}
+
+uint64_t NedAstCache::computeKey(const char *fileName, const std::string& content)
+{
+    // 64-bit FNV-1a over the magic, the file name and the contents
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto update = [&hash](const char *data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            hash ^= (unsigned char)data[i];
+            hash *= 0x100000001b3ULL;
+        }
+    };
+    update(MAGIC, sizeof(MAGIC));
+    update(fileName, strlen(fileName) + 1);
+    update(content.data(), content.size());
+    return hash;
+}
+
+std::string NedAstCache::serialize(ASTNode *tree)
+{
+    std::string data;
+    Writer writer(data);
+    writeNode(writer, tree);
+    return data;
+}
+
+ASTNode *NedAstCache::deserialize(const std::string& data, const char *fileName)
+{
+    Reader reader(data);
+    NedAstNodeFactory factory;
+    ASTNode *tree = readNode(reader, factory, fileName);
+    if (!reader.atEnd()) {
+        delete tree;
+        throw NedException("Extra data at the end of NED AST cache entry");
+    }
+    return tree;
+}
+
+std::string NedAstCache::getEntryFileName(uint64_t key) const
+{
+    return concatDirAndFile(directory.c_str(), opp_stringf("%016llx.nedast", (unsigned long long)key).c_str());
+}
+
+bool NedAstCache::get(uint64_t key, std::string& data) const
+{
+    std::ifstream in(getEntryFileName(key), std::ios::binary);
+    if (!in)
+        return false;
+
+    char magic[sizeof(MAGIC)];
+    uint64_t storedKey, size;
+    in.read(magic, sizeof(magic));
+    in.read((char *)&storedKey, sizeof(storedKey));
+    in.read((char *)&size, sizeof(size));
+    if (!in || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || storedKey != key || size > (1ULL << 31))
+        return false;
+
+    data.resize(size);
+    in.read(&data[0], size);
+    return in && in.peek() == std::ifstream::traits_type::eof();
+}
+
+void NedAstCache::put(uint64_t key, const std::string& data) const
+{
+    try {
+        if (!isDirectory(directory.c_str()))
+            mkPath(directory.c_str());
+    }
+    catch (std::exception&) {
+        return;
+    }
+
+    // write into a temp file first, so that concurrent readers never see a partial entry
+    std::string fileName = getEntryFileName(key);
+    std::string tmpFileName = fileName + opp_stringf(".%08x.tmp", (unsigned int)std::random_device()());
+    {
+        std::ofstream out(tmpFileName, std::ios::binary);
+        uint64_t size = data.size();
+        out.write(MAGIC, sizeof(MAGIC));
+        out.write((const char *)&key, sizeof(key));
+        out.write((const char *)&size, sizeof(size));
+        out.write(data.data(), data.size());
+        out.close();
+        if (!out) {
+            remove(tmpFileName.c_str());
+            return;
+        }
+    }
+    if (rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+        remove(tmpFileName.c_str());  // e.g. another process created the entry meanwhile (on Windows)
+}
+
+}  // namespace nedxml
+}  // namespace omnetpp
+
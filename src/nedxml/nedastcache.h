@@ -0,0 +1,96 @@
+//==========================================================================
+// NEDASTCACHE.H -
+//
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_NEDXML_NEDASTCACHE_H
+#define __OMNETPP_NEDXML_NEDASTCACHE_H
+
+#include <cstdint>
+#include <string>
+#include "nedxmldefs.h"
+
+namespace omnetpp {
+namespace nedxml {
+
+class ASTNode;
+
+/**
+ * A persistent, on-disk cache of parsed NED files, used by NedResourceCache
+ * to avoid lexing, parsing and validating NED files that have not changed
+ * since the last run.
+ *
+ * Entries are stored in a directory, one file per entry, and are looked up
+ * by a key computed from the file name and the file contents. Only trees
+ * that passed DTD and syntax validation are stored, so a cache hit also
+ * means that the file is valid. Entries are written via a temporary file
+ * and a rename, so several processes may share the same cache directory.
+ *
+ * Trees are stored in a compact binary form in the native byte order;
+ * entries written by an incompatible version are ignored.
+ */
+class NEDXML_API NedAstCache
+{
+  private:
+    std::string directory;
+
+  private:
+    std::string getEntryFileName(uint64_t key) const;
+
+  public:
+    /**
+     * Constructor. The directory is created on the first write if it
+     * does not exist.
+     */
+    NedAstCache(const char *directory) : directory(directory) {}
+
+    /**
+     * Returns the cache directory.
+     */
+    const char *getDirectory() const {return directory.c_str();}
+
+    /**
+     * Computes the cache key for a NED file with the given name and contents.
+     */
+    static uint64_t computeKey(const char *fileName, const std::string& content);
+
+    /**
+     * Returns the binary representation of the given tree.
+     */
+    static std::string serialize(ASTNode *tree);
+
+    /**
+     * Reconstructs a tree from its binary representation. Source locations
+     * are set to refer to the given file. Throws an exception if the data
+     * is malformed.
+     */
+    static ASTNode *deserialize(const std::string& data, const char *fileName);
+
+    /**
+     * Looks up the entry with the given key. Returns false if the entry
+     * does not exist or cannot be read.
+     */
+    bool get(uint64_t key, std::string& data) const;
+
+    /**
+     * Stores an entry with the given key. Errors are silently ignored,
+     * as the cache is only an optimization.
+     */
+    void put(uint64_t key, const std::string& data) const;
+};
+
+}  // namespace nedxml
+}  // namespace omnetpp
+
+#endif
+
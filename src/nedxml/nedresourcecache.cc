@@ -16,6 +16,10 @@
 
 #include <cstdio>
 #include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
 #include "common/fileutil.h"
 #include "common/stringutil.h"
 #include "common/stlutil.h"
@@ -25,6 +29,7 @@
 #include "common/stringtokenizer.h"
 #include "exception.h"
 #include "nedresourcecache.h"
+#include "nedastcache.h"
 
 #include "errorstore.h"
 #include "nedparser.h"
@@ -52,6 +57,22 @@ NedResourceCache::~NedResourceCache()
         delete file.second;
     for (auto & nedType : nedTypes)
         delete nedType.second;
+    delete astCache;
+}
+
+void NedResourceCache::setNumLoaderThreads(int n)
+{
+    LOCK;
+    if (n < 1)
+        throw NedException("setNumLoaderThreads(): Number of threads must be positive");
+    numLoaderThreads = n;
+}
+
+void NedResourceCache::setAstCacheDir(const char *dir)
+{
+    LOCK;
+    delete astCache;
+    astCache = opp_isempty(dir) ? nullptr : new NedAstCache(dir);
 }
 
 void NedResourceCache::registerBuiltinDeclarations()
@@ -104,15 +125,111 @@ int NedResourceCache::loadNedFolder(const char *folderName, const char *excluded
     }
 }
 
+static std::string formatFirstError(ErrorStore *errors, const char *prefix=nullptr)
+{
+    // find first error
+    int i;
+    for (i = 0; i < errors->numMessages(); i++)
+        if (errors->errorSeverityCode(i) == SEVERITY_ERROR)
+            break;
+    Assert(i != errors->numMessages());
+
+    // assemble message
+    std::string message = errors->errorText(i);
+    message[0] = opp_toupper(message[0]);
+    std::string location = errors->errorLocation(i);
+    if (opp_stringbeginswith(message.c_str(), "Syntax error, unexpected")) // this message is not really useful, replace it
+        message = "Syntax error";
+    if (!location.empty())
+        message += ", at " + location;
+    if (prefix)
+        message = std::string(prefix) + message;
+    return message;
+}
+
+static NedFileElement *doParseAndValidateNedFileOrText(const char *fname, const char *nedText, bool isXML)
+{
+    // load file
+    ASTNode *tree = nullptr;
+    ErrorStore errors;
+    if (isXML) {
+        if (nedText)
+            throw NedException("loadNedText(): Parsing XML from string not supported");
+        tree = parseXML(fname, &errors);
+    }
+    else {
+        NedParser parser(&errors);
+        parser.setStoreSource(false);
+        if (nedText)
+            tree = parser.parseNedText(nedText, fname);
+        else
+            tree = parser.parseNedFile(fname);
+    }
+    if (errors.containsError()) {
+        delete tree;
+        throw NedException("%s", formatFirstError(&errors).c_str());
+    }
+
+    // DTD validation and additional syntax validation
+    NedDtdValidator dtdvalidator(&errors);
+    dtdvalidator.validate(tree);
+    if (errors.containsError()) {
+        delete tree;
+        throw NedException("%s", formatFirstError(&errors, "NED internal DTD validation failure: ").c_str());
+    }
+
+    NedSyntaxValidator syntaxvalidator(&errors);
+    syntaxvalidator.validate(tree);
+    if (errors.containsError()) {
+        delete tree;
+        throw NedException("%s", formatFirstError(&errors).c_str());
+    }
+    NedFileElement *nedFileElement = dynamic_cast<NedFileElement*>(tree);
+    if (!nedFileElement)
+        throw NedException("<ned-file> expected as root element, in file %s", fname);
+    return nedFileElement;
+}
+
+static NedFileElement *restoreTree(const std::string& data, const char *fname)
+{
+    ASTNode *tree = nullptr;
+    try {
+        tree = NedAstCache::deserialize(data, fname);
+    }
+    catch (std::exception&) {
+        return nullptr;
+    }
+    NedFileElement *nedFileElement = dynamic_cast<NedFileElement*>(tree);
+    if (!nedFileElement)
+        delete tree;
+    return nedFileElement;
+}
+
+static bool readFileContent(const char *fname, std::string& content)
+{
+    std::ifstream in(fname, std::ios::binary);
+    if (!in)
+        return false;
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !in.bad();
+}
+
 int NedResourceCache::doLoadNedSourceFolder(const char *folderName, const char *expectedPackage, const std::vector<std::string>& excludedPackages)
 {
     LOCK;
 
+    std::vector<NedSourceFile> files;
+    collectNedSourceFiles(folderName, expectedPackage, excludedPackages, files);
+    loadNedSourceFiles(files);
+    return files.size();
+}
+
+void NedResourceCache::collectNedSourceFiles(const char *folderName, const char *expectedPackage, const std::vector<std::string>& excludedPackages, std::vector<NedSourceFile>& result)
+{
     if (!opp_isempty(expectedPackage) && contains(excludedPackages, std::string(expectedPackage)))  // note: the root package "" cannot be excluded
-        return 0;
+        return;
 
     PushDir pushDir(folderName);
-    int count = 0;
 
     FileGlobber globber("*");
     const char *filename;
@@ -121,14 +238,117 @@ int NedResourceCache::doLoadNedSourceFolder(const char *folderName, const char *
             continue;  // ignore ".", "..", and dotfiles
         }
         if (isDirectory(filename)) {
-            count += doLoadNedSourceFolder(filename, expectedPackage == nullptr ? nullptr : opp_join(".", expectedPackage, filename).c_str(), excludedPackages);
+            collectNedSourceFiles(filename, expectedPackage == nullptr ? nullptr : opp_join(".", expectedPackage, filename).c_str(), excludedPackages, result);
         }
         else if (opp_stringendswith(filename, ".ned")) {
-            doLoadNedFileOrText(filename, nullptr, expectedPackage, false);
-            count++;
+            result.push_back(NedSourceFile{canonicalize(filename), opp_nulltoempty(expectedPackage), expectedPackage != nullptr});
         }
     }
-    return count;
+}
+
+void NedResourceCache::loadNedSourceFiles(const std::vector<NedSourceFile>& files)
+{
+    LOCK;
+
+    std::vector<const NedSourceFile*> pendingFiles;
+    for (const NedSourceFile& file : files)
+        if (!containsKey(nedFiles, file.fileName))
+            pendingFiles.push_back(&file);
+    if (pendingFiles.empty())
+        return;
+
+    if (nedTypes.empty())
+        registerBuiltinDeclarations();
+
+    int numThreads = std::min(numLoaderThreads, (int)pendingFiles.size());
+#if defined(_WIN32) && defined(WITH_SHARED_LIBS)
+    numThreads = 1;  // parser state is not thread-local in this configuration, see OPP_THREAD_LOCAL
+#endif
+
+    if (numThreads <= 1) {
+        for (const NedSourceFile *file : pendingFiles) {
+            if (containsKey(nedFiles, file->fileName))
+                continue;  // listed twice
+            NedFileElement *tree = prepareNedFile(file->fileName.c_str(), true).tree;
+            addFile(tree, file->checkPackage ? file->expectedPackage.c_str() : nullptr);
+        }
+        return;
+    }
+
+    // Parse the files in parallel. Trees cannot be handed over between threads
+    // (node IDs and pooled strings are thread-local), so workers produce the
+    // binary representation of the trees, which are then rebuilt and added in
+    // the original order, so that the result and the error reported are the
+    // same as with loading the files one by one.
+    size_t n = pendingFiles.size();
+    std::vector<PreparedNedFile> results(n);
+    std::vector<std::string> errors(n);
+    std::atomic<size_t> nextIndex(0);
+    auto worker = [&]() {
+        size_t i;
+        while ((i = nextIndex++) < n) {
+            try {
+                results[i] = prepareNedFile(pendingFiles[i]->fileName.c_str(), false);
+            }
+            catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < numThreads; i++)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < n; i++) {
+        const NedSourceFile *file = pendingFiles[i];
+        if (!errors[i].empty())
+            throw NedException("%s", errors[i].c_str());
+        if (containsKey(nedFiles, file->fileName))
+            continue;  // listed twice
+        NedFileElement *tree = restoreTree(results[i].data, file->fileName.c_str());
+        if (!tree)
+            tree = prepareNedFile(file->fileName.c_str(), true).tree;  // damaged cache entry
+        addFile(tree, file->checkPackage ? file->expectedPackage.c_str() : nullptr);
+    }
+}
+
+NedResourceCache::PreparedNedFile NedResourceCache::prepareNedFile(const char *fname, bool wantTree) const
+{
+    // note: this method runs in worker threads while the caller holds the lock,
+    // so it must not lock, and must not access the tables of loaded files and types
+    PreparedNedFile result;
+    std::string content;
+    if (!astCache || !readFileContent(fname, content)) {
+        result.tree = doParseAndValidateNedFileOrText(fname, nullptr, false);
+    }
+    else {
+        uint64_t key = NedAstCache::computeKey(fname, content);
+        if (astCache->get(key, result.data)) {
+            if (!wantTree)
+                return result;
+            result.tree = restoreTree(result.data, fname);
+            result.data.clear();
+            if (result.tree)
+                return result;
+            // damaged or incompatible entry: parse the file, and overwrite the entry
+        }
+        result.tree = doParseAndValidateNedFileOrText(fname, content.c_str(), false);
+        result.data = NedAstCache::serialize(result.tree);
+        astCache->put(key, result.data);
+    }
+
+    if (wantTree)
+        result.data.clear();
+    else {
+        if (result.data.empty())
+            result.data = NedAstCache::serialize(result.tree);
+        delete result.tree;
+        result.tree = nullptr;
+    }
+    return result;
 }
 
 inline bool isPackageNedFile(const char *fname)
@@ -198,70 +418,13 @@ void NedResourceCache::addFile(NedFileElement *tree, const char *expectedPackage
 NedFileElement *NedResourceCache::parseAndValidateNedFileOrText(const char *fname, const char *nedText, bool isXML) const
 {
     LOCK;
-
-    // load file
-    ASTNode *tree = nullptr;
-    ErrorStore errors;
-    if (isXML) {
-        if (nedText)
-            throw NedException("loadNedText(): Parsing XML from string not supported");
-        tree = parseXML(fname, &errors);
-    }
-    else {
-        NedParser parser(&errors);
-        parser.setStoreSource(false);
-        if (nedText)
-            tree = parser.parseNedText(nedText, fname);
-        else
-            tree = parser.parseNedFile(fname);
-    }
-    if (errors.containsError()) {
-        delete tree;
-        throw NedException("%s", getFirstError(&errors).c_str());
-    }
-
-    // DTD validation and additional syntax validation
-    NedDtdValidator dtdvalidator(&errors);
-    dtdvalidator.validate(tree);
-    if (errors.containsError()) {
-        delete tree;
-        throw NedException("%s", getFirstError(&errors, "NED internal DTD validation failure: ").c_str());
-    }
-
-    NedSyntaxValidator syntaxvalidator(&errors);
-    syntaxvalidator.validate(tree);
-    if (errors.containsError()) {
-        delete tree;
-        throw NedException("%s", getFirstError(&errors).c_str());
-    }
-    NedFileElement *nedFileElement = dynamic_cast<NedFileElement*>(tree);
-    if (!nedFileElement)
-        throw NedException("<ned-file> expected as root element, in file %s", fname);
-    return nedFileElement;
+    return doParseAndValidateNedFileOrText(fname, nedText, isXML);
 }
 
 std::string NedResourceCache::getFirstError(ErrorStore *errors, const char *prefix) const
 {
     LOCK;
-
-    // find first error
-    int i;
-    for (i = 0; i < errors->numMessages(); i++)
-        if (errors->errorSeverityCode(i) == SEVERITY_ERROR)
-            break;
-    Assert(i != errors->numMessages());
-
-    // assemble message
-    std::string message = errors->errorText(i);
-    message[0] = opp_toupper(message[0]);
-    std::string location = errors->errorLocation(i);
-    if (opp_stringbeginswith(message.c_str(), "Syntax error, unexpected")) // this message is not really useful, replace it
-        message = "Syntax error";
-    if (!location.empty())
-        message += ", at " + location;
-    if (prefix)
-        message = std::string(prefix) + message;
-    return message;
+    return formatFirstError(errors, prefix);
 }
 
 void NedResourceCache::loadNedFile(const char *nedFilename, const char *expectedPackage, bool isXML)
@@ -29,6 +29,7 @@ namespace omnetpp {
 namespace nedxml {
 
 class ErrorStore;
+class NedAstCache;
 
 /**
  * @brief Context of NED type lookup, for NedResourceCache.
@@ -96,6 +97,25 @@ class NEDXML_API NedResourceCache
     typedef std::map<std::string,std::string> StringMap;
     StringMap folderPackages;
 
+    // number of threads to parse NED files with in loadNedFolder()
+    int numLoaderThreads = 1;
+
+    // persistent cache of parsed NED files, or nullptr
+    NedAstCache *astCache = nullptr;
+
+    // a NED file to be loaded by loadNedSourceFiles()
+    struct NedSourceFile {
+        std::string fileName;  // absolute path, canonical representation
+        std::string expectedPackage;
+        bool checkPackage;  // if false, expectedPackage is to be ignored
+    };
+
+    // result of prepareNedFile(): either a tree, or its binary representation (see NedAstCache)
+    struct PreparedNedFile {
+        NedFileElement *tree = nullptr;
+        std::string data;
+    };
+
   public:
     // internal: members must be protected against concurrent access from multiple threads
     static std::recursive_mutex nedMutex;
@@ -104,6 +124,9 @@ class NEDXML_API NedResourceCache
     virtual void addFile(NedFileElement *node, const char *expectedPackage);
     virtual void registerBuiltinDeclarations();
     virtual int doLoadNedSourceFolder(const char *foldername, const char *expectedPackage, const std::vector<std::string>& excludedFolders);
+    virtual void collectNedSourceFiles(const char *foldername, const char *expectedPackage, const std::vector<std::string>& excludedFolders, std::vector<NedSourceFile>& result);
+    virtual void loadNedSourceFiles(const std::vector<NedSourceFile>& files);
+    PreparedNedFile prepareNedFile(const char *nedfname, bool wantTree) const; // thread-safe; does not lock nedMutex
     virtual void doLoadNedFileOrText(const char *nedfname, const char *nedtext, const char *expectedPackage, bool isXML);
     virtual NedFileElement *parseAndValidateNedFileOrText(const char *nedfname, const char *nedtext, bool isXML) const;
     virtual std::string determineRootPackageName(const char *nedSourceFolderName) const;
@@ -129,9 +152,33 @@ class NEDXML_API NedResourceCache
      * (items must be separated with a semicolon).
      *
      * The function returns the number of NED files loaded.
+     *
+     * Files are parsed using the number of threads set via setNumLoaderThreads(),
+     * and via the cache set with setAstCacheDir(), but they are registered
+     * in the same order and with the same error reporting as if they were
+     * loaded one by one.
      */
     virtual int loadNedFolder(const char *foldername, const char *excludedPackages);
 
+    /**
+     * Sets the number of threads loadNedFolder() may use for parsing
+     * NED files. The default is 1.
+     */
+    virtual void setNumLoaderThreads(int n);
+
+    /**
+     * Returns the number of threads loadNedFolder() may use for parsing
+     * NED files.
+     */
+    virtual int getNumLoaderThreads() const {return numLoaderThreads;}
+
+    /**
+     * Sets the directory of the persistent cache of parsed NED files used
+     * by loadNedFolder(); see NedAstCache. nullptr or "" turns off caching,
+     * which is the default.
+     */
+    virtual void setAstCacheDir(const char *dir);
+
     /**
      * Load a single NED file. If the expected package is given (non-nullptr),
      * it should match the package declaration inside the NED file.
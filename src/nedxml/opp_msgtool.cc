@@ -343,8 +343,18 @@ void MsgTool::printHelpPage(const std::string& page)
         help.option("-Xnc", "Do not generate classes, only descriptors (cf. @existingClass MSG property)");
         help.option("-Xnd", "Do not generate class descriptors (cf. @descriptor(false) MSG property)");
         help.option("-Xns", "Do not generate setters in class descriptors (cf. @descriptor(readonly) MSG property)");
+        help.option("--daemon", "Instead of processing files given on the command line, read requests from "
+                    "the standard input, one per line. Each line contains the MSG files (or folders) "
+                    "to translate, separated by whitespace; the response is a line on the standard "
+                    "output containing either \"OK\" or \"ERROR\" and an error message. Options given on "
+                    "the command line apply to all requests, except that -MF is not allowed: with -MD, "
+                    "the dependencies of each MSG file are written next to the generated header, into "
+                    "a file with the header's name plus \".d\".");
         help.option("-v", "Verbose");
         help.line();
+        help.para("When translating several MSG files in one invocation (or in daemon mode), imported "
+                  "MSG files are parsed only once. Output files are only written if their content "
+                  "has changed, so that the C++ files that include them need not be recompiled.");
     }
     else if (page == "builtindefs") {
         std::cout << MsgCompiler::getBuiltinDefinitions();
@@ -551,6 +561,7 @@ void MsgTool::generateCppCommand(int argc, char **argv)
     bool opt_generatedependencies = false; // -MD
     std::string opt_dependenciesfile;  // -MF
     bool opt_phonytargets = false;     // -MP
+    bool opt_daemon = false;           // --daemon
     MsgCompilerOptions msg_options;
     std::vector<std::string> msgfiles;
 
@@ -602,6 +613,9 @@ void MsgTool::generateCppCommand(int argc, char **argv)
         else if (!strcmp(argv[i], "-MP")) {
             opt_phonytargets = true;
         }
+        else if (!strcmp(argv[i], "--daemon")) {
+            opt_daemon = true;
+        }
         else if (!strncmp(argv[i], "-X", 2)) {
             const char *arg = argv[i]+2;
             if (!*arg) {
@@ -629,51 +643,93 @@ void MsgTool::generateCppCommand(int argc, char **argv)
             addAll(msgfiles, expandFileArg(argv[i]));
     }
 
+    // parsed imports are shared among the files compiled in this process
+    MsgFileCache fileCache;
+    msg_options.importPath = opt_importpath;
+
+    auto compileFiles = [&](const std::vector<std::string>& msgfiles) -> int {
+        int numFilesWithErrors = 0;
+        for (std::string msgfile : msgfiles) {
+            // parse
+            MsgFileElement *tree = parseMsgFile(msgfile.c_str(), false);
+            if (tree == nullptr) {
+                numFilesWithErrors++;
+                continue;
+            }
+
+            // generate output file names
+            const char *suffix = opt_suffix;
+            const char *hdrsuffix = opt_hdrsuffix;
+            if (!suffix)
+                suffix = "_m.cc";
+            if (!hdrsuffix)
+                hdrsuffix = "_m.h";
+            std::string outccfname = removeFileExtension(msgfile.c_str()) + suffix;
+            std::string outhfname = removeFileExtension(msgfile.c_str()) + hdrsuffix;
+
+            // generate C++ code
+            if (opt_verbose)
+                cout << "writing " << outhfname << " and " << outccfname << "\n";
+            ErrorStore errors;
+            errors.setPrintToStderr(true);
+            MsgCompiler generator(msg_options, &errors, &fileCache);
+            std::set<std::string> dependencies;
+            generator.generate(tree, outhfname.c_str(), outccfname.c_str(), dependencies);
+            if (errors.containsError())
+                numFilesWithErrors++;
+            if (opt_generatedependencies) {
+                // in daemon mode, the standard output carries the responses, and all requests
+                // would overwrite the same -MF file, so each MSG file gets a dependency file
+                std::string depsfile = opt_daemon ? outhfname + ".d" : opt_dependenciesfile;
+                generateDependencies(depsfile.c_str(), msgfile.c_str(), outhfname.c_str(), outccfname.c_str(), dependencies, opt_phonytargets);
+            }
+            delete tree;
+        }
+        return numFilesWithErrors;
+    };
+
+    if (opt_daemon) {
+        if (!msgfiles.empty())
+            throw opp_runtime_error("no input files may be specified with --daemon");
+        if (!opt_dependenciesfile.empty())
+            throw opp_runtime_error("-MF cannot be used with --daemon (with -MD, dependencies are written into <header>.d files)");
+        serveCppRequests(compileFiles);
+        return;
+    }
+
     if (msgfiles.empty())
         std::cerr << "opp_msgtool: Warning: no input files\n";
 
     if (opt_verbose)
         std::cout << "Translating to C++ " << msgfiles.size() << " file(s)\n";
 
-    int numFilesWithErrors = 0;
-    for (std::string msgfile : msgfiles) {
-        // parse
-        MsgFileElement *tree = parseMsgFile(msgfile.c_str(), false);
-        if (tree == nullptr) {
-            numFilesWithErrors++;
-            continue;
-        }
-
-        // generate output file names
-        const char *suffix = opt_suffix;
-        const char *hdrsuffix = opt_hdrsuffix;
-        if (!suffix)
-            suffix = "_m.cc";
-        if (!hdrsuffix)
-            hdrsuffix = "_m.h";
-        std::string outccfname = removeFileExtension(msgfile.c_str()) + suffix;
-        std::string outhfname = removeFileExtension(msgfile.c_str()) + hdrsuffix;
-
-        // generate C++ code
-        if (opt_verbose)
-            cout << "writing " << outhfname << " and " << outccfname << "\n";
-        ErrorStore errors;
-        errors.setPrintToStderr(true);
-        msg_options.importPath = opt_importpath;
-        MsgCompiler generator(msg_options, &errors);
-        std::set<std::string> dependencies;
-        generator.generate(tree, outhfname.c_str(), outccfname.c_str(), dependencies);
-        if (errors.containsError())
-            numFilesWithErrors++;
-        if (opt_generatedependencies)
-            generateDependencies(opt_dependenciesfile.c_str(), msgfile.c_str(), outhfname.c_str(), outccfname.c_str(), dependencies, opt_phonytargets);
-        delete tree;
-    }
-
+    int numFilesWithErrors = compileFiles(msgfiles);
     if (numFilesWithErrors > 0)
         throw opp_runtime_error("error in %d file(s)", numFilesWithErrors);
 }
 
+void MsgTool::serveCppRequests(const std::function<int(const std::vector<std::string>&)>& compileFiles)
+{
+    // one request per line, containing the MSG files (or folders) to compile;
+    // the response is a line containing "OK" or "ERROR <message>"
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::string response;
+        try {
+            std::vector<std::string> msgfiles;
+            for (const std::string& arg : opp_splitandtrim(line))
+                addAll(msgfiles, expandFileArg(arg.c_str()));
+            int numFilesWithErrors = compileFiles(msgfiles);
+            response = numFilesWithErrors == 0 ? "OK" : opp_stringf("ERROR error in %d file(s)", numFilesWithErrors);
+        }
+        catch (std::exception& e) {
+            response = std::string("ERROR ") + e.what();
+        }
+        std::cerr.flush();
+        std::cout << response << std::endl;
+    }
+}
+
 int MsgTool::main(int argc, char **argv)
 {
     if (argc < 2) {
@@ -15,6 +15,7 @@
 #ifndef __OMNETPP_NEDXML_MSGTOOL_H
 #define __OMNETPP_NEDXML_MSGTOOL_H
 
+#include <functional>
 #include <string>
 #include "nedxmldefs.h"
 
@@ -54,6 +55,7 @@ class MsgTool
     void prettyprintCommand(int argc, char **argv);
     void validateCommand(int argc, char **argv);
     void generateCppCommand(int argc, char **argv);
+    void serveCppRequests(const std::function<int(const std::vector<std::string>&)>& compileFiles);
   public:
     int main(int argc, char **argv);
 };
@@ -65,12 +65,35 @@ FigureRenderingArgs CanvasRenderer::makeChildArgs(const FigureRenderingArgs& arg
     return childArgs;
 }
 
+FigureRenderingArgs CanvasRenderer::makeArgsFor(cFigure *figure, const FigureRenderingHints *hints)
+{
+    cFigure *parent = figure->getParentFigure();
+    if (parent == nullptr)
+        return makeRootArgs(hints);
+    return makeChildArgs(makeArgsFor(parent, hints), parent->findFigure(figure));
+}
+
+bool CanvasRenderer::isOutOfView(const FigureRenderingArgs& args)
+{
+    const QRectF& visibleRect = args.hints->visibleRect;
+    return !visibleRect.isNull() && args.item && !args.item->sceneBoundingRect().intersects(visibleRect);
+}
+
 bool CanvasRenderer::fulfillsTagFilter(cFigure *figure)
 {
     uint64_t figureTagBits = figure->getTagBits();
     return figureTagBits == 0 || ((figureTagBits & enabledTagBits) != 0 && (figureTagBits & exceptTagBits) == 0);
 }
 
+bool CanvasRenderer::isRendered(cFigure *figure)
+{
+    // same conditions as in drawFigureRec(), for the figure and all its ancestors except the root
+    for ( ; figure->getParentFigure() != nullptr; figure = figure->getParentFigure())
+        if (!figure->isVisible() || !fulfillsTagFilter(figure))
+            return false;
+    return true;
+}
+
 // TODO: delete comment when ASSERT is available
 void CanvasRenderer::setLayer(GraphicsLayer *layer, cCanvas *canvas, GraphicsLayer *networkLayer)
 {
@@ -87,6 +110,7 @@ void CanvasRenderer::setLayer(GraphicsLayer *layer, cCanvas *canvas, GraphicsLay
 void CanvasRenderer::setCanvas(cCanvas *canvas)
 {
     this->canvas = canvas;
+    deferredChanges.clear();
     enabledTagBits = ~(uint64_t)0;  // all enabled
     exceptTagBits = 0;
 }
@@ -115,6 +139,7 @@ void CanvasRenderer::redraw(const FigureRenderingHints &hints)
 
     layer->clear();
     items.clear();
+    deferredChanges.clear();
     lastZoom = std::nan("");
 
     // draw
@@ -158,8 +183,19 @@ void CanvasRenderer::refreshFigureRec(const FigureRenderingArgs& args, uint8_t a
         if (localChanges || subtreeChanges || inheritedChanges || args.zoomChanged) {
             uint8_t what = localChanges | inheritedChanges;
 
-            if (what || args.zoomChanged)
-                 getRendererFor(args.figure)->refresh(args, what);
+            // changes that only affect the look of a figure that is out of view are
+            // applied later, when it is scrolled into view (or changes in other ways)
+            const uint8_t deferrable = cFigure::CHANGE_VISUAL | cFigure::CHANGE_INPUTDATA | cFigure::CHANGE_OTHER;
+            if (what && !(what & ~deferrable) && !args.zoomChanged && isOutOfView(args))
+                deferredChanges[args.figure] |= what;
+            else if (what || args.zoomChanged) {
+                auto it = deferredChanges.find(args.figure);
+                if (it != deferredChanges.end()) {
+                    what |= it->second;
+                    deferredChanges.erase(it);
+                }
+                getRendererFor(args.figure)->refresh(args, what);
+            }
 
             if (subtreeChanges || what || args.zoomChanged)
                 for (int i = 0; i < args.figure->getNumFigures(); i++)
@@ -168,6 +204,34 @@ void CanvasRenderer::refreshFigureRec(const FigureRenderingArgs& args, uint8_t a
     }
 }
 
+void CanvasRenderer::refreshDeferred(const FigureRenderingHints& hints)
+{
+    if (!canvas || deferredChanges.empty())
+        return;
+
+    // after a structural or tag change, deferred figures may have been hidden,
+    // removed or even deleted; the next refresh() redraws everything anyway
+    cFigure *rootFigure = canvas->getRootFigure();
+    if ((rootFigure->getLocalChangeFlags() | rootFigure->getSubtreeChangeFlags()) & (cFigure::CHANGE_STRUCTURAL | cFigure::CHANGE_TAGS))
+        return;
+
+    for (auto it = deferredChanges.begin(); it != deferredChanges.end(); ) {
+        if (!isRendered(it->first)) {
+            // hidden or filtered out since its change was deferred (e.g. by
+            // changing the tag filter), so its item is not to be updated
+            it = deferredChanges.erase(it);
+            continue;
+        }
+        FigureRenderingArgs args = makeArgsFor(it->first, &hints);
+        if (isOutOfView(args))
+            ++it;
+        else {
+            getRendererFor(args.figure)->refresh(args, it->second);
+            it = deferredChanges.erase(it);
+        }
+    }
+}
+
 QRectF CanvasRenderer::itemsBoundingRect() const
 {
     QRectF bounds;
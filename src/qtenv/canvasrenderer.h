@@ -41,14 +41,22 @@ protected:
 
     std::map<cFigure *, QGraphicsItem*> items;
 
+    // Changes not yet applied to the items of figures that were out of view
+    // when they changed. Only changes that cannot move a figure into view
+    // are deferred like this, see refreshFigureRec().
+    std::map<cFigure *, uint8_t> deferredChanges;
+
 protected:
     void assertCanvas();
     FigureRenderer *getRendererFor(cFigure *figure);
     FigureRenderingArgs makeRootArgs(const FigureRenderingHints *hints);
     FigureRenderingArgs makeChildArgs(const FigureRenderingArgs& args, int i);
+    FigureRenderingArgs makeArgsFor(cFigure *figure, const FigureRenderingHints *hints);
+    bool isOutOfView(const FigureRenderingArgs& args);
     void drawFigureRec(const FigureRenderingArgs& args);
     void refreshFigureRec(const FigureRenderingArgs& args, uint8_t ancestorChanges);
     bool fulfillsTagFilter(cFigure *figure);
+    bool isRendered(cFigure *figure); // visible and not filtered out, together with all its ancestors
 
 public:
     void setLayer(GraphicsLayer *layer, cCanvas *canvas, GraphicsLayer *networkLayer = nullptr);
@@ -56,6 +64,7 @@ public:
     bool hasCanvas() {return canvas != nullptr;}
     void refresh(const FigureRenderingHints& hints);
     void redraw(const FigureRenderingHints& hints);
+    void refreshDeferred(const FigureRenderingHints& hints); // applies the deferred changes of the figures that came into view
 
     QRectF itemsBoundingRect() const;
 
@@ -35,6 +35,9 @@ struct QTENV_API FigureRenderingHints
     double defaultZoom = 1; // XXX name: topLevelZoom? not really a default...
     std::string defaultFont = "Arial";
     int defaultFontSize = 12;
+    // the part of the scene on the screen; applying some changes to figures
+    // outside of it may be deferred, see CanvasRenderer (null means no culling)
+    QRectF visibleRect;
 };
 
 // this is a bit more private, only used by CanvasRenderer and FigureRenderer,
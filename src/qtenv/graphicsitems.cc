@@ -17,9 +17,11 @@
 #include "graphicsitems.h"
 
 #include <cmath>
+#include <algorithm>
 #include <QtGui/QPen>
 #include <QtGui/QPainter>
 #include <QtGui/QFontMetricsF>
+#include <QtWidgets/QStyleOptionGraphicsItem>
 #include <QtCore/QDebug>
 #include "qtenvapp.h"
 #include "qtutil.h"
@@ -184,6 +186,81 @@ void ZoomLabel::setZoomFactor(double zoomFactor)
 
 //---- end of ZoomLabel ----
 
+//---- SubmoduleClusterItem implementation ----
+
+SubmoduleClusterItem::SubmoduleClusterItem(QGraphicsItem *parent)
+    : QGraphicsItem(parent)
+{
+    // for the exposedRect in paint()
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+void SubmoduleClusterItem::setPositions(const std::vector<QPointF>& positions, double cellSize)
+{
+    prepareGeometryChange();
+
+    this->cellSize = cellSize;
+    counts.clear();
+    numCols = numRows = maxCount = 0;
+
+    if (positions.empty())
+        return;
+
+    double minX = positions[0].x(), minY = positions[0].y();
+    double maxX = minX, maxY = minY;
+    for (const QPointF& p : positions) {
+        minX = std::min(minX, p.x());
+        minY = std::min(minY, p.y());
+        maxX = std::max(maxX, p.x());
+        maxY = std::max(maxY, p.y());
+    }
+
+    origin = QPointF(std::floor(minX / cellSize) * cellSize, std::floor(minY / cellSize) * cellSize);
+    numCols = (int)((maxX - origin.x()) / cellSize) + 1;
+    numRows = (int)((maxY - origin.y()) / cellSize) + 1;
+    counts.assign((size_t)numCols * numRows, 0);
+
+    for (const QPointF& p : positions) {
+        int col = std::min(numCols - 1, (int)((p.x() - origin.x()) / cellSize));
+        int row = std::min(numRows - 1, (int)((p.y() - origin.y()) / cellSize));
+        maxCount = std::max(maxCount, ++counts[(size_t)row * numCols + col]);
+    }
+
+    update();
+}
+
+QRectF SubmoduleClusterItem::boundingRect() const
+{
+    return QRectF(origin, QSizeF(numCols * cellSize, numRows * cellSize));
+}
+
+void SubmoduleClusterItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    if (counts.empty())
+        return;
+
+    // only the cells in the exposed area
+    QRectF rect = option->exposedRect.intersected(boundingRect());
+    int firstCol = std::max(0, (int)((rect.left() - origin.x()) / cellSize));
+    int lastCol = std::min(numCols - 1, (int)((rect.right() - origin.x()) / cellSize));
+    int firstRow = std::max(0, (int)((rect.top() - origin.y()) / cellSize));
+    int lastRow = std::min(numRows - 1, (int)((rect.bottom() - origin.y()) / cellSize));
+
+    painter->setPen(Qt::NoPen);
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int col = firstCol; col <= lastCol; col++) {
+            int count = counts[(size_t)row * numCols + col];
+            if (count == 0)
+                continue;
+            // the more submodules, the darker
+            painter->setBrush(QColor(0, 0, 128, 64 + 191 * count / maxCount));
+            painter->drawRect(QRectF(origin.x() + col * cellSize, origin.y() + row * cellSize, cellSize, cellSize));
+        }
+    }
+}
+
+//---- end of SubmoduleClusterItem ----
+
 //---- OutlinedTextItem implementation ----
 
 OutlinedTextItem::OutlinedTextItem(QGraphicsItem *parent)
@@ -18,6 +18,7 @@
 #define __OMNETPP_QTENV_GRAPHICSITEMS_H
 
 #include <cmath> // for NAN
+#include <vector>
 #include <QtWidgets/QGraphicsObject>
 #include <QtWidgets/QGraphicsEffect>
 #include <QtGui/QFont>
@@ -162,6 +163,29 @@ public:
     void setZoomFactor(double zoomFactor);
 };
 
+// Shown in the ModuleInspector instead of the submodules when there are so many
+// of them on the screen that their icons would cover each other. The area is
+// divided into square cells, and each nonempty cell is filled with a shade
+// depending on the number of submodules in it.
+class QTENV_API SubmoduleClusterItem : public QGraphicsItem
+{
+protected:
+    double cellSize = 16;
+    QPointF origin;
+    int numCols = 0, numRows = 0;
+    std::vector<int> counts; // row-major
+    int maxCount = 0;
+
+public:
+    SubmoduleClusterItem(QGraphicsItem *parent = nullptr);
+
+    // positions are the centers of the submodules
+    void setPositions(const std::vector<QPointF>& positions, double cellSize);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+};
+
 // XXX: Why not QGraphicsPathItem ?
 class QTENV_API BubbleItem : public QGraphicsObject {
     Q_OBJECT
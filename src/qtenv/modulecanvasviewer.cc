@@ -56,12 +56,20 @@ using namespace omnetpp::layout;
 namespace omnetpp {
 namespace qtenv {
 
+// level of detail: smaller networks are always shown in full detail; for larger
+// ones, the average distance (in pixels) of submodules on the screen below which
+// connections are hidden, and submodules are shown as clusters
+static const int LOD_MIN_SUBMODULE_COUNT = 1000;
+static const double LOD_NO_CONNECTIONS_SPACING = 24;
+static const double LOD_CLUSTERS_SPACING = 8;
+
 ModuleCanvasViewer::ModuleCanvasViewer()
 {
     setFont(getQtenv()->getCanvasFont());
 
     backgroundLayer = new GraphicsLayer();
     rangeLayer = new GraphicsLayer();
+    connectionLayer = new GraphicsLayer();
     submoduleLayer = new GraphicsLayer();
     figureLayer = new GraphicsLayer();
     animationLayer = new GraphicsLayer();
@@ -85,9 +93,16 @@ ModuleCanvasViewer::ModuleCanvasViewer()
 
     networkLayer = new GraphicsLayer();
     networkLayer->addItem(rangeLayer);
+    networkLayer->addItem(connectionLayer);
     networkLayer->addItem(submoduleLayer);
     networkLayer->addItem(animationLayer);
 
+    clusterItem = new SubmoduleClusterItem();
+    clusterItem->setData(ITEMDATA_TOOLTIP, "Zoom in to see the submodules");
+    clusterItem->setVisible(false);
+    networkLayer->addItem(clusterItem);
+    clusterItem->stackBefore(animationLayer);
+
     zoomLabel = new ZoomLabel();
     zoomLabelLayer->addItem(zoomLabel);
     zoomLabel->setZoomFactor(zoomFactor);
@@ -133,6 +148,7 @@ void ModuleCanvasViewer::scrollContentsBy(int dx, int dy)
 {
     QGraphicsView::scrollContentsBy(dx, dy);
     updateZoomLabelPos();
+    viewportChanged();
 }
 
 void ModuleCanvasViewer::updateZoomLabelPos()
@@ -300,6 +316,7 @@ void ModuleCanvasViewer::resizeEvent(QResizeEvent *event)
     if (isEnabled())
         recalcSceneRect();
     updateZoomLabelPos();
+    viewportChanged();
 }
 
 bool ModuleCanvasViewer::event(QEvent *event)
@@ -445,6 +462,17 @@ void ModuleCanvasViewer::renderToPrinter(QPrinter &printer, const QRectF& sceneR
 
 void ModuleCanvasViewer::renderToPaintDevice(QPaintDevice &printer, const QRectF& sceneRect, const QRectF& pageRect)
 {
+    // the export area may contain items that were not refreshed because they were out of view
+    if (object && !notDrawn) {
+        for (auto p : submoduleGraphicsItems)
+            SubmoduleItemUtil::updateQueueSizeLabel(p.second, p.first);
+        queueSizesOutdated = false;
+
+        FigureRenderingHints hints = makeFigureRenderingHints();
+        hints.visibleRect = QRectF();
+        canvasRenderer->refreshDeferred(hints);
+    }
+
     scene()->setSceneRect(sceneRect);
 
     QPainter painter;
@@ -490,12 +518,69 @@ FigureRenderingHints ModuleCanvasViewer::makeFigureRenderingHints()
     hints.defaultFont = canvasFont.family().toStdString();
     hints.defaultFontSize = canvasFont.pointSize();
     hints.defaultZoom = zoomFactor;
+    hints.visibleRect = getVisibleSceneRect();
     return hints;
 }
 
+QRectF ModuleCanvasViewer::getVisibleSceneRect()
+{
+    // with a margin for the labels and decorations that stick out of the bounding rectangles of items
+    const double margin = 50;
+    return mapToScene(viewport()->rect()).boundingRect().adjusted(-margin, -margin, margin, margin);
+}
+
+void ModuleCanvasViewer::updateLevelOfDetail()
+{
+    // the average distance between submodules on the screen decides
+    LevelOfDetail level = LOD_FULL;
+    int count = submoduleGraphicsItems.size();
+    if (count >= LOD_MIN_SUBMODULE_COUNT) {
+        QRectF rect = getSubmodulesRect();
+        double spacing = std::sqrt(rect.width() * rect.height() / count);
+        if (spacing < LOD_CLUSTERS_SPACING)
+            level = LOD_CLUSTERS;
+        else if (spacing < LOD_NO_CONNECTIONS_SPACING)
+            level = LOD_NO_CONNECTIONS;
+    }
+
+    levelOfDetail = level;
+    rangeLayer->setVisible(level != LOD_CLUSTERS);
+    connectionLayer->setVisible(level == LOD_FULL);
+    submoduleLayer->setVisible(level != LOD_CLUSTERS);
+    clusterItem->setVisible(level == LOD_CLUSTERS);
+
+    if (level == LOD_CLUSTERS)
+        refreshClusters();
+
+    if (level == LOD_FULL && connectionsOutdated) {
+        refreshConnections();
+        connectionsOutdated = false;
+    }
+}
+
+void ModuleCanvasViewer::refreshClusters()
+{
+    std::vector<QPointF> positions;
+    positions.reserve(submoduleGraphicsItems.size());
+    for (auto p : submoduleGraphicsItems)
+        positions.push_back(p.second->pos());
+    clusterItem->setPositions(positions, 2 * LOD_CLUSTERS_SPACING);
+}
+
+void ModuleCanvasViewer::viewportChanged()
+{
+    if (!object || notDrawn || scene() != moduleScene)
+        return;
+
+    if (queueSizesOutdated)
+        refreshQueueSizes();
+    canvasRenderer->refreshDeferred(makeFigureRenderingHints());
+}
+
 // requires either recalculateLayout() or refreshLayout() called before!
 void ModuleCanvasViewer::redrawModules()
 {
+    connectionLayer->clear();
     submoduleLayer->clear();
     submoduleGraphicsItems.clear();
     connectionGraphicsItems.clear();
@@ -623,7 +708,7 @@ void ModuleCanvasViewer::drawConnection(cGate *gate)
     ASSERT(gate->getOwnerModule() == object || gate->getOwnerModule()->getParentModule() == object);
     ASSERT(!containsKey(connectionGraphicsItems, gate));
 
-    auto item = new ConnectionItem(submoduleLayer);
+    auto item = new ConnectionItem(connectionLayer);
     try {
         item->setLine(getConnectionLine(gate));
         ConnectionItemUtil::setupFromDisplayString(item, gate, showArrowHeads);
@@ -805,6 +890,7 @@ void ModuleCanvasViewer::clear()
 {
     // everything on the animationLayer is handled by the Animator, so don't touch that!
     backgroundLayer->clear();
+    connectionLayer->clear();
     submoduleLayer->clear();
     bubbleLayer->clear();
 
@@ -816,6 +902,10 @@ void ModuleCanvasViewer::clear()
     changedSubmodules.clear();
     changedConnections.clear();
 
+    connectionsOutdated = false;
+    queueSizesOutdated = false;
+    updateLevelOfDetail();
+
     needsRedraw = false;
     notDrawn = false;
 }
@@ -855,8 +945,15 @@ void ModuleCanvasViewer::refreshSubmodules()
 
 void ModuleCanvasViewer::refreshQueueSizes()
 {
-    for (auto p : submoduleGraphicsItems)
-        SubmoduleItemUtil::updateQueueSizeLabel(p.second, p.first);
+    // only the ones in view, the rest are refreshed when they are scrolled into view
+    QRectF visibleRect = getVisibleSceneRect();
+    queueSizesOutdated = false;
+    for (auto p : submoduleGraphicsItems) {
+        if (levelOfDetail != LOD_CLUSTERS && p.second->sceneBoundingRect().intersects(visibleRect))
+            SubmoduleItemUtil::updateQueueSizeLabel(p.second, p.first);
+        else
+            queueSizesOutdated = true;
+    }
 }
 
 void ModuleCanvasViewer::refreshConnection(cGate *gate)
@@ -922,6 +1019,8 @@ void ModuleCanvasViewer::redraw()
         redrawFigures();
         refreshSubmodules();
         refreshConnections();
+        connectionsOutdated = false;
+        updateLevelOfDetail();
     }
     catch (std::exception& e) {
         getQtenv()->showException(e);
@@ -985,17 +1084,28 @@ void ModuleCanvasViewer::refresh()
             }
         }
 
-        for (auto g : changedConnections)
-            if (g && g->getNextGate()) {// if any gate was unconnected above, we added a nullptr
-                refreshConnection(g);
-                if (isTwoWayConnection(g)) {
-                    // if it is two way connection, refresh the "other half" of it as well,
-                    // so in case the connection line itself has changed, it isn't split in two
-                    cGate *otherDirection = getGateOtherHalf(g->getNextGate());
-                    if (!contains(changedConnections, otherDirection)) // don't do it twice
-                        refreshConnection(otherDirection);
+        // positions may have changed
+        if (!changedSubmodules.empty())
+            updateLevelOfDetail();
+
+        // hidden connections are refreshed when they are shown again
+        if (levelOfDetail != LOD_FULL) {
+            if (!changedConnections.empty())
+                connectionsOutdated = true;
+        }
+        else {
+            for (auto g : changedConnections)
+                if (g && g->getNextGate()) {// if any gate was unconnected above, we added a nullptr
+                    refreshConnection(g);
+                    if (isTwoWayConnection(g)) {
+                        // if it is two way connection, refresh the "other half" of it as well,
+                        // so in case the connection line itself has changed, it isn't split in two
+                        cGate *otherDirection = getGateOtherHalf(g->getNextGate());
+                        if (!contains(changedConnections, otherDirection)) // don't do it twice
+                            refreshConnection(otherDirection);
+                    }
                 }
-            }
+        }
     }
 
     compoundModuleChanged = false;
@@ -1027,9 +1137,12 @@ void ModuleCanvasViewer::setZoomFactor(double zoomFactor)
         refreshSubmodules();
         // has to be done after the submodules have been positioned, but before connections
         redrawEnclosingModule();
-        refreshConnections();
+        // refreshes the connections too, unless they are hidden
+        connectionsOutdated = true;
+        updateLevelOfDetail();
 
         recalcSceneRect();
+        viewportChanged();
 
         viewport()->update();
     }
@@ -38,6 +38,7 @@ class cComponent;
 namespace qtenv {
 
 class GraphicsLayer;
+class SubmoduleClusterItem;
 class CompoundModuleItem;
 class SubmoduleItem;
 class ConnectionItem;
@@ -82,6 +83,7 @@ private:
 
     GraphicsLayer *backgroundLayer;
     GraphicsLayer *rangeLayer;
+    GraphicsLayer *connectionLayer;
     GraphicsLayer *submoduleLayer;
     GraphicsLayer *networkLayer;
     GraphicsLayer *figureLayer;
@@ -97,6 +99,16 @@ private:
 
     ZoomLabel *zoomLabel;
 
+    // Level of detail, to keep huge networks responsive. When the submodules
+    // are crowded on the screen, connections are hidden, and when even their
+    // icons would cover each other, they are shown as clusters (by clusterItem).
+    // Changes to the hidden items are applied when they are shown again.
+    enum LevelOfDetail { LOD_FULL, LOD_NO_CONNECTIONS, LOD_CLUSTERS };
+    LevelOfDetail levelOfDetail = LOD_FULL;
+    SubmoduleClusterItem *clusterItem;
+    bool connectionsOutdated = false; // some connections changed while they were hidden
+    bool queueSizesOutdated = false; // some queue size labels were out of view in the last refresh
+
     // drawing methods:
     void redrawFigures();
     void refreshFigures();
@@ -108,6 +120,11 @@ private:
 
     FigureRenderingHints makeFigureRenderingHints();
 
+    QRectF getVisibleSceneRect();
+    void updateLevelOfDetail();
+    void refreshClusters();
+    void viewportChanged(); // refreshes what was culled because it was out of view
+
     void updateZoomLabelPos();
 
     QRectF askExportArea(); // returns a Null rectangle if the dialog was cancelled.
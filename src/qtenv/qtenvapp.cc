@@ -146,6 +146,7 @@ extern "C" QTENV_API void _qtenv_lib() {}
 Register_GlobalConfigOptionU(CFGID_QTENV_EXTRA_STACK, "qtenv-extra-stack", "B", "80KiB", "Specifies the extra amount of stack that is reserved for each `activity()` simple module when the simulation is run under Qtenv.");
 Register_GlobalConfigOption(CFGID_QTENV_DEFAULT_CONFIG, "qtenv-default-config", CFG_STRING, nullptr, "Specifies which config Qtenv should set up automatically on startup. The default is to ask the user.");
 Register_GlobalConfigOption(CFGID_QTENV_DEFAULT_RUN, "qtenv-default-run", CFG_STRING, nullptr, "Specifies which run (of the default config, see `qtenv-default-config`) Qtenv should set up automatically on startup. A run filter is also accepted. The default is to ask the user.");
+Register_GlobalConfigOption(CFGID_QTENV_AUTORUN, "qtenv-autorun", CFG_STRING, nullptr, "Specifies a run mode (`run`, `fast` or `express`) in which Qtenv should start the simulation automatically after setting up the config and run given with `qtenv-default-config` and `qtenv-default-run`. Qtenv exits when the simulation stops, and messages are printed instead of being shown in dialogs. Meant for benchmarks and automated tests; with the QT_QPA_PLATFORM=offscreen environment variable, no display is needed.");
 
 
 // According to: https://doc.qt.io/qt-5/qproxystyle.html#details
@@ -1734,6 +1735,18 @@ void QtenvApp::readOptions(cConfiguration *cfg)
 
     const char *r = args->optionValue('r');
     opt->runFilter = r ? r : cfg->getAsString(CFGID_QTENV_DEFAULT_RUN);
+
+    std::string autorun = cfg->getAsString(CFGID_QTENV_AUTORUN);
+    if (autorun.empty())
+        opt->autorunMode = RUNMODE_NOT_RUNNING;
+    else if (autorun == "run")
+        opt->autorunMode = RUNMODE_NORMAL;
+    else if (autorun == "fast")
+        opt->autorunMode = RUNMODE_FAST;
+    else if (autorun == "express")
+        opt->autorunMode = RUNMODE_EXPRESS;
+    else
+        throw cRuntimeError("Invalid value '%s' for '%s', expected 'run', 'fast' or 'express'", autorun.c_str(), CFGID_QTENV_AUTORUN->getName());
 }
 
 void QtenvApp::readPerRunOptions(cConfiguration *cfg)
@@ -1801,6 +1814,13 @@ void QtenvApp::initialSetUpConfiguration()
     mainWindow->reflectConfigOnUi();
 
     QTimer::singleShot(0, mainWindow, &MainWindow::activateWindow);
+
+    if (opt->autorunMode != RUNMODE_NOT_RUNNING) {
+        QTimer::singleShot(0, this, [this]() {
+            mainWindow->runSimulation(opt->autorunMode);
+            QApplication::quit();
+        });
+    }
 }
 
 void QtenvApp::askParameter(cPar *par, bool unassigned)
@@ -2432,8 +2452,8 @@ void QtenvApp::bubble(cComponent *component, const char *text)
 
 void QtenvApp::confirm(DialogKind kind, const char *msg)
 {
-    if (!mainWindow) {
-        // fallback in case Qt didn't fire up correctly
+    if (!mainWindow || opt->autorunMode != RUNMODE_NOT_RUNNING) {
+        // fallback in case Qt didn't fire up correctly, and no dialogs when running unattended
         const char *prefix = kind==ERROR ? "Error: " : kind==WARNING ? "Warning: " : "";
         out << "\n<!> " << prefix << msg << endl << endl;
     }
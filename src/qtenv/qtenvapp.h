@@ -91,6 +91,7 @@ struct QtenvOptions
     size_t extraStack;                     // per-module extra stack for activity() modules
     std::string defaultConfig;             // automatically set up this config at startup
     std::string runFilter;                 // groups the matching runs to the beginning of the list, or if only one matches, will set up that one automatically
+    RunMode autorunMode = RUNMODE_NOT_RUNNING; // start the simulation in this mode after setting up the run, and exit when it stops
     bool printInitBanners = true;          // print "initializing..." banners
     bool printEventBanners = true;         // print event banners
     bool shortBanners = false;             // controls detail of event banners
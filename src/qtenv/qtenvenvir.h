@@ -36,6 +36,12 @@ class QTENV_API QtenvEnvir : public GenericEnvir
     // user for a parameter value.
     virtual void askParameter(cPar *par, bool unassigned) override;
 
+    // hops are animated and shown in the message history
+    virtual bool needsSendHopNotifications() const override {return true;}
+
+    // inspectors are updated as soon as a display string changes
+    virtual bool needsImmediateDisplayStringNotifications() const override {return true;}
+
   public:
     QtenvEnvir(QtenvApp *app) : app(app) {}
     virtual ~QtenvEnvir() {}
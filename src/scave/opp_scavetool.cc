@@ -34,6 +34,8 @@
 #include "opp_scavetool.h"
 #include "vectorfileindex.h"
 #include "vectorfileindexer.h"
+#include "sketchmerger.h"
+#include "common/omnetppscalarfilewriter.h"
 
 #if defined(__MINGW32__)
 int _CRT_glob = 0;  // Turn off runtime file globbing support on MinGW. The shell already handles file globbing on the command line.
@@ -66,6 +68,7 @@ void ScaveTool::printHelpPage(const std::string& page)
         help.option("q, query", "Query the contents of result files");
         help.option("x, export", "Export results in various formats");
         help.option("i, index", "Generate index files (.vci) for vector files");
+        help.option("m, merge-sketches", "Merge quantile sketches across runs");
         help.option("h, help", "Print help text");
         help.line();
         help.para("The <files> argument accepts directories and glob patterns as well, in addition to file names. "
@@ -165,6 +168,27 @@ void ScaveTool::printHelpPage(const std::string& page)
         help.para("The <files> argument accepts directories and glob/globstar patterns as well, in addition to file names. See main help page for details.");
         help.line();
     }
+    else if (page == "m" || page == "merge-sketches") {
+        help.para("Usage: opp_scavetool merge-sketches [<options>] <scalar-files>");
+        help.para("Merge quantile sketches across runs. Quantile sketches are histograms recorded "
+                  "with the 'quantiles' result recorder (cDDSketch class), marked with the 'sketch' result attribute. "
+                  "Sketches with the same module name, result name and relative accuracy are merged "
+                  "as if all values had been collected in a single run, and the quantile estimates "
+                  "(p50, p99, etc. attributes) are recomputed from the merged sketch. Without -o, the "
+                  "merged quantiles are printed as a table.");
+        help.line("Options:");
+        help.option("-f, --filter <filter>", "Filter for the sketches to merge (try 'help filter'). Non-sketch results are ignored.");
+        help.option("-q, --quantiles <list>", "Comma-separated list of quantiles to compute, e.g. 0.5,0.99. By default, the quantiles recorded with the sketches are used.");
+        help.option("-o <filename>", "Save the merged sketches as histograms into the given scalar file (.sca), in a single run.");
+        help.option("-r, --run <name>", "Name of the run in the output file (default: 'merged').");
+        help.option("    --tabs", "Use tabs in the table instead of padding with spaces.");
+        help.option("-k, --no-indexing", "Disallow automatic indexing of vector files");
+        help.option("--allow-nonmatching", "Allow non-matching glob patterns on the command line");
+        help.option("-v, --verbose", "Print info about progress (verbose)");
+        help.line();
+        help.para("The <files> argument accepts directories and glob/globstar patterns as well, in addition to file names. See main help page for details.");
+        help.para("See also the following help topics: 'filter'");
+    }
     else if (page == "filter") {
         help.para("Several commands have a -f <filter> option that accepts a match expression "
                   "for filtering result items. This page describes the syntax available for "
@@ -820,6 +844,100 @@ void ScaveTool::indexCommand(int argc, char **argv)
     cout << "Indexed " << count << " file(s)\n";
 }
 
+void ScaveTool::mergeSketchesCommand(int argc, char **argv)
+{
+    vector<string> opt_fileNames;
+    string opt_filterExpression = "*";
+    string opt_fileName;
+    string opt_runName = "merged";
+    vector<double> opt_quantiles;
+    bool opt_verbose = false;
+    bool opt_indexingAllowed = true;
+    bool opt_allowNonmatching = false;
+    bool opt_tabs = false;
+
+    // parse options
+    bool endOpts = false;
+    for (int i = 0; i < argc; i++) {
+        string opt = argv[i];
+        if (endOpts)
+            opt_fileNames.push_back(argv[i]);
+        else if (opt == "--")
+            endOpts = true;
+        else if ((opt == "-f" || opt == "--filter") && i != argc-1)
+            opt_filterExpression = unquoteString(argv[++i]);
+        else if ((opt == "-q" || opt == "--quantiles") && i != argc-1) {
+            for (string item : opp_splitandtrim(argv[++i], ",")) {
+                double q = opp_atof(item.c_str());
+                if (q < 0 || q > 1)
+                    throw opp_runtime_error("Quantile %g is out of the [0,1] interval", q);
+                opt_quantiles.push_back(q);
+            }
+        }
+        else if (opt == "-o" && i != argc-1)
+            opt_fileName = argv[++i];
+        else if ((opt == "-r" || opt == "--run") && i != argc-1)
+            opt_runName = argv[++i];
+        else if (opt == "--tabs")
+            opt_tabs = true;
+        else if (opt == "-k" || opt == "--no-indexing")
+            opt_indexingAllowed = false;
+        else if (opt == "--allow-nonmatching")
+            opt_allowNonmatching = true;
+        else if (opt == "-v" || opt == "--verbose")
+            opt_verbose = true;
+        else if (opt[0] != '-')
+            opt_fileNames.push_back(argv[i]);
+        else
+            throw opp_runtime_error("Unknown option '%s'", opt.c_str());
+    }
+
+    // load files
+    ResultFileManager resultFileManager;
+    loadFiles(resultFileManager, opt_fileNames, opt_indexingAllowed, opt_allowNonmatching, opt_verbose);
+
+    // select and merge sketches
+    IDList results = resultFileManager.getAllHistograms();
+    results = resultFileManager.filterIDList(results, opt_filterExpression.c_str());
+    SketchMerger merger;
+    merger.setQuantiles(opt_quantiles);
+    vector<SketchMerger::MergedSketch> mergedSketches = merger.merge(&resultFileManager, results);
+
+    if (opt_fileName.empty()) {
+        // print table
+        stringstream buffer;
+        for (const auto& merged : mergedSketches) {
+            buffer << merged.moduleName << "\t" << merged.name << "\t" << "merged=" << merged.numMerged << "\t" << "count=" << merged.statistics.getCount();
+            for (const auto& pair : merged.quantiles)
+                buffer << "\t" << opp_stringf("p%g", pair.first*100) << "=" << opp_stringf("%g", pair.second);
+            buffer << endl;
+        }
+        cout << (opt_tabs ? buffer.str() : opp_format_table(buffer.str()));
+    }
+    else {
+        // save into a scalar file, in a single run
+        OmnetppScalarFileWriter writer;
+        writer.setPrecision(14);
+        if (opt_verbose)
+            cout << "writing " << opt_fileName << "... " << std::flush;
+        removeFile(opt_fileName.c_str(), "existing output file");
+        writer.open(opt_fileName.c_str());
+        StringMap runAttributes;
+        runAttributes["mergedRuns"] = opp_stringf("%d", (int)resultFileManager.getUniqueRuns(results).size());
+        writer.beginRecordingForRun(opt_runName, runAttributes, StringMap(), OmnetppScalarFileWriter::OrderedKeyValueList());
+        for (const auto& merged : mergedSketches)
+            writer.recordHistogram(merged.moduleName, merged.name, merged.statistics, merged.bins, merged.attributes);
+        writer.endRecordingForRun();
+        writer.close();
+        if (opt_verbose)
+            cout << "done\n";
+        int numMerged = 0;
+        for (const auto& merged : mergedSketches)
+            numMerged += merged.numMerged;
+        cout << "Merged " << numMerged << " histogram(s) into " << mergedSketches.size() << " sketch(es)" << endl;
+    }
+}
+
 int ScaveTool::main(int argc, char **argv)
 {
     if (argc < 2) {
@@ -837,6 +955,8 @@ int ScaveTool::main(int argc, char **argv)
             exportCommand(argc-2, argv+2);
         else if (command == "i" || command == "index")
             indexCommand(argc-2, argv+2);
+        else if (command == "m" || command == "merge-sketches")
+            mergeSketchesCommand(argc-2, argv+2);
         else if (command == "h" || command == "help" || command == "-h" || command == "--help")
             helpCommand(argc-2, argv+2);
         else if (command[0] == '-' || isFile(command.c_str())) // use default command
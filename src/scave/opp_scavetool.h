@@ -34,6 +34,7 @@ protected:
     void queryCommand(int argc, char **argv);
     void exportCommand(int argc, char **argv);
     void indexCommand(int argc, char **argv);
+    void mergeSketchesCommand(int argc, char **argv);
 public:
     int main(int argc, char **argv);
 
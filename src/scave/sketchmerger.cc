@@ -0,0 +1,155 @@
+//=========================================================================
+//  SKETCHMERGER.CC - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include "common/ddsketch.h"
+#include "common/stringutil.h"
+#include "resultfilemanager.h"
+#include "sketchmerger.h"
+
+using namespace omnetpp::common;
+
+namespace omnetpp {
+namespace scave {
+
+// merging must not lose information, so don't limit the number of buckets in practice
+#define MAX_MERGED_BUCKETS  (1<<20)
+
+bool SketchMerger::isSketch(const HistogramResult *histogram)
+{
+    const StringMap& attrs = histogram->getAttributes();
+    auto it = attrs.find("sketch");
+    return it != attrs.end() && it->second == "ddsketch" && attrs.find("relativeAccuracy") != attrs.end();
+}
+
+static bool isQuantileAttribute(const std::string& key)
+{
+    // "p50", "p99.9", etc.
+    return key.size() >= 2 && key[0] == 'p' && key.find_first_not_of("0123456789.", 1) == std::string::npos;
+}
+
+// infinities are kept in the underflow/overflow cells, outside the sketch
+static double computeQuantile(const DDSketch& sketch, const Statistics& statistics, const Histogram& bins, double q)
+{
+    double negInfSumWeights = bins.getUnderflows(), posInfSumWeights = bins.getOverflows();
+    double finiteSumWeights = sketch.getTotalWeight();
+    double totalSumWeights = negInfSumWeights + finiteSumWeights + posInfSumWeights;
+    if (totalSumWeights == 0)
+        return NAN;
+    if (q == 0)
+        return statistics.getMin();
+    if (q == 1)
+        return statistics.getMax();
+    double rank = q * totalSumWeights;
+    if (rank < negInfSumWeights || (finiteSumWeights == 0 && posInfSumWeights == 0))
+        return -INFINITY;
+    if (rank >= negInfSumWeights + finiteSumWeights && posInfSumWeights > 0)
+        return INFINITY;
+    double finiteQ = finiteSumWeights == 0 ? 0 : std::min(1.0, (rank - negInfSumWeights) / finiteSumWeights);
+    double result = sketch.getQuantile(finiteQ);
+    return std::max(statistics.getMin(), std::min(statistics.getMax(), result));
+}
+
+std::vector<SketchMerger::MergedSketch> SketchMerger::merge(ResultFileManager *manager, const IDList& histograms) const
+{
+    std::vector<MergedSketch> result;
+    std::vector<DDSketch> sketches;
+    std::map<std::string, size_t> indexByKey;
+
+    for (ID id : histograms) {
+        if (ResultFileManager::getTypeOf(id) != ResultFileManager::HISTOGRAM)
+            continue;
+        const HistogramResult *histogram = manager->getHistogram(id);
+        if (!isSketch(histogram))
+            continue;
+
+        const StringMap& attrs = histogram->getAttributes();
+        double relativeAccuracy = opp_atof(attrs.at("relativeAccuracy").c_str());
+        std::string key = histogram->getModuleName() + "\t" + histogram->getName() + "\t" + attrs.at("relativeAccuracy");
+        const Statistics& statistics = histogram->getStatistics();
+        const Histogram& bins = histogram->getHistogram();
+
+        auto it = indexByKey.find(key);
+        if (it == indexByKey.end()) {
+            indexByKey[key] = result.size();
+            MergedSketch merged;
+            merged.moduleName = histogram->getModuleName();
+            merged.name = histogram->getName();
+            merged.relativeAccuracy = relativeAccuracy;
+            merged.numMerged = 1;
+            merged.statistics = statistics;
+            merged.bins.setUnderflows(bins.getUnderflows());
+            merged.bins.setOverflows(bins.getOverflows());
+            merged.attributes = attrs;
+            result.push_back(merged);
+            sketches.push_back(DDSketch(relativeAccuracy, MAX_MERGED_BUCKETS));
+        }
+        else {
+            MergedSketch& merged = result[it->second];
+            if (merged.statistics.isWeighted() != statistics.isWeighted())
+                throw opp_runtime_error("Cannot merge weighted and unweighted sketches of %s.%s", merged.moduleName.c_str(), merged.name.c_str());
+            merged.numMerged++;
+            merged.statistics.adjoin(statistics);
+            merged.bins.setUnderflows(merged.bins.getUnderflows() + bins.getUnderflows());
+            merged.bins.setOverflows(merged.bins.getOverflows() + bins.getOverflows());
+        }
+
+        DDSketch& sketch = sketches[indexByKey[key]];
+        try {
+            sketch.addBins(bins.getBinEdges(), bins.getBinValues());
+        }
+        catch (std::exception& e) {
+            throw opp_runtime_error("Cannot merge histogram %s.%s of run %s: %s", histogram->getModuleName().c_str(),
+                    histogram->getName().c_str(), histogram->getRun()->getRunName().c_str(), e.what());
+        }
+    }
+
+    // produce the bins and recompute the quantiles
+    for (size_t i = 0; i < result.size(); i++) {
+        MergedSketch& merged = result[i];
+        const DDSketch& sketch = sketches[i];
+
+        std::vector<double> edges, values;
+        sketch.getBins(edges, values);
+        double underflows = merged.bins.getUnderflows(), overflows = merged.bins.getOverflows();
+        merged.bins.setBins(edges, values);
+        merged.bins.setUnderflows(underflows);
+        merged.bins.setOverflows(overflows);
+
+        std::vector<double> qs = quantiles;
+        for (auto it = merged.attributes.begin(); it != merged.attributes.end(); ) {
+            if (isQuantileAttribute(it->first)) {
+                if (quantiles.empty())
+                    qs.push_back(opp_atof(it->first.c_str() + 1) / 100);
+                it = merged.attributes.erase(it);
+            }
+            else
+                ++it;
+        }
+        std::sort(qs.begin(), qs.end());
+
+        for (double q : qs) {
+            double value = computeQuantile(sketch, merged.statistics, merged.bins, q);
+            merged.quantiles.push_back(std::make_pair(q, value));
+            merged.attributes[opp_stringf("p%g", q*100)] = opp_stringf("%.9g", value);
+        }
+        merged.attributes["mergedCount"] = opp_stringf("%d", merged.numMerged);
+    }
+    return result;
+}
+
+}  // namespace scave
+}  // namespace omnetpp
@@ -0,0 +1,80 @@
+//=========================================================================
+//  SKETCHMERGER.H - part of
+//                  OMNeT++/OMNEST
+//           Discrete System Simulation in C++
+//
+//=========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_SCAVE_SKETCHMERGER_H
+#define __OMNETPP_SCAVE_SKETCHMERGER_H
+
+#include <string>
+#include <vector>
+#include "common/statistics.h"
+#include "common/histogram.h"
+#include "scavedefs.h"
+#include "idlist.h"
+
+namespace omnetpp {
+namespace scave {
+
+class ResultFileManager;
+class HistogramResult;
+
+/**
+ * Merges quantile sketches across runs. Sketches are histograms recorded
+ * from cDDSketch objects (e.g. by the "quantiles" result recorder); they are
+ * recognized by their "sketch" attribute. Histograms with the same module
+ * name, result name and relative accuracy are merged into one, and the
+ * quantile attributes (p50, p99, etc.) are recomputed from the merged sketch.
+ */
+class SCAVE_API SketchMerger
+{
+  public:
+    struct MergedSketch {
+        std::string moduleName;
+        std::string name;
+        double relativeAccuracy;
+        int numMerged = 0;  // number of input histograms
+        Statistics statistics;
+        Histogram bins;
+        StringMap attributes;
+        std::vector<std::pair<double,double>> quantiles; // (q, value) pairs
+    };
+
+  protected:
+    std::vector<double> quantiles;
+
+  public:
+    /**
+     * Sets the quantiles to compute. By default (empty list), the quantiles
+     * are taken from the attributes of the input histograms.
+     */
+    void setQuantiles(const std::vector<double>& quantiles) {this->quantiles = quantiles;}
+    const std::vector<double>& getQuantiles() const {return quantiles;}
+
+    /**
+     * Returns true if the given histogram was recorded from a sketch
+     * that SketchMerger can merge.
+     */
+    static bool isSketch(const HistogramResult *histogram);
+
+    /**
+     * Merges the sketches among the given histograms. Other items in the
+     * list are ignored. Results are in the order of first occurrence.
+     */
+    std::vector<MergedSketch> merge(ResultFileManager *manager, const IDList& histograms) const;
+};
+
+}  // namespace scave
+}  // namespace omnetpp
+
+
+#endif
@@ -21,6 +21,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <climits> // INT_MIN
+#include <typeindex>
+#include <unordered_map>
 #include "common/opp_ctype.h"
 #include "common/stringutil.h"
 #include "omnetpp/cclassdescriptor.h"
@@ -250,6 +252,15 @@ bool cClassDescriptor::extendsCObject() const
     return extendscObject;
 }
 
+int cClassDescriptor::computeBaseClassFieldCount() const
+{
+    cClassDescriptor *base = getBaseClassDescriptor();
+    if (!base)
+        return 0;  // don't cache: the base class descriptor may get registered later (e.g. in a shared lib loaded later)
+    baseClassFieldCount = base->getFieldCount();
+    return baseClassFieldCount;
+}
+
 int cClassDescriptor::getInheritanceChainLength() const
 {
     getBaseClassDescriptor();  // force resolution of inheritance
@@ -259,7 +270,7 @@ int cClassDescriptor::getInheritanceChainLength() const
 const char *cClassDescriptor::getFieldDeclaredOn(int field) const
 {
     cClassDescriptor *base = getBaseClassDescriptor();
-    if (base && field < base->getFieldCount())
+    if (base && field < getBaseClassFieldCount())
         return base->getFieldDeclaredOn(field);
     return getName();
 }
@@ -270,6 +281,22 @@ cClassDescriptor *cClassDescriptor::getDescriptorFor(const char *classname)
 }
 
 cClassDescriptor *cClassDescriptor::getDescriptorFor(const cObject *object)
+{
+    // the result only depends on the class of the object, so cache it
+    static OPP_THREAD_LOCAL std::unordered_map<std::type_index,cClassDescriptor*> *descriptorCache;
+    if (!descriptorCache)
+        descriptorCache = new std::unordered_map<std::type_index,cClassDescriptor*>();  // never deleted: may be needed during static deinitialization
+    std::type_index type = typeid(*object);
+    auto it = descriptorCache->find(type);
+    if (it != descriptorCache->end())
+        return it->second;
+    cClassDescriptor *desc = lookupDescriptorFor(object);
+    if (desc)
+        (*descriptorCache)[type] = desc;  // don't cache failures, a descriptor may get registered later
+    return desc;
+}
+
+cClassDescriptor *cClassDescriptor::lookupDescriptorFor(const cObject *object)
 {
     // find descriptor by class name
     cClassDescriptor *desc = cClassDescriptor::getDescriptorFor(object->getClassName());
@@ -277,7 +304,6 @@ cClassDescriptor *cClassDescriptor::getDescriptorFor(const cObject *object)
         return desc;
 
     // bad luck: no descriptor for exactly this class. Try to find one for some base class.
-    //XXX we could even cache the result in a {classname->descriptor} hashtable.
     cClassDescriptor *bestDesc = nullptr;
     int bestInheritanceChainLength = -1;
     cRegistrationList *array = classDescriptors.getInstance();
@@ -39,6 +39,7 @@
 #include "omnetpp/cresultrecorder.h"
 #include "omnetpp/cresultfilter.h"
 #include "omnetpp/crngmanager.h"
+#include "profiler.h"
 
 using namespace omnetpp::common;
 
@@ -170,6 +171,18 @@ void cComponent::preDelete(cComponent *root)
 {
 }
 
+void cComponent::checkpoint(cCommBuffer *buffer)
+{
+    // Called when a simulation checkpoint is written.
+    // Should be redefined by components that have state.
+}
+
+void cComponent::restore(cCommBuffer *buffer)
+{
+    // Called instead of initialize() when a simulation is restored from a checkpoint.
+    // Should be redefined by components that have state.
+}
+
 void cComponent::setDisplayName(const char *name)
 {
     displayName = name;
@@ -718,11 +731,21 @@ void cComponent::fire(cComponent *source, simsignal_t signalID, T x, cObject *de
         if (notificationSP >= NOTIFICATION_STACK_SIZE)
             throw cRuntimeError(this, "emit(): Recursive notification stack overflow, signalID=%d", signalID);
 
+        internal::Profiler *profiler = simulation->getProfiler();
+        if (profiler && !profiler->isSampling())
+            profiler = nullptr;
+
         int oldNotificationSP = notificationSP;
         try {
             notificationStack[notificationSP++] = listeners;  // lock against modification
-            for (int i = 0; listeners[i]; i++)
-                listeners[i]->receiveSignal(source, signalID, x, details);  // will crash if listener is already deleted
+            for (int i = 0; listeners[i]; i++) {
+                if (!profiler)
+                    listeners[i]->receiveSignal(source, signalID, x, details);  // will crash if listener is already deleted
+                else {
+                    internal::Profiler::ListenerGuard guard(profiler, signalID, listeners[i]);
+                    listeners[i]->receiveSignal(source, signalID, x, details);
+                }
+            }
             notificationSP--;
         }
         catch (std::exception& e) {
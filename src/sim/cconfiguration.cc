@@ -109,6 +109,8 @@ std::string cConfiguration::parseFilename(const char *s, const char *baseDir, co
         return "";
     cComponent *ctx = getContextComponent();
     std::string str = s[0]=='"' ? evaluate(s, ctx).stringValue() : s;
+    if (str.empty())
+        return "";  // e.g. "" from an iteration; not to be turned into the base directory
     return tidyFilename(concatDirAndFile(baseDir, str.c_str()).c_str());
 }
 
@@ -25,10 +25,7 @@
 #include "omnetpp/cexception.h"
 #include "omnetpp/ctimestampedvalue.h"
 #include "omnetpp/csimplemodule.h" // SendOptions
-
-#ifdef WITH_PARSIM
 #include "omnetpp/ccommbuffer.h"
-#endif
 
 namespace omnetpp {
 
@@ -94,6 +91,45 @@ void cDatarateChannel::handleParameterChange(const char *)
     rereadPars();
 }
 
+void cDatarateChannel::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack((int)mode);
+    buffer->pack(singleTx.startTime);
+    buffer->pack(singleTx.finishTime);
+    buffer->pack(singleTx.transmissionId);
+    buffer->pack((int)txList.size());
+    for (const Tx& tx : txList) {
+        buffer->pack(tx.startTime);
+        buffer->pack(tx.finishTime);
+        buffer->pack(tx.transmissionId);
+    }
+    buffer->pack(channelFinishTime);
+}
+
+void cDatarateChannel::restore(cCommBuffer *buffer)
+{
+    channelBusySignal = registerSignal("channelBusy");
+    messageSentSignal = registerSignal("messageSent");
+    messageDiscardedSignal = registerSignal("messageDiscarded");
+
+    rereadPars();
+
+    int tmp;
+    buffer->unpack(tmp);
+    mode = (Mode)tmp;
+    buffer->unpack(singleTx.startTime);
+    buffer->unpack(singleTx.finishTime);
+    buffer->unpack(singleTx.transmissionId);
+    buffer->unpack(tmp);
+    txList.resize(tmp);
+    for (Tx& tx : txList) {
+        buffer->unpack(tx.startTime);
+        buffer->unpack(tx.finishTime);
+        buffer->unpack(tx.transmissionId);
+    }
+    buffer->unpack(channelFinishTime);
+}
+
 void cDatarateChannel::setMode(Mode mode)
 {
     this->mode = mode;
@@ -0,0 +1,332 @@
+//==========================================================================
+//  CDDSKETCH.CC - part of
+//                 OMNeT++/OMNEST
+//              Discrete System Simulation in C++
+//
+//  Member functions of
+//    cDDSketch : quantile estimation with a mergeable sketch
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cmath>
+#include <algorithm>
+#include "common/ddsketch.h"
+#include "common/stringutil.h"
+#include "omnetpp/globals.h"
+#include "omnetpp/cddsketch.h"
+#include "omnetpp/cexception.h"
+#include "omnetpp/distrib.h"
+
+#ifdef WITH_PARSIM
+#include "omnetpp/ccommbuffer.h"
+#endif
+
+using namespace omnetpp::common;
+
+namespace omnetpp {
+
+Register_Class(cDDSketch);
+
+cDDSketch::cDDSketch(const cDDSketch& r) : cAbstractHistogram(r), sketch(new DDSketch(*r.sketch))
+{
+    copy(r);
+}
+
+cDDSketch::cDDSketch(const char *name, double relativeAccuracy, int maxBins, bool weighted) : cAbstractHistogram(name, weighted)
+{
+    try {
+        sketch = new DDSketch(relativeAccuracy, maxBins);
+    }
+    catch (std::exception& e) {
+        throw cRuntimeError(this, "%s", e.what());
+    }
+}
+
+cDDSketch::~cDDSketch()
+{
+    delete sketch;
+}
+
+void cDDSketch::copy(const cDDSketch& res)
+{
+    *sketch = *res.sketch;
+    negInfSumWeights = res.negInfSumWeights;
+    posInfSumWeights = res.posInfSumWeights;
+    numNegInfs = res.numNegInfs;
+    numPosInfs = res.numPosInfs;
+    binsValid = false;
+}
+
+cDDSketch& cDDSketch::operator=(const cDDSketch& res)
+{
+    if (this == &res)
+        return *this;
+    cAbstractHistogram::operator=(res);
+    copy(res);
+    return *this;
+}
+
+void cDDSketch::parsimPack(cCommBuffer *buffer) const
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(this, E_NOPARSIM);
+#else
+    cAbstractHistogram::parsimPack(buffer);
+
+    buffer->pack(sketch->getRelativeAccuracy());
+    buffer->pack(sketch->getMaxBuckets());
+    buffer->pack(numNegInfs);
+    buffer->pack(numPosInfs);
+    buffer->pack(negInfSumWeights);
+    buffer->pack(posInfSumWeights);
+
+    ensureBins();
+    buffer->pack((int)binValues.size());
+    if (!binValues.empty()) {
+        buffer->pack(binEdges.data(), binEdges.size());
+        buffer->pack(binValues.data(), binValues.size());
+    }
+#endif
+}
+
+void cDDSketch::parsimUnpack(cCommBuffer *buffer)
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(this, E_NOPARSIM);
+#else
+    cAbstractHistogram::parsimUnpack(buffer);
+
+    double relativeAccuracy;
+    int maxBins, numBins;
+    buffer->unpack(relativeAccuracy);
+    buffer->unpack(maxBins);
+    buffer->unpack(numNegInfs);
+    buffer->unpack(numPosInfs);
+    buffer->unpack(negInfSumWeights);
+    buffer->unpack(posInfSumWeights);
+
+    buffer->unpack(numBins);
+    std::vector<double> edges(numBins > 0 ? numBins+1 : 0), values(numBins);
+    if (numBins > 0) {
+        buffer->unpack(edges.data(), numBins+1);
+        buffer->unpack(values.data(), numBins);
+    }
+    *sketch = DDSketch(relativeAccuracy, maxBins);
+    sketch->addBins(edges, values);
+    binsValid = false;
+#endif
+}
+
+void cDDSketch::collect(double value)
+{
+    cAbstractHistogram::collect(value);
+    if (std::isinf(value)) {
+        if (value < 0) {
+            numNegInfs++;
+            negInfSumWeights += 1;
+        }
+        else {
+            numPosInfs++;
+            posInfSumWeights += 1;
+        }
+        return;
+    }
+    sketch->add(value);
+    binsValid = false;
+}
+
+void cDDSketch::collectWeighted(double value, double weight)
+{
+    cAbstractHistogram::collectWeighted(value, weight);
+    if (std::isinf(value)) {
+        if (value < 0) {
+            numNegInfs++;
+            negInfSumWeights += weight;
+        }
+        else {
+            numPosInfs++;
+            posInfSumWeights += weight;
+        }
+        return;
+    }
+    sketch->add(value, weight);
+    binsValid = false;
+}
+
+void cDDSketch::ensureBins() const
+{
+    if (!binsValid) {
+        sketch->getBins(binEdges, binValues);
+        binsValid = true;
+    }
+}
+
+int cDDSketch::getNumBins() const
+{
+    ensureBins();
+    return binValues.size();
+}
+
+double cDDSketch::getBinEdge(int k) const
+{
+    ensureBins();
+    if (k < 0 || k >= (int)binEdges.size())
+        throw cRuntimeError(this, "getBinEdge(): Bin edge index %d out of bounds", k);
+    return binEdges[k];
+}
+
+double cDDSketch::getBinValue(int k) const
+{
+    ensureBins();
+    if (k < 0 || k >= (int)binValues.size())
+        throw cRuntimeError(this, "getBinValue(): Bin index %d out of bounds", k);
+    return binValues[k];
+}
+
+double cDDSketch::getQuantile(double q) const
+{
+    if (q < 0 || q > 1)
+        throw cRuntimeError(this, "getQuantile(): Argument %g is out of the [0,1] interval", q);
+    double finiteSumWeights = sketch->getTotalWeight();
+    double totalSumWeights = negInfSumWeights + finiteSumWeights + posInfSumWeights;
+    if (totalSumWeights == 0)
+        return NAN;
+    if (q == 0)
+        return getMin();
+    if (q == 1)
+        return getMax();
+
+    // infinities are below/above all finite values
+    double rank = q * totalSumWeights;
+    if (rank < negInfSumWeights || (finiteSumWeights == 0 && posInfSumWeights == 0))
+        return -INFINITY;
+    if (rank >= negInfSumWeights + finiteSumWeights && posInfSumWeights > 0)
+        return INFINITY;
+    double finiteQ = finiteSumWeights == 0 ? 0 : std::min(1.0, (rank - negInfSumWeights) / finiteSumWeights);
+    double result = sketch->getQuantile(finiteQ);
+
+    // the exact extremes are known, so never report a value outside them
+    return std::max(getMin(), std::min(getMax(), result));
+}
+
+double cDDSketch::draw() const
+{
+    if (getCount() == 0)
+        throw cRuntimeError(this, "draw(): No observations collected yet");
+    return getQuantile(dblrand(getRNG()));
+}
+
+void cDDSketch::merge(const cStatistic *stat)
+{
+    const cDDSketch *other = dynamic_cast<const cDDSketch *>(stat);
+    if (other == nullptr)
+        throw cRuntimeError(this, "merge(): Cannot merge non-cDDSketch statistics (%s)%s into a sketch", stat->getClassName(), stat->getFullPath().c_str());
+    if (other->getRelativeAccuracy() != getRelativeAccuracy())
+        throw cRuntimeError(this, "Cannot merge (%s)%s: Different relative accuracy (%g vs. %g)",
+                other->getClassName(), other->getFullPath().c_str(), getRelativeAccuracy(), other->getRelativeAccuracy());
+
+    cAbstractHistogram::merge(other);
+
+    sketch->merge(*other->sketch);
+    numNegInfs += other->numNegInfs;
+    numPosInfs += other->numPosInfs;
+    negInfSumWeights += other->negInfSumWeights;
+    posInfSumWeights += other->posInfSumWeights;
+    binsValid = false;
+}
+
+void cDDSketch::clear()
+{
+    cAbstractHistogram::clear();
+    sketch->clear();
+    numNegInfs = numPosInfs = 0;
+    negInfSumWeights = posInfSumWeights = 0;
+    binsValid = false;
+}
+
+double cDDSketch::getRelativeAccuracy() const
+{
+    return sketch->getRelativeAccuracy();
+}
+
+int cDDSketch::getMaxBins() const
+{
+    return sketch->getMaxBuckets();
+}
+
+void cDDSketch::addResultAttributes(opp_string_map& attributes, const std::vector<double>& quantiles) const
+{
+    attributes["sketch"] = "ddsketch";
+    attributes["relativeAccuracy"] = opp_stringf("%g", getRelativeAccuracy());
+    if (getCount() > 0)
+        for (double q : quantiles)
+            attributes[opp_stringf("p%g", q*100).c_str()] = opp_stringf("%.9g", getQuantile(q));
+}
+
+void cDDSketch::getAttributesToRecord(opp_string_map& attributes)
+{
+    addResultAttributes(attributes, {0.5, 0.9, 0.99});
+}
+
+void cDDSketch::saveToFile(FILE *f) const
+{
+    cAbstractHistogram::saveToFile(f);
+
+    fprintf(f, "%.17g\t #= relative_accuracy\n", getRelativeAccuracy());
+    fprintf(f, "%d\t #= max_bins\n", getMaxBins());
+    fprintf(f, "%" PRId64 " %" PRId64 "\t #= num_neginfs, num_posinfs\n", numNegInfs, numPosInfs);
+    fprintf(f, "%lg %lg\t #= neginf_sum_weights, posinf_sum_weights\n", negInfSumWeights, posInfSumWeights);
+
+    ensureBins();
+    fprintf(f, "%d\t #= num_bins\n", (int)binValues.size());
+    if (!binValues.empty()) {
+        // full precision, so that the edges can be mapped back to sketch buckets
+        fprintf(f, "#= bin_edges\n");
+        for (double edge : binEdges)
+            fprintf(f, " %.17g\n", edge);
+        fprintf(f, "#= bin_values\n");
+        for (double value : binValues)
+            fprintf(f, " %.17g\n", value);
+    }
+}
+
+void cDDSketch::loadFromFile(FILE *f)
+{
+    cAbstractHistogram::loadFromFile(f);
+
+    double relativeAccuracy;
+    int maxBins, numBins;
+    freadvarsf(f, "%lg\t #= relative_accuracy", &relativeAccuracy);
+    freadvarsf(f, "%d\t #= max_bins", &maxBins);
+    freadvarsf(f, "%" SCNd64 " %" SCNd64 "\t #= num_neginfs, num_posinfs", &numNegInfs, &numPosInfs);
+    freadvarsf(f, "%lg %lg\t #= neginf_sum_weights, posinf_sum_weights", &negInfSumWeights, &posInfSumWeights);
+
+    freadvarsf(f, "%d\t #= num_bins", &numBins);
+    std::vector<double> edges(numBins > 0 ? numBins+1 : 0), values(numBins);
+    if (numBins > 0) {
+        freadvarsf(f, "#= bin_edges");
+        for (int i = 0; i <= numBins; i++)
+            freadvarsf(f, " %lg", edges.data() + i);
+        freadvarsf(f, "#= bin_values");
+        for (int i = 0; i < numBins; i++)
+            freadvarsf(f, " %lg", values.data() + i);
+    }
+
+    try {
+        *sketch = DDSketch(relativeAccuracy, maxBins);
+        sketch->addBins(edges, values);
+    }
+    catch (std::exception& e) {
+        throw cRuntimeError(this, "loadFromFile(): %s", e.what());
+    }
+    binsValid = false;
+}
+
+}  // namespace omnetpp
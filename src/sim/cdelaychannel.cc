@@ -24,10 +24,7 @@
 #include "omnetpp/cgate.h"
 #include "omnetpp/cexception.h"
 #include "omnetpp/ctimestampedvalue.h"
-
-#ifdef WITH_PARSIM
 #include "omnetpp/ccommbuffer.h"
-#endif
 
 namespace omnetpp {
 
@@ -65,6 +62,19 @@ void cDelayChannel::handleParameterChange(const char *)
     rereadPars();
 }
 
+void cDelayChannel::checkpoint(cCommBuffer *buffer)
+{
+    // only cached parameter values
+}
+
+void cDelayChannel::restore(cCommBuffer *buffer)
+{
+    messageSentSignal = registerSignal("messageSent");
+    messageDiscardedSignal = registerSignal("messageDiscarded");
+
+    rereadPars();
+}
+
 void cDelayChannel::setDelay(double d)
 {
     par("delay").setDoubleValue(d);
@@ -16,9 +16,11 @@
 
 #include <cstring>
 #include <cstdio>
+#include <cmath>
 #include "common/opp_ctype.h"
 #include "common/stringutil.h"
 #include "omnetpp/cenvir.h"
+#include "omnetpp/csimulation.h"
 #include "omnetpp/cmodule.h"
 #include "omnetpp/cchannel.h"
 #include "omnetpp/cgate.h"
@@ -71,7 +73,16 @@ void cDisplayString::afterChange()
 #ifdef SIMFRONTEND_SUPPORT
         ownerComponent->updateLastChangeSerial();
 #endif
-        EVCB.displayStringChanged(ownerComponent);
+        cEnvir *envir = cSimulation::getActiveEnvir();
+        if (!envir->suppressNotifications) {
+            if (!envir->coalesceDisplayStringNotifications || ownerComponent->getId() == -1)
+                envir->displayStringChanged(ownerComponent);
+            else if (!notificationPending) {
+                // let the simulation notify envir at the end of the event
+                notificationPending = true;
+                ownerComponent->getSimulation()->addPendingDisplayStringChange(ownerComponent);
+            }
+        }
 
         // notify post-change listeners
         if (ownerComponent->hasListeners(POST_MODEL_CHANGE)) {
@@ -82,6 +93,14 @@ void cDisplayString::afterChange()
     }
 }
 
+void cDisplayString::notifyPendingChange()
+{
+    if (notificationPending) {
+        notificationPending = false;
+        EVCB.displayStringChanged(ownerComponent);
+    }
+}
+
 const char *cDisplayString::str() const
 {
     if (!assembledStringValid)
@@ -159,11 +178,106 @@ const char *cDisplayString::getTagArg(const char *tagname, int index) const
     return getTagArg(getTagIndex(tagname), index);
 }
 
+// faster than sprintf(); buf must be at least 21 bytes
+static char *formatInteger(char *buf, unsigned long long value, bool negative)
+{
+    char tmp[24];
+    char *s = tmp + sizeof(tmp);
+    *--s = '\0';
+    do {
+        *--s = '0' + value % 10;
+        value /= 10;
+    } while (value != 0);
+    if (negative)
+        *--s = '-';
+    strcpy(buf, s);
+    return buf;
+}
+
+static char *formatInteger(char *buf, long long value)
+{
+    return formatInteger(buf, value < 0 ? 0ULL - (unsigned long long)value : value, value < 0);
+}
+
+// produces the same result as "%.12g"; fast for numbers with at most 6 decimals
+static char *formatDouble(char *buf, double value)
+{
+    double absValue = std::fabs(value);
+    if (absValue >= 1e-4 && absValue < 1e6) {
+        double scaled = std::round(absValue * 1e6);
+        if (scaled / 1e6 == absValue) {
+            long long n = (long long)scaled;
+            int frac = n % 1000000;
+            formatInteger(buf, n / 1000000, value < 0);
+            char *d = buf + strlen(buf);
+            if (frac != 0) {
+                *d++ = '.';
+                for (int div = 100000; frac != 0; div /= 10) {
+                    *d++ = '0' + frac / div;
+                    frac %= div;
+                }
+            }
+            *d = '\0';
+            return buf;
+        }
+    }
+    return opp_dtoa(buf, "%.12g", value);
+}
+
 bool cDisplayString::setTagArg(const char *tagname, int index, long value)
 {
-    char buf[32];
-    sprintf(buf, "%ld", value);
-    return setTagArg(tagname, index, buf);
+    char buf[NUMERICARG_SIZE];
+    return setNumericTagArg(tagname, index, formatInteger(buf, value));
+}
+
+bool cDisplayString::setTagArg(const char *tagname, int index, long long value)
+{
+    char buf[NUMERICARG_SIZE];
+    return setNumericTagArg(tagname, index, formatInteger(buf, value));
+}
+
+bool cDisplayString::setTagArg(const char *tagname, int index, unsigned long long value)
+{
+    char buf[NUMERICARG_SIZE];
+    return setNumericTagArg(tagname, index, formatInteger(buf, value, false));
+}
+
+bool cDisplayString::setTagArg(const char *tagname, int index, double value)
+{
+    char buf[NUMERICARG_SIZE];
+    if (value == std::floor(value) && std::fabs(value) < 1e15)
+        formatInteger(buf, (long long)value);  // also turns -0 into "0"
+    else
+        formatDouble(buf, value);
+    return setNumericTagArg(tagname, index, buf);
+}
+
+bool cDisplayString::setNumericTagArg(const char *tagname, int index, const char *value)
+{
+    int tagIndex = getTagIndex(tagname);
+    if (!strcmp(getTagArg(tagIndex, index), value))
+        return false;
+    if (index < 0 || index >= MAXARGS)
+        return setTagArg(tagname, index, value);  // let it fail the usual way
+
+    beforeChange();
+    if (tagIndex == -1)
+        tagIndex = doInsertTag(tagname);
+    Tag& tag = tags[tagIndex];
+    char *& slot = tag.args[index];
+    if (!(tag.numericArgs & (1 << index))) {
+        // allocate a buffer that is large enough for any number, so that
+        // subsequent updates of the same argument can be done in place
+        if (slot && !pointsIntoBuffer(slot))
+            delete[] slot;
+        slot = new char[NUMERICARG_SIZE];
+        tag.numericArgs |= 1 << index;
+    }
+    strcpy(slot, value);
+    if (index >= tag.numArgs)
+        tag.numArgs = index + 1;
+    afterChange();
+    return true;
 }
 
 bool cDisplayString::setTagArg(const char *tagname, int index, const char *value)
@@ -247,10 +361,16 @@ bool cDisplayString::doSetTagArg(int tagindex, int index, const char *value)
     if (!opp_strcmp(slot, value))
         return true;
 
-    // set value
-    if (slot && !pointsIntoBuffer(slot))
-        delete[] slot;
-    slot = opp_strdup(value);
+    // set value; reuse the buffer of a numeric argument if the new value fits
+    // (empty values must become nullptr, see the trimming below)
+    if (value && *value && (tag.numericArgs & (1 << index)) && strlen(value) < NUMERICARG_SIZE)
+        strcpy(slot, value);
+    else {
+        if (slot && !pointsIntoBuffer(slot))
+            delete[] slot;
+        slot = opp_strdup(value);
+        tag.numericArgs &= ~(1 << index);
+    }
 
     // get rid of possible empty trailing args, throw out tag if it became empty
     while (tag.numArgs > 0 && tag.args[tag.numArgs - 1] == nullptr)
@@ -302,6 +422,7 @@ int cDisplayString::doInsertTag(const char *tagname, int atindex)
     // fill in new tag
     tags[atindex].name = opp_strdup(tagname);
     tags[atindex].numArgs = 0;
+    tags[atindex].numericArgs = 0;
     for (auto & arg : tags[atindex].args)
         arg = nullptr;
 
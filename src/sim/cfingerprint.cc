@@ -38,6 +38,7 @@
 namespace omnetpp {
 
 Register_Class(cSingleFingerprintCalculator);
+Register_Class(cFastFingerprintCalculator);
 
 Register_GlobalConfigOption(CFGID_FINGERPRINT_INGREDIENTS, "fingerprint-ingredients", CFG_STRING, "tplx", "Specifies the list of ingredients to be taken into account for fingerprint computation. Each character corresponds to one ingredient: 'e' event number, 't' simulation time, 'n' message (event) full name, 'c' message (event) class name, 'k' message kind, 'l' message bit length, 'o' message control info class name, 'd' message data, 'i' module id, 'm' module full name, 'p' module full path, 'a' module class name, 'r' random numbers drawn, 's' scalar results, 'z' statistic results, 'v' vector results, 'x' extra data provided by modules. Note: ingredients specified in an expected fingerprint (characters after the '/' in the fingerprint value) take precedence over this setting. If you configured multiple fingerprints, separate ingredients with commas.");
 Register_GlobalConfigOption(CFGID_FINGERPRINT_EVENTS, "fingerprint-events", CFG_STRING, "*", "Configures the fingerprint calculator to consider only certain events. The value is a pattern that will be matched against the event name by default. It may also be an expression containing pattern matching characters, field access, and logical operators. The default setting is '*' which includes all events in the calculated fingerprint. If you configured multiple fingerprints, separate filters with commas.");
@@ -156,7 +157,8 @@ void cSingleFingerprintCalculator::parseResultMatcher(const char *s)
     }
 }
 
-void cSingleFingerprintCalculator::addEvent(cEvent *event)
+template <typename H>
+void cSingleFingerprintCalculator::hashEvent(H& hasher, cEvent *event)
 {
     if (addEvents) {
         const MatchableObject matchableEvent(event);
@@ -180,24 +182,24 @@ void cSingleFingerprintCalculator::addEvent(cEvent *event)
                     if (!addEventIngredient(event, ingredient)) {
                         switch (ingredient) {
                             case EVENT_NUMBER:
-                                hasher_ << cSimulation::getActiveSimulation()->getEventNumber(); break;
+                                hasher << cSimulation::getActiveSimulation()->getEventNumber(); break;
                             case SIMULATION_TIME:
-                                hasher_ << simTime(); break;
+                                hasher << simTime(); break;
                             case MESSAGE_FULL_NAME:
-                                hasher_ << event->getFullName(); break;
+                                hasher << event->getFullName(); break;
                             case MESSAGE_CLASS_NAME:
-                                hasher_ << event->getClassName(); break;
+                                hasher << event->getClassName(); break;
                             case MESSAGE_KIND:
                                 if (message != nullptr)
-                                    hasher_ << message->getKind();
+                                    hasher << message->getKind();
                                 break;
                             case MESSAGE_BIT_LENGTH:
                                 if (packet != nullptr)
-                                    hasher_ << packet->getBitLength();
+                                    hasher << packet->getBitLength();
                                 break;
                             case MESSAGE_CONTROL_INFO_CLASS_NAME:
                                 if (controlInfo != nullptr)
-                                    hasher_ << controlInfo->getClassName();
+                                    hasher << controlInfo->getClassName();
                                 break;
                             case MESSAGE_DATA:
                                 if (message != nullptr) {
@@ -207,7 +209,7 @@ void cSingleFingerprintCalculator::addEvent(cEvent *event)
                                     cMemCommBuffer buffer;
                                     cMessage *copy = message->dup();
                                     copy->parsimPack(&buffer);
-                                    hasher_.add(buffer.getBuffer(), buffer.getMessageSize());
+                                    hasher.add(buffer.getBuffer(), buffer.getMessageSize());
                                     delete copy;
 #else
                                     throw cRuntimeError("Fingerprint is configured to contain MESSAGE_DATA (d),"
@@ -218,25 +220,25 @@ void cSingleFingerprintCalculator::addEvent(cEvent *event)
                                 break;
                             case MODULE_ID:
                                 if (module != nullptr)
-                                    hasher_ << module->getId();
+                                    hasher << module->getId();
                                 break;
                             case MODULE_FULL_NAME:
                                 if (module != nullptr)
-                                    hasher_ << module->getFullName();
+                                    hasher << module->getFullName();
                                 break;
                             case MODULE_FULL_PATH:
                                 if (module != nullptr)
-                                    hasher_ << module->getFullPath().c_str();
+                                    hashModuleFullPath(hasher, module);
                                 break;
                             case MODULE_CLASS_NAME:
                                 if (module != nullptr)
-                                    hasher_ << module->getComponentType()->getClassName();
+                                    hasher << module->getComponentType()->getClassName();
                                 break;
                             case RANDOM_NUMBERS_DRAWN:
-                                hasher_ << cSimulation::getActiveSimulation()->getRngManager()->getHash();
+                                hasher << cSimulation::getActiveSimulation()->getRngManager()->getHash();
                                 break;
                             case CLEAN_HASHER:
-                                hasher_.reset();
+                                hasher.reset();
                                 break;
                             case RESULT_SCALAR:
                             case RESULT_STATISTIC:
@@ -256,12 +258,28 @@ void cSingleFingerprintCalculator::addEvent(cEvent *event)
     }
 }
 
+void cSingleFingerprintCalculator::addEvent(cEvent *event)
+{
+    hashEvent(hasher_, event);
+}
+
+void cSingleFingerprintCalculator::hashModuleFullPath(cHasher& hasher, cModule *module)
+{
+    hasher << module->getFullPath().c_str();
+}
+
+void cSingleFingerprintCalculator::hashModuleFullPath(cHasher64& hasher, cModule *module)
+{
+    hasher << module->getFullPath().c_str();
+}
+
 bool cSingleFingerprintCalculator::addEventIngredient(cEvent *event, FingerprintIngredient ingredient)
 {
     return false;
 }
 
-void cSingleFingerprintCalculator::addScalarResult(const cComponent *component, const char *name, double value)
+template <typename H>
+void cSingleFingerprintCalculator::hashScalarResult(H& hasher, const cComponent *component, const char *name, double value)
 {
     if (addScalarResults) {
         MatchableObject matchableComponent(component);
@@ -269,38 +287,50 @@ void cSingleFingerprintCalculator::addScalarResult(const cComponent *component,
             cNamedObject object(name);
             MatchableObject matchableResult(&object);
             if (resultMatcher == nullptr || resultMatcher->matches(&matchableResult))
-                hasher_ << value;
+                hasher << value;
         }
     }
 }
 
-void cSingleFingerprintCalculator::addStatisticResult(const cComponent *component, const char *name, const cStatistic *statistic)
+void cSingleFingerprintCalculator::addScalarResult(const cComponent *component, const char *name, double value)
+{
+    hashScalarResult(hasher_, component, name, value);
+}
+
+template <typename H>
+void cSingleFingerprintCalculator::hashStatisticResult(H& hasher, const cComponent *component, const char *name, const cStatistic *statistic)
 {
     if (addStatisticResults) {
         MatchableObject matchableComponent(component);
         if (moduleMatcher == nullptr || moduleMatcher->matches(&matchableComponent)) {
             MatchableObject matchableResult(statistic);
             if (resultMatcher == nullptr || resultMatcher->matches(&matchableResult)) {
-                hasher_ << statistic->getSumWeights();
-                hasher_ << statistic->getWeightedSum();
-                hasher_ << statistic->getMin();
-                hasher_ << statistic->getMax();
-                hasher_ << statistic->getMean();
-                hasher_ << statistic->getStddev();
+                hasher << statistic->getSumWeights();
+                hasher << statistic->getWeightedSum();
+                hasher << statistic->getMin();
+                hasher << statistic->getMax();
+                hasher << statistic->getMean();
+                hasher << statistic->getStddev();
                 if (const cAbstractHistogram *histogram = dynamic_cast<const cAbstractHistogram*>(statistic)) {
-                    hasher_ << histogram->getUnderflowSumWeights();
-                    hasher_ << histogram->getOverflowSumWeights();
+                    hasher << histogram->getUnderflowSumWeights();
+                    hasher << histogram->getOverflowSumWeights();
                     int numBins = histogram->getNumBins();
                     for (int i = 0; i < numBins; i++)
-                        hasher_ << histogram->getBinEdge(i) << histogram->getBinValue(i);
-                    hasher_ << histogram->getBinEdge(numBins);
+                        hasher << histogram->getBinEdge(i) << histogram->getBinValue(i);
+                    hasher << histogram->getBinEdge(numBins);
                 }
             }
         }
     }
 }
 
-void cSingleFingerprintCalculator::addVectorResult(const cComponent *component, const char *name, const simtime_t& t, double value)
+void cSingleFingerprintCalculator::addStatisticResult(const cComponent *component, const char *name, const cStatistic *statistic)
+{
+    hashStatisticResult(hasher_, component, name, statistic);
+}
+
+template <typename H>
+void cSingleFingerprintCalculator::hashVectorResult(H& hasher, const cComponent *component, const char *name, const simtime_t& t, double value)
 {
     if (addVectorResults) {
         MatchableObject matchableComponent(component);
@@ -309,11 +339,16 @@ void cSingleFingerprintCalculator::addVectorResult(const cComponent *component,
             cNamedObject object(name);
             MatchableObject matchableResult(&object);
             if (resultMatcher == nullptr || resultMatcher->matches(&matchableResult))
-                hasher_ << t << value;
+                hasher << t << value;
         }
     }
 }
 
+void cSingleFingerprintCalculator::addVectorResult(const cComponent *component, const char *name, const simtime_t& t, double value)
+{
+    hashVectorResult(hasher_, component, name, t, value);
+}
+
 void cSingleFingerprintCalculator::addVisuals()
 {
     bool displayStrings = ingredients.find(DISPLAY_STRINGS) != std::string::npos;
@@ -322,34 +357,112 @@ void cSingleFingerprintCalculator::addVisuals()
         addModuleVisuals(cSimulation::getActiveSimulation()->getSystemModule(), displayStrings, figures);
 }
 
-void cSingleFingerprintCalculator::addModuleVisuals(cModule *module, bool displayStrings, bool figures)
+template <typename H>
+void cSingleFingerprintCalculator::hashModuleVisuals(H& hasher, cModule *module, bool displayStrings, bool figures)
 {
     // add this module
     if (displayStrings && module->hasDisplayString())
-        hasher_ << module->getDisplayString().str();
+        hasher << module->getDisplayString().str();
     if (figures && module->getCanvasIfExists())
-        hasher_ << module->getCanvas()->getHash();
+        hasher << module->getCanvas()->getHash();
 
     // and recurse
     for (cModule::SubmoduleIterator it(module); !it.end(); ++it)
-        addModuleVisuals(*it, displayStrings, figures);
+        hashModuleVisuals(hasher, *it, displayStrings, figures);
     for (cModule::ChannelIterator it(module); !it.end(); ++it)
-        hasher_ << (*it)->getDisplayString().str();
+        hasher << (*it)->getDisplayString().str();
 }
 
-bool cSingleFingerprintCalculator::checkFingerprint() const
+void cSingleFingerprintCalculator::addModuleVisuals(cModule *module, bool displayStrings, bool figures)
+{
+    hashModuleVisuals(hasher_, module, displayStrings, figures);
+}
+
+template <typename H>
+bool cSingleFingerprintCalculator::matchesExpected(const H& hasher) const
 {
     cStringTokenizer tokenizer(expectedFingerprints.c_str());
     while (tokenizer.hasMoreTokens()) {
         std::string fingerprint = tokenizer.nextToken();
         if (fingerprint.find('/') != std::string::npos)
             fingerprint = omnetpp::common::opp_substringbefore(fingerprint, "/");
-        if (hasher_.equals(fingerprint.c_str()))
+        if (hasher.equals(fingerprint.c_str()))
             return true;
     }
     return false;
 }
 
+bool cSingleFingerprintCalculator::checkFingerprint() const
+{
+    return matchesExpected(hasher_);
+}
+
+//----
+
+void cFastFingerprintCalculator::configure(cSimulation *simulation, cConfiguration *cfg, const char *expectedFingerprints, int index)
+{
+    cSingleFingerprintCalculator::configure(simulation, cfg, expectedFingerprints, index);
+    hasher64.reset();
+    modulePathHashes.clear();
+}
+
+std::string cFastFingerprintCalculator::str() const
+{
+    return hasher64.str() + "/" + ingredients;
+}
+
+void cFastFingerprintCalculator::hashModuleFullPath(cHasher64& hasher, cModule *module)
+{
+    // cache the hash of the full path per module; revalidate on parent change (see cModule::changeParentTo())
+    int id = module->getId();
+    if (id >= (int)modulePathHashes.size())
+        modulePathHashes.resize(id + 1024);
+    ModulePathHash& entry = modulePathHashes[id];
+    cModule *parent = module->getParentModule();
+    int parentId = parent ? parent->getId() : -1;
+    if (!entry.valid || entry.parentId != parentId) {
+        cHasher64 pathHasher;
+        pathHasher << module->getFullPath().c_str();
+        entry.hash = pathHasher.getHash();
+        entry.parentId = parentId;
+        entry.valid = true;
+    }
+    hasher << entry.hash;
+}
+
+void cFastFingerprintCalculator::addEvent(cEvent *event)
+{
+    hashEvent(hasher64, event);
+}
+
+void cFastFingerprintCalculator::addScalarResult(const cComponent *component, const char *name, double value)
+{
+    hashScalarResult(hasher64, component, name, value);
+}
+
+void cFastFingerprintCalculator::addStatisticResult(const cComponent *component, const char *name, const cStatistic *statistic)
+{
+    hashStatisticResult(hasher64, component, name, statistic);
+}
+
+void cFastFingerprintCalculator::addVectorResult(const cComponent *component, const char *name, const simtime_t& t, double value)
+{
+    hashVectorResult(hasher64, component, name, t, value);
+}
+
+void cFastFingerprintCalculator::addVisuals()
+{
+    bool displayStrings = ingredients.find(DISPLAY_STRINGS) != std::string::npos;
+    bool figures = ingredients.find(CANVAS_FIGURES) != std::string::npos;
+    if (displayStrings || figures)
+        hashModuleVisuals(hasher64, cSimulation::getActiveSimulation()->getSystemModule(), displayStrings, figures);
+}
+
+bool cFastFingerprintCalculator::checkFingerprint() const
+{
+    return matchesExpected(hasher64);
+}
+
 //----
 
 cMultiFingerprintCalculator::cMultiFingerprintCalculator(cFingerprintCalculator *prototype) :
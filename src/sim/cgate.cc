@@ -20,6 +20,7 @@
 #include <cmath>  // pow
 #include <cstdio>  // sprintf
 #include <cstring>  // strcpy
+#include <typeinfo>
 #include "common/stringutil.h"
 #include "common/stringpool.h"
 #include "omnetpp/cpacket.h"
@@ -298,6 +299,7 @@ cChannel *cGate::connectTo(cGate *g, cChannel *chan, bool leaveUninitialized)
     connectionId = ++lastConnectionId;
     if (chan)
         installChannel(chan);
+    invalidateShortcutGates();
 
     checkChannels();
 
@@ -390,6 +392,7 @@ void cGate::disconnect()
     nextGate->prevGate = nullptr;
     nextGate = nullptr;
     connectionId = -1;
+    invalidateShortcutGates();
 
 
 #ifdef SIMFRONTEND_SUPPORT
@@ -475,13 +478,50 @@ void cGate::setDeliverImmediately(bool d)
         pos &= ~2;
 }
 
+cGate *cGate::getShortcutGate()
+{
+    if (shortcutGate)
+        return shortcutGate;
+
+    // skip connections whose channel does nothing; note that subclasses
+    // of cIdealChannel may redefine processMessage()
+    cGate *g = this;
+    while (g->nextGate) {
+        if (g->channel) {
+            if (typeid(*g->channel) != typeid(cIdealChannel))
+                break;
+            if (!g->channel->initialized())
+                return g;  // let deliver() report the error; don't cache
+        }
+        g = g->nextGate;
+    }
+    shortcutGate = g;
+    return g;
+}
+
+void cGate::invalidateShortcutGates()
+{
+    for (cGate *g = this; g != nullptr; g = g->prevGate)
+        g->shortcutGate = nullptr;
+}
+
 bool cGate::deliver(cMessage *msg, const SendOptions& options, simtime_t t)
 {
     if (!nextGate) {
         getOwnerModule()->arrived(msg, this, options, t);
         return true;
     }
-    else if (!channel) {
+
+    // if no one is interested in the individual hops, skip the connections
+    // that have no channel or an ideal channel in one step
+    cEnvir *envir = cSimulation::getActiveEnvir();
+    if (envir->suppressSendHopNotifications || envir->suppressNotifications) {
+        cGate *g = getShortcutGate();
+        if (g != this)
+            return g->deliver(msg, options, t);
+    }
+
+    if (!channel) {
         EVCB.messageSendHop(msg, this);
         return nextGate->deliver(msg, options, t);
     }
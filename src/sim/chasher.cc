@@ -13,6 +13,7 @@
    `license' for details on this and other legal matters.
 *--------------------------------------------------------------*/
 
+#include <cerrno>
 #include "omnetpp/chasher.h"
 
 namespace omnetpp {
@@ -66,5 +67,159 @@ std::string cHasher::str() const
     return str;
 }
 
+//----
+
+// XXH64 constants
+static const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+static const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t read64(const uint8_t *p)
+{
+    uint64_t x;
+    memcpy(&x, p, 8);
+    return x;
+}
+
+static inline uint32_t read32(const uint8_t *p)
+{
+    uint32_t x;
+    memcpy(&x, p, 4);
+    return x;
+}
+
+static inline uint64_t round64(uint64_t acc, uint64_t input)
+{
+    acc += input * PRIME64_2;
+    acc = rotl64(acc, 31);
+    return acc * PRIME64_1;
+}
+
+static inline uint64_t mergeRound64(uint64_t acc, uint64_t val)
+{
+    acc ^= round64(0, val);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+void cHasher64::reset()
+{
+    v[0] = PRIME64_1 + PRIME64_2;
+    v[1] = PRIME64_2;
+    v[2] = 0;
+    v[3] = -PRIME64_1;
+    totalLength = 0;
+    stripeLength = 0;
+}
+
+void cHasher64::update(const void *ptr, size_t length)
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+    const uint8_t *end = p + length;
+    totalLength += length;
+
+    // complete the partially filled stripe
+    if (stripeLength > 0) {
+        size_t n = sizeof(stripe) - stripeLength;
+        if (length < n) {
+            memcpy(stripe + stripeLength, p, length);
+            stripeLength += length;
+            return;
+        }
+        memcpy(stripe + stripeLength, p, n);
+        for (int i = 0; i < 4; i++)
+            v[i] = round64(v[i], read64(stripe + 8*i));
+        p += n;
+        stripeLength = 0;
+    }
+
+    // process whole stripes directly from the input; the four lanes are independent
+    for (; p + 32 <= end; p += 32) {
+        v[0] = round64(v[0], read64(p));
+        v[1] = round64(v[1], read64(p + 8));
+        v[2] = round64(v[2], read64(p + 16));
+        v[3] = round64(v[3], read64(p + 24));
+    }
+
+    // keep the rest for later
+    if (p < end) {
+        memcpy(stripe, p, end - p);
+        stripeLength = end - p;
+    }
+}
+
+uint64_t cHasher64::getHash() const
+{
+    uint64_t h;
+    if (totalLength >= 32) {
+        h = rotl64(v[0], 1) + rotl64(v[1], 7) + rotl64(v[2], 12) + rotl64(v[3], 18);
+        for (int i = 0; i < 4; i++)
+            h = mergeRound64(h, v[i]);
+    }
+    else
+        h = v[2] + PRIME64_5;  // v[2] is the seed
+    h += totalLength;
+
+    const uint8_t *p = stripe;
+    const uint8_t *end = stripe + stripeLength;
+    for (; p + 8 <= end; p += 8) {
+        h ^= round64(0, read64(p));
+        h = rotl64(h, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (p + 4 <= end) {
+        h ^= (uint64_t)read32(p) * PRIME64_1;
+        h = rotl64(h, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+    for (; p < end; p++) {
+        h ^= (*p) * PRIME64_5;
+        h = rotl64(h, 11) * PRIME64_1;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+uint64_t cHasher64::parse(const char *hash) const
+{
+    // remove spaces, hyphens and colons before parsing
+    std::string s;
+    for (const char *p = hash; *p; p++)
+        if (*p != ' ' && *p != '-' && *p != ':')
+            s += *p;
+
+    // parse
+    char *e;
+    errno = 0;
+    unsigned long long d = strtoull(s.c_str(), &e, 16);
+    if (s.empty() || *e || errno != 0)
+        throw cRuntimeError("Cannot verify hash: Invalid hash text \"%s\"", hash);
+    return (uint64_t)d;
+}
+
+bool cHasher64::equals(const char *hash) const
+{
+    uint64_t value = parse(hash);
+    return getHash() == value;
+}
+
+std::string cHasher64::str() const
+{
+    char buf[32];
+    uint64_t h = getHash();
+    sprintf(buf, "%04x-%04x-%04x-%04x", (unsigned int)(h >> 48), (unsigned int)(h >> 32) & 0xffff, (unsigned int)(h >> 16) & 0xffff, (unsigned int)h & 0xffff);
+    return buf;
+}
+
 }  // namespace omnetpp
 
@@ -13,6 +13,7 @@
   `license' for details on this and other legal matters.
 *--------------------------------------------------------------*/
 
+#include <cmath>
 #include <algorithm>
 #include <omnetpp/chistogram.h>
 #include "omnetpp/chistogramstrategy.h"
@@ -136,12 +137,12 @@ void cHistogram::parsimUnpack(cCommBuffer *buffer)
     size_t n;
     buffer->unpack(n);
     binEdges.resize(n);
-    for (size_t i = 0; i < n; n++)
+    for (size_t i = 0; i < n; i++)
         buffer->unpack(binEdges[i]);
 
     buffer->unpack(n);
     binValues.resize(n);
-    for (size_t i = 0; i < n; n++)
+    for (size_t i = 0; i < n; i++)
         buffer->unpack(binValues[i]);
 
     buffer->unpack(finiteUnderflowSumWeights);
@@ -149,8 +150,13 @@ void cHistogram::parsimUnpack(cCommBuffer *buffer)
     buffer->unpack(negInfSumWeights);
     buffer->unpack(posInfSumWeights);
 
-    if (buffer->checkFlag())
-        setStrategy((cIHistogramStrategy *)buffer->unpackObject());
+    // note: not setStrategy(), as it refuses to replace the strategy once values have been collected
+    delete strategy;
+    strategy = nullptr;
+    if (buffer->checkFlag()) {
+        strategy = (cIHistogramStrategy *)buffer->unpackObject();
+        strategy->setHistogram(this);
+    }
 #endif
 }
 
@@ -190,6 +196,44 @@ void cHistogram::collectWeighted(double value, double weight)
     }
 }
 
+void cHistogram::collect(const double *values, size_t n)
+{
+    cStdDev::collect(values, n);
+    collectFiniteRuns(values, nullptr, n);
+}
+
+void cHistogram::collectWeighted(const double *values, const double *weights, size_t n)
+{
+    cStdDev::collectWeighted(values, weights, n);
+    collectFiniteRuns(values, weights, n);
+}
+
+void cHistogram::collectFiniteRuns(const double *values, const double *weights, size_t n)
+{
+    // infinities are counted here; runs of finite values go to the strategy in one piece
+    size_t start = 0;
+    for (size_t i = 0; i <= n; i++) {
+        if (i < n && !std::isinf(values[i]))
+            continue;
+        if (i > start) {
+            if (strategy == nullptr)
+                collectIntoHistogram(values + start, weights ? weights + start : nullptr, i - start); // error if no bins
+            else if (weights == nullptr)
+                strategy->collect(values + start, i - start);
+            else
+                strategy->collectWeighted(values + start, weights + start, i - start);
+        }
+        if (i < n) {
+            double weight = weights ? weights[i] : 1;
+            if (values[i] < 0)
+                negInfSumWeights += weight;
+            else
+                posInfSumWeights += weight;
+        }
+        start = i + 1;
+    }
+}
+
 int64_t cHistogram::getNumUnderflows() const
 {
     if (isWeighted())
@@ -517,6 +561,79 @@ void cHistogram::collectIntoHistogram(double value, double weight)
         binValues[index] += weight;
 }
 
+// Returns the index of the bin containing x, the same way as std::upper_bound()
+// does in collectIntoHistogram(double,double): -1 for underflow, numEdges-1
+// for overflow. The loop has a fixed number of iterations and no
+// data-dependent branches.
+static inline int findBinBranchless(const double *edges, int numEdges, double x)
+{
+    const double *base = edges;
+    int len = numEdges;
+    while (len > 1) {
+        int half = len / 2;
+        base = (base[half] <= x) ? base + half : base;
+        len -= half;
+    }
+    return (base - edges) + (*base <= x) - 1;
+}
+
+void cHistogram::collectIntoHistogram(const double *values, const double *weights, size_t n)
+{
+    ASSERT(binEdges.size() >= 2);
+    ASSERT(binEdges.size() == binValues.size() + 1);
+
+    const double *edges = binEdges.data();
+    int numBins = binValues.size();
+    double firstEdge = edges[0];
+    double binSize = (edges[numBins] - firstEdge) / numBins;
+
+    // With (nearly) uniform bins, the bin index can be computed with a multiplication;
+    // the result is corrected against the actual edges, so it is always exact.
+    // Tiny (e.g. denormal) bin sizes whose reciprocal overflows take the slow path.
+    double invBinSize = 1 / binSize;
+    bool uniform = std::isfinite(invBinSize);
+    for (int k = 1; k < numBins && uniform; k++)
+        uniform = std::fabs(edges[k] - (firstEdge + k * binSize)) <= 1e-6 * binSize;
+
+    const size_t INDEX_BLOCK_SIZE = 256;
+    int indices[INDEX_BLOCK_SIZE];
+    for (size_t start = 0; start < n; start += INDEX_BLOCK_SIZE) {
+        size_t blockSize = std::min(INDEX_BLOCK_SIZE, n - start);
+        const double *x = values + start;
+
+        // compute the bin indices for the block; these loops are vectorizable
+        if (uniform) {
+            for (size_t j = 0; j < blockSize; j++) {
+                double t = (x[j] - firstEdge) * invBinSize;
+                t = t < -1 ? -1 : t <= numBins ? t : numBins; // NaN goes to overflow
+                indices[j] = (int)std::floor(t);
+            }
+        }
+        else {
+            for (size_t j = 0; j < blockSize; j++)
+                indices[j] = findBinBranchless(edges, numBins + 1, x[j]);
+        }
+
+        // add the weights
+        for (size_t j = 0; j < blockSize; j++) {
+            int index = indices[j];
+            if (uniform) {
+                while (index >= 0 && x[j] < edges[index])
+                    index--;
+                while (index < numBins && x[j] >= edges[index + 1])
+                    index++;
+            }
+            double weight = weights ? weights[start + j] : 1;
+            if (index < 0)
+                finiteUnderflowSumWeights += weight;
+            else if (index >= numBins)
+                finiteOverflowSumWeights += weight;
+            else
+                binValues[index] += weight;
+        }
+    }
+}
+
 cAutoRangeHistogramStrategy *cHistogram::getOrCreateAutoRangeStrategy() const
 {
     cHistogram *mutableThis = const_cast<cHistogram *>(this);
@@ -13,12 +13,14 @@
   `license' for details on this and other legal matters.
 *--------------------------------------------------------------*/
 
+#include <cmath>
 #include <algorithm>
 #include <limits>
 #include "omnetpp/regmacros.h"
 #include "omnetpp/onstartup.h"
 #include "omnetpp/globals.h"
 #include "omnetpp/chistogramstrategy.h"
+#include "omnetpp/ccommbuffer.h"
 
 namespace omnetpp {
 
@@ -33,6 +35,18 @@ void cIHistogramStrategy::setHistogram(cHistogram *hist)
     this->hist = hist;
 }
 
+void cIHistogramStrategy::collect(const double *values, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        collect(values[i]);
+}
+
+void cIHistogramStrategy::collectWeighted(const double *values, const double *weights, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        collectWeighted(values[i], weights[i]);
+}
+
 //----
 
 void cFixedRangeHistogramStrategy::copy(const cFixedRangeHistogramStrategy& other)
@@ -50,6 +64,32 @@ cFixedRangeHistogramStrategy& cFixedRangeHistogramStrategy::operator=(const cFix
     return *this;
 }
 
+void cFixedRangeHistogramStrategy::parsimPack(cCommBuffer *buffer) const
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(E_NOPARSIM);
+#else
+    buffer->pack(lo);
+    buffer->pack(hi);
+    buffer->pack(numBins);
+    buffer->pack((int)mode);
+#endif
+}
+
+void cFixedRangeHistogramStrategy::parsimUnpack(cCommBuffer *buffer)
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(E_NOPARSIM);
+#else
+    int tmp;
+    buffer->unpack(lo);
+    buffer->unpack(hi);
+    buffer->unpack(numBins);
+    buffer->unpack(tmp);
+    mode = (Mode)tmp;
+#endif
+}
+
 void cFixedRangeHistogramStrategy::setUpBins()
 {
     // validate parameters
@@ -89,6 +129,22 @@ void cFixedRangeHistogramStrategy::collectWeighted(double value, double weight)
     hist->collectIntoHistogram(value, weight);
 }
 
+void cFixedRangeHistogramStrategy::collect(const double *values, size_t n)
+{
+    if (!hist->binsAlreadySetUp())
+        setUpBins();
+    ASSERT(hist->getNumBins() > 0);
+    hist->collectIntoHistogram(values, nullptr, n);
+}
+
+void cFixedRangeHistogramStrategy::collectWeighted(const double *values, const double *weights, size_t n)
+{
+    if (!hist->binsAlreadySetUp())
+        setUpBins();
+    ASSERT(hist->getNumBins() > 0);
+    hist->collectIntoHistogram(values, weights, n);
+}
+
 //----
 
 void cPrecollectionBasedHistogramStrategy::copy(const cPrecollectionBasedHistogramStrategy& other)
@@ -112,6 +168,47 @@ cPrecollectionBasedHistogramStrategy& cPrecollectionBasedHistogramStrategy::oper
     return *this;
 }
 
+void cPrecollectionBasedHistogramStrategy::parsimPack(cCommBuffer *buffer) const
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(E_NOPARSIM);
+#else
+    buffer->pack(inPrecollection);
+    buffer->pack(numToPrecollect);
+    buffer->pack(numToCollate);
+    buffer->pack(lastRange);
+    buffer->pack(rangeUnchangedCounter);
+    buffer->pack(rangeUnchangedThreshold);
+    buffer->pack(finiteMinValue);
+    buffer->pack(finiteMaxValue);
+    buffer->pack(values.size());
+    buffer->pack(values.data(), values.size());
+    buffer->pack(weights.data(), weights.size());  // same size as values[]
+#endif
+}
+
+void cPrecollectionBasedHistogramStrategy::parsimUnpack(cCommBuffer *buffer)
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(E_NOPARSIM);
+#else
+    buffer->unpack(inPrecollection);
+    buffer->unpack(numToPrecollect);
+    buffer->unpack(numToCollate);
+    buffer->unpack(lastRange);
+    buffer->unpack(rangeUnchangedCounter);
+    buffer->unpack(rangeUnchangedThreshold);
+    buffer->unpack(finiteMinValue);
+    buffer->unpack(finiteMaxValue);
+    size_t n;
+    buffer->unpack(n);
+    values.resize(n);
+    weights.resize(n);
+    buffer->unpack(values.data(), n);
+    buffer->unpack(weights.data(), n);
+#endif
+}
+
 bool cPrecollectionBasedHistogramStrategy::precollect(double value, double weight)
 {
     // precollect value
@@ -148,13 +245,53 @@ bool cPrecollectionBasedHistogramStrategy::precollect(double value, double weigh
 
 void cPrecollectionBasedHistogramStrategy::moveValuesIntoHistogram()
 {
-    size_t numValues = values.size();
-    for (size_t i = 0; i < numValues; i++)
-        hist->collectIntoHistogram(values[i], weights[i]);
+    hist->collectIntoHistogram(values.data(), weights.data(), values.size());
     values.clear();
     weights.clear();
 }
 
+void cPrecollectionBasedHistogramStrategy::collectRun(const double *values, const double *weights, size_t n)
+{
+    // precollection, and values that may cause the bins to be extended, go
+    // through the subclass' collect()/collectWeighted(); runs of values that
+    // fall into the existing bins are collected directly
+    size_t i = 0;
+    while (i < n) {
+        if (inPrecollection) {
+            if (weights)
+                collectWeighted(values[i], weights[i]);
+            else
+                collect(values[i]);
+            i++;
+            continue;
+        }
+
+        double firstEdge = hist->getBinEdges().front();
+        double lastEdge = hist->getBinEdges().back();
+        size_t start = i;
+        double runMin = values[i], runMax = values[i];
+        while (i < n && values[i] >= firstEdge && values[i] < lastEdge) {
+            runMin = std::min(runMin, values[i]);
+            runMax = std::max(runMax, values[i]);
+            i++;
+        }
+        if (i > start) {
+            if (std::isnan(finiteMinValue) || runMin < finiteMinValue)
+                finiteMinValue = runMin;
+            if (std::isnan(finiteMaxValue) || runMax > finiteMaxValue)
+                finiteMaxValue = runMax;
+            hist->collectIntoHistogram(values + start, weights ? weights + start : nullptr, i - start);
+        }
+        if (i < n) {
+            if (weights)
+                collectWeighted(values[i], weights[i]);
+            else
+                collect(values[i]);
+            i++;
+        }
+    }
+}
+
 void cPrecollectionBasedHistogramStrategy::setUpBins()
 {
     createBins();
@@ -193,6 +330,42 @@ cDefaultHistogramStrategy& cDefaultHistogramStrategy::operator=(const cDefaultHi
     return *this;
 }
 
+void cDefaultHistogramStrategy::parsimPack(cCommBuffer *buffer) const
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(E_NOPARSIM);
+#else
+    cPrecollectionBasedHistogramStrategy::parsimPack(buffer);
+    buffer->pack(rangeExtensionFactor);
+    buffer->pack(binSize);
+    buffer->pack(numBinsHint);
+    buffer->pack(targetNumBins);
+    buffer->pack((int)mode);
+    buffer->pack(autoExtend);
+    buffer->pack(binMerging);
+    buffer->pack(maxNumBins);
+#endif
+}
+
+void cDefaultHistogramStrategy::parsimUnpack(cCommBuffer *buffer)
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(E_NOPARSIM);
+#else
+    cPrecollectionBasedHistogramStrategy::parsimUnpack(buffer);
+    int tmp;
+    buffer->unpack(rangeExtensionFactor);
+    buffer->unpack(binSize);
+    buffer->unpack(numBinsHint);
+    buffer->unpack(targetNumBins);
+    buffer->unpack(tmp);
+    mode = (Mode)tmp;
+    buffer->unpack(autoExtend);
+    buffer->unpack(binMerging);
+    buffer->unpack(maxNumBins);
+#endif
+}
+
 void cDefaultHistogramStrategy::collect(double value)
 {
     collectWeighted(value, 1);
@@ -471,6 +644,50 @@ cAutoRangeHistogramStrategy& cAutoRangeHistogramStrategy::operator=(const cAutoR
     return *this;
 }
 
+void cAutoRangeHistogramStrategy::parsimPack(cCommBuffer *buffer) const
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(E_NOPARSIM);
+#else
+    cPrecollectionBasedHistogramStrategy::parsimPack(buffer);
+    buffer->pack(lo);
+    buffer->pack(hi);
+    buffer->pack(rangeExtensionFactor);
+    buffer->pack(numBinsHint);
+    buffer->pack(targetNumBins);
+    buffer->pack(requestedBinSize);
+    buffer->pack(binSize);
+    buffer->pack((int)mode);
+    buffer->pack(binSizeRounding);
+    buffer->pack(autoExtend);
+    buffer->pack(binMerging);
+    buffer->pack(maxNumBins);
+#endif
+}
+
+void cAutoRangeHistogramStrategy::parsimUnpack(cCommBuffer *buffer)
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError(E_NOPARSIM);
+#else
+    cPrecollectionBasedHistogramStrategy::parsimUnpack(buffer);
+    int tmp;
+    buffer->unpack(lo);
+    buffer->unpack(hi);
+    buffer->unpack(rangeExtensionFactor);
+    buffer->unpack(numBinsHint);
+    buffer->unpack(targetNumBins);
+    buffer->unpack(requestedBinSize);
+    buffer->unpack(binSize);
+    buffer->unpack(tmp);
+    mode = (Mode)tmp;
+    buffer->unpack(binSizeRounding);
+    buffer->unpack(autoExtend);
+    buffer->unpack(binMerging);
+    buffer->unpack(maxNumBins);
+#endif
+}
+
 void cAutoRangeHistogramStrategy::collect(double value)
 {
     collectWeighted(value, 1.0);
@@ -22,6 +22,7 @@
 #include "omnetpp/cenvir.h"
 #include "omnetpp/csimulation.h"
 #include "omnetpp/cexception.h"
+#include "omnetpp/ccommbuffer.h"
 #include "omnetpp/cconfigoption.h"
 
 namespace omnetpp {
@@ -119,6 +120,18 @@ double cLCG32::doubleRandIncl1()
     return (double)intRand() * (1.0 / (LCG32_MAX - 1));
 }
 
+void cLCG32::checkpoint(cCommBuffer *buffer) const
+{
+    buffer->pack(seed);
+    buffer->pack(numDrawn);
+}
+
+void cLCG32::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(seed);
+    buffer->unpack(numDrawn);
+}
+
 const uint32_t cLCG32::autoSeeds[] = {
     1L, 1331238991L, 1550655590L, 930627303L, 766698560L, 372156336L,
     1645116277L, 1635860990L, 1154667137L, 692982627L, 1961833381L,
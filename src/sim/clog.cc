@@ -25,6 +25,7 @@ OPP_THREAD_LOCAL bool cLog::loggingEnabled = true;
 OPP_THREAD_LOCAL LogLevel cLog::logLevel = LOGLEVEL_TRACE;
 OPP_THREAD_LOCAL cLog::NoncomponentLogPredicate cLog::noncomponentLogPredicate = &cLog::defaultNoncomponentLogPredicate;
 OPP_THREAD_LOCAL cLog::ComponentLogPredicate cLog::componentLogPredicate = &cLog::defaultComponentLogPredicate;
+OPP_THREAD_LOCAL bool cLog::captureUserTime = true;
 
 namespace internal {
 
@@ -167,7 +168,7 @@ void cLogProxy::fillEntry(LogLevel logLevel, const char *category, const char *s
     currentEntry.sourceFile = sourceFile;
     currentEntry.sourceLine = sourceLine;
     currentEntry.sourceFunction = sourceFunction;
-    currentEntry.userTime = clock();
+    currentEntry.userTime = cLog::captureUserTime ? clock() : 0;
 }
 
 void cLogProxy::flushLastLine()
@@ -20,6 +20,7 @@
 #include "omnetpp/cenvir.h"
 #include "omnetpp/simutil.h"
 #include "omnetpp/cexception.h"
+#include "omnetpp/ccommbuffer.h"
 #include "omnetpp/cmersennetwister.h"
 #include "omnetpp/cmessage.h"
 #include "omnetpp/cconfigoption.h"
@@ -112,5 +113,21 @@ double cMersenneTwister::doubleRandIncl1()
     return rng.rand();
 }
 
+void cMersenneTwister::checkpoint(cCommBuffer *buffer) const
+{
+    MTRand::uint32 state[MTRand::SAVE];
+    rng.save(state);
+    buffer->pack(state, MTRand::SAVE);
+    buffer->pack(numDrawn);
+}
+
+void cMersenneTwister::restore(cCommBuffer *buffer)
+{
+    MTRand::uint32 state[MTRand::SAVE];
+    buffer->unpack(state, MTRand::SAVE);
+    rng.load(state);
+    buffer->unpack(numDrawn);
+}
+
 }  // namespace omnetpp
 
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include "common/stringutil.h"
 #include "common/stlutil.h"
+#include "common/stringpool.h"
 #include "omnetpp/cconfiguration.h"
 #include "omnetpp/cconfigoption.h"
 #include "omnetpp/cmodule.h"
@@ -39,6 +40,7 @@
 #include "omnetpp/cosgcanvas.h"
 #include "omnetpp/simutil.h"
 #include "omnetpp/cmodelchange.h"
+#include "modulepathcache.h"
 
 using namespace omnetpp::common;
 
@@ -224,21 +226,9 @@ std::string cModule::str() const
     return out.str();
 }
 
-template<typename T>
-typename std::vector<T>::iterator findByName(std::vector<T>& v, const std::string& name) {
-    for (auto it = v.begin(); it != v.end(); ++it)
-        if (it->name == name)
-            return it;
-    return v.end();
-}
-
-template<typename T>
-typename std::vector<T>::const_iterator findByName(const std::vector<T>& v, const std::string& name) {
-    std::string namestr = name;
-    for (auto it = v.cbegin(); it != v.cend(); ++it)
-        if (it->name == namestr)
-            return it;
-    return v.cend();
+size_t cModule::NameHash::operator()(const char *s) const
+{
+    return opp_hash((unsigned char *)s);
 }
 
 void cModule::insertSubmodule(cModule *mod)
@@ -256,13 +246,14 @@ void cModule::insertSubmodule(cModule *mod)
         if (hasSubmoduleVector(name))
             throw cRuntimeError("Cannot insert module %s into parent %s: a submodule vector of the same name already exists", mod->getClassAndFullName().c_str(), getNedTypeAndFullPath().c_str());
         subcomponentData->scalarSubmodules.push_back(mod);
+        subcomponentData->scalarSubmoduleByName[opp_staticpooledstring::get(name)] = mod;
     }
     else {
         // add to submodule vectors array (name and index must already be set)
-        auto it = findByName(subcomponentData->submoduleVectors, name);
-        if (it == subcomponentData->submoduleVectors.end())
+        SubmoduleVector *vector = findSubmoduleVector(name);
+        if (vector == nullptr)
             throw cRuntimeError("Cannot insert module %s into parent %s: There is no submodule vector named '%s'", mod->getClassAndFullName().c_str(), getNedTypeAndFullPath().c_str(), name);
-        auto& array = it->array;
+        auto& array = vector->array;
         if (index < 0 || index >= array.size())
             throw cRuntimeError("Cannot insert module %s into parent %s: index is out of range (vector size is %d)", mod->getClassAndFullName().c_str(), getNedTypeAndFullPath().c_str(), (int)array.size());
         if (array.at(index) != nullptr)
@@ -276,6 +267,7 @@ void cModule::insertSubmodule(cModule *mod)
     take(mod);
 
     mod->invalidateFullPathRec();
+    getSimulation()->invalidateModulePathCache();
 }
 
 void cModule::removeSubmodule(cModule *mod)
@@ -294,6 +286,7 @@ void cModule::removeSubmodule(cModule *mod)
         auto it = std::find(submodules.begin(), submodules.end(), mod);
         ASSERT(it != submodules.end());
         submodules.erase(it);
+        subcomponentData->scalarSubmoduleByName.erase(mod->getName());
     }
     else {
         // remove from submodule vectors array
@@ -303,6 +296,7 @@ void cModule::removeSubmodule(cModule *mod)
     }
 
     subcomponentData->submoduleChangeCount++;
+    getSimulation()->invalidateModulePathCache();
 }
 
 void cModule::insertChannel(cChannel *channel)
@@ -376,6 +370,8 @@ void cModule::updateFullName()
     }
 
     invalidateFullPathRec();
+    if (getSimulation())
+        getSimulation()->invalidateModulePathCache();
 
 #ifdef SIMFRONTEND_SUPPORT
     updateLastChangeSerial();
@@ -437,14 +433,19 @@ bool cModule::isSimple() const
     return dynamic_cast<const cSimpleModule *>(this) != nullptr;
 }
 
+cModule::SubmoduleVector *cModule::findSubmoduleVector(const char *name) const
+{
+    if (subcomponentData == nullptr)
+        return nullptr;
+    auto& byName = subcomponentData->submoduleVectorByName;
+    auto it = byName.find(name);
+    return it == byName.end() ? nullptr : &subcomponentData->submoduleVectors[it->second];
+}
+
 std::vector<cModule*>& cModule::getSubmoduleArray(const char *name) const
 {
-    if (subcomponentData != nullptr) {
-        std::string namestr = name;
-        for (const auto& v : subcomponentData->submoduleVectors)
-            if (v.name == namestr)
-                return const_cast<std::vector<cModule*>&>(v.array);
-    }
+    if (SubmoduleVector *vector = findSubmoduleVector(name))
+        return vector->array;
     if (hasSubmodule(name))
         throw cRuntimeError("Module '%s' has no submodule vector named '%s' ('%s' is a scalar submodule)", getFullPath().c_str(), name, name);
     else
@@ -1304,10 +1305,7 @@ bool cModule::hasSubmodules() const
 
 bool cModule::hasSubmoduleVector(const char *name) const
 {
-    if (subcomponentData == nullptr)
-        return false;
-    const auto& submoduleVectors = subcomponentData->submoduleVectors;
-    return findByName(submoduleVectors, name) != submoduleVectors.end();
+    return findSubmoduleVector(name) != nullptr;
 }
 
 std::vector<std::string> cModule::getSubmoduleVectorNames() const
@@ -1348,6 +1346,7 @@ void cModule::addSubmoduleVector(const char *name, int size)
     submoduleVectors.push_back(SubmoduleVector());
     submoduleVectors.back().name = name;
     submoduleVectors.back().array.resize(size);
+    subcomponentData->submoduleVectorByName[opp_staticpooledstring::get(name)] = submoduleVectors.size() - 1;
 }
 
 void cModule::deleteSubmoduleVector(const char *name)
@@ -1355,16 +1354,23 @@ void cModule::deleteSubmoduleVector(const char *name)
     if (subcomponentData == nullptr)
         subcomponentData = new SubcomponentData;
 
-    auto& submoduleVectors = subcomponentData->submoduleVectors;
-    auto it = findByName(submoduleVectors, name);
-    if (it == submoduleVectors.end())
+    SubmoduleVector *vector = findSubmoduleVector(name);
+    if (vector == nullptr)
         throw cRuntimeError("Module '%s' has no submodule vector named '%s'", getFullPath().c_str(), name);
 
-    for (cModule *submodule : it->array)
+    for (cModule *submodule : vector->array)
         if (submodule)
             submodule->deleteModule();
 
-    submoduleVectors.erase(it);
+    // erase, and update the indices in the lookup table
+    auto& submoduleVectors = subcomponentData->submoduleVectors;
+    auto& byName = subcomponentData->submoduleVectorByName;
+    int index = byName[name];
+    submoduleVectors.erase(submoduleVectors.begin() + index);
+    byName.erase(name);
+    for (auto& entry : byName)
+        if (entry.second > index)
+            entry.second--;
 }
 
 void cModule::setSubmoduleVectorSize(const char *name, int newSize)
@@ -1400,17 +1406,16 @@ cModule *cModule::getSubmodule(const char *name, int index) const
 
     if (index == -1) {
         // scalar
-        for (cModule *submodule : subcomponentData->scalarSubmodules)
-            if (submodule->isName(name))
-                return submodule;
-        return nullptr;
+        auto& byName = subcomponentData->scalarSubmoduleByName;
+        auto it = byName.find(name);
+        return it == byName.end() ? nullptr : it->second;
     }
     else {
         // vector
-        auto it = findByName(subcomponentData->submoduleVectors, name);
-        if (it == subcomponentData->submoduleVectors.end())
+        SubmoduleVector *vector = findSubmoduleVector(name);
+        if (vector == nullptr)
             return nullptr;
-        auto& array = it->array;
+        auto& array = vector->array;
         if (index < 0 || index >= array.size())
             return nullptr;
         return array[index];
@@ -1435,8 +1440,14 @@ cModule *cModule::doFindModuleByPath(const char *path) const
     if (!path || !path[0])
         return nullptr;
 
-    // determine starting point
+    // absolute paths are first looked up in the cache
     bool isRelative = (path[0] == '.' || path[0] == '^');
+    internal::ModulePathCache *cache = isRelative ? nullptr : getSimulation()->getModulePathCache();
+    int cachedModuleId;
+    if (cache && cache->lookup(path, cachedModuleId))
+        return getSimulation()->getModule(cachedModuleId);
+
+    // determine starting point
     const cModule *module = isRelative ? this : getSimulation()->getSystemModule();
     const char *pathWithoutFirstDot = (path[0] == '.') ? path+1 : path;
 
@@ -1471,6 +1482,8 @@ cModule *cModule::doFindModuleByPath(const char *path) const
         isFirst = false;
     }
 
+    if (cache)
+        cache->put(path, module ? module->getId() : -1);
     return const_cast<cModule*>(module);
 }
 
@@ -0,0 +1,253 @@
+//==========================================================================
+//  CPHILOX.CC - part of
+//                 OMNeT++/OMNEST
+//              Discrete System Simulation in C++
+//
+// Contents:
+//   class cPhilox
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include "omnetpp/clog.h"
+#include "omnetpp/cenvir.h"
+#include "omnetpp/simutil.h"
+#include "omnetpp/cexception.h"
+#include "omnetpp/ccommbuffer.h"
+#include "omnetpp/cphilox.h"
+#include "omnetpp/cconfigoption.h"
+
+namespace omnetpp {
+
+Register_Class(cPhilox);
+
+Register_GlobalConfigOption(CFGID_SEED_N_PHILOX, "seed-%-philox", CFG_INT, nullptr, "When cPhilox is selected as random number generator: seed for RNG number k, used instead of the seed set as the first key word. (Substitute k for '%' in the key.)");
+
+#define PHILOX_M0  0xD2511F53u
+#define PHILOX_M1  0xCD9E8D57u
+#define PHILOX_W0  0x9E3779B9u
+#define PHILOX_W1  0xBB67AE85u
+
+#define TWO_POW_MINUS_53  (1.0 / 9007199254740992.0)
+
+// number of blocks computed together in fillDoubles(); large enough that the
+// compiler vectorizes the loops instead of unrolling them completely
+#define BATCH  32
+
+void cPhilox::configure(int seedSet, int rngId, int numRngs,
+        int parsimProcId, int parsimNumPartitions,
+        cConfiguration *cfg)
+{
+    char key[32];
+    sprintf(key, "seed-%d-philox", rngId);
+    const char *value = cfg->getConfigValue(key);
+    uint32_t seed = value != nullptr ? (uint32_t)cfg->parseLong(value, nullptr) : (uint32_t)seedSet;
+
+    // the key selects the stream; partitions get disjoint parts of the counter space
+    setKey(seed, (uint32_t)rngId, parsimNumPartitions > 1 ? (uint32_t)parsimProcId : 0);
+}
+
+void cPhilox::setKey(uint32_t key0, uint32_t key1, uint32_t streamId)
+{
+    key[0] = key0;
+    key[1] = key1;
+    this->streamId = streamId;
+    position = 0;
+    bufferedBlockIndex = UINT64_MAX;
+}
+
+void cPhilox::philox4x32_10(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4])
+{
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+void cPhilox::generateBlock(uint64_t blockIndex, Block& out) const
+{
+    uint32_t counter[4] = { (uint32_t)blockIndex, (uint32_t)(blockIndex >> 32), 0, streamId };
+    philox4x32_10(counter, key, out);
+}
+
+void cPhilox::selfTest()
+{
+    // known-answer tests from the Random123 distribution (kat_vectors)
+    static const uint32_t kat[3][10] = {
+        // counter, key, expected output
+        { 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 },
+        { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd },
+        { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344, 0xa4093822, 0x299f31d0, 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 },
+    };
+    for (auto& v : kat) {
+        uint32_t out[4];
+        philox4x32_10(v, v+4, out);
+        if (out[0] != v[6] || out[1] != v[7] || out[2] != v[8] || out[3] != v[9])
+            throw cRuntimeError("cPhilox: selfTest() failed, please report this problem!");
+    }
+
+    // bulk generation and skipping must be consistent with one-by-one generation
+    const int n = 4*BATCH+3;
+    double singles[n], bulk[n];
+    setKey(1, 2, 3);
+    intRand();
+    intRand();
+    for (int i = 0; i < n; i++)
+        singles[i] = doubleRand();
+    setKey(1, 2, 3);
+    skip(2);
+    fillDoubles(bulk, n);
+    for (int i = 0; i < n; i++)
+        if (singles[i] != bulk[i])
+            throw cRuntimeError("cPhilox: selfTest() failed, please report this problem!");
+}
+
+uint32_t cPhilox::intRand()
+{
+    numDrawn++;
+    return nextWord();
+}
+
+uint32_t cPhilox::intRandMax()
+{
+    return 0xffffffffUL;  // 2^32-1
+}
+
+uint32_t cPhilox::intRand(uint32_t n)
+{
+    if (n == 0)
+        throw cRuntimeError("cPhilox: intRand(%u): Argument out of range 1..2^32-1", (unsigned)n);
+
+    numDrawn++;
+
+    // Find which bits are used in n
+    uint32_t used = n - 1;
+    used |= used >> 1;
+    used |= used >> 2;
+    used |= used >> 4;
+    used |= used >> 8;
+    used |= used >> 16;
+
+    // Draw numbers until one is found in [0,n)
+    uint32_t i;
+    do
+        i = nextWord() & used;  // toss unused bits to shorten search
+    while (i >= n);
+    return i;
+}
+
+double cPhilox::doubleRand()
+{
+    numDrawn++;
+    return nextRes53() * TWO_POW_MINUS_53;
+}
+
+double cPhilox::doubleRandNonz()
+{
+    numDrawn++;
+    return (nextRes53() + 0.5) * TWO_POW_MINUS_53;
+}
+
+double cPhilox::doubleRandIncl1()
+{
+    numDrawn++;
+    return nextRes53() * (1.0 / 9007199254740991.0);  // 1/(2^53-1)
+}
+
+void cPhilox::fillDoubles(double *dest, size_t n)
+{
+    numDrawn += n;
+
+    size_t i = 0;
+    if (position & 1) {
+        // odd position (after an intRand() call): pairs straddle blocks, no bulk path
+        for ( ; i < n; i++)
+            dest[i] = nextRes53() * TWO_POW_MINUS_53;
+        return;
+    }
+
+    // align to a block boundary
+    if ((position & 3) != 0 && i < n)
+        dest[i++] = nextRes53() * TWO_POW_MINUS_53;
+
+    // Compute BATCH blocks at a time, with the same operations as in
+    // philox4x32_10(). The counter words are kept in separate arrays,
+    // so that the inner loops can be vectorized by the compiler.
+    const uint32_t hiWord = streamId;
+    while (n - i >= 2*BATCH) {
+        uint64_t blockIndex = position >> 2;
+        uint32_t c0[BATCH], c1[BATCH], c2[BATCH], c3[BATCH];
+        for (int j = 0; j < BATCH; j++) {
+            c0[j] = (uint32_t)(blockIndex + j);
+            c1[j] = (uint32_t)((blockIndex + j) >> 32);
+            c2[j] = 0;
+            c3[j] = hiWord;
+        }
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; round++) {
+            for (int j = 0; j < BATCH; j++) {
+                uint64_t p0 = (uint64_t)PHILOX_M0 * c0[j];
+                uint64_t p1 = (uint64_t)PHILOX_M1 * c2[j];
+                uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1[j] ^ k0;
+                uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3[j] ^ k1;
+                c1[j] = (uint32_t)p1;
+                c3[j] = (uint32_t)p0;
+                c0[j] = n0;
+                c2[j] = n2;
+            }
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        double *d = dest + i;
+        for (int j = 0; j < BATCH; j++) {
+            d[2*j] = (double)(((uint64_t)(c0[j] >> 5) << 26) | (c1[j] >> 6)) * TWO_POW_MINUS_53;
+            d[2*j+1] = (double)(((uint64_t)(c2[j] >> 5) << 26) | (c3[j] >> 6)) * TWO_POW_MINUS_53;
+        }
+        i += 2*BATCH;
+        position += 4*BATCH;
+    }
+
+    // remainder
+    for ( ; i < n; i++)
+        dest[i] = nextRes53() * TWO_POW_MINUS_53;
+}
+
+void cPhilox::checkpoint(cCommBuffer *buffer) const
+{
+    buffer->pack(key, 2);
+    buffer->pack(streamId);
+    buffer->pack(position);
+    buffer->pack(numDrawn);
+}
+
+void cPhilox::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(key, 2);
+    buffer->unpack(streamId);
+    buffer->unpack(position);
+    buffer->unpack(numDrawn);
+    bufferedBlockIndex = UINT64_MAX;  // the buffered block is regenerated on demand
+}
+
+}  // namespace omnetpp
+
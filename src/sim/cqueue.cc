@@ -20,6 +20,7 @@
 #include <cstdio>
 #include <cstring>
 #include <sstream>
+#include <algorithm>
 #include "omnetpp/globals.h"
 #include "omnetpp/cqueue.h"
 #include "omnetpp/cexception.h"
@@ -75,8 +76,8 @@ std::string cQueue::str() const
 
 void cQueue::forEachChild(cVisitor *v)
 {
-    for (QElem *p = frontp; p != nullptr; p = p->next)
-        if (!v->visit(p->obj))
+    for (int i = 0; i < len; i++)
+        if (!v->visit(elemAt(i)))
             return;
 }
 
@@ -108,32 +109,34 @@ void cQueue::parsimUnpack(cCommBuffer *buffer)
 #else
     cOwnedObject::parsimUnpack(buffer);
 
-    buffer->unpack(len);
+    int n;
+    buffer->unpack(n);
 
     Comparator *oldCmp = comparator;
     comparator = nullptr;  // temporarily, so that insert() keeps the original order
-    for (int i = 0; i < len; i++) {
+    for (int i = 0; i < n; i++) {
         cObject *obj = buffer->unpackObject();
         insert(obj);
     }
     comparator = oldCmp;
+    sorted = isSorted();
 #endif
 }
 
 void cQueue::clear()
 {
-    while (frontp) {
-        QElem *tmp = frontp->next;
-        cObject *obj = frontp->obj;
+    while (len > 0) {
+        cObject *obj = elems[head++];
+        len--;
         if (!obj->isOwnedObject())
             delete obj;
         else if (obj->getOwner() == this)
             dropAndDelete(static_cast<cOwnedObject *>(obj));
-        delete frontp;
-        frontp = tmp;
     }
-    backp = nullptr;
-    len = 0;
+    delete[] elems;
+    elems = nullptr;
+    capacity = head = 0;
+    sorted = true;
 }
 
 void cQueue::copy(const cQueue& queue)
@@ -158,6 +161,7 @@ void cQueue::copy(const cQueue& queue)
     takeOwnership = queue.takeOwnership;
     if (queue.comparator)
         comparator = queue.comparator->dup();
+    sorted = queue.sorted;
 }
 
 cQueue& cQueue::operator=(const cQueue& queue)
@@ -174,6 +178,7 @@ void cQueue::setup(Comparator *cmp)
 {
     delete comparator;
     comparator = cmp;
+    sorted = isSorted();
 }
 
 void cQueue::setup(CompareFunc cmp)
@@ -181,58 +186,120 @@ void cQueue::setup(CompareFunc cmp)
     setup(cmp ? new FunctionBasedComparator(cmp) : nullptr);
 }
 
-cQueue::QElem *cQueue::find_qelem(cObject *obj) const
+void cQueue::reallocate(int newCapacity)
 {
-    QElem *p = frontp;
-    while (p && p->obj != obj)
-        p = p->next;
-    return p;
+    // also moves the contents to the middle, leaving free space at both ends
+    int newHead = (newCapacity - len) / 2;
+    if (newCapacity == capacity)
+        memmove(elems + newHead, elems + head, len * sizeof(cObject *));
+    else {
+        cObject **newElems = new cObject *[newCapacity];
+        if (len > 0)
+            memcpy(newElems + newHead, elems + head, len * sizeof(cObject *));
+        delete[] elems;
+        elems = newElems;
+        capacity = newCapacity;
+    }
+    head = newHead;
 }
 
-void cQueue::insbefore_qelem(QElem *p, cObject *obj)
+bool cQueue::isSorted() const
 {
-    QElem *e = new QElem;
-    e->obj = obj;
+    if (comparator)
+        for (int i = 1; i < len; i++)
+            if (comparator->less(elemAt(i), elemAt(i-1)))
+                return false;
+    return true;
+}
 
-    e->prev = p->prev;
-    e->next = p;
-    p->prev = e;
-    if (e->prev)
-        e->prev->next = e;
-    else
-        frontp = e;
-    len++;
+int cQueue::findInsertionPosition(cObject *obj) const
+{
+    // insert after the last element that obj is not less than, so that
+    // equal elements stay in insertion order
+    if (len == 0 || !comparator->less(obj, elemAt(len-1)))
+        return len;
+
+    if (!sorted) {
+        // contents were rearranged by insertBefore()/insertAfter() or setup(),
+        // so do what the linked list implementation did: scan from the back
+        int pos = len - 1;
+        while (pos > 0 && comparator->less(obj, elemAt(pos-1)))
+            pos--;
+        return pos;
+    }
+
+    // binary search for the first element that obj is less than
+    int lo = 0, hi = len - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (comparator->less(obj, elemAt(mid)))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return lo;
 }
 
-void cQueue::insafter_qelem(QElem *p, cObject *obj)
+void cQueue::checkOrderAt(int pos)
 {
-    QElem *e = new QElem;
-    e->obj = obj;
+    // insertBefore()/insertAfter() may put the element out of order
+    if (comparator && sorted) {
+        cObject *obj = elemAt(pos);
+        if ((pos > 0 && comparator->less(obj, elemAt(pos-1))) || (pos < len-1 && comparator->less(elemAt(pos+1), obj)))
+            sorted = false;
+    }
+}
 
-    e->next = p->next;
-    e->prev = p;
-    p->next = e;
-    if (e->next)
-        e->next->prev = e;
-    else
-        backp = e;
-    len++;
+int cQueue::findIndex(cObject *obj, int hint) const
+{
+    // try the hint and its neighbors first
+    for (int pos = std::max(hint - 1, 0); pos <= hint + 1 && pos < len; pos++)
+        if (elemAt(pos) == obj)
+            return pos;
+
+    // then linear search from the front
+    for (int pos = 0; pos < len; pos++)
+        if (elemAt(pos) == obj)
+            return pos;
+    return -1;
 }
 
-cObject *cQueue::remove_qelem(QElem *p)
+void cQueue::insertAt(int pos, cObject *obj)
 {
-    if (p->next)
-        p->next->prev = p->prev;
-    else
-        backp = p->prev;
-    if (p->prev)
-        p->prev->next = p->next;
-    else
-        frontp = p->next;
+    // move the elements on the shorter side of pos
+    bool towardsFront = pos < len - pos;
+    if (towardsFront ? head == 0 : head + len == capacity) {
+        // no free slot on that side: recenter, or grow if more than half full
+        reallocate(capacity == 0 ? 16 : len < capacity / 2 ? capacity : 2 * capacity);
+    }
+    if (towardsFront) {
+        memmove(elems + head - 1, elems + head, pos * sizeof(cObject *));
+        head--;
+    }
+    else {
+        memmove(elems + head + pos + 1, elems + head + pos, (len - pos) * sizeof(cObject *));
+    }
+    elems[head + pos] = obj;
+    len++;
+}
 
-    cObject *retobj = p->obj;
-    delete p;
+cObject *cQueue::removeAt(int pos)
+{
+    // close the gap from the shorter side
+    cObject *retobj = elems[head + pos];
+    if (pos < len - 1 - pos) {
+        memmove(elems + head + 1, elems + head, pos * sizeof(cObject *));
+        head++;
+    }
+    else {
+        memmove(elems + head + pos, elems + head + pos + 1, (len - 1 - pos) * sizeof(cObject *));
+    }
     len--;
+    if (len == 0)
+        sorted = true;
+    else if (capacity > 64 && len < capacity / 8)
+        reallocate(capacity / 2);
+
     if (retobj->isOwnedObject() && retobj->getOwner() == this)
         drop(static_cast<cOwnedObject *>(retobj));
     return retobj;
@@ -246,27 +313,7 @@ void cQueue::insert(cObject *obj)
     if (obj->isOwnedObject() && getTakeOwnership())
         take(static_cast<cOwnedObject *>(obj));
 
-    if (!backp) {
-        // insert as the only item
-        QElem *e = new QElem;
-        e->obj = obj;
-        e->next = e->prev = nullptr;
-        frontp = backp = e;
-        len = 1;
-    }
-    else if (comparator == nullptr) {
-        insafter_qelem(backp, obj);
-    }
-    else {
-        // priority queue: seek insertion place
-        QElem *p = backp;
-        while (p && comparator->less(obj, p->obj))
-            p = p->prev;
-        if (p)
-            insafter_qelem(p, obj);
-        else
-            insbefore_qelem(frontp, obj);
-    }
+    insertAt(comparator ? findInsertionPosition(obj) : len, obj);
 }
 
 void cQueue::insertBefore(cObject *where, cObject *obj)
@@ -274,13 +321,14 @@ void cQueue::insertBefore(cObject *where, cObject *obj)
     if (!obj)
         throw cRuntimeError(this, "Cannot insert nullptr");
 
-    QElem *p = find_qelem(where);
-    if (!p)
+    int pos = findIndex(where);
+    if (pos == -1)
         throw cRuntimeError(this, "insertBefore(w,o): Object w='%s' not in the queue", where->getName());
 
     if (obj->isOwnedObject() && getTakeOwnership())
         take(static_cast<cOwnedObject *>(obj));
-    insbefore_qelem(p, obj);
+    insertAt(pos, obj);
+    checkOrderAt(pos);
 }
 
 void cQueue::insertAfter(cObject *where, cObject *obj)
@@ -288,41 +336,42 @@ void cQueue::insertAfter(cObject *where, cObject *obj)
     if (!obj)
         throw cRuntimeError(this, "Cannot insert nullptr");
 
-    QElem *p = find_qelem(where);
-    if (!p)
+    int pos = findIndex(where);
+    if (pos == -1)
         throw cRuntimeError(this, "insertAfter(w,o): Object w='%s' not in the queue", where->getName());
 
     if (obj->isOwnedObject() && getTakeOwnership())
         take(static_cast<cOwnedObject *>(obj));
-    insafter_qelem(p, obj);
+    insertAt(pos + 1, obj);
+    checkOrderAt(pos + 1);
 }
 
 cObject *cQueue::front() const
 {
-    return frontp ? frontp->obj : nullptr;
+    return len > 0 ? elemAt(0) : nullptr;
 }
 
 cObject *cQueue::back() const
 {
-    return backp ? backp->obj : nullptr;
+    return len > 0 ? elemAt(len-1) : nullptr;
 }
 
 cObject *cQueue::remove(cObject *obj)
 {
     if (!obj)
         return nullptr;
-    QElem *p = find_qelem(obj);
-    if (!p)
+    int pos = findIndex(obj);
+    if (pos == -1)
         return nullptr;
-    return remove_qelem(p);
+    return removeAt(pos);
 }
 
 cObject *cQueue::pop()
 {
-    if (!frontp)
+    if (len == 0)
         throw cRuntimeError(this, "pop(): Queue empty");
 
-    return remove_qelem(frontp);
+    return removeAt(0);
 }
 
 int cQueue::getLength() const
@@ -332,16 +381,24 @@ int cQueue::getLength() const
 
 bool cQueue::contains(cObject *obj) const
 {
-    return find_qelem(obj) != nullptr;
+    return findIndex(obj) != -1;
 }
 
 cObject *cQueue::get(int i) const
 {
-    QElem *p = frontp;
-    while (p != nullptr && i > 0)
-        p = p->next, i--;
-    return p ? p->obj : nullptr;
+    return (i >= 0 && i < len) ? elemAt(i) : nullptr;
 }
 
-}  // namespace omnetpp
+//----
 
+void cQueue::Iterator::advance(int delta)
+{
+    // elements may have been inserted or removed since the last step,
+    // so find the current object before moving on
+    if (pos < 0 || pos >= q->len || q->elemAt(pos) != obj)
+        pos = q->findIndex(obj, pos);
+    pos = pos == -1 ? -1 : pos + delta;
+    obj = (pos >= 0 && pos < q->len) ? q->elemAt(pos) : nullptr;
+}
+
+}  // namespace omnetpp
@@ -0,0 +1,31 @@
+//==========================================================================
+//  CRNG.CC - part of
+//                 OMNeT++/OMNEST
+//              Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include "omnetpp/crng.h"
+#include "omnetpp/cexception.h"
+
+namespace omnetpp {
+
+void cRNG::checkpoint(cCommBuffer *buffer) const
+{
+    throw cRuntimeError("RNG class %s does not support checkpointing", getClassName());
+}
+
+void cRNG::restore(cCommBuffer *buffer)
+{
+    throw cRuntimeError("RNG class %s does not support checkpointing", getClassName());
+}
+
+}  // namespace omnetpp
+
@@ -23,13 +23,15 @@
 #include "omnetpp/globals.h"
 #include "omnetpp/cdynamicexpression.h"
 #include "omnetpp/chasher.h"
+#include "omnetpp/ccommbuffer.h"
+#include "omnetpp/opp_string.h"
 
 namespace omnetpp {
 
 Register_Class(cRngManager);
 
 Register_GlobalConfigOption(CFGID_NUM_RNGS, "num-rngs", CFG_INT, "1", "The number of random number generators.");
-Register_GlobalConfigOption(CFGID_RNG_CLASS, "rng-class", CFG_STRING, "omnetpp::cMersenneTwister", "The random number generator class to be used. It can be `cMersenneTwister`, `cLCG32`, `cAkaroaRNG`, or you can use your own RNG class (it must be subclassed from `cRNG`).");
+Register_GlobalConfigOption(CFGID_RNG_CLASS, "rng-class", CFG_STRING, "omnetpp::cMersenneTwister", "The random number generator class to be used. It can be `cMersenneTwister`, `cPhilox`, `cLCG32`, `cAkaroaRNG`, or you can use your own RNG class (it must be subclassed from `cRNG`).");
 Register_GlobalConfigOption(CFGID_SEED_SET, "seed-set", CFG_INT, "${runnumber}", "Selects the kth set of automatic random number seeds for the simulation. Meaningful values include `${repetition}` which is the repeat loop counter (see `repeat` option), and `${runnumber}`.");
 Register_PerObjectConfigOption(CFGID_RNG_K, "rng-%", KIND_COMPONENT, CFG_INT, "", "Maps a module-local RNG to one of the global RNGs. Example: `**.gen.rng-1=3` maps the local RNG 1 of modules matching `**.gen` to the global RNG 3. The value may be an expression, with the `index` and `ancestorIndex()` operators being potentially very useful. The default is one-to-one mapping, i.e. RNG k of all modules refer to the global RNG k (`for k=0..num-rngs-1`).\nUsage: `<module-full-path>.rng-<local-index>=<global-index>`. Examples: `**.mac.rng-0=1; **.source[*].rng-0=index`");
 
@@ -37,6 +39,21 @@ cIRngManager::~cIRngManager()
 {
 }
 
+void cIRngManager::reseed(cConfiguration *cfg)
+{
+    throw cRuntimeError(this, "Reseeding the RNGs is not supported");
+}
+
+void cIRngManager::checkpoint(cCommBuffer *buffer) const
+{
+    throw cRuntimeError(this, "Checkpointing the RNGs is not supported");
+}
+
+void cIRngManager::restore(cCommBuffer *buffer)
+{
+    throw cRuntimeError(this, "Checkpointing the RNGs is not supported");
+}
+
 cRngManager::~cRngManager()
 {
     for (int i = 0; i < numRNGs; i++)
@@ -47,6 +64,8 @@ cRngManager::~cRngManager()
 void cRngManager::configure(cSimulation *simulation, cConfiguration *cfg, int parsimProcId, int parsimNumPartitions)
 {
     this->cfg = cfg;
+    this->parsimProcId = parsimProcId;
+    this->parsimNumPartitions = parsimNumPartitions;
 
     // run RNG self-test on RNG class selected for this run
     std::string rngClass = cfg->getAsString(CFGID_RNG_CLASS);
@@ -68,6 +87,42 @@ void cRngManager::configure(cSimulation *simulation, cConfiguration *cfg, int pa
     }
 }
 
+void cRngManager::reseed(cConfiguration *cfg)
+{
+    this->cfg = cfg;
+
+    if (cfg->getAsInt(CFGID_NUM_RNGS) != numRNGs)
+        throw cRuntimeError(this, "Cannot reseed RNGs: The number of RNGs differs in the new configuration");
+
+    int seedset = cfg->getAsInt(CFGID_SEED_SET);
+    for (int i = 0; i < numRNGs; i++)
+        rngs[i]->configure(seedset, i, numRNGs, parsimProcId, parsimNumPartitions, cfg);
+}
+
+void cRngManager::checkpoint(cCommBuffer *buffer) const
+{
+    buffer->pack(numRNGs);
+    for (int i = 0; i < numRNGs; i++) {
+        buffer->pack(rngs[i]->getClassName());
+        rngs[i]->checkpoint(buffer);
+    }
+}
+
+void cRngManager::restore(cCommBuffer *buffer)
+{
+    int n;
+    buffer->unpack(n);
+    if (n != numRNGs)
+        throw cRuntimeError(this, "Cannot restore RNGs: The checkpoint contains %d RNGs instead of %d", n, numRNGs);
+    for (int i = 0; i < numRNGs; i++) {
+        opp_string className;
+        buffer->unpack(className);
+        if (strcmp(className.c_str(), rngs[i]->getClassName()) != 0)
+            throw cRuntimeError(this, "Cannot restore RNGs: RNG class mismatch, %s in the checkpoint vs. %s configured", className.c_str(), rngs[i]->getClassName());
+        rngs[i]->restore(buffer);
+    }
+}
+
 void cRngManager::configureRNGs(cComponent *component)
 {
     std::string componentFullPath = component->getFullPath();
@@ -36,6 +36,7 @@
 #include "omnetpp/cenvir.h"
 #include "omnetpp/cexception.h"
 #include "omnetpp/platdep/platmisc.h"  // for DEBUG_TRAP
+#include "profiler.h"
 
 using namespace omnetpp::common;
 
@@ -576,7 +577,14 @@ cMessage *cSimpleModule::cancelEvent(cMessage *msg)
         if (msg->getArrivalModuleId() != getId())
             throw cRuntimeError("cancelEvent(): Cannot cancel another module's self-message");
 
-        getSimulation()->getFES()->remove(msg);
+        internal::Profiler *profiler = getSimulation()->getProfiler();
+        if (profiler && profiler->isSampling()) {
+            internal::Profiler::ticks_t start = internal::Profiler::now();
+            getSimulation()->getFES()->remove(msg);
+            profiler->recordFesRemove(internal::Profiler::now() - start);
+        }
+        else
+            getSimulation()->getFES()->remove(msg);
         EVCB.messageCancelled(msg);
         msg->setPreviousEventNumber(getSimulation()->getEventNumber());
     }
@@ -25,12 +25,16 @@
 #include <climits>
 #include <algorithm> // copy_n()
 #include <mutex>
+#include <fstream>
+#include <set>
 #include "common/stringutil.h"
+#include "common/fileutil.h"
 #include "common/stlutil.h"
 #include "omnetpp/cmodule.h"
 #include "omnetpp/csimplemodule.h"
 #include "omnetpp/cpacket.h"
 #include "omnetpp/cchannel.h"
+#include "omnetpp/cdisplaystring.h"
 #include "omnetpp/csimulation.h"
 #include "omnetpp/cconfiguration.h"
 #include "omnetpp/cconfigoption.h"
@@ -46,6 +50,7 @@
 #include "omnetpp/ccontextswitcher.h"
 #include "omnetpp/cstatistic.h"
 #include "omnetpp/cexception.h"
+#include "omnetpp/checkandcast.h"
 #include "omnetpp/cparimpl.h"
 #include "omnetpp/cfingerprint.h"
 #include "omnetpp/cconfiguration.h"
@@ -53,11 +58,16 @@
 #include "omnetpp/cinedloader.h"
 #include "omnetpp/clifecyclelistener.h"
 #include "omnetpp/crngmanager.h"
+#include "omnetpp/distrib.h"
 #include "omnetpp/cstatisticbuilder.h"
+#include "omnetpp/cresultfilter.h"
 #include "omnetpp/clog.h"
 #include "omnetpp/platdep/platmisc.h"  // for DEBUG_TRAP
 #include "sim/netbuilder/cnedloader.h"
 #include "stopwatch.h"
+#include "modulepathcache.h"
+#include "profiler.h"
+#include "streamcommbuffer.h"
 
 #ifdef WITH_PARSIM
 #include "omnetpp/ccommbuffer.h"
@@ -70,10 +80,6 @@
 #include "pythonutil.h"
 #endif
 
-#ifdef DEVELOPER_DEBUG
-#include <set>
-#endif
-
 using namespace omnetpp::common;
 using namespace omnetpp::internal;
 
@@ -92,7 +98,7 @@ Register_GlobalConfigOption(CFGID_PARALLEL_SIMULATION, "parallel-simulation", CF
 Register_GlobalConfigOption(CFGID_FUTUREEVENTSET_CLASS, "futureeventset-class", CFG_STRING, "omnetpp::cEventHeap", "Part of the Envir plugin mechanism: selects the class for storing the future events in the simulation. The class has to implement the `cFutureEventSet` interface.");
 Register_GlobalConfigOption(CFGID_SCHEDULER_CLASS, "scheduler-class", CFG_STRING, "omnetpp::cSequentialScheduler", "Part of the Envir plugin mechanism: selects the scheduler class. This plugin interface allows for implementing real-time, hardware-in-the-loop, distributed and distributed parallel simulation. The class has to implement the `cScheduler` interface.");
 Register_GlobalConfigOption(CFGID_FINGERPRINT, "fingerprint", CFG_STRING, nullptr, "The expected fingerprints of the simulation. If you need multiple fingerprints, separate them with commas. When provided, the fingerprints will be calculated from the specified properties of simulation events, messages, and statistics during execution, and checked against the provided values. Fingerprints are suitable for crude regression tests. As fingerprints occasionally differ across platforms, more than one value can be specified for a single fingerprint, separated by spaces, and a match with any of them will be accepted. To obtain a fingerprint, enter a dummy value (such as `0000`), and run the simulation.");
-Register_GlobalConfigOption(CFGID_FINGERPRINTER_CLASS, "fingerprintcalculator-class", CFG_STRING, "omnetpp::cSingleFingerprintCalculator", "Part of the Envir plugin mechanism: selects the fingerprint calculator class to be used to calculate the simulation fingerprint. The class has to implement the `cFingerprintCalculator` interface.");
+Register_GlobalConfigOption(CFGID_FINGERPRINTER_CLASS, "fingerprintcalculator-class", CFG_STRING, "omnetpp::cSingleFingerprintCalculator", "Part of the Envir plugin mechanism: selects the fingerprint calculator class to be used to calculate the simulation fingerprint. The class has to implement the `cFingerprintCalculator` interface. Built-in choices are `omnetpp::cSingleFingerprintCalculator` (32-bit fingerprints) and `omnetpp::cFastFingerprintCalculator` (64-bit fingerprints).");
 Register_GlobalConfigOption(CFGID_RNGMANAGER_CLASS, "rngmanager-class", CFG_STRING, "omnetpp::cRngManager", "Part of the Envir plugin mechanism: selects the RNG manager class to be used for providing RNGs to modules and channels. The class has to implement the `cIRngManager` interface.");
 Register_GlobalConfigOptionU(CFGID_SIM_TIME_LIMIT, "sim-time-limit", "s", nullptr, "Stops the simulation when simulation time reaches the given limit. The default is no limit.");
 Register_GlobalConfigOptionU(CFGID_CPU_TIME_LIMIT, "cpu-time-limit", "s", nullptr, "Stops the simulation when CPU usage has reached the given limit. The default is no limit. Note: To reduce per-event overhead, this time limit is only checked every N events (by default, N=1024).");
@@ -100,9 +106,16 @@ Register_GlobalConfigOptionU(CFGID_REAL_TIME_LIMIT, "real-time-limit", "s", null
 Register_GlobalConfigOptionU(CFGID_WARMUP_PERIOD, "warmup-period", "s", nullptr, "Length of the initial warm-up period. When set, results belonging to the first x seconds of the simulation will not be recorded into output vectors, and will not be counted into output scalars (see option `**.result-recording-modes`). This option is useful for steady-state simulations. The default is 0s (no warmup period). Note that models that compute and record scalar results manually (via `recordScalar()`) will not automatically obey this setting.");
 Register_GlobalConfigOption(CFGID_CHECK_SIGNALS, "check-signals", CFG_BOOL, CHECKSIGNALS_DEFAULT, "Controls whether the simulation kernel will validate signals emitted by modules and channels against signal declarations (`@signal` properties) in NED files. The default setting depends on the build type: `true` in DEBUG, and `false` in RELEASE mode.");
 Register_GlobalConfigOption(CFGID_PARAMETER_MUTABILITY_CHECK, "parameter-mutability-check", CFG_BOOL, "true", "Setting to false will disable errors raised when trying to change the values of module/channel parameters not marked as @mutable. This is primarily a compatibility setting intended to facilitate running simulation models that were not yet annotated with @mutable.");
+Register_GlobalConfigOption(CFGID_DISTRIBUTION_ALGORITHMS, "distribution-algorithms", CFG_STRING, "classic", "Selects the algorithms used for generating random variates. `classic`: the variate streams of earlier OMNeT++ versions; `fast`: ziggurat method for normal, exponential and the distributions built on them (e.g. gamma, lognormal), and PTRS for poisson with lambda>=10. The two settings produce different variate streams from the same random numbers.");
 Register_GlobalConfigOption(CFGID_ALLOW_OBJECT_STEALING_ON_DELETION, "allow-object-stealing-on-deletion", CFG_BOOL, "false", "Setting it to true disables the \"Context component is deleting an object it doesn't own\" error message. This option exists primarily for backward compatibility with pre-6.0 versions that were more permissive during object deletion.");
 Register_GlobalConfigOption(CFGID_DEBUG_STATISTICS_RECORDING, "debug-statistics-recording", CFG_BOOL, "false", "Turns on the printing of debugging information related to statistics recording (`@statistic` properties)");
 Register_GlobalConfigOption(CFGID_PRINT_UNUSED_CONFIG, "print-unused-config", CFG_BOOL, "true", "Enables listing of unused configuration entries after network setup. Note that the reported entries are not necessarily redundant, e.g. they may be needed by modules created dynamically during simulation. It tries to be smart about which entries to report, e.g. entries overridden from a derived section, likely intentionally, are not reported.");
+Register_GlobalConfigOption(CFGID_PROFILING, "profiling", CFG_BOOL, "false", "Turns on the built-in profiler, which measures the wall-clock time spent in events per module, module type, message class and message kind, in signal listeners and result recording, and in future event set operations. The results are written into the file given with `profiling-file` at the end of the run, in the output scalar file format.");
+Register_GlobalConfigOption(CFGID_PROFILING_FILE, "profiling-file", CFG_FILENAME, "${resultdir}/${configname}-${iterationvarsf}#${repetition}.prof.sca", "Name of the output file of the profiler (see `profiling`). The file is in the output scalar file format, with the same run ID as the other result files of the run.");
+Register_GlobalConfigOption(CFGID_PROFILING_SAMPLING_INTERVAL, "profiling-sampling-interval", CFG_INT, "1", "When profiling is enabled (see `profiling`), only every Nth event is measured on average, and the results are extrapolated to all events. Raise it to reduce the overhead of profiling.");
+Register_GlobalConfigOptionU(CFGID_CHECKPOINT_AT, "checkpoint-at", "s", nullptr, "Writes a checkpoint of the simulation state at the given simulation time, before the events scheduled for that time are processed. The checkpoint can be used to resume the simulation from that point later (see `restore-checkpoint`). Modules and channels must implement the `checkpoint()` and `restore()` methods to save and restore their state. The default is not to write a checkpoint.");
+Register_GlobalConfigOption(CFGID_CHECKPOINT_FILE, "checkpoint-file", CFG_FILENAME, "${resultdir}/${configname}-${iterationvarsf}#${repetition}.ckpt", "Name of the checkpoint file written at the time given with `checkpoint-at`.");
+Register_GlobalConfigOption(CFGID_RESTORE_CHECKPOINT, "restore-checkpoint", CFG_FILENAME, nullptr, "Name of a checkpoint file (see `checkpoint-at`) to resume the simulation from, instead of initializing the network. The checkpoint must have been written with the same network and model code. Configuration options that affect the state of the simulation only at initialization time are ignored, while e.g. the simulation time limit is observed.");
 Register_GlobalConfigOption(CFGID_PRINT_UNUSED_CONFIG_ON_COMPLETION, "print-unused-config-on-completion", CFG_BOOL, "false", "Enables listing of unused configuration entries after the simulation has successfully completed. It tries to be smart about which entries to report, e.g. entries overridden from a derived section, likely intentionally, are not reported.");
 
 
@@ -133,6 +146,30 @@ class SIM_API cEndSimulationEvent : public cEvent, public noncopyable
     virtual void execute() override { delete this; throw cTerminationException(E_SIMTIME); }
 };
 
+/**
+ * Writes a checkpoint of the simulation at the time it is scheduled for,
+ * before the other events at that time. Used internally by cSimulation.
+ */
+class SIM_API cCheckpointEvent : public cEvent, public noncopyable
+{
+  private:
+    std::string fileName;
+
+  public:
+    cCheckpointEvent(const char *name, simtime_t t, const char *fileName) : cEvent(name), fileName(fileName) {
+        setArrivalTime(t);
+        setSchedulingPriority(SHRT_MIN);  // highest priority
+    }
+    virtual cEvent *dup() const override { copyNotSupported(); return nullptr; }
+    virtual cObject *getTargetObject() const override { return nullptr; }
+    virtual void execute() override {
+        cSimulation *simulation = cSimulation::getActiveSimulation();  // no owner after removal from the FES
+        std::string tmp = fileName;
+        delete this;  // must not be in the checkpoint
+        simulation->writeCheckpoint(tmp.c_str());
+    }
+};
+
 cSimulation::cSimulation(const char *name, cEnvir *env, cINedLoader *loader) : cNamedObject(name, false)
 {
     // sanity checks regarding library setup
@@ -158,6 +195,7 @@ cSimulation::cSimulation(const char *name, cEnvir *env, cINedLoader *loader) : c
     envir->setSimulation(this);
 
     stopwatch = new Stopwatch;
+    modulePathCache = new ModulePathCache;
 
     sharedCounters.resize(MAX_NUM_COUNTERS, CTR_UNINITIALIZED);
 
@@ -208,6 +246,8 @@ cSimulation::~cSimulation()
         setActiveSimulation(nullptr);
 
     delete stopwatch;
+    delete modulePathCache;
+    delete profiler;
 
     delete envir;  // after setActiveSimulation(nullptr), due to objectDeleted() callbacks
 
@@ -354,9 +394,26 @@ void cSimulation::configure(cConfiguration *cfg)
     bool checkParamMutability = cfg->getAsBool(CFGID_PARAMETER_MUTABILITY_CHECK);
     setParameterMutabilityCheck(checkParamMutability);
 
+    delete profiler;
+    profiler = nullptr;
+    if (cfg->getAsBool(CFGID_PROFILING))
+        profiler = new Profiler(cfg->getAsInt(CFGID_PROFILING_SAMPLING_INTERVAL), cfg->getAsFilename(CFGID_PROFILING_FILE).c_str());
+
+    checkpointTime = cfg->getAsDouble(CFGID_CHECKPOINT_AT, -1);
+    checkpointFile = cfg->getAsFilename(CFGID_CHECKPOINT_FILE);
+    restoreCheckpointFile = cfg->getAsFilename(CFGID_RESTORE_CHECKPOINT);
+
     bool allowObjectStealing = cfg->getAsBool(CFGID_ALLOW_OBJECT_STEALING_ON_DELETION);
     cSoftOwner::setAllowObjectStealing(allowObjectStealing);
 
+    std::string distributionAlgorithms = cfg->getAsString(CFGID_DISTRIBUTION_ALGORITHMS);
+    if (distributionAlgorithms == "classic")
+        setDistributionAlgorithms(DISTRIB_ALGORITHMS_CLASSIC);
+    else if (distributionAlgorithms == "fast")
+        setDistributionAlgorithms(DISTRIB_ALGORITHMS_FAST);
+    else
+        throw cRuntimeError("Invalid value '%s' for configuration option '%s': 'classic' or 'fast' expected", distributionAlgorithms.c_str(), CFGID_DISTRIBUTION_ALGORITHMS->getName());
+
     rngManager->configure(this, cfg, getParsimProcId(), getParsimNumPartitions());
 
     // note: this must come last, as e.g. result manager initializations call cSimulation::isParsimEnabled()
@@ -571,6 +628,7 @@ void cSimulation::deregisterComponent(cComponent *component)
     component->simulation = nullptr;
     component->componentId = -1;
     componentv[id] = nullptr;
+    invalidateModulePathCache();  // not only for modules: isModule() cannot be called from the cComponent destructor
 
     if (component == systemModule) {
         cOwningContextSwitcher tmp(&globalOwningContext);
@@ -590,6 +648,27 @@ void cSimulation::setSystemModule(cModule *module)
 
     systemModule = module;
     take(module);
+    invalidateModulePathCache();
+}
+
+void cSimulation::invalidateModulePathCache()
+{
+    modulePathCache->clear();
+}
+
+void cSimulation::addPendingDisplayStringChange(cComponent *component)
+{
+    pendingDisplayStringChanges.push_back(component->getId());
+}
+
+void cSimulation::doFlushPendingDisplayStringChanges()
+{
+    // IDs are stored instead of pointers because components may be deleted
+    // in the meantime; notifications may cause further changes, so iterate by index
+    for (size_t i = 0; i < pendingDisplayStringChanges.size(); i++)
+        if (cComponent *component = getComponent(pendingDisplayStringChanges[i]))
+            component->getDisplayString().notifyPendingChange();
+    pendingDisplayStringChanges.clear();
 }
 
 const char *cSimulation::getStateName(State state)
@@ -723,6 +802,7 @@ void cSimulation::setupNetwork(cModuleType *networkType, cConfiguration *cfg)
         ASSERT(systemModule == module);
         module->finalizeParameters();
         module->buildInside();
+        flushPendingDisplayStringChanges();
         scheduleEndSimulationEvent();
         gotoState(SIM_NETWORKBUILT);
         notifyLifecycleListeners(LF_POST_NETWORK_SETUP);
@@ -753,6 +833,11 @@ void cSimulation::callInitialize()
         throw cRuntimeError("callInitialize(): A newly set up network is expected");
     ASSERT(systemModule != nullptr);
 
+    if (!restoreCheckpointFile.empty()) {
+        restoreCheckpoint(restoreCheckpointFile.c_str());
+        return;
+    }
+
     // reset counters. Note fes->clear() was already called from setupNetwork()
     currentSimtime = 0;
     currentEventNumber = 0;  // initialize() has event number 0
@@ -774,6 +859,9 @@ void cSimulation::callInitialize()
         systemModule->scheduleStart(SIMTIME_ZERO);
         notifyLifecycleListeners(LF_PRE_NETWORK_INITIALIZE);
         systemModule->callInitialize();
+        if (!checkpointFile.empty() && checkpointTime >= SIMTIME_ZERO)
+            fes->insert(new cCheckpointEvent("checkpoint", checkpointTime, checkpointFile.c_str()));
+        flushPendingDisplayStringChanges();
         cLogProxy::flushLastLine();
         gotoState(SIM_INITIALIZED);
         notifyLifecycleListeners(LF_POST_NETWORK_INITIALIZE);
@@ -812,11 +900,14 @@ void cSimulation::callFinish()
     try {
         notifyLifecycleListeners(LF_PRE_NETWORK_FINISH);
         systemModule->callFinish();
+        flushPendingDisplayStringChanges();
         cLogProxy::flushLastLine();
         gotoState(SIM_FINISHCALLED);
         notifyLifecycleListeners(LF_POST_NETWORK_FINISH);
         onRunEndFired = true;
         notifyLifecycleListeners(LF_ON_RUN_END);
+        if (profiler)
+            profiler->writeReport(this);
     }
     catch (std::exception& e) {
         cLogProxy::flushLastLine();
@@ -831,6 +922,288 @@ void cSimulation::callFinish()
     checkFingerprint();
 }
 
+void cSimulation::switchToRun(cConfiguration *cfg)
+{
+    // Continue the current run as another one that only differs from it in
+    // the RNG seeds, e.g. in a process forked at the end of the warm-up period.
+    // Settings that are the same in both runs are left alone.
+    this->cfg = cfg;
+    rngManager->reseed(cfg);
+
+    if (profiler) {
+        delete profiler;
+        profiler = new Profiler(cfg->getAsInt(CFGID_PROFILING_SAMPLING_INTERVAL), cfg->getAsFilename(CFGID_PROFILING_FILE).c_str(), currentEventNumber);
+    }
+}
+
+#ifdef WITH_PARSIM
+static const char *CHECKPOINT_MAGIC = "OMNeT++ simulation checkpoint";
+static const int CHECKPOINT_VERSION = 1;
+static const int CHECKPOINT_SENTINEL = 0x0c4ec4;
+
+static void collectResultListeners(cResultListener *listener, std::vector<cResultListener *>& result, std::set<cResultListener *>& visited)
+{
+    if (!visited.insert(listener).second)
+        return;
+    result.push_back(listener);
+    if (cResultFilter *filter = dynamic_cast<cResultFilter *>(listener))
+        for (int i = 0; i < filter->getNumDelegates(); i++)
+            collectResultListeners(filter->getDelegate(i), result, visited);
+}
+
+// result filters and recorders of the component, in a well-defined order
+static std::vector<cResultListener *> collectResultListeners(cComponent *component)
+{
+    std::vector<cResultListener *> result;
+    std::set<cResultListener *> visited;
+    for (simsignal_t signalID : component->getLocalListenedSignals())
+        for (cIListener *listener : component->getLocalSignalListeners(signalID))
+            if (cResultListener *resultListener = dynamic_cast<cResultListener *>(listener))
+                collectResultListeners(resultListener, result, visited);
+    return result;
+}
+#endif
+
+void cSimulation::writeCheckpoint(const char *fileName)
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError("Cannot write checkpoint: Checkpointing relies on object serialization which is only available with parallel simulation support (WITH_PARSIM=yes)");
+#else
+    checkActive();
+    if (state != SIM_INITIALIZED && state != SIM_RUNNING && state != SIM_PAUSED)
+        throw cRuntimeError("writeCheckpoint(): No initialized network, or simulation already terminated");
+    if (contextComponent != nullptr)
+        throw cRuntimeError("writeCheckpoint(): Cannot be called during an event or from a module or channel");
+    if (parsim)
+        throw cRuntimeError("writeCheckpoint(): Checkpointing is not supported with parallel simulation");
+
+    // collect messages in the FES, in the order they would be processed
+    std::vector<cMessage *> messages;
+    for (int i = 0; i < fes->getLength(); i++) {
+        cEvent *event = fes->get(i);
+        if (event == endSimulationEvent)
+            continue;  // re-created from the configuration on restore
+        if (!event->isMessage())
+            throw cRuntimeError("Cannot write checkpoint: The future event set contains an event of class %s, only messages are supported", event->getClassName());
+        messages.push_back(static_cast<cMessage *>(event));
+    }
+    std::sort(messages.begin(), messages.end(), [](cMessage *a, cMessage *b) {return a->shouldPrecede(b);});
+
+    mkPath(directoryOf(fileName).c_str());
+    std::ofstream out(fileName, std::ios::binary);
+    if (!out)
+        throw cRuntimeError("Cannot open checkpoint file '%s' for write", fileName);
+    StreamCommBuffer buffer(&out);
+
+    try {
+        // header: identifies the network, down to the component IDs
+        buffer.pack(CHECKPOINT_MAGIC);
+        buffer.pack(CHECKPOINT_VERSION);
+        buffer.pack(SimTime::getScaleExp());
+        buffer.pack(getNetworkType()->getFullName());
+        buffer.pack(lastComponentId);
+        for (int i = 1; i <= lastComponentId; i++) {
+            cComponent *component = componentv[i];
+            cSimpleModule *simpleModule = dynamic_cast<cSimpleModule *>(component);
+            if (simpleModule && simpleModule->usesActivity())
+                throw cRuntimeError("Cannot write checkpoint: Module %s uses activity(), which cannot be checkpointed", simpleModule->getFullPath().c_str());
+            buffer.pack(component ? component->getFullPath().c_str() : "");
+        }
+
+        // simulation-wide state
+        buffer.pack(currentSimtime);
+        buffer.pack(currentEventNumber);
+        buffer.pack(cMessage::getNextMessageId());
+        buffer.pack(nextUniqueNumber);
+        rngManager->checkpoint(&buffer);
+
+        // future events; message IDs are not part of parsimPack()
+        buffer.pack((int)messages.size());
+        for (cMessage *msg : messages) {
+            buffer.packObject(msg);
+            buffer.pack(msg->getId());
+            buffer.pack(msg->getTreeId());
+        }
+
+        // components and their result recorders
+        for (int i = 1; i <= lastComponentId; i++) {
+            cComponent *component = componentv[i];
+            if (!component)
+                continue;
+            {
+                cContextSwitcher tmp(component);
+                component->checkpoint(&buffer);
+            }
+            buffer.pack(CHECKPOINT_SENTINEL);
+
+            std::vector<cResultListener *> resultListeners = collectResultListeners(component);
+            buffer.pack((int)resultListeners.size());
+            for (cResultListener *listener : resultListeners) {
+                buffer.pack(listener->getClassName());
+                listener->checkpoint(&buffer);
+            }
+        }
+        buffer.pack(CHECKPOINT_SENTINEL);
+
+        out.close();
+        if (!out)
+            throw cRuntimeError("Cannot write checkpoint file '%s'", fileName);
+    }
+    catch (std::exception&) {
+        // don't leave a truncated checkpoint behind
+        out.close();
+        removeFile(fileName, "incomplete checkpoint file");
+        throw;
+    }
+#endif
+}
+
+void cSimulation::restoreCheckpoint(const char *fileName)
+{
+#ifndef WITH_PARSIM
+    throw cRuntimeError("Cannot restore checkpoint: Checkpointing relies on object serialization which is only available with parallel simulation support (WITH_PARSIM=yes)");
+#else
+    checkActive();
+
+    if (state != SIM_NETWORKBUILT)
+        throw cRuntimeError("restoreCheckpoint(): A newly set up network is expected");
+    ASSERT(systemModule != nullptr);
+    if (parsim)
+        throw cRuntimeError("restoreCheckpoint(): Checkpointing is not supported with parallel simulation");
+
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in)
+        throw cRuntimeError("Cannot open checkpoint file '%s'", fileName);
+    StreamCommBuffer buffer(&in);
+
+    trapOnNextEvent = false;
+    cMessage::resetMessageCounters();
+
+    cLog::setLoggingEnabled(!envir->isExpressMode());
+
+    StageSwitcher _(this, STAGE_INITIALIZE);
+
+    std::map<msgid_t,cMessage*> messages;
+    try {
+        cContextSwitcher tmp(systemModule);
+
+        // verify header
+        opp_string magic, networkName;
+        int version, scaleExp, numComponents;
+        buffer.unpack(magic);
+        if (strcmp(magic.c_str(), CHECKPOINT_MAGIC) != 0)
+            throw cRuntimeError("'%s' is not a simulation checkpoint file", fileName);
+        buffer.unpack(version);
+        if (version != CHECKPOINT_VERSION)
+            throw cRuntimeError("Checkpoint file '%s' has unsupported version %d", fileName, version);
+        buffer.unpack(scaleExp);
+        if (scaleExp != SimTime::getScaleExp())
+            throw cRuntimeError("Checkpoint file '%s' was written with a different simulation time precision (simtime-resolution)", fileName);
+        buffer.unpack(networkName);
+        if (strcmp(networkName.c_str(), getNetworkType()->getFullName()) != 0)
+            throw cRuntimeError("Checkpoint file '%s' was written for a different network, %s", fileName, networkName.c_str());
+        buffer.unpack(numComponents);
+        if (numComponents != lastComponentId)
+            throw cRuntimeError("Checkpoint file '%s' does not match the network: Different number of modules and channels", fileName);
+        for (int i = 1; i <= lastComponentId; i++) {
+            opp_string path;
+            buffer.unpack(path);
+            std::string actualPath = componentv[i] ? componentv[i]->getFullPath() : "";
+            if (actualPath != path.c_str())
+                throw cRuntimeError("Checkpoint file '%s' does not match the network: Component ID %d is '%s' in the checkpoint, and '%s' in the network",
+                        fileName, i, path.c_str(), actualPath.c_str());
+        }
+
+        // simulation-wide state
+        msgid_t nextMessageId;
+        buffer.unpack(currentSimtime);
+        buffer.unpack(currentEventNumber);
+        buffer.unpack(nextMessageId);
+        buffer.unpack(nextUniqueNumber);
+        rngManager->restore(&buffer);
+
+        if (simTimeLimit != SIMTIME_ZERO && simTimeLimit < currentSimtime)
+            throw cRuntimeError("Simulation time limit %ss has already passed at the time of the checkpoint, %ss", simTimeLimit.str().c_str(), currentSimtime.str().c_str());
+
+        notifyLifecycleListeners(LF_PRE_NETWORK_INITIALIZE);
+
+        // future events
+        int numMessages;
+        buffer.unpack(numMessages);
+        for (int i = 0; i < numMessages; i++) {
+            cMessage *msg = check_and_cast<cMessage *>(buffer.unpackObject());
+            msgid_t id, treeId;
+            buffer.unpack(id);
+            buffer.unpack(treeId);
+            msg->setIds(id, treeId);
+            fes->insert(msg);
+            messages[id] = msg;
+        }
+        cMessage::setNextMessageId(std::max(cMessage::getNextMessageId(), nextMessageId));
+
+        // components and their result recorders; restore() replaces initialize()
+        restoredMessages = &messages;
+        for (int i = 1; i <= lastComponentId; i++) {
+            cComponent *component = componentv[i];
+            if (!component)
+                continue;
+            {
+                cContextSwitcher tmp(component);
+                component->restore(&buffer);
+            }
+            component->lastCompletedInitStage = component->numInitStages() - 1;
+            component->setFlag(cComponent::FL_INITIALIZED, true);
+
+            int sentinel;
+            buffer.unpack(sentinel);
+            if (sentinel != CHECKPOINT_SENTINEL)
+                throw cRuntimeError("Error restoring checkpoint from '%s': restore() of %s did not read back what checkpoint() wrote", fileName, component->getFullPath().c_str());
+
+            std::vector<cResultListener *> resultListeners = collectResultListeners(component);
+            int numResultListeners;
+            buffer.unpack(numResultListeners);
+            if (numResultListeners != (int)resultListeners.size())
+                throw cRuntimeError("Checkpoint file '%s' does not match the network: Different result recording setup for %s", fileName, component->getFullPath().c_str());
+            for (cResultListener *listener : resultListeners) {
+                opp_string className;
+                buffer.unpack(className);
+                if (strcmp(className.c_str(), listener->getClassName()) != 0)
+                    throw cRuntimeError("Checkpoint file '%s' does not match the network: Different result recording setup for %s", fileName, component->getFullPath().c_str());
+                listener->restore(&buffer);
+            }
+        }
+        restoredMessages = nullptr;
+
+        int sentinel;
+        buffer.unpack(sentinel);
+        if (sentinel != CHECKPOINT_SENTINEL || !buffer.isBufferEmpty())
+            throw cRuntimeError("Error restoring checkpoint from '%s': Unexpected data at the end of the file", fileName);
+
+        if (!checkpointFile.empty() && checkpointTime > currentSimtime)
+            fes->insert(new cCheckpointEvent("checkpoint", checkpointTime, checkpointFile.c_str()));
+
+        flushPendingDisplayStringChanges();
+        cLogProxy::flushLastLine();
+        gotoState(SIM_INITIALIZED);
+        notifyLifecycleListeners(LF_POST_NETWORK_INITIALIZE);
+    }
+    catch (std::exception& e) {
+        restoredMessages = nullptr;
+        cLogProxy::flushLastLine();
+        gotoState(SIM_ERROR);
+        notifyLifecycleListenersOnErrorThenRethrow(e);
+    }
+#endif
+}
+
+cMessage *cSimulation::getRestoredMessage(msgid_t id) const
+{
+    if (!restoredMessages)
+        throw cRuntimeError(this, "getRestoredMessage(): Can only be called while restoring a checkpoint");
+    auto it = restoredMessages->find(id);
+    return it == restoredMessages->end() ? nullptr : it->second;
+}
+
 void cSimulation::printUnusedConfigEntriesIfAny(std::ostream& out)
 {
     bool postsimulation = (getState() == SIM_FINISHCALLED);
@@ -890,6 +1263,8 @@ void cSimulation::deleteNetwork()
         if (!onRunEndFired) {
             onRunEndFired = true;
             notifyLifecycleListeners(LF_ON_RUN_END);
+            if (profiler)
+                profiler->writeReport(this);
         }
 
         StageSwitcher _(this, STAGE_CLEANUP);
@@ -917,6 +1292,7 @@ void cSimulation::deleteNetwork()
         sharedCounters.resize(MAX_NUM_COUNTERS, CTR_UNINITIALIZED);
 
         // and clean up
+        pendingDisplayStringChanges.clear();  // component IDs will be reused
         delete[] componentv;
         componentv = nullptr;
         size = 0;
@@ -936,6 +1312,8 @@ void cSimulation::deleteNetwork()
         endSimulationEvent = nullptr;
 
         stopwatch->clear();
+        if (profiler)
+            profiler->clear();
     }
     catch (std::exception& e) {
         gotoState(SIM_ERROR);
@@ -957,7 +1335,11 @@ cEvent *cSimulation::takeNextEvent()
 {
     // determine next event. Normally (with sequential simulation),
     // the scheduler just returns fes->peekFirst().
+    bool profiling = profiler && profiler->startSample();
+    Profiler::ticks_t start = profiling ? Profiler::now() : 0;
     cEvent *event = scheduler->takeNextEvent();
+    if (profiling)
+        profiler->recordTakeNextEvent(Profiler::now() - start);
     if (!event)
         return nullptr;
 
@@ -1052,7 +1434,29 @@ void cSimulation::transferTo(cSimpleModule *module)
 #define DEBUG_TRAP_IF_REQUESTED    { if (trapOnNextEvent) { trapOnNextEvent = false; if (getEnvir()->ensureDebugger()) DEBUG_TRAP; } }
 #endif
 
+// Policy classes for cSimulation::doExecuteEvent(): whether the per-event
+// hooks (envir notification, fingerprint, profiler, debug trap) are compiled in
+struct cSimulation::FullEventHooks {
+    static constexpr bool enabled = true;
+};
+
+struct cSimulation::NoEventHooks {
+    static constexpr bool enabled = false;
+};
+
 void cSimulation::executeEvent(cEvent *event)
+{
+    doExecuteEvent<FullEventHooks>(event);
+}
+
+void cSimulation::executeEventLean(cEvent *event)
+{
+    ASSERT(canExecuteEventLean());
+    doExecuteEvent<NoEventHooks>(event);
+}
+
+template <class Hooks>
+void cSimulation::doExecuteEvent(cEvent *event)
 {
     ASSERT(state == SIM_RUNNING);  // must be called from run()
 
@@ -1062,43 +1466,59 @@ void cSimulation::executeEvent(cEvent *event)
     // advance simulation time
     currentSimtime = event->getArrivalTime();
 
-    // notify the environment about the event (writes eventlog, etc.)
-    EVCB.simulationEvent(event);
+    if (Hooks::enabled) {
+        // notify the environment about the event (writes eventlog, etc.)
+        EVCB.simulationEvent(event);
+    }
 
     // store arrival event number of this message; it is useful input for the
     // sequence chart tool if the message doesn't get immediately deleted or
     // sent out again
     event->setPreviousEventNumber(currentEventNumber);
 
-    // ignore fingerprint of plain events, as they tend to be internal (like cEndSimulationEvent)
-    if (fingerprint && event->isMessage())
-        fingerprint->addEvent(event);
+    Profiler *eventProfiler = nullptr;
+
+    if (Hooks::enabled) {
+        // ignore fingerprint of plain events, as they tend to be internal (like cEndSimulationEvent)
+        if (fingerprint && event->isMessage())
+            fingerprint->addEvent(event);
 
 #ifndef NDEBUG
-    if (trapOnNextEvent && !event->isMessage())
-        DEBUG_TRAP_IF_REQUESTED;  // ABOUT TO PROCESS THE EVENT YOU REQUESTED TO DEBUG -- SELECT "STEP INTO" IN YOUR DEBUGGER
+        if (trapOnNextEvent && !event->isMessage())
+            DEBUG_TRAP_IF_REQUESTED;  // ABOUT TO PROCESS THE EVENT YOU REQUESTED TO DEBUG -- SELECT "STEP INTO" IN YOUR DEBUGGER
 #endif
 
-    try {
-        event->execute();
-    }
-    catch (cDeleteModuleException& e) {
-        setGlobalContext();
-        e.getModuleToDelete()->deleteModule();
+        if (profiler && profiler->isSampling())
+            eventProfiler = profiler;
     }
-    catch (cException&) {
-        // restore global context before throwing the exception further
-        setGlobalContext();
-        throw;
-    }
-    catch (std::exception& e) {
-        // restore global context before throwing the exception further
-        // but wrap into a cRuntimeError which captures the module before that
-        cRuntimeError e2(e);
+
+    {
+        // ends the profiler sample also if the event throws (e.g. endSimulation())
+        Profiler::EventGuard profilerGuard(eventProfiler, event);
+        try {
+            event->execute();
+        }
+        catch (cDeleteModuleException& e) {
+            setGlobalContext();
+            e.getModuleToDelete()->deleteModule();
+        }
+        catch (cException&) {
+            // restore global context before throwing the exception further
+            setGlobalContext();
+            throw;
+        }
+        catch (std::exception& e) {
+            // restore global context before throwing the exception further
+            // but wrap into a cRuntimeError which captures the module before that
+            cRuntimeError e2(e);
+            setGlobalContext();
+            throw e2;
+        }
         setGlobalContext();
-        throw e2;
     }
-    setGlobalContext();
+
+    // notify the environment about display strings changed during the event (if deferred)
+    flushPendingDisplayStringChanges();
 
     // Note: simulation time (as read via simTime() from modules) will be updated
     // in takeNextEvent(), called right before the next executeEvent().
@@ -1385,7 +1805,13 @@ void cSimulation::setFingerprintCalculator(cFingerprintCalculator *f)
 void cSimulation::insertEvent(cEvent *event)
 {
     event->setPreviousEventNumber(currentEventNumber);
-    fes->insert(event);
+    if (profiler && profiler->isSampling()) {
+        Profiler::ticks_t start = Profiler::now();
+        fes->insert(event);
+        profiler->recordFesInsert(Profiler::now() - start);
+    }
+    else
+        fes->insert(event);
 }
 
 void cSimulation::addLifecycleListener(cISimulationLifecycleListener *listener)
@@ -85,6 +85,18 @@ void cStatistic::collectWeighted(double, double)
     throw cRuntimeError(this, "collectWeighted() not implemented");
 }
 
+void cStatistic::collect(const double *values, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        collect(values[i]);
+}
+
+void cStatistic::collectWeighted(const double *values, const double *weights, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        collectWeighted(values[i], weights[i]);
+}
+
 void cStatistic::recordAs(const char *scalarname, const char *unit)
 {
     cSimpleModule *mod = dynamic_cast<cSimpleModule *>(getSimulation()->getContextModule());
@@ -23,6 +23,12 @@
 #include <cstring>
 #include <cmath>
 #include <string>
+#include <algorithm>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define CSTDDEV_USE_SSE2
+#endif
 
 #include "common/stringutil.h"
 #include "common/commonutil.h"  // NaN
@@ -45,6 +51,129 @@ using std::ostream;
 
 Register_Class(cStdDev);
 
+// Bulk collection: number of independent accumulator lanes (two SSE2 registers),
+// and the number of values summed into the lanes before the block sum is added
+// to the total.
+#define NUM_LANES   4
+#define BLOCK_SIZE  256
+
+namespace {
+
+// Kahan-compensated summation of the block sums
+struct CompensatedSum
+{
+    double sum = 0, compensation = 0;
+    void add(double x) {
+        double y = x - compensation;
+        double t = sum + y;
+        compensation = std::isfinite(t) ? (t - sum) - y : 0; // infinities are simply summed
+        sum = t;
+    }
+    double get() const {return sum - compensation;}
+};
+
+inline double sumLanes(const double *lanes)
+{
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+// Accumulates values[i..end) into the lanes, NUM_LANES values at a time
+// (value i+j goes into lane j). Returns the index of the first unprocessed value.
+size_t accumulateLanes(const double *values, size_t i, size_t end, double *s, double *sq, double *lo, double *hi)
+{
+#ifdef CSTDDEV_USE_SSE2
+    __m128d s01 = _mm_loadu_pd(s), s23 = _mm_loadu_pd(s + 2);
+    __m128d sq01 = _mm_loadu_pd(sq), sq23 = _mm_loadu_pd(sq + 2);
+    __m128d lo01 = _mm_loadu_pd(lo), lo23 = _mm_loadu_pd(lo + 2);
+    __m128d hi01 = _mm_loadu_pd(hi), hi23 = _mm_loadu_pd(hi + 2);
+    for (; i + NUM_LANES <= end; i += NUM_LANES) {
+        __m128d x01 = _mm_loadu_pd(values + i), x23 = _mm_loadu_pd(values + i + 2);
+        s01 = _mm_add_pd(s01, x01);
+        s23 = _mm_add_pd(s23, x23);
+        sq01 = _mm_add_pd(sq01, _mm_mul_pd(x01, x01));
+        sq23 = _mm_add_pd(sq23, _mm_mul_pd(x23, x23));
+        lo01 = _mm_min_pd(x01, lo01);  // same as x < lo ? x : lo
+        lo23 = _mm_min_pd(x23, lo23);
+        hi01 = _mm_max_pd(x01, hi01);
+        hi23 = _mm_max_pd(x23, hi23);
+    }
+    _mm_storeu_pd(s, s01); _mm_storeu_pd(s + 2, s23);
+    _mm_storeu_pd(sq, sq01); _mm_storeu_pd(sq + 2, sq23);
+    _mm_storeu_pd(lo, lo01); _mm_storeu_pd(lo + 2, lo23);
+    _mm_storeu_pd(hi, hi01); _mm_storeu_pd(hi + 2, hi23);
+#else
+    for (; i + NUM_LANES <= end; i += NUM_LANES) {
+        for (int j = 0; j < NUM_LANES; j++) {
+            double x = values[i + j];
+            s[j] += x;
+            sq[j] += x * x;
+            lo[j] = x < lo[j] ? x : lo[j];
+            hi[j] = x > hi[j] ? x : hi[j];
+        }
+    }
+#endif
+    return i;
+}
+
+// Weighted version of accumulateLanes().
+size_t accumulateWeightedLanes(const double *values, const double *weights, size_t i, size_t end,
+        double *sw, double *swx, double *sww, double *swxx, double *lo, double *hi, double *wmin)
+{
+#ifdef CSTDDEV_USE_SSE2
+    __m128d sw01 = _mm_loadu_pd(sw), sw23 = _mm_loadu_pd(sw + 2);
+    __m128d swx01 = _mm_loadu_pd(swx), swx23 = _mm_loadu_pd(swx + 2);
+    __m128d sww01 = _mm_loadu_pd(sww), sww23 = _mm_loadu_pd(sww + 2);
+    __m128d swxx01 = _mm_loadu_pd(swxx), swxx23 = _mm_loadu_pd(swxx + 2);
+    __m128d lo01 = _mm_loadu_pd(lo), lo23 = _mm_loadu_pd(lo + 2);
+    __m128d hi01 = _mm_loadu_pd(hi), hi23 = _mm_loadu_pd(hi + 2);
+    __m128d wmin01 = _mm_loadu_pd(wmin), wmin23 = _mm_loadu_pd(wmin + 2);
+    for (; i + NUM_LANES <= end; i += NUM_LANES) {
+        __m128d x01 = _mm_loadu_pd(values + i), x23 = _mm_loadu_pd(values + i + 2);
+        __m128d w01 = _mm_loadu_pd(weights + i), w23 = _mm_loadu_pd(weights + i + 2);
+        __m128d wx01 = _mm_mul_pd(w01, x01), wx23 = _mm_mul_pd(w23, x23);
+        sw01 = _mm_add_pd(sw01, w01);
+        sw23 = _mm_add_pd(sw23, w23);
+        swx01 = _mm_add_pd(swx01, wx01);
+        swx23 = _mm_add_pd(swx23, wx23);
+        sww01 = _mm_add_pd(sww01, _mm_mul_pd(w01, w01));
+        sww23 = _mm_add_pd(sww23, _mm_mul_pd(w23, w23));
+        swxx01 = _mm_add_pd(swxx01, _mm_mul_pd(wx01, x01));
+        swxx23 = _mm_add_pd(swxx23, _mm_mul_pd(wx23, x23));
+        lo01 = _mm_min_pd(x01, lo01);
+        lo23 = _mm_min_pd(x23, lo23);
+        hi01 = _mm_max_pd(x01, hi01);
+        hi23 = _mm_max_pd(x23, hi23);
+        wmin01 = _mm_min_pd(w01, wmin01);
+        wmin23 = _mm_min_pd(w23, wmin23);
+    }
+    _mm_storeu_pd(sw, sw01); _mm_storeu_pd(sw + 2, sw23);
+    _mm_storeu_pd(swx, swx01); _mm_storeu_pd(swx + 2, swx23);
+    _mm_storeu_pd(sww, sww01); _mm_storeu_pd(sww + 2, sww23);
+    _mm_storeu_pd(swxx, swxx01); _mm_storeu_pd(swxx + 2, swxx23);
+    _mm_storeu_pd(lo, lo01); _mm_storeu_pd(lo + 2, lo23);
+    _mm_storeu_pd(hi, hi01); _mm_storeu_pd(hi + 2, hi23);
+    _mm_storeu_pd(wmin, wmin01); _mm_storeu_pd(wmin + 2, wmin23);
+#else
+    for (; i + NUM_LANES <= end; i += NUM_LANES) {
+        for (int j = 0; j < NUM_LANES; j++) {
+            double x = values[i + j], w = weights[i + j];
+            double wx = w * x;
+            sw[j] += w;
+            swx[j] += wx;
+            sww[j] += w * w;
+            swxx[j] += wx * x;
+            lo[j] = x < lo[j] ? x : lo[j];
+            hi[j] = x > hi[j] ? x : hi[j];
+            wmin[j] = w < wmin[j] ? w : wmin[j];
+        }
+    }
+#endif
+    return i;
+}
+
+}  // namespace
+
+
 cStdDev::cStdDev(const char *s, bool weighted) : cStatistic(s), weighted(weighted)
 {
     clear();
@@ -155,6 +284,110 @@ void cStdDev::collectWeighted(double value, double weight)
     sumWeightedSquaredValues += weight * value * value;
 }
 
+void cStdDev::collect(const double *values, size_t n)
+{
+    if (weighted)
+        throw cRuntimeError(this, "Use collectWeighted(value, weight) to add observations to a weighted statistics");
+
+    double minv = minValue, maxv = maxValue;
+    CompensatedSum sum, sqrSum;
+    for (size_t start = 0; start < n; start += BLOCK_SIZE) {
+        size_t end = std::min(n, start + BLOCK_SIZE);
+        double s[NUM_LANES] = {0}, sq[NUM_LANES] = {0}, lo[NUM_LANES], hi[NUM_LANES];
+        for (int j = 0; j < NUM_LANES; j++) {
+            lo[j] = minv;
+            hi[j] = maxv;
+        }
+        size_t i = accumulateLanes(values, start, end, s, sq, lo, hi);
+        for (; i < end; i++) {
+            double x = values[i];
+            s[0] += x;
+            sq[0] += x * x;
+            lo[0] = x < lo[0] ? x : lo[0];
+            hi[0] = x > hi[0] ? x : hi[0];
+        }
+        sum.add(sumLanes(s));
+        sqrSum.add(sumLanes(sq));
+        for (int j = 0; j < NUM_LANES; j++) {
+            minv = std::min(minv, lo[j]);
+            maxv = std::max(maxv, hi[j]);
+        }
+    }
+
+    // a NaN makes the sum NaN (but so do opposite infinities, so check the values)
+    if (std::isnan(sum.get()))
+        for (size_t i = 0; i < n; i++)
+            if (std::isnan(values[i]))
+                throw cRuntimeError(this, "collect(): NaN values are not allowed");
+
+    numValues += n;
+    sumWeights += n;
+    minValue = minv;
+    maxValue = maxv;
+    sumWeightedValues += sum.get();
+    sumSquaredWeights += n;
+    sumWeightedSquaredValues += sqrSum.get();
+}
+
+void cStdDev::collectWeighted(const double *values, const double *weights, size_t n)
+{
+    if (!weighted)
+        throw cRuntimeError(this, "Use collect(value) to add observations to an unweighted statistics");
+
+    double minv = minValue, maxv = maxValue, minWeight = 0;
+    CompensatedSum sumW, sumWX, sumWW, sumWXX;
+    for (size_t start = 0; start < n; start += BLOCK_SIZE) {
+        size_t end = std::min(n, start + BLOCK_SIZE);
+        double sw[NUM_LANES] = {0}, swx[NUM_LANES] = {0}, sww[NUM_LANES] = {0}, swxx[NUM_LANES] = {0};
+        double lo[NUM_LANES], hi[NUM_LANES], wmin[NUM_LANES];
+        for (int j = 0; j < NUM_LANES; j++) {
+            lo[j] = minv;
+            hi[j] = maxv;
+            wmin[j] = minWeight;
+        }
+        size_t i = accumulateWeightedLanes(values, weights, start, end, sw, swx, sww, swxx, lo, hi, wmin);
+        for (; i < end; i++) {
+            double x = values[i], w = weights[i];
+            double wx = w * x;
+            sw[0] += w;
+            swx[0] += wx;
+            sww[0] += w * w;
+            swxx[0] += wx * x;
+            lo[0] = x < lo[0] ? x : lo[0];
+            hi[0] = x > hi[0] ? x : hi[0];
+            wmin[0] = w < wmin[0] ? w : wmin[0];
+        }
+        sumW.add(sumLanes(sw));
+        sumWX.add(sumLanes(swx));
+        sumWW.add(sumLanes(sww));
+        sumWXX.add(sumLanes(swxx));
+        for (int j = 0; j < NUM_LANES; j++) {
+            minv = std::min(minv, lo[j]);
+            maxv = std::max(maxv, hi[j]);
+            minWeight = std::min(minWeight, wmin[j]);
+        }
+    }
+
+    // invalid weights and NaN values show up in the sums; if something is
+    // suspicious, report the first offending observation like collectWeighted(double, double)
+    if (minWeight < 0 || !std::isfinite(sumW.get()) || std::isnan(sumWX.get())) {
+        for (size_t i = 0; i < n; i++) {
+            if (!std::isfinite(weights[i]) || weights[i] < 0)
+                throw cRuntimeError(this, "collectWeighted(): weight must be nonnegative and finite (%g)", weights[i]);
+            if (std::isnan(values[i]))
+                throw cRuntimeError(this, "collect(): NaN values are not allowed");
+        }
+    }
+
+    numValues += n;
+    minValue = minv;
+    maxValue = maxv;
+    sumWeights += sumW.get();
+    sumWeightedValues += sumWX.get();
+    sumSquaredWeights += sumWW.get();
+    sumWeightedSquaredValues += sumWXX.get();
+}
+
 void cStdDev::merge(const cStatistic *other)
 {
     if (!weighted && other->isWeighted())
@@ -24,6 +24,9 @@
 #include <list>
 #include <algorithm>
 #include <sstream>
+#include <thread>
+#include <atomic>
+#include <functional>
 #include "common/patternmatcher.h"
 #include "common/stringutil.h"
 #include "omnetpp/ctopology.h"
@@ -42,6 +45,275 @@ namespace omnetpp {
 
 Register_Class(cTopology);
 
+/**
+ * Compact copy of the graph for the all-pairs shortest path algorithms:
+ * the links in CSR (compressed sparse row) form, plus the results, one row
+ * per target node.
+ */
+struct cTopology::Snapshot
+{
+    bool valid = true;  // false if the graph structure changed since the snapshot was taken
+    bool weighted;
+    int numNodes;
+    std::vector<Node *> nodes;
+    std::vector<double> nodeWeights;  // 0 in the unweighted case
+    std::vector<bool> nodeEnabled;
+
+    // links, grouped by destination node: the incoming links of node v
+    // are at indices inLinkStart[v]..inLinkStart[v+1]-1
+    std::vector<int> inLinkStart;
+    std::vector<int> linkSrc;  // index of the source node
+    std::vector<int> linkDest;  // index of the destination node
+    std::vector<double> linkWeights;  // INFINITY for disabled links, 1 in the unweighted case
+    std::vector<Link *> links;
+
+    // the outgoing links of node v (as link indices) are at outLinks[outLinkStart[v]..outLinkStart[v+1]-1]
+    std::vector<int> outLinkStart;
+    std::vector<int> outLinks;
+
+    // results: distance of node s from target t, and index of the first link
+    // on the path (-1 if none), at index t*numNodes+s
+    std::vector<double> dist;
+    std::vector<int> nextLink;
+
+    struct LinkChange { int link; double oldWeight; };
+
+    struct Workspace {
+        std::vector<std::pair<double,int>> heap;  // also serves as FIFO for BFS
+        std::vector<int> nodeList;
+        std::vector<bool> nodeFlags;
+    };
+
+    Snapshot(const cTopology *topology, const std::vector<Node *>& nodes, bool weighted);
+    double getLinkWeight(const cTopology *topology, Link *link) const;
+    double getNodeWeight(const cTopology *topology, Node *node) const;
+    double getDistanceVia(int target, int link, const double *d) const;
+    void calculatePathsTo(int target, Workspace& ws);
+    void updatePathsTo(int target, const std::vector<LinkChange>& changes, Workspace& ws);
+    void propagate(int target, Workspace& ws);
+};
+
+cTopology::Snapshot::Snapshot(const cTopology *topology, const std::vector<Node *>& nodes, bool weighted) :
+    weighted(weighted), numNodes(nodes.size()), nodes(nodes)
+{
+    for (int i = 0; i < numNodes; i++) {
+        nodes[i]->snapshotIndex = i;
+        nodeWeights.push_back(getNodeWeight(topology, nodes[i]));
+        nodeEnabled.push_back(nodes[i]->enabled);
+    }
+
+    inLinkStart.push_back(0);
+    std::vector<int> numOutLinks(numNodes);
+    for (int v = 0; v < numNodes; v++) {
+        for (Link *link : nodes[v]->inLinks) {
+            int src = link->srcNode->snapshotIndex;
+            linkSrc.push_back(src);
+            linkDest.push_back(v);
+            linkWeights.push_back(getLinkWeight(topology, link));
+            links.push_back(link);
+            numOutLinks[src]++;
+        }
+        inLinkStart.push_back(links.size());
+    }
+
+    outLinkStart.push_back(0);
+    for (int v = 0; v < numNodes; v++)
+        outLinkStart.push_back(outLinkStart.back() + numOutLinks[v]);
+    outLinks.resize(links.size());
+    std::vector<int> pos(outLinkStart.begin(), outLinkStart.end()-1);
+    for (int i = 0; i < (int)links.size(); i++)
+        outLinks[pos[linkSrc[i]]++] = i;
+
+    dist.resize((size_t)numNodes * numNodes);
+    nextLink.resize((size_t)numNodes * numNodes);
+}
+
+double cTopology::Snapshot::getLinkWeight(const cTopology *topology, Link *link) const
+{
+    if (!link->enabled)
+        return INFINITY;
+    if (!weighted)
+        return 1;
+    if (!(link->weight >= 0))
+        throw cRuntimeError(topology, "Link weights must not be negative, found %g", link->weight);
+    return link->weight;
+}
+
+double cTopology::Snapshot::getNodeWeight(const cTopology *topology, Node *node) const
+{
+    if (!weighted)
+        return 0;
+    if (!(node->weight >= 0))
+        throw cRuntimeError(topology, "Node weights must not be negative, found %g", node->weight);
+    return node->weight;
+}
+
+// distance of the link's source node from the target, if it routes through that link
+inline double cTopology::Snapshot::getDistanceVia(int target, int link, const double *d) const
+{
+    int dest = linkDest[link];
+    double newdist = d[dest] + linkWeights[link];
+    if (dest != target)
+        newdist += nodeWeights[dest];  // weight of intermediate nodes is the price of routing through them
+    return newdist;
+}
+
+void cTopology::Snapshot::calculatePathsTo(int target, Workspace& ws)
+{
+    double *d = dist.data() + (size_t)target * numNodes;
+    int *next = nextLink.data() + (size_t)target * numNodes;
+    std::fill(d, d + numNodes, INFINITY);
+    std::fill(next, next + numNodes, -1);
+    d[target] = 0;
+    ws.heap.clear();
+    ws.heap.push_back(std::make_pair(0.0, target));
+
+    if (weighted) {
+        propagate(target, ws);
+        return;
+    }
+
+    // BFS; the heap vector is used as a FIFO
+    auto& queue = ws.heap;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int v = queue[head].second;
+        for (int i = inLinkStart[v]; i < inLinkStart[v+1]; i++) {
+            int w = linkSrc[i];
+            if (linkWeights[i] == INFINITY || !nodeEnabled[w] || d[w] != INFINITY)
+                continue;
+            d[w] = d[v] + 1;
+            next[w] = i;
+            queue.push_back(std::make_pair(d[w], w));
+        }
+    }
+}
+
+// Dijkstra from the nodes in the heap, which may also contain stale entries
+void cTopology::Snapshot::propagate(int target, Workspace& ws)
+{
+    double *d = dist.data() + (size_t)target * numNodes;
+    int *next = nextLink.data() + (size_t)target * numNodes;
+    auto& heap = ws.heap;
+    auto greater = std::greater<std::pair<double,int>>();
+    std::make_heap(heap.begin(), heap.end(), greater);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), greater);
+        double dv = heap.back().first;
+        int v = heap.back().second;
+        heap.pop_back();
+        if (dv > d[v])
+            continue;  // stale entry
+        for (int i = inLinkStart[v]; i < inLinkStart[v+1]; i++) {
+            int src = linkSrc[i];
+            if (!nodeEnabled[src])
+                continue;
+            double newdist = getDistanceVia(target, i, d);
+            if (newdist != INFINITY && d[src] > newdist) {
+                d[src] = newdist;
+                next[src] = i;
+                heap.push_back(std::make_pair(newdist, src));
+                std::push_heap(heap.begin(), heap.end(), greater);
+            }
+        }
+    }
+}
+
+// Repairs the shortest path tree of the target after the given link weight
+// changes (a variant of the Ramalingam-Reps algorithm). Nodes whose path
+// contains a link that became more expensive lose their distance, and are
+// assigned the best distance via their other neighbors; sources of links that
+// became cheaper are assigned the distance via the link if that is shorter.
+// Dijkstra then propagates the changes from these nodes.
+void cTopology::Snapshot::updatePathsTo(int target, const std::vector<LinkChange>& changes, Workspace& ws)
+{
+    double *d = dist.data() + (size_t)target * numNodes;
+    int *next = nextLink.data() + (size_t)target * numNodes;
+
+    // collect the nodes whose path contains a link that became more expensive
+    auto& affected = ws.nodeList;
+    auto& isAffected = ws.nodeFlags;
+    affected.clear();
+    isAffected.assign(numNodes, false);
+    for (const LinkChange& change : changes) {
+        int src = linkSrc[change.link];
+        if (linkWeights[change.link] > change.oldWeight && next[src] == change.link && !isAffected[src]) {
+            isAffected[src] = true;
+            affected.push_back(src);
+        }
+    }
+    for (size_t k = 0; k < affected.size(); k++) {
+        int v = affected[k];
+        for (int i = inLinkStart[v]; i < inLinkStart[v+1]; i++) {
+            int src = linkSrc[i];
+            if (next[src] == i && !isAffected[src]) {
+                isAffected[src] = true;
+                affected.push_back(src);
+            }
+        }
+    }
+
+    // find a path for them via unaffected neighbors
+    ws.heap.clear();
+    for (int v : affected) {
+        d[v] = INFINITY;
+        next[v] = -1;
+    }
+    for (int v : affected) {
+        for (int k = outLinkStart[v]; k < outLinkStart[v+1]; k++) {
+            int i = outLinks[k];
+            if (isAffected[linkDest[i]])
+                continue;
+            double newdist = getDistanceVia(target, i, d);
+            if (newdist != INFINITY && d[v] > newdist) {
+                d[v] = newdist;
+                next[v] = i;
+            }
+        }
+        if (d[v] != INFINITY)
+            ws.heap.push_back(std::make_pair(d[v], v));
+    }
+
+    // links that became cheaper may offer shorter paths
+    for (const LinkChange& change : changes) {
+        int src = linkSrc[change.link];
+        if (linkWeights[change.link] < change.oldWeight && nodeEnabled[src]) {
+            double newdist = getDistanceVia(target, change.link, d);
+            if (newdist != INFINITY && d[src] > newdist) {
+                d[src] = newdist;
+                next[src] = change.link;
+                ws.heap.push_back(std::make_pair(newdist, src));
+            }
+        }
+    }
+
+    propagate(target, ws);
+}
+
+// Runs task(i, workspace) for i=0..numTasks-1 on numThreads threads (0 means
+// the number of hardware threads); each thread has its own workspace object
+template<typename Workspace, typename Task>
+static void runInParallel(int numTasks, int numThreads, const Task& task)
+{
+    if (numThreads <= 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, numTasks);
+    std::atomic<int> nextTask(0);
+    auto worker = [&]() {
+        Workspace workspace;
+        for (int i = nextTask++; i < numTasks; i = nextTask++)
+            task(i, workspace);
+    };
+    if (numThreads <= 1) {
+        worker();
+        return;
+    }
+    std::vector<std::thread> threads;
+    for (int k = 0; k < numThreads; k++)
+        threads.push_back(std::thread(worker));
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
 
 cTopology::LinkIn *cTopology::Node::getLinkIn(int i)
 {
@@ -71,6 +343,7 @@ cTopology::cTopology(const cTopology& topo) : cOwnedObject(topo)
 cTopology::~cTopology()
 {
     clear();
+    delete snapshot;
 }
 
 std::string cTopology::str() const
@@ -93,6 +366,7 @@ void cTopology::clear()
         delete node;
     }
     nodes.clear();
+    graphChanged();
 }
 
 //---
@@ -224,6 +498,7 @@ void cTopology::extractFromNetwork(bool (*predicate)(cModule *, void *), void *d
 
 int cTopology::addNode(Node *node)
 {
+    graphChanged();
     if (node->moduleId == -1) {
         // elements without module ID are stored at the end
         nodes.push_back(node);
@@ -239,6 +514,8 @@ int cTopology::addNode(Node *node)
 
 void cTopology::deleteNode(Node *node)
 {
+    graphChanged();
+
     // remove outgoing links
     for (auto link : node->outLinks) {
         unlinkFromDestNode(link);
@@ -263,6 +540,8 @@ void cTopology::deleteNode(Node *node)
 
 void cTopology::addLink(Link *link, Node *srcNode, Node *destNode)
 {
+    graphChanged();
+
     // remove from graph if it's already in
     if (link->srcNode)
         unlinkFromSourceNode(link);
@@ -282,6 +561,8 @@ void cTopology::addLink(Link *link, Node *srcNode, Node *destNode)
 
 void cTopology::addLink(Link *link, cGate *srcGate, cGate *destGate)
 {
+    graphChanged();
+
     // remove from graph if it's already in
     if (link->srcNode)
         unlinkFromSourceNode(link);
@@ -305,11 +586,18 @@ void cTopology::addLink(Link *link, cGate *srcGate, cGate *destGate)
 
 void cTopology::deleteLink(Link *link)
 {
+    graphChanged();
     unlinkFromSourceNode(link);
     unlinkFromDestNode(link);
     delete link;
 }
 
+void cTopology::graphChanged()
+{
+    if (snapshot)
+        snapshot->valid = false;
+}
+
 void cTopology::unlinkFromSourceNode(Link *link)
 {
     std::vector<Link *>& srcOutLinks = link->srcNode->outLinks;
@@ -438,5 +726,112 @@ void cTopology::calculateWeightedSingleShortestPathsTo(Node *_target)
     }
 }
 
-}  // namespace omnetpp
+void cTopology::calculateUnweightedAllShortestPaths(int numThreads)
+{
+    calculateAllShortestPaths(false, numThreads);
+}
+
+void cTopology::calculateWeightedAllShortestPaths(int numThreads)
+{
+    calculateAllShortestPaths(true, numThreads);
+}
+
+void cTopology::calculateAllShortestPaths(bool weighted, int numThreads)
+{
+    delete snapshot;
+    snapshot = nullptr;
+    snapshot = new Snapshot(this, nodes, weighted);
+    runInParallel<Snapshot::Workspace>(snapshot->numNodes, numThreads, [this](int target, Snapshot::Workspace& ws) {
+        snapshot->calculatePathsTo(target, ws);
+    });
+}
+
+void cTopology::updateAllShortestPaths(int numThreads)
+{
+    if (!snapshot)
+        throw cRuntimeError(this, "updateAllShortestPaths(): There are no all-pairs shortest path results to update");
+    if (!snapshot->valid) {
+        calculateAllShortestPaths(snapshot->weighted, numThreads);
+        return;
+    }
+
+    // node changes may affect any path
+    Snapshot& g = *snapshot;
+    for (int i = 0; i < g.numNodes; i++) {
+        if (g.nodes[i]->enabled != g.nodeEnabled[i] || g.getNodeWeight(this, g.nodes[i]) != g.nodeWeights[i]) {
+            calculateAllShortestPaths(g.weighted, numThreads);
+            return;
+        }
+    }
+
+    // collect changed links
+    std::vector<Snapshot::LinkChange> changes;
+    try {
+        for (int i = 0; i < (int)g.links.size(); i++) {
+            double weight = g.getLinkWeight(this, g.links[i]);
+            if (weight != g.linkWeights[i]) {
+                changes.push_back(Snapshot::LinkChange { i, g.linkWeights[i] });
+                g.linkWeights[i] = weight;
+            }
+        }
+    }
+    catch (std::exception&) {
+        g.valid = false;  // weights partially updated, force a full recalculation next time
+        throw;
+    }
+    if (changes.empty())
+        return;
+
+    runInParallel<Snapshot::Workspace>(g.numNodes, numThreads, [&](int target, Snapshot::Workspace& ws) {
+        // Check whether the shortest path tree of the target is affected at all:
+        // a link that became more expensive only matters if it is in the tree,
+        // and a link that became cheaper only if it offers a strictly shorter path.
+        const double *d = g.dist.data() + (size_t)target * g.numNodes;
+        const int *next = g.nextLink.data() + (size_t)target * g.numNodes;
+        for (const Snapshot::LinkChange& change : changes) {
+            int src = g.linkSrc[change.link];
+            bool affected;
+            if (g.linkWeights[change.link] > change.oldWeight)
+                affected = next[src] == change.link;
+            else {
+                double newdist = g.getDistanceVia(target, change.link, d);
+                affected = g.nodeEnabled[src] && newdist != INFINITY && d[src] > newdist;
+            }
+            if (affected) {
+                g.updatePathsTo(target, changes, ws);
+                break;
+            }
+        }
+    });
+}
+
+int cTopology::getSnapshotIndex(Node *node, const char *func) const
+{
+    if (!snapshot)
+        throw cRuntimeError(this, "%s: No all-pairs shortest paths have been calculated", func);
+    if (!snapshot->valid)
+        throw cRuntimeError(this, "%s: The graph has changed since the all-pairs shortest paths were calculated", func);
+    if (!node)
+        throw cRuntimeError(this, "%s: Node is nullptr", func);
+    int index = node->snapshotIndex;
+    if (index < 0 || index >= snapshot->numNodes || snapshot->nodes[index] != node)
+        throw cRuntimeError(this, "%s: Node is not part of this graph", func);
+    return index;
+}
+
+double cTopology::getDistance(Node *src, Node *target) const
+{
+    int s = getSnapshotIndex(src, "getDistance()");
+    int t = getSnapshotIndex(target, "getDistance()");
+    return snapshot->dist[(size_t)t * snapshot->numNodes + s];
+}
+
+cTopology::LinkOut *cTopology::getNextLink(Node *src, Node *target) const
+{
+    int s = getSnapshotIndex(src, "getNextLink()");
+    int t = getSnapshotIndex(target, "getNextLink()");
+    int i = snapshot->nextLink[(size_t)t * snapshot->numNodes + s];
+    return i == -1 ? nullptr : (LinkOut *)snapshot->links[i];
+}
 
+}  // namespace omnetpp
@@ -14,6 +14,7 @@
 //
 //==========================================================================
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include "omnetpp/distrib.h"
@@ -31,6 +32,136 @@
 
 namespace omnetpp {
 
+static OPP_THREAD_LOCAL DistributionAlgorithms distributionAlgorithms = DISTRIB_ALGORITHMS_CLASSIC;
+
+void setDistributionAlgorithms(DistributionAlgorithms algorithms)
+{
+    distributionAlgorithms = algorithms;
+}
+
+DistributionAlgorithms getDistributionAlgorithms()
+{
+    return distributionAlgorithms;
+}
+
+//----------------------------------------------------------------------------
+//
+//  Z I G G U R A T
+//
+//----------------------------------------------------------------------------
+
+/*
+ * Ziggurat method for the normal and exponential distributions. The area
+ * under the density function is covered with C horizontal blocks of equal
+ * area V: C-1 rectangles stacked on top of each other, and a bottom block
+ * that also contains the tail beyond R. A point is chosen uniformly from a
+ * random block; it is accepted right away if it falls into the part of the
+ * rectangle that lies fully under the curve, which is the case most of the
+ * time. Otherwise it is tested against the curve (wedge), or sampled from
+ * the tail (bottom block).
+ *
+ * The table layout and constants follow: Jurgen A. Doornik, "An Improved
+ * Ziggurat Method to Generate Normal Random Samples", 2005 (ZIGNOR), and
+ * George Marsaglia and Wai Wan Tsang, "The Ziggurat Method for Generating
+ * Random Variables", Journal of Statistical Software, Vol. 5, Issue 8, 2000.
+ *
+ * Both the block index and the horizontal position are taken from a single
+ * doubleRand() call, similar to how the original uses a single 32-bit integer.
+ */
+#define ZIGNOR_C  128                   // number of blocks
+#define ZIGNOR_R  3.442619855899        // start of the right tail
+#define ZIGNOR_V  9.91256303526217e-3   // area of each block
+
+#define ZIGEXP_C  256
+#define ZIGEXP_R  7.69711747013104972
+#define ZIGEXP_V  3.949659822581572e-3
+
+namespace {
+
+struct ZigguratTables
+{
+    // x[i]: right edge of block i (x[0] is the virtual edge of the bottom block: V/f(R)); x[C]=0
+    // r[i]: x[i+1]/x[i], the fraction of block i that lies fully under the curve
+    double normalX[ZIGNOR_C+1], normalR[ZIGNOR_C];
+    double expX[ZIGEXP_C+1], expR[ZIGEXP_C];
+
+    ZigguratTables() {
+        double f = exp(-0.5 * ZIGNOR_R * ZIGNOR_R);
+        normalX[0] = ZIGNOR_V / f;
+        normalX[1] = ZIGNOR_R;
+        normalX[ZIGNOR_C] = 0;
+        for (int i = 2; i < ZIGNOR_C; i++) {
+            normalX[i] = sqrt(-2 * log(ZIGNOR_V / normalX[i-1] + f));
+            f = exp(-0.5 * normalX[i] * normalX[i]);
+        }
+        for (int i = 0; i < ZIGNOR_C; i++)
+            normalR[i] = normalX[i+1] / normalX[i];
+
+        f = exp(-ZIGEXP_R);
+        expX[0] = ZIGEXP_V / f;
+        expX[1] = ZIGEXP_R;
+        expX[ZIGEXP_C] = 0;
+        for (int i = 2; i < ZIGEXP_C; i++) {
+            expX[i] = -log(ZIGEXP_V / expX[i-1] + f);
+            f = exp(-expX[i]);
+        }
+        for (int i = 0; i < ZIGEXP_C; i++)
+            expR[i] = expX[i+1] / expX[i];
+    }
+};
+
+const ZigguratTables zigguratTables;
+
+}  // namespace
+
+static double unit_normal_Ziggurat(cRNG *rng)
+{
+    const double *X = zigguratTables.normalX;
+    const double *R = zigguratTables.normalR;
+    for (;;) {
+        double d = rng->doubleRand() * ZIGNOR_C;
+        int i = (int)d;
+        double u = 2 * (d - i) - 1;  // horizontal position in (-1,1)
+        if (fabs(u) < R[i])
+            return u * X[i];  // inside the rectangle
+        if (i == 0) {
+            // tail beyond R (Marsaglia, 1964)
+            double x, y;
+            do {
+                x = log(rng->doubleRandNonz()) / ZIGNOR_R;
+                y = log(rng->doubleRandNonz());
+            } while (-2 * y < x * x);
+            return u < 0 ? x - ZIGNOR_R : ZIGNOR_R - x;
+        }
+        // wedge: accept if a uniform point between f(X[i]) and f(X[i+1]) is under the curve
+        double x = u * X[i];
+        double f0 = exp(-0.5 * (X[i] * X[i] - x * x));
+        double f1 = exp(-0.5 * (X[i+1] * X[i+1] - x * x));
+        if (f1 + rng->doubleRand() * (f0 - f1) < 1.0)
+            return x;
+    }
+}
+
+static double unit_exponential_Ziggurat(cRNG *rng)
+{
+    const double *X = zigguratTables.expX;
+    const double *R = zigguratTables.expR;
+    for (;;) {
+        double d = rng->doubleRand() * ZIGEXP_C;
+        int i = (int)d;
+        double u = d - i;  // horizontal position in [0,1)
+        if (u < R[i])
+            return u * X[i];  // inside the rectangle
+        if (i == 0)
+            return ZIGEXP_R - log(rng->doubleRandNonz());  // the tail is exponential itself
+        double x = u * X[i];
+        double f0 = exp(-(X[i] - x));
+        double f1 = exp(-(X[i+1] - x));
+        if (f1 + rng->doubleRand() * (f0 - f1) < 1.0)
+            return x;
+    }
+}
+
 //----------------------------------------------------------------------------
 //
 //  C O N T I N U O U S
@@ -46,11 +177,15 @@ double uniform(cRNG *rng, double a, double b)
 
 double exponential(cRNG *rng, double p)
 {
+    if (distributionAlgorithms == DISTRIB_ALGORITHMS_FAST)
+        return p * unit_exponential_Ziggurat(rng);
     return -p *log(1.0 - rng->doubleRand());
 }
 
 double unit_normal(cRNG *rng)
 {
+    if (distributionAlgorithms == DISTRIB_ALGORITHMS_FAST)
+        return unit_normal_Ziggurat(rng);
     double U = 1.0 - rng->doubleRand();
     double V = 1.0 - rng->doubleRand();
     return sqrt(-2.0*log(U)) * cos(M_PI*2*V);
@@ -58,6 +193,8 @@ double unit_normal(cRNG *rng)
 
 double normal(cRNG *rng, double m, double d)
 {
+    if (distributionAlgorithms == DISTRIB_ALGORITHMS_FAST)
+        return m + d * unit_normal_Ziggurat(rng);
     double U = 1.0 - rng->doubleRand();
     double V = 1.0 - rng->doubleRand();
     return m + d * sqrt(-2.0*log(U)) * cos(M_PI*2*V);
@@ -160,6 +297,9 @@ static double gamma_ChengFeast79(cRNG *rng, double alpha)
  * From: "A Simple Method for Generating Gamma Variables", George Marsaglia and
  * Wai Wan Tsang, ACM Transactions on Mathematical Software, Vol. 26, No. 3,
  * September 2000. Available online.
+ *
+ * The normal variates come from unit_normal(), so with the "fast"
+ * distribution algorithms this runs on top of the ziggurat method.
  */
 static double gamma_Marsaglia2000(cRNG *rng, double a)
 {
@@ -395,8 +535,43 @@ int hypergeometric(cRNG *rng, int a, int b, int n)
 }
 */
 
+/*
+ * internal, for lambda>=10.
+ *
+ * PTRS (transformed rejection with squeeze) from: Wolfgang Hormann, "The
+ * Transformed Rejection Method for Generating Poisson Random Variables",
+ * Insurance: Mathematics and Economics, Vol. 12, No. 1, 1993.
+ * Uses two uniforms per iteration, and accepts about 90% of the candidates
+ * at the first, log-free test.
+ */
+static int poisson_PTRS(cRNG *rng, double lambda)
+{
+    double slam = sqrt(lambda);
+    double loglam = log(lambda);
+    double b = 0.931 + 2.53 * slam;
+    double a = -0.059 + 0.02483 * b;
+    double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+    double vr = 0.9277 - 3.6224 / (b - 2);
+
+    for (;;) {
+        double U = rng->doubleRand() - 0.5;
+        double V = rng->doubleRand();
+        double us = 0.5 - fabs(U);
+        double k = floor((2 * a / us + b) * U + lambda + 0.43);
+        if (us >= 0.07 && V <= vr)
+            return (int)k;
+        if (k < 0 || (us < 0.013 && V > us))
+            continue;
+        if (log(V) + log(invalpha) - log(a / (us * us) + b) <= -lambda + k * loglam - lgamma(k + 1))
+            return (int)k;
+    }
+}
+
 int poisson(cRNG *rng, double lambda)
 {
+    if (distributionAlgorithms == DISTRIB_ALGORITHMS_FAST && lambda >= 10.0)
+        return poisson_PTRS(rng, lambda);
+
     int X;
     if (lambda > 30.0) {
         double a = M_PI * sqrt(lambda / 3.0);
@@ -428,5 +603,56 @@ int poisson(cRNG *rng, double lambda)
     return X;
 }
 
+//----------------------------------------------------------------------------
+//
+//  B A T C H E D
+//
+//----------------------------------------------------------------------------
+
+void uniform(cRNG *rng, double a, double b, double *dest, size_t n)
+{
+    if (a > b)
+        throw cRuntimeError("uniform(): Wrong parameters a=%g and b=%g: a <= b required", a, b);
+    rng->fillDoubles(dest, n);
+    for (size_t i = 0; i < n; i++)
+        dest[i] = a + dest[i] * (b-a);
+}
+
+void exponential(cRNG *rng, double p, double *dest, size_t n)
+{
+    if (distributionAlgorithms == DISTRIB_ALGORITHMS_FAST) {
+        // rejection method: number of uniforms per variate is not fixed
+        for (size_t i = 0; i < n; i++)
+            dest[i] = p * unit_exponential_Ziggurat(rng);
+        return;
+    }
+    rng->fillDoubles(dest, n);
+    for (size_t i = 0; i < n; i++)
+        dest[i] = -p * log(1.0 - dest[i]);
+}
+
+void normal(cRNG *rng, double m, double d, double *dest, size_t n)
+{
+    if (distributionAlgorithms == DISTRIB_ALGORITHMS_FAST) {
+        // rejection method: number of uniforms per variate is not fixed
+        for (size_t i = 0; i < n; i++)
+            dest[i] = m + d * unit_normal_Ziggurat(rng);
+        return;
+    }
+
+    // two uniforms per variate, in the same order as normal() draws them
+    const size_t CHUNK = 256;
+    double uv[2*CHUNK];
+    for (size_t i = 0; i < n; i += CHUNK) {
+        size_t k = std::min(CHUNK, n - i);
+        rng->fillDoubles(uv, 2*k);
+        for (size_t j = 0; j < k; j++) {
+            double U = 1.0 - uv[2*j];
+            double V = 1.0 - uv[2*j+1];
+            dest[i+j] = m + d * sqrt(-2.0*log(U)) * cos(M_PI*2*V);
+        }
+    }
+}
+
 }  // namespace omnetpp
 
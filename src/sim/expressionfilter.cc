@@ -17,6 +17,8 @@
 #include "omnetpp/csimulation.h"
 #include "omnetpp/ccomponent.h"
 #include "omnetpp/any_ptr.h"
+#include "omnetpp/ccommbuffer.h"
+#include "omnetpp/opp_string.h"
 #include "expressionfilter.h"
 #include "common/pooledstring.h"
 
@@ -114,6 +116,57 @@ std::string ExpressionFilter::str() const
     return out.str();
 }
 
+typedef ExpressionFilter::ExprValue ExprValue;
+
+static void packValue(cCommBuffer *buffer, const ExprValue& value)
+{
+    buffer->pack((char)value.getType());
+    switch (value.getType()) {
+        case ExprValue::UNDEF: break;
+        case ExprValue::BOOL: buffer->pack(value.boolValue()); break;
+        case ExprValue::INT: buffer->pack(value.intValue()); buffer->pack(value.getUnit()); break;
+        case ExprValue::DOUBLE: buffer->pack(value.doubleValue()); buffer->pack(value.getUnit()); break;
+        case ExprValue::STRING: buffer->pack(value.stringValue()); break;
+        case ExprValue::POINTER: throw cRuntimeError("Cannot checkpoint object-valued expression filter inputs");
+    }
+}
+
+static ExprValue unpackValue(cCommBuffer *buffer)
+{
+    char type;
+    buffer->unpack(type);
+    opp_string unit, str;
+    switch (type) {
+        case ExprValue::UNDEF: return ExprValue();
+        case ExprValue::BOOL: {bool b; buffer->unpack(b); return ExprValue(b);}
+        case ExprValue::INT: {intval_t l; buffer->unpack(l); buffer->unpack(unit); return unit.empty() ? ExprValue(l) : ExprValue(l, unit.c_str());}
+        case ExprValue::DOUBLE: {double d; buffer->unpack(d); buffer->unpack(unit); return unit.empty() ? ExprValue(d) : ExprValue(d, unit.c_str());}
+        case ExprValue::STRING: buffer->unpack(str); return ExprValue(str.c_str());
+        default: throw cRuntimeError("Invalid expression filter value in checkpoint");
+    }
+}
+
+void ExpressionFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(numInputs);
+    for (int i = 0; i < numInputs; i++)
+        packValue(buffer, numInputs == 1 ? soleInput.lastValue : inputs[i].lastValue);
+    packValue(buffer, lastOutput);
+    buffer->pack(lastTimestamp);
+}
+
+void ExpressionFilter::restore(cCommBuffer *buffer)
+{
+    int n;
+    buffer->unpack(n);
+    if (n != numInputs)
+        throw cRuntimeError("Cannot restore expression filter '%s': Number of inputs differs", expr.str().c_str());
+    for (int i = 0; i < numInputs; i++)
+        (numInputs == 1 ? soleInput.lastValue : inputs[i].lastValue) = unpackValue(buffer);
+    lastOutput = unpackValue(buffer);
+    buffer->unpack(lastTimestamp);
+}
+
 int ExpressionFilter::findInput(const SignalSource& source) const
 {
     if (numInputs == 1)
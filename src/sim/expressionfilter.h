@@ -130,6 +130,8 @@ class SIM_API ExpressionFilter : public cResultFilter
         const virtual char *getName() const override;
         Expression& getExpression() {return expr;}
         virtual std::string str() const override;
+        virtual void checkpoint(cCommBuffer *buffer) override;
+        virtual void restore(cCommBuffer *buffer) override;
         int addInput(const SignalSource& source, FilterInputNode *filterInputNode);
         int getNumInputs() const {return numInputs;}
         SignalSource getInputSource(int k) const {ASSERT(k>=0 && k<numInputs); return numInputs==1 ? soleInput.source : inputs[k].source;}
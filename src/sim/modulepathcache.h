@@ -0,0 +1,82 @@
+//==========================================================================
+//  MODULEPATHCACHE.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_MODULEPATHCACHE_H
+#define __OMNETPP_MODULEPATHCACHE_H
+
+#include <cstring>
+#include <unordered_map>
+#include "common/stringpool.h"
+
+namespace omnetpp {
+namespace internal {
+
+/**
+ * Internal class for cSimulation: caches the results of absolute module path
+ * lookups, as module IDs (or -1 for paths that do not denote a module).
+ * The cache must be cleared whenever the module tree changes, i.e. when
+ * modules are created, deleted, renamed or moved.
+ */
+class ModulePathCache
+{
+  private:
+    struct str_hash {
+        std::size_t operator()(const char *s) const { return common::opp_hash((unsigned char *)s); }
+    };
+    struct str_eq {
+        bool operator()(const char *lhs, const char *rhs) const { return strcmp(lhs, rhs) == 0; }
+    };
+    std::unordered_map<const char *, int, str_hash, str_eq> moduleIds; // keys are owned by the cache
+
+    // a safety limit for models that look up an unbounded number of distinct paths
+    static const size_t MAX_ENTRIES = 1 << 20;
+
+  public:
+    ModulePathCache() {}
+    ModulePathCache(const ModulePathCache&) = delete;
+    ~ModulePathCache() {clear();}
+
+    bool lookup(const char *path, int& moduleId) const {
+        auto it = moduleIds.find(path);
+        if (it == moduleIds.end())
+            return false;
+        moduleId = it->second;
+        return true;
+    }
+
+    void put(const char *path, int moduleId) {
+        if (moduleIds.size() >= MAX_ENTRIES)
+            clear();
+        if (moduleIds.find(path) == moduleIds.end()) {
+            char *key = new char[strlen(path) + 1];
+            strcpy(key, path);
+            moduleIds[key] = moduleId;
+        }
+    }
+
+    void clear() {
+        if (moduleIds.empty())
+            return;
+        for (auto& entry : moduleIds)
+            delete[] entry.first;
+        moduleIds.clear();
+    }
+
+    size_t size() const {return moduleIds.size();}
+};
+
+}  // namespace internal
+}  // namespace omnetpp
+
+#endif
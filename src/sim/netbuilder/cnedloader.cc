@@ -14,6 +14,8 @@
   `license' for details on this and other legal matters.
 *--------------------------------------------------------------*/
 
+#include <algorithm>
+#include <thread>
 #include "common/stringutil.h"
 #include "common/fileutil.h"
 #include "common/stringtokenizer.h"
@@ -44,6 +46,8 @@ namespace omnetpp {
 
 Register_GlobalConfigOption(CFGID_NED_PATH, "ned-path", CFG_PATH, "", "A semicolon-separated list of directories. The directories will be regarded as roots of the NED package hierarchy, and all NED files will be loaded from their subdirectory trees. This option is normally left empty, as the OMNeT++ IDE sets the NED path automatically, and for simulations started outside the IDE it is more convenient to specify it via command-line option (-n) or via environment variable (OMNETPP_NED_PATH, NEDPATH).");
 Register_GlobalConfigOption(CFGID_NED_PACKAGE_EXCLUSIONS, "ned-package-exclusions", CFG_CUSTOM, "", "A semicolon-separated list of NED packages to be excluded when loading NED files. Sub-packages of excluded ones are also excluded. Additional items may be specified via the `-x` command-line option and the `OMNETPP_NED_PACKAGE_EXCLUSIONS` environment variable.");
+Register_GlobalConfigOption(CFGID_NED_LOADER_THREADS, "ned-loader-threads", CFG_INT, "0", "The number of threads to use for parsing NED files. 0 means the number of CPU cores. Regardless of this setting, NED files are registered in a deterministic order.");
+Register_GlobalConfigOption(CFGID_NED_CACHE_DIR, "ned-cache-dir", CFG_FILENAME, "", "Directory for a persistent cache of parsed and validated NED files, keyed by file name and content. Unchanged NED files are loaded from the cache, without parsing them again. The cache can be shared by simulations running concurrently. Empty means no caching. Can also be specified via the `OMNETPP_NED_CACHE_DIR` environment variable.");
 
 #define LOCK   std::lock_guard<std::recursive_mutex> guard(NedResourceCache::nedMutex)
 
@@ -92,6 +96,18 @@ void cNedLoader::configure(cConfiguration *cfg, const char *nArg, const char *xA
     LOCK;
     setNedPath(extractNedPath(cfg, nArg).c_str());
     setNedExcludedPackages(extractNedExcludedPackages(cfg, xArg).c_str());
+
+    int numThreads = cfg->getAsInt(CFGID_NED_LOADER_THREADS);
+    if (numThreads < 0)
+        throw cRuntimeError("Invalid value %d for '%s'", numThreads, CFGID_NED_LOADER_THREADS->getName());
+    if (numThreads == 0)
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    setNumLoaderThreads(numThreads);
+
+    std::string cacheDir = cfg->getAsFilename(CFGID_NED_CACHE_DIR);
+    if (cacheDir.empty())
+        cacheDir = opp_nulltoempty(getenv("OMNETPP_NED_CACHE_DIR"));
+    setAstCacheDir(cacheDir.c_str());
 }
 
 std::string cNedLoader::extractNedPath(cConfiguration *cfg, const char *nArg)
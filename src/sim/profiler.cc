@@ -0,0 +1,187 @@
+//==========================================================================
+//  PROFILER.CC - part of
+//                     OMNeT++/OMNEST
+//             Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include "profiler.h"
+#include "common/fileutil.h"
+#include "common/stringutil.h"
+#include "common/omnetppscalarfilewriter.h"
+#include "omnetpp/cmessage.h"
+#include "omnetpp/cmodule.h"
+#include "omnetpp/ccomponenttype.h"
+#include "omnetpp/cresultlistener.h"
+#include "omnetpp/csimulation.h"
+#include "omnetpp/cconfiguration.h"
+
+using namespace omnetpp::common;
+
+namespace omnetpp {
+namespace internal {
+
+Profiler::Profiler(int samplingInterval, const char *fileName, eventnumber_t startEventNumber) :
+    samplingInterval(samplingInterval < 1 ? 1 : samplingInterval), fileName(fileName)
+{
+    clear();
+    this->startEventNumber = startEventNumber;
+}
+
+void Profiler::clear()
+{
+    countdown = 1;
+    randomState = 1;
+    sampling = false;
+    listenerDepth = 0;
+    startEventNumber = 0;
+    numSampledEvents = 0;
+
+    modules.clear();
+    componentTypes.clear();
+    messageClasses.clear();
+    messageKinds.clear();
+    listeners.clear();
+    resultListeners.clear();
+    events = takeNextEvent = fesInserts = fesRemoves = Entry();
+
+    startTicks = now();
+    startTime = std::chrono::steady_clock::now();
+}
+
+int Profiler::nextInterval()
+{
+    if (samplingInterval == 1)
+        return 1;
+
+    // uniform in [1, 2*samplingInterval-1], i.e. samplingInterval on average;
+    // the randomization avoids aliasing with periodic patterns in the model
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return 1 + randomState % (2 * samplingInterval - 1);
+}
+
+void Profiler::beginEvent(cEvent *event, EventSample& sample)
+{
+    NamedEntry& classEntry = messageClasses[std::type_index(typeid(*event))];
+    if (classEntry.name.empty())
+        classEntry.name = event->getClassName();
+    sample.messageClassEntry = &classEntry;
+
+    if (event->isMessage()) {
+        cMessage *msg = static_cast<cMessage *>(event);
+        sample.messageKindEntry = &messageKinds[msg->getKind()];
+
+        cModule *module = msg->getArrivalModule();
+        if (module) {
+            int id = module->getId();
+            if (id >= (int)modules.size())
+                modules.resize(id + 1);
+            if (modules[id].name.empty())
+                modules[id].name = module->getFullPath();
+            sample.moduleId = id;
+            sample.componentTypeEntry = &componentTypes[module->getComponentType()];
+        }
+    }
+
+    sample.startTicks = now();
+}
+
+void Profiler::endEvent(const EventSample& sample)
+{
+    ticks_t t = now() - sample.startTicks;
+    sampling = false;
+
+    numSampledEvents++;
+    events.add(t);
+    sample.messageClassEntry->add(t);
+    if (sample.messageKindEntry)
+        sample.messageKindEntry->add(t);
+    if (sample.moduleId != -1) {
+        modules[sample.moduleId].add(t);
+        sample.componentTypeEntry->add(t);
+    }
+}
+
+void Profiler::recordListener(simsignal_t signalID, cIListener *listener, ticks_t t)
+{
+    std::vector<Entry>& entries = dynamic_cast<cResultListener *>(listener) ? resultListeners : listeners;
+    if (signalID >= (int)entries.size())
+        entries.resize(signalID + 1);
+    entries[signalID].add(t);
+}
+
+void Profiler::writeReport(cSimulation *simulation)
+{
+    cConfiguration *cfg = simulation->getConfig();
+    cModule *systemModule = simulation->getSystemModule();
+    std::string networkPath = systemModule->getFullPath();
+    eventnumber_t numEvents = simulation->getEventNumber() - startEventNumber;
+
+    // scale sampled values up to all events, and ticks to seconds
+    double factor = numSampledEvents == 0 ? 0 : (double)numEvents / numSampledEvents;
+    ticks_t elapsedTicks = now() - startTicks;
+    double elapsedSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    double secsPerTick = elapsedTicks == 0 ? 0 : elapsedSecs / elapsedTicks;
+
+    OmnetppScalarFileWriter::StringMap secondsUnit = {{"unit", "s"}};
+    OmnetppScalarFileWriter writer;
+
+    removeFile(fileName.c_str(), "old profiling result file");
+    mkPath(directoryOf(fileName.c_str()).c_str());
+    writer.open(fileName.c_str());
+
+    OmnetppScalarFileWriter::StringMap attributes = cfg->getPredefinedVariables();
+    attributes.erase(CFGVAR_RUNID);
+    writer.beginRecordingForRun(opp_nulltoempty(cfg->getVariable(CFGVAR_RUNID)), attributes, cfg->getIterationVariables(), {});
+
+    auto recordEntry = [&](const std::string& componentPath, const std::string& prefix, const Entry& entry) {
+        writer.recordScalar(componentPath, prefix + "count", factor * entry.count, {});
+        writer.recordScalar(componentPath, prefix + "time", factor * entry.ticks * secsPerTick, secondsUnit);
+    };
+
+    writer.recordScalar(networkPath, "profile:numEvents", numEvents, {});
+    writer.recordScalar(networkPath, "profile:numSampledEvents", numSampledEvents, {});
+    writer.recordScalar(networkPath, "profile:samplingInterval", samplingInterval, {});
+    writer.recordScalar(networkPath, "profile:elapsedTime", elapsedSecs, secondsUnit);
+    recordEntry(networkPath, "profile:event:", events);
+    recordEntry(networkPath, "profile:takeNextEvent:", takeNextEvent);
+    recordEntry(networkPath, "profile:fesInsert:", fesInserts);
+    recordEntry(networkPath, "profile:fesRemove:", fesRemoves);
+
+    // the unordered maps are written in name order, for reproducible files
+    std::map<std::string, const Entry *> sorted;
+    for (auto& entry : componentTypes)
+        sorted[std::string("profile:moduleType:") + entry.first->getFullName() + ":"] = &entry.second;
+    for (auto& entry : messageClasses)
+        sorted["profile:messageClass:" + entry.second.name + ":"] = &entry.second;
+    for (auto& entry : sorted)
+        recordEntry(networkPath, entry.first, *entry.second);
+    for (auto& entry : messageKinds)
+        recordEntry(networkPath, "profile:messageKind:" + std::to_string(entry.first) + ":", entry.second);
+    for (int i = 0; i < (int)listeners.size(); i++)
+        if (listeners[i].count != 0)
+            recordEntry(networkPath, std::string("profile:listener:") + opp_nulltoempty(cComponent::getSignalName(i)) + ":", listeners[i]);
+    for (int i = 0; i < (int)resultListeners.size(); i++)
+        if (resultListeners[i].count != 0)
+            recordEntry(networkPath, std::string("profile:resultRecording:") + opp_nulltoempty(cComponent::getSignalName(i)) + ":", resultListeners[i]);
+
+    for (auto& entry : modules)
+        if (entry.count != 0)
+            recordEntry(entry.name, "profile:event:", entry);
+
+    writer.endRecordingForRun();
+    writer.close();
+}
+
+}  // namespace internal
+}  // namespace omnetpp
+
@@ -0,0 +1,194 @@
+//==========================================================================
+//  PROFILER.H - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#ifndef __OMNETPP_PROFILER_H
+#define __OMNETPP_PROFILER_H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include "omnetpp/simkerneldefs.h"
+#include "omnetpp/clistener.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define OPP_PROFILER_USE_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define OPP_PROFILER_USE_TSC
+#endif
+
+namespace omnetpp {
+
+class cEvent;
+class cIListener;
+class cComponentType;
+class cSimulation;
+
+namespace internal {
+
+/**
+ * Internal class for cSimulation: an opt-in profiler (see the `profiling`
+ * configuration option) that accumulates wall-clock time and counts per
+ * module, module type, message class and message kind, and for signal
+ * listeners, result recorders and FES operations.
+ *
+ * Time is measured with the CPU timestamp counter where available (calibrated
+ * against the steady clock at the end of the run), and only for a random
+ * subset of the events: the mean distance between sampled events is the
+ * sampling interval. Results are extrapolated to all events, and written
+ * into a file in the output scalar file format at the end of the run.
+ */
+class SIM_API Profiler
+{
+  public:
+    typedef uint64_t ticks_t;
+
+  private:
+    struct Entry {
+        uint64_t count = 0;
+        ticks_t ticks = 0;
+        void add(ticks_t t) {count++; ticks += t;}
+    };
+
+    struct NamedEntry : Entry {
+        std::string name;
+    };
+
+  public:
+    // per-event data collected before the event is executed, because the
+    // message may be deleted and the module may be gone by the end of it
+    struct EventSample {
+        int moduleId = -1;
+        Entry *componentTypeEntry = nullptr;
+        Entry *messageClassEntry = nullptr;
+        Entry *messageKindEntry = nullptr;
+        ticks_t startTicks = 0;
+    };
+
+  private:
+    // configuration
+    int samplingInterval;
+    std::string fileName;
+    eventnumber_t startEventNumber;  // event number at which profiling started
+
+    // sampling state
+    int countdown = 1;          // number of events until the next sampled one
+    uint32_t randomState = 1;   // xorshift32 state; not the simulation's RNGs, so that results are not affected
+    bool sampling = false;      // whether the current event is being sampled
+    int listenerDepth = 0;      // nesting level of listener calls in the current event
+    uint64_t numSampledEvents = 0;
+
+    // calibration of ticks against the steady clock
+    ticks_t startTicks;
+    std::chrono::steady_clock::time_point startTime;
+
+    // results
+    std::vector<NamedEntry> modules;  // indexed by module ID
+    std::unordered_map<const cComponentType*, Entry> componentTypes;
+    std::unordered_map<std::type_index, NamedEntry> messageClasses;
+    std::map<short, Entry> messageKinds;
+    std::vector<Entry> listeners;     // indexed by signal ID
+    std::vector<Entry> resultListeners;  // indexed by signal ID
+    Entry events;
+    Entry takeNextEvent;
+    Entry fesInserts;
+    Entry fesRemoves;
+
+  private:
+    int nextInterval();
+    void recordListener(simsignal_t signalID, cIListener *listener, ticks_t t);
+
+  public:
+    Profiler(int samplingInterval, const char *fileName, eventnumber_t startEventNumber=0);
+    void clear();  // call on network deletion
+
+    static ticks_t now() {
+#ifdef OPP_PROFILER_USE_TSC
+        return __rdtsc();
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+    // decides whether the next event is sampled; call before taking it from the FES
+    bool startSample() {
+        sampling = --countdown <= 0;
+        if (sampling) {
+            countdown = nextInterval();
+            listenerDepth = 0;
+        }
+        return sampling;
+    }
+    bool isSampling() const {return sampling;}
+
+    void beginEvent(cEvent *event, EventSample& sample);
+    void endEvent(const EventSample& sample);
+    void recordTakeNextEvent(ticks_t t) {takeNextEvent.add(t);}
+    void recordFesInsert(ticks_t t) {fesInserts.add(t);}
+    void recordFesRemove(ticks_t t) {fesRemoves.add(t);}
+
+    // nested listener calls (emit() from a listener) are accounted to the outermost one
+    ticks_t enterListener() {listenerDepth++; return now();}
+    void leaveListener(simsignal_t signalID, cIListener *listener, ticks_t start) {
+        ticks_t t = now() - start;
+        if (--listenerDepth == 0)
+            recordListener(signalID, listener, t);
+    }
+
+    void writeReport(cSimulation *simulation);
+
+    /**
+     * Brackets a sampled event with beginEvent()/endEvent(), also when the
+     * event is left with an exception (e.g. the cTerminationException thrown
+     * by endSimulation()). No-op if the profiler pointer is nullptr.
+     */
+    class EventGuard {
+      private:
+        Profiler *profiler;
+        EventSample sample;
+      public:
+        EventGuard(Profiler *profiler, cEvent *event) : profiler(profiler) {if (profiler) profiler->beginEvent(event, sample);}
+        ~EventGuard() {if (profiler) profiler->endEvent(sample);}
+        EventGuard(const EventGuard&) = delete;
+        EventGuard& operator=(const EventGuard&) = delete;
+    };
+
+    /**
+     * Brackets a listener call with enterListener()/leaveListener(), also
+     * when the listener throws.
+     */
+    class ListenerGuard {
+      private:
+        Profiler *profiler;
+        simsignal_t signalID;
+        cIListener *listener;
+        ticks_t start;
+      public:
+        ListenerGuard(Profiler *profiler, simsignal_t signalID, cIListener *listener) :
+            profiler(profiler), signalID(signalID), listener(listener), start(profiler->enterListener()) {}
+        ~ListenerGuard() {profiler->leaveListener(signalID, listener, start);}
+        ListenerGuard(const ListenerGuard&) = delete;
+        ListenerGuard& operator=(const ListenerGuard&) = delete;
+    };
+};
+
+}  // namespace internal
+}  // namespace omnetpp
+
+#endif
+
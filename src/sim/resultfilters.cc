@@ -16,6 +16,7 @@
 #include "omnetpp/cpacket.h"  // PacketBytesFilter
 #include "omnetpp/cproperty.h"
 #include "omnetpp/checkandcast.h"
+#include "omnetpp/ccommbuffer.h"
 #include "omnetpp/resultfilters.h"
 #include "omnetpp/cresultrecorder.h"
 
@@ -292,6 +293,17 @@ std::string DemuxFilter::str() const
     return os.str();
 }
 
+void DemuxFilter::checkpoint(cCommBuffer *buffer)
+{
+    // the output chains created on demand would have to be re-created on restore
+    if (!labelToDelegateStartIndexMap.empty())
+        throw cRuntimeError("%s: Checkpointing is not supported after values have been received", getClassName());
+}
+
+void DemuxFilter::restore(cCommBuffer *buffer)
+{
+}
+
 //---
 
 std::string TotalCountFilter::str() const
@@ -301,6 +313,16 @@ std::string TotalCountFilter::str() const
     return os.str();
 }
 
+void TotalCountFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(count);
+}
+
+void TotalCountFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(count);
+}
+
 //---
 
 std::string ConstantFilter::str() const
@@ -337,6 +359,16 @@ std::string CountNanFilter::str() const
     return os.str();
 }
 
+void CountNanFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(count);
+}
+
+void CountNanFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(count);
+}
+
 //---
 
 bool SumFilter::process(simtime_t& t, double& value, cObject* details)
@@ -355,6 +387,16 @@ std::string SumFilter::str() const
     return os.str();
 }
 
+void SumFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(sum);
+}
+
+void SumFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(sum);
+}
+
 //---
 
 void MeanFilter::init(Context *ctx)
@@ -411,6 +453,24 @@ std::string MeanFilter::str() const
     return os.str();
 }
 
+void MeanFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(count);
+    buffer->pack(lastValue);
+    buffer->pack(lastTime);
+    buffer->pack(weightedSum);
+    buffer->pack(totalTime);
+}
+
+void MeanFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(count);
+    buffer->unpack(lastValue);
+    buffer->unpack(lastTime);
+    buffer->unpack(weightedSum);
+    buffer->unpack(totalTime);
+}
+
 //---
 
 bool MinFilter::process(simtime_t& t, double& value, cObject *details)
@@ -430,6 +490,16 @@ std::string MinFilter::str() const
     return os.str();
 }
 
+void MinFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(min);
+}
+
+void MinFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(min);
+}
+
 //---
 
 
@@ -450,6 +520,16 @@ std::string MaxFilter::str() const
     return os.str();
 }
 
+void MaxFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(max);
+}
+
+void MaxFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(max);
+}
+
 //---
 
 
@@ -470,6 +550,18 @@ std::string AverageFilter::str() const
     return os.str();
 }
 
+void AverageFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(count);
+    buffer->pack(sum);
+}
+
+void AverageFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(count);
+    buffer->unpack(sum);
+}
+
 //---
 
 bool TimeAverageFilter::process(simtime_t& t, double& value, cObject *details)
@@ -504,6 +596,22 @@ std::string TimeAverageFilter::str() const
     return os.str();
 }
 
+void TimeAverageFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(lastValue);
+    buffer->pack(lastTime);
+    buffer->pack(weightedSum);
+    buffer->pack(totalTime);
+}
+
+void TimeAverageFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(lastValue);
+    buffer->unpack(lastTime);
+    buffer->unpack(weightedSum);
+    buffer->unpack(totalTime);
+}
+
 //---
 
 std::string RemoveRepeatsFilter::str() const
@@ -513,6 +621,16 @@ std::string RemoveRepeatsFilter::str() const
     return os.str();
 }
 
+void RemoveRepeatsFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(prev);
+}
+
+void RemoveRepeatsFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(prev);
+}
+
 bool RemoveRepeatsFilter::process(simtime_t& t, double& value, cObject *details)
 {
     bool repeated = std::isnan(value) ? std::isnan(prev) : value==prev;
@@ -566,5 +684,15 @@ std::string SumPerDurationFilter::str() const
     return os.str();
 }
 
+void SumPerDurationFilter::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(sum);
+}
+
+void SumPerDurationFilter::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(sum);
+}
+
 }  // namespace omnetpp
 
@@ -18,8 +18,11 @@
 #include "omnetpp/csimulation.h"
 #include "omnetpp/cstatistic.h"
 #include "omnetpp/checkandcast.h"
+#include "omnetpp/ccommbuffer.h"
 #include "omnetpp/cpsquare.h"
 #include "omnetpp/cksplit.h"
+#include "omnetpp/cddsketch.h"
+#include "omnetpp/cstringtokenizer.h"
 #include "omnetpp/resultrecorders.h"
 #include "common/stringutil.h"
 
@@ -119,6 +122,14 @@ Register_ResultRecorder2("ksplit", KSplitRecorder,
         SIGNALTYPE_TO_NUMERIC_CONVERSIONS
         OPTIONALLY_TIMEWEIGHTED
 );
+Register_ResultRecorder2("quantiles", QuantilesRecorder,
+        "Records a mergeable quantile sketch of the input values (cDDSketch class) as a histogram, "
+        "with the estimated quantiles as result attributes (p50, p99, etc.). "
+        "The quantiles can be selected with the 'quantiles' attribute (default: 'quantiles=0.5,0.9,0.99,0.999'), "
+        "the accuracy with the 'relativeAccuracy' (default: 0.01) and 'maxBins' (default: 2048) attributes. "
+        SIGNALTYPE_TO_NUMERIC_CONVERSIONS
+        OPTIONALLY_TIMEWEIGHTED
+);
 
 VectorRecorder::~VectorRecorder()
 {
@@ -163,6 +174,18 @@ std::string VectorRecorder::str() const
     return os.str();
 }
 
+void VectorRecorder::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(lastTime);
+    buffer->pack(lastValue);
+}
+
+void VectorRecorder::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(lastTime);
+    buffer->unpack(lastValue);
+}
+
 //---
 
 void TotalCountRecorder::finish(cResultFilter *prev)
@@ -178,6 +201,16 @@ std::string TotalCountRecorder::str() const
     return os.str();
 }
 
+void TotalCountRecorder::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(count);
+}
+
+void TotalCountRecorder::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(count);
+}
+
 //---
 
 void LastValueRecorder::collect(simtime_t_cref t, double value, cObject *details)
@@ -199,6 +232,16 @@ std::string LastValueRecorder::str() const
     return os.str();
 }
 
+void LastValueRecorder::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(lastValue);
+}
+
+void LastValueRecorder::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(lastValue);
+}
+
 //---
 
 void ErrorNanRecorder::collect(simtime_t_cref t, double value, cObject *details)
@@ -228,6 +271,16 @@ std::string SumRecorder::str() const
     return os.str();
 }
 
+void SumRecorder::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(sum);
+}
+
+void SumRecorder::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(sum);
+}
+
 //---
 
 void MeanRecorder::init(Context *ctx)
@@ -264,6 +317,24 @@ std::string MeanRecorder::str() const
     return os.str();
 }
 
+void MeanRecorder::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(count);
+    buffer->pack(lastValue);
+    buffer->pack(lastTime);
+    buffer->pack(weightedSum);
+    buffer->pack(totalTime);
+}
+
+void MeanRecorder::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(count);
+    buffer->unpack(lastValue);
+    buffer->unpack(lastTime);
+    buffer->unpack(weightedSum);
+    buffer->unpack(totalTime);
+}
+
 double MeanRecorder::getMean() const
 {
     if (!timeWeighted) {
@@ -312,6 +383,16 @@ std::string MinRecorder::str() const
     return os.str();
 }
 
+void MinRecorder::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(min);
+}
+
+void MinRecorder::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(min);
+}
+
 //---
 
 void MaxRecorder::collect(simtime_t_cref t, double value, cObject *details)
@@ -335,6 +416,16 @@ std::string MaxRecorder::str() const
     return os.str();
 }
 
+void MaxRecorder::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(max);
+}
+
+void MaxRecorder::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(max);
+}
+
 //---
 
 void AverageRecorder::collect(simtime_t_cref t, double value, cObject *details)
@@ -358,6 +449,18 @@ std::string AverageRecorder::str() const
     return os.str();
 }
 
+void AverageRecorder::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(count);
+    buffer->pack(sum);
+}
+
+void AverageRecorder::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(count);
+    buffer->unpack(sum);
+}
+
 //---
 
 void TimeAverageRecorder::collect(simtime_t_cref t, double value, cObject *details)
@@ -396,6 +499,22 @@ std::string TimeAverageRecorder::str() const
     return os.str();
 }
 
+void TimeAverageRecorder::checkpoint(cCommBuffer *buffer)
+{
+    buffer->pack(lastValue);
+    buffer->pack(lastTime);
+    buffer->pack(weightedSum);
+    buffer->pack(totalTime);
+}
+
+void TimeAverageRecorder::restore(cCommBuffer *buffer)
+{
+    buffer->unpack(lastValue);
+    buffer->unpack(lastTime);
+    buffer->unpack(weightedSum);
+    buffer->unpack(totalTime);
+}
+
 //---
 
 StatisticsRecorder::~StatisticsRecorder()
@@ -446,6 +565,20 @@ std::string StatisticsRecorder::str() const
     return os.str();
 }
 
+void StatisticsRecorder::checkpoint(cCommBuffer *buffer)
+{
+    statistic->parsimPack(buffer);
+    buffer->pack(lastValue);
+    buffer->pack(lastTime);
+}
+
+void StatisticsRecorder::restore(cCommBuffer *buffer)
+{
+    statistic->parsimUnpack(buffer);
+    buffer->unpack(lastValue);
+    buffer->unpack(lastTime);
+}
+
 inline bool getBoolAttr(const opp_string_map& attrs, const char *name, bool defaultValue)
 {
     auto it = attrs.find(name);
@@ -458,6 +591,12 @@ inline int getIntAttr(const opp_string_map& attrs, const char *name, int default
     return it == attrs.end() ? defaultValue : opp_atol(it->second.c_str());
 }
 
+inline double getDoubleAttr(const opp_string_map& attrs, const char *name, double defaultValue)
+{
+    auto it = attrs.find(name);
+    return it == attrs.end() ? defaultValue : opp_atof(it->second.c_str());
+}
+
 void StatsRecorder::init(Context *ctx)
 {
     StatisticsRecorder::init(ctx);
@@ -512,5 +651,34 @@ void KSplitRecorder::init(Context *ctx)
     setStatistic(new cKSplit("ksplit"));
 }
 
+void QuantilesRecorder::init(Context *ctx)
+{
+    StatisticsRecorder::init(ctx);
+    const opp_string_map& attrs = getStatisticAttributes();
+    bool weighted = getBoolAttr(attrs, "timeWeighted", false);
+    double relativeAccuracy = getDoubleAttr(attrs, "relativeAccuracy", 0.01);
+    int maxBins = getIntAttr(attrs, "maxBins", 2048);
+
+    auto it = attrs.find("quantiles");
+    const char *quantilesAttr = it == attrs.end() ? "0.5,0.9,0.99,0.999" : it->second.c_str();
+    quantiles = cStringTokenizer(quantilesAttr, " ,").asDoubleVector();
+    for (double q : quantiles)
+        if (q < 0 || q > 1)
+            throw cRuntimeError("%s: Quantile %g is out of the [0,1] interval", getClassName(), q);
+
+    setStatistic(new cDDSketch("quantiles", relativeAccuracy, maxBins, weighted));
+}
+
+void QuantilesRecorder::finish(cResultFilter *prev)
+{
+    if (statistic->isWeighted() && !std::isnan(lastValue))
+        statistic->collectWeighted(lastValue, simTime() - lastTime);
+
+    opp_string_map attributes = getStatisticAttributes();
+    attributes.erase("quantiles");
+    static_cast<cDDSketch *>(statistic)->addResultAttributes(attributes, quantiles);
+    getEnvir()->recordStatistic(getComponent(), getResultName().c_str(), statistic, &attributes);
+}
+
 }  // namespace omnetpp
 
@@ -0,0 +1,164 @@
+//==========================================================================
+//  STREAMCOMMBUFFER.CC - part of
+//                     OMNeT++/OMNEST
+//            Discrete System Simulation in C++
+//
+//==========================================================================
+
+/*--------------------------------------------------------------*
+  Copyright (C) 2006-2017 OpenSim Ltd.
+
+  This file is distributed WITHOUT ANY WARRANTY. See the file
+  `license' for details on this and other legal matters.
+*--------------------------------------------------------------*/
+
+#include <cstring>
+#include "omnetpp/cexception.h"
+#include "omnetpp/opp_string.h"
+#include "streamcommbuffer.h"
+
+namespace omnetpp {
+namespace internal {
+
+void StreamCommBuffer::write(const void *data, size_t size)
+{
+    if (!out)
+        throw cRuntimeError("StreamCommBuffer: Buffer is open for reading");
+    if (size > 0 && !out->write((const char *)data, size))
+        throw cRuntimeError("StreamCommBuffer: Write error");
+}
+
+void StreamCommBuffer::read(void *data, size_t size)
+{
+    if (!in)
+        throw cRuntimeError("StreamCommBuffer: Buffer is open for writing");
+    if (size > 0 && !in->read((char *)data, size))
+        throw cRuntimeError("StreamCommBuffer: Unexpected end of data, or read error");
+}
+
+bool StreamCommBuffer::isBufferEmpty() const
+{
+    return !in || in->peek() == std::istream::traits_type::eof();
+}
+
+void StreamCommBuffer::assertBufferEmpty()
+{
+    if (!isBufferEmpty())
+        throw cRuntimeError("StreamCommBuffer: Extra data after the end of the expected data");
+}
+
+#define PACKUNPACK(type) \
+    void StreamCommBuffer::pack(type d)  {write(&d, sizeof(type));} \
+    void StreamCommBuffer::unpack(type& d)  {read(&d, sizeof(type));} \
+    void StreamCommBuffer::pack(const type *d, int size)  {write(d, size*sizeof(type));} \
+    void StreamCommBuffer::unpack(type *d, int size)  {read(d, size*sizeof(type));}
+
+PACKUNPACK(char)
+PACKUNPACK(unsigned char)
+PACKUNPACK(bool)
+PACKUNPACK(short)
+PACKUNPACK(unsigned short)
+PACKUNPACK(int)
+PACKUNPACK(unsigned int)
+PACKUNPACK(long)
+PACKUNPACK(unsigned long)
+PACKUNPACK(long long)
+PACKUNPACK(unsigned long long)
+PACKUNPACK(float)
+PACKUNPACK(double)
+PACKUNPACK(long double)
+
+#undef PACKUNPACK
+
+void StreamCommBuffer::pack(const char *d)
+{
+    int len = d ? strlen(d) : 0;
+    pack(len);
+    write(d, len);
+}
+
+void StreamCommBuffer::pack(const opp_string& d)
+{
+    pack(d.c_str());
+}
+
+void StreamCommBuffer::pack(SimTime d)
+{
+    pack((long long)d.raw());
+}
+
+void StreamCommBuffer::pack(const char **d, int size)
+{
+    for (int i = 0; i < size; i++)
+        pack(d[i]);
+}
+
+void StreamCommBuffer::pack(const opp_string *d, int size)
+{
+    for (int i = 0; i < size; i++)
+        pack(d[i]);
+}
+
+void StreamCommBuffer::pack(const SimTime *d, int size)
+{
+    for (int i = 0; i < size; i++)
+        pack(d[i]);
+}
+
+void StreamCommBuffer::unpack(const char *& d)
+{
+    int len;
+    unpack(len);
+    if (len < 0)
+        throw cRuntimeError("StreamCommBuffer: Invalid string length in data");
+    char *tmp = new char[len+1];
+    try {
+        read(tmp, len);
+    }
+    catch (std::exception&) {
+        delete[] tmp;
+        throw;
+    }
+    tmp[len] = '\0';
+    d = tmp;
+}
+
+void StreamCommBuffer::unpack(opp_string& d)
+{
+    int len;
+    unpack(len);
+    if (len < 0)
+        throw cRuntimeError("StreamCommBuffer: Invalid string length in data");
+    d.reserve(len+1);
+    read(d.buffer(), len);
+    d.buffer()[len] = '\0';
+}
+
+void StreamCommBuffer::unpack(SimTime& d)
+{
+    long long raw;
+    unpack(raw);
+    d.setRaw(raw);
+}
+
+void StreamCommBuffer::unpack(const char **d, int size)
+{
+    for (int i = 0; i < size; i++)
+        unpack(d[i]);
+}
+
+void StreamCommBuffer::unpack(opp_string *d, int size)
+{
+    for (int i = 0; i < size; i++)
+        unpack(d[i]);
+}
+
+void StreamCommBuffer::unpack(SimTime *d, int size)
+{
+    for (int i = 0; i < size; i++)
+        unpack(d[i]);
+}
+
+}  // namespace internal
+}  // namespace omnetpp
+
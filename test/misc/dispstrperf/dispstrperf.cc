@@ -0,0 +1,51 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class DisplayStringBenchmark : public cSimpleModule
+{
+  protected:
+    template <typename F> double measure(long numUpdates, F update);
+    virtual void initialize() override;
+};
+
+Define_Module(DisplayStringBenchmark);
+
+template <typename F>
+double DisplayStringBenchmark::measure(long numUpdates, F update)
+{
+    cDisplayString& ds = getDisplayString();
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < numUpdates; i++)
+        update(ds, 100 + (i % 1000) * 0.25, 200 + (i % 777) * 0.5);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / numUpdates * 1e9;
+}
+
+void DisplayStringBenchmark::initialize()
+{
+    long numUpdates = par("numUpdates").intValue();
+
+    double sprintfTime = measure(numUpdates, [](cDisplayString& ds, double x, double y) {
+        char buf[32];
+        sprintf(buf, "%g", x);
+        ds.setTagArg("p", 0, buf);
+        sprintf(buf, "%g", y);
+        ds.setTagArg("p", 1, buf);
+    });
+    double toStringTime = measure(numUpdates, [](cDisplayString& ds, double x, double y) {
+        ds.setTagArg("p", 0, std::to_string(x).c_str());
+        ds.setTagArg("p", 1, std::to_string(y).c_str());
+    });
+    double numericTime = measure(numUpdates, [](cDisplayString& ds, double x, double y) {
+        ds.setTagArg("p", 0, x);
+        ds.setTagArg("p", 1, y);
+    });
+
+    EV << "sprintf() + string setter:        " << sprintfTime << " ns/update\n";
+    EV << "std::to_string() + string setter: " << toStringTime << " ns/update\n";
+    EV << "numeric setter:                   " << numericTime << " ns/update\n";
+    EV << "display string at the end: " << getDisplayString().str() << "\n";
+}
@@ -0,0 +1,41 @@
+#include <chrono>
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class DistribBenchmark : public cSimpleModule
+{
+  protected:
+    template <typename F> void measure(const char *label, long numIterations, F generate);
+    virtual void initialize() override;
+};
+
+Define_Module(DistribBenchmark);
+
+template <typename F>
+void DistribBenchmark::measure(const char *label, long numIterations, F generate)
+{
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < numIterations; i++)
+        sum += generate();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EV << label << ": " << (numIterations / seconds / 1e6) << " Mvariates/s, mean: " << (sum / numIterations) << "\n";
+}
+
+void DistribBenchmark::initialize()
+{
+    long numIterations = par("numIterations").intValue();
+    cRNG *rng = getRNG(0);
+    measure("uniform(0,1)     ", numIterations, [=]() {return omnetpp::uniform(rng, 0, 1);});
+    measure("exponential(1)   ", numIterations, [=]() {return omnetpp::exponential(rng, 1);});
+    measure("normal(0,1)      ", numIterations, [=]() {return omnetpp::normal(rng, 0, 1);});
+    measure("truncnormal(0,1) ", numIterations, [=]() {return omnetpp::truncnormal(rng, 0, 1);});
+    measure("lognormal(0,1)   ", numIterations, [=]() {return omnetpp::lognormal(rng, 0, 1);});
+    measure("gamma_d(0.5,1)   ", numIterations, [=]() {return omnetpp::gamma_d(rng, 0.5, 1);});
+    measure("gamma_d(2.5,1)   ", numIterations, [=]() {return omnetpp::gamma_d(rng, 2.5, 1);});
+    measure("poisson(5)       ", numIterations, [=]() {return (double)omnetpp::poisson(rng, 5);});
+    measure("poisson(20)      ", numIterations, [=]() {return (double)omnetpp::poisson(rng, 20);});
+    measure("poisson(100)     ", numIterations, [=]() {return (double)omnetpp::poisson(rng, 100);});
+    measure("poisson(10000)   ", numIterations, [=]() {return (double)omnetpp::poisson(rng, 10000);});
+}
@@ -134,6 +134,106 @@ sub testFilter
    unlink("result/tmp.elog");
 }
 
+sub testBinaryRoundTrip
+{
+   my($fileName, $lastEventNumber) = @_;
+
+   print("\nTesting binary conversion on $fileName\n");
+
+   print("  Converting the input file to binary and back to text\n");
+   system("$eventLogTool tobinary -o result/tmp.belog $fileName") == 0
+      or print("*** FAIL: Testing tobinary on $fileName failed\n");
+   system("$eventLogTool totext -o result/tmp.elog result/tmp.belog") == 0
+      or print("*** FAIL: Testing totext on $fileName failed\n");
+
+   print("  Diffing output against original input file\n");
+   system("diff result/tmp.elog $fileName > result/tmp.diff");
+   $fail = (stat("result/tmp.diff"))[7] != 0;
+
+   # the binary file is read directly, through the decoding FileReader
+   print("  Echoing the binary file\n");
+   system("$eventLogTool echo -o result/tmp2.elog result/tmp.belog") == 0
+      or print("*** FAIL: Testing echo on binary $fileName failed\n");
+   system("$eventLogTool echo -o result/tmp3.elog $fileName");
+   system("diff result/tmp2.elog result/tmp3.elog > result/tmp.diff");
+   $fail ||= (stat("result/tmp.diff"))[7] != 0;
+
+   # seeking by event number must keep the file offsets in snapshot and index entries intact
+   open(FULL, "<result/tmp.elog");
+   $full = join("", <FULL>);
+   close(FULL);
+   for ($i = 0; $i <= $lastEventNumber; $i += int($lastEventNumber / 10) + 1)
+   {
+      system("$eventLogTool totext -fe $i -o result/tmp2.elog result/tmp.belog") == 0
+         or print("*** FAIL: Testing totext -fe $i on $fileName failed\n");
+      open(PART, "<result/tmp2.elog");
+      $part = join("", <PART>);
+      close(PART);
+      if (substr($full, -length($part)) ne $part)
+      {
+         print("*** FAIL: totext -fe $i is not the end of the whole content for $fileName\n");
+         $fail = 1;
+      }
+   }
+
+   unlink("result/tmp.elog");
+   unlink("result/tmp2.elog");
+   unlink("result/tmp3.elog");
+   unlink("result/tmp.belog");
+
+   if ($fail)
+   {
+      print("*** FAIL: Binary conversion returned different content for $fileName\n");
+   }
+   else
+   {
+      print("PASS\n");
+   }
+
+   unlink("result/tmp.diff");
+}
+
+sub testIndexedFilter
+{
+   my($fileName, $lastEventNumber) = @_;
+
+   print("\nTesting indexed filter on $fileName\n");
+
+   # the index is written next to the input file, so work on a copy
+   system("cp $fileName result/tmp.elog");
+   $fail = 0;
+   for ($i = 0; $i <= $lastEventNumber; $i += 7)
+   {
+      print("  Tracing event number $i in $fileName with and without index\n");
+
+      unlink("result/tmp.elog.eidx");
+      system("$eventLogTool filter -e $i -o result/tmp1.elog result/tmp.elog") == 0
+         or print("*** FAIL: Testing filter on $fileName failed\n");
+      system("$eventLogTool index -j 4 result/tmp.elog") == 0
+         or print("*** FAIL: Testing index on $fileName failed\n");
+      system("$eventLogTool filter -e $i -o result/tmp2.elog result/tmp.elog") == 0
+         or print("*** FAIL: Testing indexed filter on $fileName failed\n");
+
+      system("diff result/tmp1.elog result/tmp2.elog > result/tmp.diff");
+      if ((stat("result/tmp.diff"))[7] != 0)
+      {
+         print("*** FAIL: Indexed filter returned different content for $fileName\n");
+         $fail = 1;
+      }
+   }
+
+   if (!$fail)
+   {
+      print("PASS\n");
+   }
+
+   unlink("result/tmp.elog");
+   unlink("result/tmp.elog.eidx");
+   unlink("result/tmp1.elog");
+   unlink("result/tmp2.elog");
+   unlink("result/tmp.diff");
+}
+
 sub testEventLogTool
 {
    my($fileName) = @_;
@@ -149,6 +249,8 @@ sub testEventLogTool
    testOffsets($fileName);
    testEvents($fileName, $lastEventNumber);
    testFilter($fileName, $lastEventNumber);
+   testBinaryRoundTrip($fileName, $lastEventNumber);
+   testIndexedFilter($fileName, $lastEventNumber);
 }
 
 testEventLogTool("elog/predefined/simple/empty.elog");
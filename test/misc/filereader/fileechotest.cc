@@ -27,10 +27,11 @@
 using namespace omnetpp;
 using namespace omnetpp::common;
 
-void testFileEcho(const char *file, bool forward)
+void testFileEcho(const char *file, bool forward, bool memoryMapping)
 {
     _setmode(_fileno(stdout), _O_BINARY);
     FileReader fileReader(file);
+    fileReader.setMemoryMapping(memoryMapping);
 
     if (forward)
         fileReader.seekTo(0);
@@ -50,7 +51,7 @@ void usage(const char *message)
 
     fprintf(stderr, ""
                     "Usage:\n"
-                    "   fileechotest <input-file-name> (forward|backward)\n"
+                    "   fileechotest <input-file-name> (forward|backward) [mmap]\n"
             );
 }
 
@@ -62,7 +63,7 @@ int main(int argc, char **argv)
             return -1;
         }
         else {
-            testFileEcho(argv[1], strcmp(argv[2], "backward"));
+            testFileEcho(argv[1], strcmp(argv[2], "backward"), argc > 3 && !strcmp(argv[3], "mmap"));
             return 0;
         }
     }
@@ -14,6 +14,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fcntl.h>
 #include <common/lcgrandom.h>
 #include <common/exception.h>
@@ -33,10 +34,13 @@ int parseLineNumber(char *line)
     return !line || *line == '\r' || *line == '\n' ? -1 : atol(line);
 }
 
-void testFileReader(const char *file, long numberOfLines, int numberOfSeeks, int numberOfReadLines)
+void testFileReader(const char *file, long numberOfLines, int numberOfSeeks, int numberOfReadLines, bool memoryMapping)
 {
     _setmode(_fileno(stdout), _O_BINARY);
     FileReader fileReader(file);
+    fileReader.setMemoryMapping(memoryMapping);
+    if (memoryMapping)
+        fileReader.setAccessPattern(FileReader::ACCESS_RANDOM);
     LCGRandom random;
     int64_t fileSize = fileReader.getFileSize();
 
@@ -121,7 +125,7 @@ void usage(const char *message)
 
     fprintf(stderr, ""
                     "Usage:\n"
-                    "   filereadertest <input-file-name> <number-of-lines> <number-of-seeks> <number-of-read-lines-per-seek>\n"
+                    "   filereadertest <input-file-name> <number-of-lines> <number-of-seeks> <number-of-read-lines-per-seek> [mmap]\n"
             );
 }
 
@@ -134,7 +138,7 @@ int main(int argc, char **argv)
             return -1;
         }
         else {
-            testFileReader(argv[1], atol(argv[2]), atoi(argv[3]), atoi(argv[4]));
+            testFileReader(argv[1], atol(argv[2]), atoi(argv[3]), atoi(argv[4]), argc > 5 && !strcmp(argv[5], "mmap"));
             printf("PASS\n");
 
             return 0;
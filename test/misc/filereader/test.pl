@@ -61,6 +61,46 @@ sub test
    }
 }
 
+sub testMemoryMapped
+{
+   my($fileName, $numberOfLines, $numberOfSeeks, $numberOfReadLines) = @_;
+
+   print("Testing $fileName with memory mapping...\n");
+   $resultFileName = $fileName;
+   $forwardResultFileName = $fileName;
+   $backwardResultFileName = $fileName;
+   $resultFileName =~ s/^(.*)\//results\/mmap-/;
+   $forwardResultFileName =~ s/^(.*)\//results\/mmap-forward-/;
+   $backwardResultFileName =~ s/^(.*)\//results\/mmap-backward-/;
+
+   if (system("${progdir}fileechotest $fileName forward mmap > $forwardResultFileName") == 0 && matchFiles($fileName, $forwardResultFileName))
+   {
+      print("PASS: Forward echoing $fileName with memory mapping\n\n");
+   }
+   else
+   {
+      print("FAIL: Forward echoing $fileName with memory mapping\n\n");
+   }
+
+   if (system("${progdir}fileechotest $fileName backward mmap > $backwardResultFileName") == 0)
+   {
+      print("PASS: Backward echoing $fileName with memory mapping\n\n");
+   }
+   else
+   {
+      print("FAIL: Backward echoing $fileName with memory mapping\n\n");
+   }
+
+   if (system("${progdir}filereadertest $fileName $numberOfLines $numberOfSeeks $numberOfReadLines mmap > $resultFileName") == 0)
+   {
+      print("PASS: Reader test on $fileName with memory mapping\n\n");
+   }
+   else
+   {
+      print("FAIL: Reader test on $fileName with memory mapping\n\n");
+   }
+}
+
 sub generateContent
 {
    my($maxLineSize) = @_;
@@ -103,7 +143,9 @@ sub generateAndTest
 {
    my($fileName, $fileSize, $maxLineSize, $numberOfSeeks, $numberOfReadLines) = @_;
 
-   test($fileName, generate($fileName, $fileSize, $maxLineSize), $numberOfSeeks, $numberOfReadLines);
+   my $numberOfLines = generate($fileName, $fileSize, $maxLineSize);
+   test($fileName, $numberOfLines, $numberOfSeeks, $numberOfReadLines);
+   testMemoryMapped($fileName, $numberOfLines, $numberOfSeeks, $numberOfReadLines);
 }
 
 sub concurrentTest
@@ -150,6 +192,18 @@ test("text/two-big-lines-with-new-line-at-the-end.txt", 2, 10, 10);
 test("text/two-lines.txt", 1, 10, 10);
 test("text/two-lines-with-new-line-at-the-end.txt", 2, 10, 10);
 
+testMemoryMapped("text/empty.txt", 0, 10, 10);
+testMemoryMapped("text/one-character.txt", 0, 10, 10);
+testMemoryMapped("text/one-big-line.txt", 0, 10, 10);
+testMemoryMapped("text/one-big-line-with-new-line-at-the-end.txt", 1, 10, 10);
+testMemoryMapped("text/one-line.txt", 0, 10, 10);
+testMemoryMapped("text/one-line-with-new-line-at-the-end.txt", 1, 10, 10);
+testMemoryMapped("text/ten-new-lines.txt", 10, 10, 20);
+testMemoryMapped("text/two-big-lines.txt", 1, 10, 10);
+testMemoryMapped("text/two-big-lines-with-new-line-at-the-end.txt", 2, 10, 10);
+testMemoryMapped("text/two-lines.txt", 1, 10, 10);
+testMemoryMapped("text/two-lines-with-new-line-at-the-end.txt", 2, 10, 10);
+
 generateAndTest("generated/tiny-small-lines.txt",   1E+5, 1000, 100, 100);
 generateAndTest("generated/small-small-lines.txt",  1E+6, 1000, 100, 100);
 generateAndTest("generated/medium-small-lines.txt", 1E+7, 1000, 1000, 1000);
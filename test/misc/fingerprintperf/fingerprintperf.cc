@@ -0,0 +1,61 @@
+#include <chrono>
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class HasherBenchmark : public cSimpleModule
+{
+  protected:
+    template <typename H> void measure(const char *label, long numIterations);
+    virtual void initialize() override;
+};
+
+Define_Module(HasherBenchmark);
+
+template <typename H>
+void HasherBenchmark::measure(const char *label, long numIterations)
+{
+    H hasher;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < numIterations; i++) {
+        // event number, simulation time, module full path, extra data
+        hasher << (int64_t)i << SimTime::fromRaw(i*1000) << "EventStream.host[42].node" << i*0.5;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t bytesPerIteration = 8 + 8 + strlen("EventStream.host[42].node")+1 + 8;
+    EV << label << ": " << seconds << "s, " << (numIterations * bytesPerIteration / seconds / 1e6) << " MB/s, hash: " << hasher.str() << "\n";
+}
+
+void HasherBenchmark::initialize()
+{
+    long numIterations = par("numIterations").intValue();
+    measure<cHasher>("cHasher", numIterations);
+    measure<cHasher64>("cHasher64", numIterations);
+}
+
+class Node : public cSimpleModule
+{
+  protected:
+    int numPeers;
+
+  protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+};
+
+Define_Module(Node);
+
+void Node::initialize()
+{
+    numPeers = par("numPeers");
+    scheduleAt(exponential(1), new cMessage("job"));
+}
+
+void Node::handleMessage(cMessage *msg)
+{
+    cModule *peer = getParentModule()->getParentModule()->getSubmodule("host", intuniform(0, numPeers-1))->getSubmodule("node");
+    if (msg->isSelfMessage())
+        sendDirect(msg, exponential(1), 0, peer, "in");
+    else
+        scheduleAt(simTime() + exponential(1), msg);
+}
@@ -0,0 +1,135 @@
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <vector>
+#include "layout/basicspringembedderlayout.h"
+#include "layout/forcedirectedgraphlayouter.h"
+#include <omnetpp.h>  // after the layout headers, to avoid clashing with NaN in omnetpp::common
+
+using namespace omnetpp;
+using namespace omnetpp::layout;
+
+class LayoutBenchmark : public cSimpleModule
+{
+  protected:
+    int numNodes;
+    std::vector<std::pair<int,int>> edges;
+
+  protected:
+    static double measure(const std::function<void()>& f);
+    void report(const char *label, GraphLayouter& layouter, double time);
+    void runBasicSpringEmbedder(bool exact);
+    void runForceDirected(bool exact);
+    virtual void initialize() override;
+};
+
+Define_Module(LayoutBenchmark);
+
+static const double NODE_SIZE = 40;
+
+double LayoutBenchmark::measure(const std::function<void()>& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void LayoutBenchmark::report(const char *label, GraphLayouter& layouter, double time)
+{
+    std::vector<double> xs(numNodes), ys(numNodes);
+    for (int i = 0; i < numNodes; i++)
+        layouter.getNodePosition(i, xs[i], ys[i]);
+
+    // edge length statistics
+    double sum = 0, sumSquares = 0;
+    for (auto& edge : edges) {
+        double length = std::hypot(xs[edge.first] - xs[edge.second], ys[edge.first] - ys[edge.second]);
+        sum += length;
+        sumSquares += length * length;
+    }
+    double mean = sum / edges.size();
+    double stddev = std::sqrt(std::max(0.0, sumSquares / edges.size() - mean * mean));
+
+    // nodes overlapping another node, using a grid with the node size as cell size
+    std::map<std::pair<long,long>, std::vector<int>> grid;
+    for (int i = 0; i < numNodes; i++)
+        grid[std::make_pair((long)std::floor(xs[i] / NODE_SIZE), (long)std::floor(ys[i] / NODE_SIZE))].push_back(i);
+    int numOverlapping = 0;
+    for (int i = 0; i < numNodes; i++) {
+        long cx = (long)std::floor(xs[i] / NODE_SIZE), cy = (long)std::floor(ys[i] / NODE_SIZE);
+        bool overlapping = false;
+        for (long gx = cx - 1; gx <= cx + 1 && !overlapping; gx++) {
+            for (long gy = cy - 1; gy <= cy + 1 && !overlapping; gy++) {
+                auto it = grid.find(std::make_pair(gx, gy));
+                if (it != grid.end())
+                    for (int j : it->second)
+                        if (j != i && std::abs(xs[i] - xs[j]) < NODE_SIZE && std::abs(ys[i] - ys[j]) < NODE_SIZE)
+                            overlapping = true;
+            }
+        }
+        if (overlapping)
+            numOverlapping++;
+    }
+
+    EV << label << ": " << time << " s, edge length deviation: " << stddev / mean
+       << ", overlapping nodes: " << (double)numOverlapping / numNodes << "\n";
+}
+
+void LayoutBenchmark::runBasicSpringEmbedder(bool exact)
+{
+    BasicGraphLayouterEnvironment environment;
+    BasicSpringEmbedderLayout layouter;
+    layouter.setEnvironment(&environment);
+    layouter.setSeed(1);
+    layouter.setNumThreads(par("numThreads"));
+    if (exact)
+        layouter.setBarnesHutThreshold(INT_MAX);
+    for (int i = 0; i < numNodes; i++)
+        layouter.addMovableNode(i, NODE_SIZE, NODE_SIZE);
+    for (auto& edge : edges)
+        layouter.addEdge(edge.first, edge.second);
+    double time = measure([&]() {layouter.execute();});
+    report(exact ? "BasicSpringEmbedderLayout, exact" : "BasicSpringEmbedderLayout, Barnes-Hut", layouter, time);
+}
+
+void LayoutBenchmark::runForceDirected(bool exact)
+{
+    BasicGraphLayouterEnvironment environment;
+    environment.addParameter("bht", exact ? INT_MAX : 200);
+    ForceDirectedGraphLayouter layouter;
+    layouter.setEnvironment(&environment);
+    layouter.setSeed(1);
+    for (int i = 0; i < numNodes; i++)
+        layouter.addMovableNode(i, NODE_SIZE, NODE_SIZE);
+    for (auto& edge : edges)
+        layouter.addEdge(edge.first, edge.second);
+    double time = measure([&]() {layouter.execute();});
+    report(exact ? "ForceDirectedGraphLayouter, exact" : "ForceDirectedGraphLayouter, Barnes-Hut", layouter, time);
+}
+
+void LayoutBenchmark::initialize()
+{
+    numNodes = par("numNodes");
+    int numExtraEdges = (int)(numNodes * par("numEdgesPerNode").doubleValue());
+
+    // random spanning tree plus random extra edges
+    for (int i = 1; i < numNodes; i++)
+        edges.push_back(std::make_pair(i, intuniform(0, i-1)));
+    for (int i = 0; i < numExtraEdges; i++) {
+        int a = intuniform(0, numNodes-1), b = intuniform(0, numNodes-1);
+        if (a != b)
+            edges.push_back(std::make_pair(a, b));
+    }
+
+    EV << numNodes << " nodes, " << edges.size() << " edges\n";
+    if (numNodes <= par("exactLimit").intValue())
+        runBasicSpringEmbedder(true);
+    runBasicSpringEmbedder(false);
+    if (numNodes <= par("forceDirectedLimit").intValue()) {
+        if (numNodes <= par("exactLimit").intValue())
+            runForceDirected(true);
+        runForceDirected(false);
+    }
+}
@@ -0,0 +1,105 @@
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class PathLookupBenchmark : public cSimpleModule
+{
+  protected:
+    std::vector<std::string> paths;  // absolute paths
+    std::vector<std::string> relativePaths;  // the same paths, relative to the network
+
+    static cModule *linearGetSubmodule(cModule *parent, const char *name, int index);
+    static cModule *linearFindModuleByPath(cModule *root, const char *path);
+    template <typename F> double measure(const std::vector<std::string>& lookupPaths, long numLookups, F lookup);
+    virtual void initialize() override;
+};
+
+Define_Module(PathLookupBenchmark);
+
+// Submodule lookup as it was done before the per-module name index:
+// linear search among the submodules
+cModule *PathLookupBenchmark::linearGetSubmodule(cModule *parent, const char *name, int index)
+{
+    for (cModule::SubmoduleIterator it(parent); !it.end(); ++it)
+        if ((*it)->isName(name) && (*it)->getIndex() == index)
+            return *it;
+    return nullptr;
+}
+
+// Absolute path lookup without the cache; only understands "name.name[index]..."
+cModule *PathLookupBenchmark::linearFindModuleByPath(cModule *root, const char *path)
+{
+    std::string buf = path;
+    cModule *module = root;
+    char *rest = &buf[0];
+    while (rest && module) {
+        char *token = rest;
+        rest = strchr(rest, '.');
+        if (rest)
+            *rest++ = '\0';
+        int index = -1;
+        if (char *lbracket = strchr(token, '[')) {
+            index = atoi(lbracket+1);
+            *lbracket = '\0';
+        }
+        module = linearGetSubmodule(module, token, index);
+    }
+    return module;
+}
+
+template <typename F>
+double PathLookupBenchmark::measure(const std::vector<std::string>& lookupPaths, long numLookups, F lookup)
+{
+    int numPaths = lookupPaths.size();
+    long found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < numLookups; i++)
+        if (lookup(lookupPaths[(i * 7919) % numPaths].c_str()))
+            found++;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (found != numLookups)
+        throw cRuntimeError("Lookup failed");
+    return seconds / numLookups * 1e9;
+}
+
+void PathLookupBenchmark::initialize()
+{
+    cModule *network = getSystemModule();
+    int numGroups = network->par("numGroups");
+    int numScalars = par("numScalarSubmodules");
+    long numLookups = par("numLookups").intValue();
+
+    // scalar submodules cannot be declared in bulk in NED, so create them here
+    cModuleType *boxType = cModuleType::get("Box");
+    for (int g = 0; g < numGroups; g++) {
+        cModule *group = network->getSubmodule("group", g);
+        int numHosts = group->par("numHosts");
+        for (int i = 0; i < numScalars; i++) {
+            std::string name = "s" + std::to_string(i);
+            boxType->createScheduleInit(name.c_str(), group);
+            paths.push_back("group[" + std::to_string(g) + "]." + name);
+        }
+        for (int i = 0; i < numHosts; i++)
+            paths.push_back("group[" + std::to_string(g) + "].host[" + std::to_string(i) + "]");
+    }
+    for (const std::string& path : paths)
+        relativePaths.push_back("." + path);
+    EV << "Network has " << getSimulation()->getLastComponentId() << " components, looking up " << paths.size() << " different paths\n";
+
+    long n = std::min(numLookups, 100000L);  // the linear search is slow
+    auto find = [&](const char *path) {return network->findModuleByPath(path);};
+    double linearTime = measure(paths, n, [&](const char *path) {return linearFindModuleByPath(network, path);});
+    double relativeTime = measure(relativePaths, numLookups, find);
+    getSimulation()->invalidateModulePathCache();
+    double coldTime = measure(paths, paths.size(), find);
+    double cachedTime = measure(paths, numLookups, find);
+
+    EV << "linear search, no cache:            " << linearTime << " ns/lookup\n";
+    EV << "hashed submodule lookup, no cache:  " << relativeTime << " ns/lookup (relative paths)\n";
+    EV << "absolute paths, first lookup:       " << coldTime << " ns/lookup\n";
+    EV << "absolute paths, cached:             " << cachedTime << " ns/lookup\n";
+}
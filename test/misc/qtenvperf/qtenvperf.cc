@@ -0,0 +1,99 @@
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class Node : public cSimpleModule
+{
+};
+
+Define_Module(Node);
+
+class Driver : public cSimpleModule
+{
+  protected:
+    typedef std::chrono::steady_clock Clock;
+
+    cMessage *timer = nullptr;
+    cPolylineFigure *trace = nullptr;
+    int numFrames;
+
+    // the display update is the time between refreshDisplay() and the next event
+    mutable bool frameStarted = false;
+    mutable Clock::time_point frameStart;
+    std::vector<double> frameTimes;
+
+  protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void refreshDisplay() const override;
+    void report();
+
+  public:
+    virtual ~Driver() {cancelAndDelete(timer);}
+};
+
+Define_Module(Driver);
+
+void Driver::initialize()
+{
+    numFrames = par("numFrames");
+    trace = check_and_cast<cPolylineFigure *>(getParentModule()->getCanvas()->getFigure("trace"));
+    timer = new cMessage("timer");
+    scheduleAt(simTime(), timer);
+}
+
+void Driver::handleMessage(cMessage *msg)
+{
+    if (frameStarted) {
+        frameTimes.push_back(std::chrono::duration<double>(Clock::now() - frameStart).count());
+        frameStarted = false;
+        if ((int)frameTimes.size() >= numFrames) {
+            report();
+            endSimulation();
+        }
+    }
+
+    // change the icon color of a few nodes
+    cModule *network = getParentModule();
+    int numNodes = network->par("numNodes");
+    int numChanges = par("numChanges");
+    for (int i = 0; i < numChanges; i++) {
+        cModule *node = network->getSubmodule("node", intuniform(0, numNodes-1));
+        node->getDisplayString().setTagArg("i", 1, intuniform(0, 1) ? "red" : "");
+    }
+
+    // extend the trace (a random walk over the network), and change its color
+    int numColumns = network->par("numColumns");
+    cFigure::Point last = trace->getNumPoints() > 0 ? trace->getPoint(trace->getNumPoints()-1) : cFigure::Point(100, 100);
+    double scale = network->par("scale");
+    double x = std::max(100.0, std::min(last.x + normal(0, 60), 100 + 60 * numColumns * scale));
+    double y = std::max(100.0, std::min(last.y + normal(0, 60), 100 + 60 * numNodes / numColumns * scale));
+    trace->addPoint(cFigure::Point(x, y));
+    trace->setLineColor(cFigure::GOOD_DARK_COLORS[intuniform(0, cFigure::NUM_GOOD_DARK_COLORS-1)]);
+
+    scheduleAt(simTime() + par("interval"), msg);
+}
+
+void Driver::refreshDisplay() const
+{
+    frameStart = Clock::now();
+    frameStarted = true;
+}
+
+void Driver::report()
+{
+    std::sort(frameTimes.begin(), frameTimes.end());
+    double sum = 0;
+    for (double t : frameTimes)
+        sum += t;
+    int numNodes = getParentModule()->par("numNodes");
+    double scale = getParentModule()->par("scale");
+    std::cout << numNodes << " nodes, scale " << scale << ": "
+              << "mean frame time: " << 1000 * sum / frameTimes.size() << " ms, "
+              << "median: " << 1000 * frameTimes[frameTimes.size() / 2] << " ms, "
+              << "max: " << 1000 * frameTimes.back() << " ms" << std::endl;
+}
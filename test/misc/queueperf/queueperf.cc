@@ -0,0 +1,128 @@
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+// The linked list that cQueue used before it was changed to an array,
+// with the same insertion, removal and ownership logic, for comparison
+class ListQueue : public cOwnedObject
+{
+  private:
+    struct QElem
+    {
+        cObject *obj;
+        QElem *prev;
+        QElem *next;
+    };
+    QElem *frontp = nullptr, *backp = nullptr;
+    int len = 0;
+    cQueue::CompareFunc compare;
+
+    void insafter(QElem *p, cObject *obj) {
+        QElem *e = new QElem;
+        e->obj = obj;
+        e->prev = p;
+        e->next = p ? p->next : frontp;
+        if (e->next) e->next->prev = e; else backp = e;
+        if (p) p->next = e; else frontp = e;
+        len++;
+    }
+
+  public:
+    ListQueue(const char *name, cQueue::CompareFunc compare) : cOwnedObject(name), compare(compare) {}
+    virtual ~ListQueue() {while (frontp) delete pop();}
+
+    void insert(cObject *obj) {
+        take(static_cast<cOwnedObject *>(obj));
+        QElem *p = backp;
+        while (compare && p && compare(obj, p->obj) < 0)
+            p = p->prev;
+        insafter(p, obj);
+    }
+
+    cObject *remove(cObject *obj) {
+        QElem *p = frontp;
+        while (p && p->obj != obj)
+            p = p->next;
+        if (!p)
+            return nullptr;
+        if (p->next) p->next->prev = p->prev; else backp = p->prev;
+        if (p->prev) p->prev->next = p->next; else frontp = p->next;
+        delete p;
+        len--;
+        drop(static_cast<cOwnedObject *>(obj));
+        return obj;
+    }
+
+    cObject *pop() {return remove(frontp->obj);}
+    cObject *get(int i) const {QElem *p = frontp; while (p && i > 0) p = p->next, i--; return p ? p->obj : nullptr;}
+    int getLength() const {return len;}
+};
+
+static int compareByKind(cObject *a, cObject *b)
+{
+    return static_cast<cMessage *>(a)->getKind() - static_cast<cMessage *>(b)->getKind();
+}
+
+class QueueBenchmark : public cSimpleModule
+{
+  protected:
+    template <typename Q> double measure(Q& queue, int depth, long numOps, int numPriorities, bool removeFromMiddle);
+    void compare(const char *label, int depth, long numOps, int numPriorities, bool removeFromMiddle);
+    virtual void initialize() override;
+};
+
+Define_Module(QueueBenchmark);
+
+// Keeps the queue at the given depth: each operation inserts a message
+// and pops (or removes from the middle) another one. Returns ns/operation.
+template <typename Q>
+double QueueBenchmark::measure(Q& queue, int depth, long numOps, int numPriorities, bool removeFromMiddle)
+{
+    std::vector<cMessage *> msgs(depth + 1);
+    for (int i = 0; i <= depth; i++)
+        msgs[i] = new cMessage("msg", numPriorities > 1 ? intuniform(0, numPriorities - 1) : 0);
+    // fill in priority order, otherwise filling a deep list would take O(depth^2) time
+    std::stable_sort(msgs.begin(), msgs.begin() + depth, [](cMessage *a, cMessage *b) {return a->getKind() < b->getKind();});
+    for (int i = 0; i < depth; i++)
+        queue.insert(msgs[i]);
+    cMessage *spare = msgs[depth];
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < numOps; i++) {
+        queue.insert(spare);
+        spare = static_cast<cMessage *>(removeFromMiddle ? queue.remove(queue.get(depth / 2)) : queue.pop());
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    delete spare;
+    while (queue.getLength() > 0)
+        delete queue.pop();
+    return seconds / numOps * 1e9;
+}
+
+void QueueBenchmark::compare(const char *label, int depth, long numOps, int numPriorities, bool removeFromMiddle)
+{
+    cQueue::CompareFunc cmp = numPriorities > 0 ? compareByKind : nullptr;
+    ListQueue listQueue("list", cmp);
+    cQueue queue("queue", cmp);
+    // best of two alternating runs, to reduce the effect of warm-up and noise
+    double listTime = 1e300, queueTime = 1e300;
+    for (int i = 0; i < 2; i++) {
+        listTime = std::min(listTime, measure(listQueue, depth, numOps, numPriorities, removeFromMiddle));
+        queueTime = std::min(queueTime, measure(queue, depth, numOps, numPriorities, removeFromMiddle));
+    }
+    EV << label << " depth=" << depth << ": list " << listTime << " ns/op, cQueue " << queueTime << " ns/op, speedup " << listTime / queueTime << "x\n";
+}
+
+void QueueBenchmark::initialize()
+{
+    long numOps = par("numOps").intValue();
+    for (int depth : {10, 1000, 50000, 100000, 1000000}) {
+        long n = std::min(numOps, 500000000L / depth);  // the list is slow on deep queues
+        compare("FIFO                  ", depth, numOps, 0, false);
+        compare("priority, 8 classes   ", depth, n, 8, false);
+        compare("priority, 1000 classes", depth, n, 1000, false);
+        compare("FIFO, remove(get(n/2))", depth, n, 0, true);
+    }
+}
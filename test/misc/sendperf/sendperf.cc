@@ -0,0 +1,62 @@
+#include <chrono>
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class SendBenchmark : public cSimpleModule
+{
+  protected:
+    static const int BATCH_SIZE = 1000;
+    cMessage *timer = nullptr;
+    long numMessages = 0;
+    long numSent = 0;
+    double time[2] = {0, 0};  // hop-by-hop, skipped
+
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+
+  public:
+    virtual ~SendBenchmark() {cancelAndDelete(timer);}
+};
+
+Define_Module(SendBenchmark);
+
+void SendBenchmark::initialize()
+{
+    numMessages = par("numMessages");
+    timer = new cMessage("timer");
+    scheduleAt(0, timer);
+}
+
+// sends a batch of messages in both modes, alternately
+void SendBenchmark::handleMessage(cMessage *msg)
+{
+    int mode = (numSent / BATCH_SIZE) % 2;
+    bool origSuppress = getEnvir()->suppressSendHopNotifications;
+    getEnvir()->suppressSendHopNotifications = mode == 1;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BATCH_SIZE; i++)
+        send(new cMessage("msg"), "out");
+    time[mode] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    getEnvir()->suppressSendHopNotifications = origSuppress;
+
+    numSent += BATCH_SIZE;
+    if (numSent < 2 * numMessages)
+        scheduleAt(simTime() + 1, timer);
+}
+
+void SendBenchmark::finish()
+{
+    int depth = getSystemModule()->getSubmodule("nest", getIndex())->par("depth");
+    EV << "depth " << depth << ": hop-by-hop " << time[0] / numMessages * 1e9 << " ns/send, skipping ideal connections "
+       << time[1] / numMessages * 1e9 << " ns/send\n";
+}
+
+class Sink : public cSimpleModule
+{
+  protected:
+    virtual void handleMessage(cMessage *msg) override {delete msg;}
+};
+
+Define_Module(Sink);
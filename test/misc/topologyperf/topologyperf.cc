@@ -0,0 +1,98 @@
+#include <chrono>
+#include <vector>
+#include <functional>
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+class TopologyBenchmark : public cSimpleModule
+{
+  protected:
+    static double measure(const std::function<void()>& f);
+    void compare(cTopology& topo, bool weighted);
+    virtual void initialize() override;
+};
+
+Define_Module(TopologyBenchmark);
+
+double TopologyBenchmark::measure(const std::function<void()>& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void TopologyBenchmark::compare(cTopology& topo, bool weighted)
+{
+    const char *label = weighted ? "weighted" : "unweighted";
+    int n = topo.getNumNodes();
+
+    // the single-target methods, with checking the results of the all-pairs ones
+    double singleTime = 0;
+    for (int t = 0; t < n; t++) {
+        cTopology::Node *target = topo.getNode(t);
+        singleTime += measure([&]() {
+            if (weighted)
+                topo.calculateWeightedSingleShortestPathsTo(target);
+            else
+                topo.calculateUnweightedSingleShortestPathsTo(target);
+        });
+        for (int s = 0; s < n; s++)
+            if (topo.getDistance(topo.getNode(s), target) != topo.getNode(s)->getDistanceToTarget())
+                throw cRuntimeError("Mismatch between all-pairs and single-target results");
+    }
+
+    double allTime = measure([&]() {
+        if (weighted)
+            topo.calculateWeightedAllShortestPaths(1);
+        else
+            topo.calculateUnweightedAllShortestPaths(1);
+    });
+    double parallelTime = measure([&]() {
+        if (weighted)
+            topo.calculateWeightedAllShortestPaths();
+        else
+            topo.calculateUnweightedAllShortestPaths();
+    });
+
+    EV << label << ", " << n << " x single-target:  " << singleTime << " s\n";
+    EV << label << ", all-pairs, 1 thread:    " << allTime << " s\n";
+    EV << label << ", all-pairs, all threads: " << parallelTime << " s\n";
+}
+
+void TopologyBenchmark::initialize()
+{
+    int numNodes = par("numNodes");
+    int numLinks = numNodes * par("numLinksPerNode").intValue();
+    int numChangedLinks = par("numChangedLinks");
+
+    cTopology topo("topo");
+    for (int i = 0; i < numNodes; i++) {
+        cTopology::Node *node = new cTopology::Node(&topo);
+        node->setWeight(intuniform(0, 2));
+        topo.addNode(node);
+    }
+    std::vector<cTopology::Link *> links;
+    for (int i = 0; i < numLinks; i++) {
+        cTopology::Link *link = new cTopology::Link(&topo, intuniform(1, 10));
+        topo.addLink(link, topo.getNode(intuniform(0, numNodes-1)), topo.getNode(intuniform(0, numNodes-1)));
+        links.push_back(link);
+    }
+
+    topo.calculateUnweightedAllShortestPaths();
+    compare(topo, false);
+    topo.calculateWeightedAllShortestPaths();
+    compare(topo, true);
+
+    // incremental update after changing a few link weights
+    double updateTime = 0;
+    const int numRounds = 10;
+    for (int round = 0; round < numRounds; round++) {
+        for (int i = 0; i < numChangedLinks; i++) {
+            cTopology::Link *link = links[intuniform(0, numLinks-1)];
+            link->setWeight(intuniform(1, 10));
+        }
+        updateTime += measure([&]() {topo.updateAllShortestPaths(1);});
+    }
+    EV << "weighted, update after changing " << numChangedLinks << " links, 1 thread: " << updateTime / numRounds << " s\n";
+}